@@ -64,6 +64,12 @@ public:
 	 */
 	void classifyRegion(int region);
 
+	/***
+	 * @brief 	Classifies the given regions in parallel. The features are
+	 * 			appended to \ref m_features in the order of the given regions.
+	 */
+	virtual void classifyRegions(const vector<int>& regions);
+
 	/***
 	 * @brief 	Returns the number of generated features in the classification stage
 	 */
@@ -83,6 +89,9 @@ public:
 
 private:
 
+	/// Creates the feature vector of region r from its statistics
+	void createFeature(int r, const RegionStatistics<VertexT, NormalT>& stats, PlanarClusterFeature& pf);
+
 	/// A vector containing the planar feature vectors for all
 	/// classified regions
 	vector<PlanarClusterFeature> m_features;
@@ -65,45 +65,10 @@ void FurnitureFeatureClassifier<VertexT, NormalT>::classifyRegion(int r)
 		Region<VertexT, NormalT>* region = this->m_regions->at(r);
 		if(region)
 		{
-			region->calcArea();
-			pf.index = r;
-			pf.area = region->getArea();
-			pf.nx = region->m_normal.x;
-			pf.ny = region->m_normal.y;
-			pf.nz = region->m_normal.z;
-
-			BoundingBox<VertexT> bb = region->getBoundingBox();
-			VertexT centroid = bb.getCentroid();
-			pf.cx = centroid.x;
-			pf.cy = centroid.y;
-			pf.cz = centroid.z;
-			pf.w = bb.getXSize();
-			pf.h = bb.getYSize();
-			pf.d = bb.getZSize();
-
-			NormalT n_ceil(0.0, 0.0, 1.0);
-			NormalT n_floor(0.0, 0.0, -1.0);
-			float radius = sqrt(pf.nx * pf.nx + pf.ny * pf.ny);
-
-			pf.orientation = UNKNOWN;
-		    if(n_ceil * region->m_normal > 0.98 || n_floor * region->m_normal > 0.98)
-		    {
-		    	pf.orientation = HORIZONTAL;
-		    }
-		    else if(radius > 0.90)
-		    {
-		    	pf.orientation = VERTICAL;
-		    }
-
-		    this->m_features.push_back(pf);
-
-//		    std::cout << "Index: " << pf.index << std::endl;
-//		    std::cout << "Centroid: " << pf.cx << " " << pf.cy << " " << pf.cz << std::endl;
-//		    std::cout << "BBOX: " << pf.w << " " << pf.h << " " << pf.d << std::endl;
-//		    std::cout << "Normal: " << pf.nx << " " << pf.ny << " " << pf.nz << std::endl;
-//		    std::cout << "Area: " << pf.area << std::endl;
-//		    std::cout << "Orientation: " << pf.orientation << std::endl;
-
+			RegionStatistics<VertexT, NormalT> stats;
+			this->calcStatistics(region, stats);
+			createFeature(r, stats, pf);
+			this->m_features.push_back(pf);
 		}
 	}
 	else
@@ -112,4 +77,76 @@ void FurnitureFeatureClassifier<VertexT, NormalT>::classifyRegion(int r)
 	}
 }
 
+template<typename VertexT, typename NormalT>
+void FurnitureFeatureClassifier<VertexT, NormalT>::classifyRegions(const vector<int>& regions)
+{
+	this->calcStatistics(regions);
+
+	// Features are created in parallel into pre-sized buffers and
+	// appended in the order of the given regions
+	vector<PlanarClusterFeature> features(regions.size());
+	vector<char> valid(regions.size(), 0);
+
+	#pragma omp parallel for schedule(dynamic, 64)
+	for(long i = 0; i < (long)regions.size(); i++)
+	{
+		int r = regions[i];
+		if(r >= 0 && (size_t)r < this->m_regions->size() && this->m_regions->at(r))
+		{
+			createFeature(r, this->m_statistics[r], features[i]);
+			valid[i] = 1;
+		}
+	}
+
+	for(size_t i = 0; i < regions.size(); i++)
+	{
+		if(valid[i])
+		{
+			this->m_features.push_back(features[i]);
+		}
+		else
+		{
+			cout << timestamp << " Furniture Classifier: Region number out of bounds." << endl;
+		}
+	}
+}
+
+template<typename VertexT, typename NormalT>
+void FurnitureFeatureClassifier<VertexT, NormalT>::createFeature(
+		int r,
+		const RegionStatistics<VertexT, NormalT>& stats,
+		PlanarClusterFeature& pf)
+{
+	Region<VertexT, NormalT>* region = this->m_regions->at(r);
+
+	pf.index = r;
+	pf.area = stats.area;
+	pf.nx = region->m_normal.x;
+	pf.ny = region->m_normal.y;
+	pf.nz = region->m_normal.z;
+
+	BoundingBox<VertexT> bb = stats.bb;
+	VertexT centroid = bb.getCentroid();
+	pf.cx = centroid.x;
+	pf.cy = centroid.y;
+	pf.cz = centroid.z;
+	pf.w = bb.getXSize();
+	pf.h = bb.getYSize();
+	pf.d = bb.getZSize();
+
+	NormalT n_ceil(0.0, 0.0, 1.0);
+	NormalT n_floor(0.0, 0.0, -1.0);
+	float radius = sqrt(pf.nx * pf.nx + pf.ny * pf.ny);
+
+	pf.orientation = UNKNOWN;
+	if(n_ceil * region->m_normal > 0.98 || n_floor * region->m_normal > 0.98)
+	{
+		pf.orientation = HORIZONTAL;
+	}
+	else if(radius > 0.90)
+	{
+		pf.orientation = VERTICAL;
+	}
+}
+
 } /* namespace lvr */
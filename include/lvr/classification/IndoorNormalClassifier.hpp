@@ -28,6 +28,7 @@
 
 //#include "RegionClassifier.hpp"
 #include <lvr/display/Color.hpp>
+#include <lvr/io/LabeledMeshIO.hpp>
 
 namespace lvr
 {
@@ -75,31 +76,46 @@ public:
 	 */
 	virtual uchar b(int region);
 
+	/**
+	 * @brief Writes all regions with their labels to the binary labeled
+	 * 		  mesh "clusters.lbm" (see \ref LabeledMeshIO)
+	 */
 	virtual void writeMetaInfo();
 
+	/**
+	 * @brief Classifies the given regions in parallel and caches the labels
+	 */
+	virtual void classifyRegions(const vector<int>& regions);
+
 private:
 
 	RegionLabel _classifyRegion(int region);
 
 	uchar* getColor(int region);
 
+	/**
+	 * @brief Collects the vertices and triangles of a region. Vertices are
+	 * 		  compacted via their index in the half edge mesh.
+	 *
+	 * @param region_id	The region to process
+	 * @param remap		Scratch array that maps mesh vertex indices to
+	 * 					region vertex indices. Unused entries are -1. The
+	 * 					array is enlarged if needed and reset on return.
+	 * @param vertices	The vertices of the region
+	 * @param indices	Triangles of the region with region vertex indices
+	 */
 	void createRegionBuffer(
 					int region_id,
-					map<VertexT, int> &map,
-					vector<int> &indices,
-					vector<float> &vertices,
-					vector<float> &normals,
-					vector<uint> &colors
+					vector<int> &remap,
+					vector<HalfEdgeVertex<VertexT, NormalT>*> &vertices,
+					vector<unsigned int> &indices
 					);
 
-	void writeBuffers(
-			ofstream &out,
-			RegionLabel label,
-			vector<int> &indices,
-			vector<float> &vertices,
-			vector<float> &normals,
-			vector<uint> &colors);
+	/// Labels computed by classifyRegions(), indexed by region number
+	vector<RegionLabel> m_labels;
 
+	/// True for all regions with a cached label
+	vector<char> m_classified;
 };
 
 } /* namespace lvr */
@@ -87,6 +87,11 @@ uchar IndoorNormalClassifier<VertexT, NormalT>::b(int i)
 template<typename VertexT, typename NormalT>
 RegionLabel IndoorNormalClassifier<VertexT, NormalT>::_classifyRegion(int index)
 {
+	// Use the result of classifyRegions() if available
+	if((unsigned int) index < m_classified.size() && m_classified[index])
+	{
+		return m_labels[index];
+	}
 
 	if((unsigned int) index < this->m_regions->size())
 	{
@@ -112,158 +117,186 @@ RegionLabel IndoorNormalClassifier<VertexT, NormalT>::_classifyRegion(int index)
 	return Unknown;
 }
 
+template<typename VertexT, typename NormalT>
+void IndoorNormalClassifier<VertexT, NormalT>::classifyRegions(const vector<int>& regions)
+{
+	// The statistics provide the region areas to HalfEdgeMesh::finalize()
+	RegionClassifier<VertexT, NormalT>::classifyRegions(regions);
+
+	// Drop labels of previous calls, the regions may have changed
+	m_labels.assign(this->m_regions->size(), Unknown);
+	m_classified.assign(this->m_regions->size(), 0);
+
+	vector<RegionLabel> labels(regions.size());
+
+	#pragma omp parallel for schedule(dynamic, 64)
+	for(long i = 0; i < (long)regions.size(); i++)
+	{
+		labels[i] = _classifyRegion(regions[i]);
+	}
+
+	for(size_t i = 0; i < regions.size(); i++)
+	{
+		if(regions[i] >= 0 && (size_t)regions[i] < m_labels.size())
+		{
+			m_labels[regions[i]] = labels[i];
+			m_classified[regions[i]] = 1;
+		}
+	}
+}
+
 template<typename VertexT, typename NormalT>
 void IndoorNormalClassifier<VertexT, NormalT>::createRegionBuffer(
 				int region_id,
-				map<VertexT, int> &vertex_map,
-				vector<int> &indices,
-				vector<float> &vertices,
-				vector<float> &normals,
-				vector<uint> &colors
+				vector<int> &remap,
+				vector<HalfEdgeVertex<VertexT, NormalT>*> &vertices,
+				vector<unsigned int> &indices
 				)
 {
-	//int index_counter = 0;
-	size_t	vertex_position = 0;
-
 	Region<VertexT, NormalT>* region = this->m_regions->at(region_id);
 
-	// get the color
-	uchar* color = getColor(region_id);
-	uchar red   = color[0];
-	uchar green = color[1];
-	uchar blue  = color[2];
-
-	// Check if region is a planar cluster
-	VertexT current;
-	NormalT normal;
-	for(unsigned int a = 0; a < region->m_faces.size(); a++)
+	for(size_t a = 0; a < region->m_faces.size(); a++)
 	{
+		HalfEdgeFace<VertexT, NormalT>* f = region->m_faces[a];
 		for(int d = 0; d < 3; d++)
 		{
-			HalfEdgeFace<VertexT, NormalT>* f = region->m_faces[a];
-
-			current = (*f)(d)->m_position;
-			normal =  (*f)(d)->m_normal;
+			HalfEdgeVertex<VertexT, NormalT>* v = (*f)(d);
+			size_t index = v->m_actIndex;
 
-			if(vertex_map.find(current) != vertex_map.end())
+			if(index >= remap.size())
 			{
-				// Use already present vertex
-				vertex_position = vertex_map[current];
+				remap.resize(std::max(index + 1, 2 * remap.size()), -1);
 			}
-			else
-			{
-				// Create new index
-				vertex_position = vertices.size() / 3;
 
-				// Insert new vertex to vertex map and save relevant information
-				vertex_map.insert(pair<VertexT, int>(current, vertex_position));
-
-				vertices.push_back(current.x);
-				vertices.push_back(current.y);
-				vertices.push_back(current.z);
-
-				normals.push_back(normal.x);
-				normals.push_back(normal.y);
-				normals.push_back(normal.z);
-
-				colors.push_back(red);
-				colors.push_back(green);
-				colors.push_back(blue);
+			// Create new region vertex on first use
+			if(remap[index] < 0)
+			{
+				remap[index] = vertices.size();
+				vertices.push_back(v);
 			}
 
-			indices.push_back(vertex_position);
+			indices.push_back(remap[index]);
 		}
 	}
-}
 
-template<typename VertexT, typename NormalT>
-void IndoorNormalClassifier<VertexT, NormalT>::writeBuffers(
-		ofstream &out,
-		RegionLabel label,
-		vector<int> &indices,
-		vector<float> &vertices,
-		vector<float> &normals,
-		vector<uint> &colors)
-{
-	static int c;
-	string str_label = "Unclassified";
-	switch(label)
+	// Reset the scratch array for the next region
+	for(size_t i = 0; i < vertices.size(); i++)
 	{
-	case Ceiling 	: str_label = "Ceiling"; 	break;
-	case Floor		: str_label = "Floor";		break;
-	case Wall		: str_label = "Wall";		break;
-	case Unknown	: return;
-	}
-
-	out << str_label << c << std::endl;
-	c++;
-	out << indices.size() / 3 << " " << vertices.size() / 3 << std::endl;
-	for(size_t c = 0; c < indices.size() / 3; c++)
-	{
-		size_t buff_pos = 3 * c;
-		out << indices[buff_pos] << " " << indices[buff_pos + 1] << " " << indices[buff_pos + 2] << std::endl;
-	}
-
-	for(size_t c = 0; c < vertices.size() / 3; c++)
-	{
-		size_t buff_pos = 3 * c;
-		out << vertices[buff_pos] << " " << vertices[buff_pos + 1] << " " << vertices[buff_pos + 2] << " ";
-		out << normals [buff_pos] << " " << normals [buff_pos + 1] << " " <<  normals[buff_pos + 2] << " ";
-		out << colors  [buff_pos] << " " << colors  [buff_pos + 1] << " " <<   colors[buff_pos + 2] << std::endl;
+		remap[vertices[i]->m_actIndex] = -1;
 	}
 }
 
 template<typename VertexT, typename NormalT>
 void IndoorNormalClassifier<VertexT, NormalT>::writeMetaInfo()
 {
-	ofstream out("clusters.clu");
+	size_t numRegions = this->m_regions->size();
 
-	if(!out.good())
+	vector<int> regionIds(numRegions);
+	for(size_t i = 0; i < numRegions; i++)
 	{
-		std::cout << "Unable to open cluster file." << std::endl;
-		return;
+		regionIds[i] = i;
 	}
+	this->calcStatistics(regionIds);
 
-	// Save all small clusters in a seperate mesh for
-	// performance reasons
-	vector<int> 	uc_indices;
-	vector<float> 	uc_vertices;
-	vector<uint> 	uc_colors;
-	vector<float> 	uc_normals;
-	map<VertexT, int> uc_vertex_map;
+	// Collect the vertices and triangles of all regions. Each
+	// thread uses its own scratch array for vertex compaction.
+	vector<vector<HalfEdgeVertex<VertexT, NormalT>*> > regionVertices(numRegions);
+	vector<vector<unsigned int> > regionIndices(numRegions);
 
-	for(unsigned int i = 0; i < this->m_regions->size(); i++)
+	#pragma omp parallel
 	{
-		// Get current region and label
-		Region<VertexT, NormalT>* region = this->m_regions->at(i);
+		vector<int> remap;
 
-		if(region->m_faces.size() > 20)
+		#pragma omp for schedule(dynamic, 16)
+		for(long i = 0; i < (long)numRegions; i++)
 		{
+			createRegionBuffer(i, remap, regionVertices[i], regionIndices[i]);
+		}
+	}
 
-			RegionLabel label = _classifyRegion(i);
+	// Compute the offsets of the regions in the output buffers
+	vector<size_t> vertexOffsets(numRegions + 1, 0);
+	vector<size_t> faceOffsets(numRegions + 1, 0);
+	for(size_t i = 0; i < numRegions; i++)
+	{
+		vertexOffsets[i + 1] = vertexOffsets[i] + regionVertices[i].size();
+		faceOffsets[i + 1] = faceOffsets[i] + regionIndices[i].size() / 3;
+	}
 
-			// Buffer vectors
-			vector<int> 	indices;
-			vector<float> 	vertices;
-			vector<float> 	normals;
-			vector<uint>	colors;
+	LabeledMesh mesh;
+	mesh.numVertices = vertexOffsets.back();
+	mesh.numFaces = faceOffsets.back();
+	mesh.vertices = floatArr(new float[3 * mesh.numVertices]);
+	mesh.normals = floatArr(new float[3 * mesh.numVertices]);
+	mesh.colors = ucharArr(new unsigned char[3 * mesh.numVertices]);
+	mesh.faces = uintArr(new unsigned int[3 * mesh.numFaces]);
+	mesh.faceRegions = uintArr(new unsigned int[mesh.numFaces]);
+	mesh.faceLabels = uintArr(new unsigned int[mesh.numFaces]);
+
+	// Label names are stored in the order of RegionLabel
+	mesh.labels.push_back("Wall");
+	mesh.labels.push_back("Floor");
+	mesh.labels.push_back("Ceiling");
+	mesh.labels.push_back("Unknown");
+	mesh.regions.resize(numRegions);
+
+	#pragma omp parallel for schedule(dynamic, 16)
+	for(long i = 0; i < (long)numRegions; i++)
+	{
+		// Small regions are not classified
+		RegionLabel label = Unknown;
+		if(this->m_regions->at(i)->m_faces.size() > 20)
+		{
+			label = _classifyRegion(i);
+		}
 
-			map<VertexT, int> vertex_map;
+		uchar* color = getColor(i);
 
-			createRegionBuffer(i, vertex_map, indices, vertices, normals, colors);
-			writeBuffers(out, label, indices, vertices, normals, colors);
+		const vector<HalfEdgeVertex<VertexT, NormalT>*>& vertices = regionVertices[i];
+		for(size_t j = 0; j < vertices.size(); j++)
+		{
+			size_t pos = 3 * (vertexOffsets[i] + j);
+			for(int k = 0; k < 3; k++)
+			{
+				mesh.vertices[pos + k] = vertices[j]->m_position[k];
+				mesh.normals[pos + k] = vertices[j]->m_normal[k];
+				mesh.colors[pos + k] = color[k];
+			}
+		}
+		delete[] color;
 
+		const vector<unsigned int>& indices = regionIndices[i];
+		for(size_t j = 0; j < indices.size(); j++)
+		{
+			mesh.faces[3 * faceOffsets[i] + j] = vertexOffsets[i] + indices[j];
 		}
-		else
+
+		for(size_t j = faceOffsets[i]; j < faceOffsets[i + 1]; j++)
 		{
-			createRegionBuffer(i, uc_vertex_map, uc_indices, uc_vertices, uc_normals, uc_colors);
+			mesh.faceRegions[j] = i;
+			mesh.faceLabels[j] = label;
 		}
 
+		// Region metadata
+		const RegionStatistics<VertexT, NormalT>& stats = this->m_statistics[i];
+		LabeledRegion& region = mesh.regions[i];
+		BoundingBox<VertexT> bb = stats.bb;
+		region.label = label;
+		region.numFaces = faceOffsets[i + 1] - faceOffsets[i];
+		region.area = stats.area;
+		for(int k = 0; k < 3; k++)
+		{
+			region.normal[k] = this->m_regions->at(i)->m_normal[k];
+			region.centroid[k] = stats.centroid[k];
+			region.bbMin[k] = bb.getMin()[k];
+			region.bbMax[k] = bb.getMax()[k];
+		}
 	}
 
-	// Write all unclassified clusters
-	writeBuffers(out, Unknown, uc_indices, uc_vertices, uc_normals, uc_colors);
-	out.close();
+	if(!LabeledMeshIO::write("clusters.lbm", mesh))
+	{
+		std::cout << "Unable to write cluster file." << std::endl;
+	}
 }
 
 } /* namespace lvr */
@@ -89,6 +89,11 @@ public:
 	 */
 	bool generatesLabel() { return true; }
 
+	/**
+	 * @brief Classifies the given regions in parallel and caches the labels
+	 */
+	virtual void classifyRegions(const vector<int>& regions);
+
 private:
 
 	NormalLabel _classifyRegion(int region);
@@ -104,6 +109,11 @@ private:
 					vector<uint> &colors
 					);
 
+	/// Labels computed by classifyRegions(), indexed by region number
+	vector<NormalLabel> m_labels;
+
+	/// True for all regions with a cached label
+	vector<char> m_classified;
 };
 
 } /* namespace lvr */
@@ -125,6 +125,11 @@ uchar NormalClassifier<VertexT, NormalT>::b(int i)
 template<typename VertexT, typename NormalT>
 NormalLabel NormalClassifier<VertexT, NormalT>::_classifyRegion(int index)
 {
+	// Use the result of classifyRegions() if available
+	if((unsigned int) index < m_classified.size() && m_classified[index])
+	{
+		return m_labels[index];
+	}
 
 	if((unsigned int) index < this->m_regions->size())
 	{
@@ -150,6 +155,34 @@ NormalLabel NormalClassifier<VertexT, NormalT>::_classifyRegion(int index)
 	return UnknownFace;
 }
 
+template<typename VertexT, typename NormalT>
+void NormalClassifier<VertexT, NormalT>::classifyRegions(const vector<int>& regions)
+{
+	// The statistics provide the region areas to HalfEdgeMesh::finalize()
+	RegionClassifier<VertexT, NormalT>::classifyRegions(regions);
+
+	// Drop labels of previous calls, the regions may have changed
+	m_labels.assign(this->m_regions->size(), UnknownFace);
+	m_classified.assign(this->m_regions->size(), 0);
+
+	vector<NormalLabel> labels(regions.size());
+
+	#pragma omp parallel for schedule(dynamic, 64)
+	for(long i = 0; i < (long)regions.size(); i++)
+	{
+		labels[i] = _classifyRegion(regions[i]);
+	}
+
+	for(size_t i = 0; i < regions.size(); i++)
+	{
+		if(regions[i] >= 0 && (size_t)regions[i] < m_labels.size())
+		{
+			m_labels[regions[i]] = labels[i];
+			m_classified[regions[i]] = 1;
+		}
+	}
+}
+
 template<typename VertexT, typename NormalT>
 void NormalClassifier<VertexT, NormalT>::createRegionBuffer(
 				int region_id,
@@ -34,6 +34,30 @@ using std::vector;
 namespace lvr
 {
 
+/**
+ * @brief	Geometric properties of a region that are collected in a single
+ * 			sweep over its faces
+ */
+template<typename VertexT, typename NormalT>
+struct RegionStatistics
+{
+	/// Sum of the face areas
+	float					area;
+
+	/// Bounding box of all face vertices
+	BoundingBox<VertexT>	bb;
+
+	/// Area weighted centroid of the faces
+	VertexT					centroid;
+
+	/// Area weighted mean of the face normals
+	NormalT					meanNormal;
+
+	/// Length of the area weighted normal sum divided by the area. Close
+	/// to one for planar regions, smaller for curved regions.
+	float					normalCoherence;
+};
+
 /**
  * @brief	Base class for cluster classification.
  */
@@ -99,6 +123,30 @@ public:
 
 	virtual void classifyRegion(int region) {};
 
+	/**
+	 * @brief	Classifies the given regions. The statistics of all regions
+	 * 			are computed in parallel and the results are stored per
+	 * 			region, so they do not depend on the number of threads.
+	 * 			Overwrite this method together with \ref classifyRegion and
+	 * 			call the base version to provide the statistics.
+	 */
+	virtual void classifyRegions(const vector<int>& regions) { calcStatistics(regions); }
+
+	/**
+	 * @brief	Returns the statistics of the given region. Only valid for
+	 * 			regions that were passed to \ref classifyRegions.
+	 */
+	const RegionStatistics<VertexT, NormalT>& getStatistics(int region) const { return m_statistics[region]; }
+
+	/**
+	 * @brief	True if the statistics of the given region were computed in
+	 * 			the last call of \ref classifyRegions.
+	 */
+	bool hasStatistics(int region) const
+	{
+		return region >= 0 && (size_t)region < m_hasStatistics.size() && m_hasStatistics[region];
+	}
+
 	/**
 	 * @brief Returns the label for the given region
 	 */
@@ -111,11 +159,23 @@ public:
 
 protected:
 
+	/// Computes the statistics of the given regions in parallel
+	void calcStatistics(const vector<int>& regions);
+
+	/// Computes the statistics of a single region
+	static void calcStatistics(Region<VertexT, NormalT>* region, RegionStatistics<VertexT, NormalT>& stats);
+
 	/// A pointer to a vector containing regions
 	vector<Region<VertexT, NormalT>* >*  m_regions;
 
 	/// minimum number of faces for classification
 	size_t m_minSize;
+
+	/// Statistics of the classified regions, indexed by region number
+	vector<RegionStatistics<VertexT, NormalT> > m_statistics;
+
+	/// True for all regions with valid statistics
+	vector<char> m_hasStatistics;
 };
 
 } /* namespace lvr */
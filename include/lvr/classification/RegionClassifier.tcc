@@ -23,3 +23,75 @@
  *      Author: Thomas Wiemann
  */
 
+namespace lvr
+{
+
+template<typename VertexT, typename NormalT>
+void RegionClassifier<VertexT, NormalT>::calcStatistics(const vector<int>& regions)
+{
+	if(m_statistics.size() < m_regions->size())
+	{
+		m_statistics.resize(m_regions->size());
+	}
+
+	// Drop statistics of previous calls, the regions may have changed
+	m_hasStatistics.assign(m_regions->size(), 0);
+
+	// Each region is handled by one thread, so no synchronisation is needed
+	#pragma omp parallel for schedule(dynamic, 64)
+	for(long i = 0; i < (long)regions.size(); i++)
+	{
+		int r = regions[i];
+		if(r >= 0 && (size_t)r < m_regions->size() && m_regions->at(r))
+		{
+			calcStatistics(m_regions->at(r), m_statistics[r]);
+			m_hasStatistics[r] = 1;
+		}
+	}
+}
+
+template<typename VertexT, typename NormalT>
+void RegionClassifier<VertexT, NormalT>::calcStatistics(
+		Region<VertexT, NormalT>* region,
+		RegionStatistics<VertexT, NormalT>& stats)
+{
+	float area = 0.0f;
+	BoundingBox<VertexT> bb;
+	float cx = 0.0f, cy = 0.0f, cz = 0.0f;
+	float nx = 0.0f, ny = 0.0f, nz = 0.0f;
+
+	for(size_t i = 0; i < region->m_faces.size(); i++)
+	{
+		HalfEdgeFace<VertexT, NormalT>* f = region->m_faces[i];
+		VertexT p0 = (*f)(0)->m_position;
+		VertexT p1 = (*f)(1)->m_position;
+		VertexT p2 = (*f)(2)->m_position;
+
+		bb.expand(p0);
+		bb.expand(p1);
+		bb.expand(p2);
+
+		// The length of the cross product is twice the face area
+		VertexT c = (p1 - p0).cross(p2 - p0);
+		float a = 0.5f * c.length();
+		area += a;
+
+		cx += a * (p0.x + p1.x + p2.x) / 3.0f;
+		cy += a * (p0.y + p1.y + p2.y) / 3.0f;
+		cz += a * (p0.z + p1.z + p2.z) / 3.0f;
+
+		nx += 0.5f * c.x;
+		ny += 0.5f * c.y;
+		nz += 0.5f * c.z;
+	}
+
+	stats.area = area;
+	stats.bb = bb;
+	stats.centroid = area > 0.0f ? VertexT(cx / area, cy / area, cz / area) : bb.getCentroid();
+	stats.normalCoherence = area > 0.0f ? sqrt(nx * nx + ny * ny + nz * nz) / area : 0.0f;
+
+	// Closed or degenerated regions have no mean normal
+	stats.meanNormal = stats.normalCoherence > 0.0f ? NormalT(nx, ny, nz) : region->m_normal;
+}
+
+} /* namespace lvr */
@@ -0,0 +1,191 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+/*
+ * TaskScheduler.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef TASKSCHEDULER_HPP_
+#define TASKSCHEDULER_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lvr
+{
+
+class TaskGroup;
+
+/**
+ * @brief   Work stealing task scheduler for recursive fork/join
+ *          algorithms (TaskGroup) and chunked loops whose chunks have
+ *          very different costs (parallelFor). Flat loops over arrays
+ *          use OpenMP, OpenMPConfig sizes both with the same thread count.
+ *
+ *          Every worker owns a task deque. New tasks are pushed to the
+ *          deque of the spawning worker and executed in LIFO order, idle
+ *          workers steal the oldest tasks of other workers. Threads that
+ *          wait for a task group execute pending tasks instead of blocking,
+ *          so nested parallel sections never create additional threads.
+ *
+ *          The scheduler uses numThreads() - 1 worker threads, because the
+ *          thread that waits for the results participates in the work. Inside
+ *          of worker threads OpenMP is restricted to a single thread to avoid
+ *          oversubscription when a task calls code that uses OpenMP.
+ */
+class TaskScheduler
+{
+public:
+
+    typedef std::function<void()> Task;
+
+    /// Returns the global scheduler instance
+    static TaskScheduler& instance();
+
+    /**
+     * @brief   Sets the number of threads (including the calling thread).
+     *          Must not be called while tasks are executed.
+     */
+    void setNumThreads(int n);
+
+    /// Returns the number of threads used for parallel sections
+    int numThreads() const { return m_numThreads; }
+
+    /// Returns the index of the current worker thread or -1
+    static int workerIndex();
+
+    /**
+     * @brief   Calls body(b, e) for disjoint sub ranges [b, e) that cover
+     *          [begin, end) in parallel and returns when all calls are done.
+     *
+     * @param   grain   Minimum size of a sub range. If 0 a size is chosen
+     *                  that results in a few chunks per thread.
+     */
+    void parallelFor(size_t begin, size_t end,
+                     const std::function<void(size_t, size_t)>& body,
+                     size_t grain = 0);
+
+    ~TaskScheduler();
+
+private:
+
+    friend class TaskGroup;
+
+    TaskScheduler();
+
+    /// A queued task and the group it belongs to
+    struct Item
+    {
+        Task        task;
+        TaskGroup*  group;
+    };
+
+    /// Task deque of a worker
+    struct Queue
+    {
+        std::deque<Item>    items;
+        std::mutex          mutex;
+    };
+
+    /// Enqueues a task of the given group
+    void spawn(const Task& task, TaskGroup* group);
+
+    /// Executes one pending task. Returns false if no task was found.
+    bool executeOne();
+
+    /// Main loop of the worker threads
+    void workerLoop(int index);
+
+    /// Starts the worker threads
+    void start();
+
+    /// Stops and joins the worker threads
+    void stop();
+
+    /// Computes chunk boundaries for the given range
+    void chunks(size_t begin, size_t end, size_t grain, std::vector<size_t>& bounds) const;
+
+    /// Number of threads including the calling thread
+    int                         m_numThreads;
+
+    /// Task queues. The last one is used by non-worker threads.
+    std::vector<Queue*>         m_queues;
+
+    /// Worker threads
+    std::vector<std::thread>    m_workers;
+
+    /// Number of queued tasks
+    std::atomic<long>           m_numQueued;
+
+    /// Stop flag for the workers
+    std::atomic<bool>           m_stop;
+
+    /// Used to put idle workers to sleep
+    std::mutex                  m_sleepMutex;
+    std::condition_variable     m_sleepCondition;
+};
+
+/**
+ * @brief   A set of tasks that can be waited for. Waiting threads help to
+ *          execute pending tasks. Exceptions thrown by a task are rethrown
+ *          by wait().
+ */
+class TaskGroup
+{
+public:
+
+    TaskGroup();
+
+    /// Waits for all tasks of the group
+    ~TaskGroup();
+
+    /// Runs the given task asynchronously
+    void run(const TaskScheduler::Task& task);
+
+    /// Returns after all tasks of the group (including tasks
+    /// spawned by them) are finished
+    void wait();
+
+private:
+
+    friend class TaskScheduler;
+
+    /// Called by the scheduler when a task of the group is done
+    void finished(std::exception_ptr error);
+
+    /// Number of unfinished tasks
+    std::atomic<long>   m_pending;
+
+    /// First exception thrown by a task
+    std::exception_ptr  m_error;
+    std::mutex          m_errorMutex;
+};
+
+} // namespace lvr
+
+#endif /* TASKSCHEDULER_HPP_ */
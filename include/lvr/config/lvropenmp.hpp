@@ -19,7 +19,7 @@ public:
 	/// Returns the number of supported threads (or 1 if OpenMP is not supported)
 	static int  getNumThreads();
 
-	/// Sets the number of used threads if OpenMP is used for parallelization
+	/// Sets the number of used threads for OpenMP and the task scheduler
 	static void setNumThreads(int n);
 
 	/// Enables the maximum number of parallel threads
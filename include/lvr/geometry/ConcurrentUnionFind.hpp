@@ -0,0 +1,126 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * ConcurrentUnionFind.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef CONCURRENTUNIONFIND_HPP_
+#define CONCURRENTUNIONFIND_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+namespace lvr
+{
+
+/**
+ * @brief   Lock free disjoint set forest that can be used from multiple
+ *          threads.
+ *
+ *          Sets are always linked to the root with the smaller index, so
+ *          the root of a set is its smallest element and the result does
+ *          not depend on the order of the unions. Paths are halved during
+ *          the search for a root.
+ */
+class ConcurrentUnionFind
+{
+public:
+
+    /// Creates n singleton sets
+    explicit ConcurrentUnionFind(size_t n) : m_parent(n)
+    {
+        #pragma omp parallel for schedule(static)
+        for(long i = 0; i < (long)n; i++)
+        {
+            m_parent[i].store((uint32_t)i);
+        }
+    }
+
+    /// Returns the number of elements
+    size_t size() const { return m_parent.size(); }
+
+    /// Returns true if x is the root of its set
+    bool isRoot(uint32_t x) const { return m_parent[x].load() == x; }
+
+    /// Returns the root of the set of x
+    uint32_t find(uint32_t x)
+    {
+        while(true)
+        {
+            uint32_t p = m_parent[x].load();
+            if(p == x)
+            {
+                return x;
+            }
+
+            uint32_t gp = m_parent[p].load();
+            if(gp != p)
+            {
+                // Failing is harmless, another thread already
+                // moved x closer to its root.
+                m_parent[x].compare_exchange_weak(p, gp);
+            }
+            x = gp;
+        }
+    }
+
+    /**
+     * @brief   Merges the sets of a and b.
+     *
+     * @return  True if the sets were different and this call linked them
+     */
+    bool unite(uint32_t a, uint32_t b)
+    {
+        while(true)
+        {
+            a = find(a);
+            b = find(b);
+            if(a == b)
+            {
+                return false;
+            }
+
+            if(a > b)
+            {
+                std::swap(a, b);
+            }
+
+            uint32_t expected = b;
+            if(m_parent[b].compare_exchange_strong(expected, a))
+            {
+                return true;
+            }
+        }
+    }
+
+private:
+
+    std::vector<std::atomic<uint32_t> > m_parent;
+};
+
+} // namespace lvr
+
+#endif /* CONCURRENTUNIONFIND_HPP_ */
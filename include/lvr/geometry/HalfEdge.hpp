@@ -59,6 +59,7 @@ public:
 	bool hasNeighborFace();
 	bool hasFace();
 	bool hasPair();
+	bool hasNext();
 
 private:
 	/// A pointer to the next edge in current contour
@@ -63,6 +63,12 @@ bool HalfEdge<HVertexT, FaceT>::hasPair()
    return p != 0;
 }
 
+template<typename HVertexT, typename FaceT>
+bool HalfEdge<HVertexT, FaceT>::hasNext()
+{
+   return n != 0;
+}
+
 template<typename HVertexT, typename FaceT>
 bool HalfEdge<HVertexT, FaceT>::hasFace()
 {
@@ -38,6 +38,7 @@ using namespace std;
 #include "Normal.hpp"
 #include "HalfEdge.hpp"
 #include "Region.hpp"
+#include "Quadric.hpp"
 
 
 namespace lvr
@@ -145,6 +146,12 @@ public:
 	 */
 	float getD();
 
+	/**
+	 * @brief Returns the error quadric of the face's plane. If use_tri is
+	 *        true, the quadric is weighted by the area of the face.
+	 */
+	Quadric getQuadric(bool use_tri);
+
 	/**
 	 * @brief Returns true, if one of the face's edges has no adjacent face
 	 */
@@ -187,6 +194,10 @@ public:
 	/// The face normal
 	NormalT							m_normal;
 
+	/// The plane quadric that was added to the quadrics of the vertices.
+	/// Only valid if the mesh maintains quadrics.
+	Quadric							m_quadric;
+
 	bool                            m_invalid;
 	bool 							m_fusion_face;
 
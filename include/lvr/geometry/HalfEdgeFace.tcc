@@ -269,6 +269,14 @@ float HalfEdgeFace<VertexT, NormalT>::getD()
 	return -(normal * vertex);
 }
 
+template<typename VertexT, typename NormalT>
+Quadric HalfEdgeFace<VertexT, NormalT>::getQuadric(bool use_tri)
+{
+	NormalT n = getFaceNormal();
+	float d = -(n * this->m_edge->end()->m_position);
+	return Quadric(n[0], n[1], n[2], d, use_tri ? getArea() : 1.0f);
+}
+
 
 template<typename VertexT, typename NormalT>
 bool HalfEdgeFace<VertexT, NormalT>::isBorderFace()
@@ -32,6 +32,7 @@
 #define HALFEDGEMESH_H_
 
 #include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <vector>
@@ -44,6 +45,8 @@
 #include <math.h>
 #include <algorithm>
 #include <queue>
+#include <limits>
+#include <stdint.h>
 
 #ifndef __APPLE__
 #include <GL/glu.h>
@@ -63,15 +66,20 @@ using namespace std;
 #include "HalfEdge.hpp"
 #include "HalfEdgeFace.hpp"
 #include "HalfEdgeAccessExceptions.hpp"
+#include "MeshNormals.hpp"
+#include "MeshComponents.hpp"
 
 #include <lvr/io/Timestamp.hpp>
+#include <lvr/config/lvropenmp.hpp>
 #include <lvr/io/Progress.hpp>
 #include <lvr/io/Model.hpp>
+#include <lvr/io/MeshCheckpointIO.hpp>
 
 #include "Region.hpp"
 #include "Tesselator.hpp"
 #include <lvr/texture/Texturizer.hpp>
 #include "ColorVertex.hpp"
+#include "VertexTraits.hpp"
 
 #include "VertexCosts.hpp"
 
@@ -195,6 +203,10 @@ public:
 	/**
 	 * @brief	Removes artifacts in the mesh that are not connected to the main mesh
 	 *
+	 * 			The connected components are labeled with a parallel
+	 * 			union-find (see MeshComponents) and all faces of small
+	 * 			components are deleted in a single pass.
+	 *
 	 * @param	threshold	Specifies the maximum number of faces
 	 * 						which will be detected as an artifact
 	 */
@@ -297,6 +309,23 @@ public:
 	 */
 	void reduceMeshByCollapse(int n_collapses, VertexCosts<VertexT, NormalT> &c);
 
+	/**
+	 * @brief	Calculates the error quadrics of all vertices in parallel.
+	 * 			Afterwards the quadrics are updated incrementally when faces
+	 * 			are added, deleted or flipped and when edges are collapsed.
+	 * 			Operations that move vertices otherwise (plane fitting and
+	 * 			intersection optimization) invalidate them.
+	 *
+	 * @param	useTriangleArea		If true, the face planes are weighted
+	 * 								by the area of the faces
+	 */
+	void calcQuadrics(bool useTriangleArea = false);
+
+	/**
+	 * @brief	Returns true if the vertex quadrics are up to date
+	 */
+	bool hasQuadrics() const { return m_quadricsValid; }
+
 	/**
 	 * @brief returns the RegionVector
 	 */
@@ -320,6 +349,40 @@ public:
 	 */
 	virtual void deleteRegions();
 
+	/**
+	 * @brief	Deletes the given faces and removes them from the face
+	 * 			list in a single pass. Vertices are not deleted, so the
+	 * 			vertex indices stay valid.
+	 */
+	void deleteFaces(const vector<FacePtr>& faces);
+
+	/**
+	 * @brief	Writes a binary snapshot of the complete mesh state, i.e.,
+	 * 			the topology, positions, normals, colors, the flags of
+	 * 			vertices, edges and faces, the region assignments and the
+	 * 			region planes (see MeshCheckpointIO). Post-processing can
+	 * 			be resumed from the snapshot with loadCheckpoint().
+	 *
+	 * @param	filename	The output file
+	 * @param	stage		Name of the last applied processing step
+	 *
+	 * @return	false if the snapshot could not be written
+	 */
+	bool saveCheckpoint(string filename, string stage = "");
+
+	/**
+	 * @brief	Restores a snapshot written by saveCheckpoint(). The mesh
+	 * 			has to be empty. Vertices, edges and faces are allocated in
+	 * 			contiguous blocks and linked in parallel.
+	 *
+	 * @param	filename	The checkpoint file
+	 * @param	stage		If not null, the stored processing step is
+	 * 						returned here
+	 *
+	 * @return	false if the snapshot could not be read
+	 */
+	bool loadCheckpoint(string filename, string* stage = 0);
+
 
 protected:
 
@@ -425,6 +488,14 @@ protected:
 	 */
 	virtual int stackSafeRegionGrowing(FacePtr start_face, NormalT &normal, float &angle, RegionPtr region);
 
+	/**
+	 * @brief	Fits regression planes to the given regions in parallel and
+	 * 			drags the regions into their planes in the given order. All
+	 * 			planes are fitted to the current geometry, so the result
+	 * 			does not depend on the number of threads.
+	 */
+	void fitRegionPlanes(vector<RegionPtr>& regions);
+
 	/**
 	 * @brief	Starts a region growing wrt the angle between the faces and returns the
 	 * 			number of connected faces. Faces are connected means they share a common
@@ -467,6 +538,18 @@ protected:
 	 */
 	virtual void dragOntoIntersection(RegionPtr plane, RegionPtr neighbor_region, VertexT& x, VertexT& direction);
 
+	/**
+	 * @brief	Adds the quadric of the given face to its vertices or
+	 * 			subtracts it from them
+	 */
+	void updateQuadrics(FacePtr f, bool add);
+
+	/// True if the vertex quadrics are maintained
+	bool						m_quadricsValid;
+
+	/// True if the quadrics are weighted by the face areas
+	bool						m_quadricsUseArea;
+
 	/**
 	 * @brief	Collapse the given edge safely
 	 *
@@ -502,6 +585,33 @@ protected:
 	set<HFace*>         m_garbageFaces;
 	set<RegionPtr>      m_garbageRegions;
 
+	/**
+	 * @brief	Builds the topology of the given indexed triangles in bulk.
+	 * 			The directed edges of all faces are keyed by their vertex
+	 * 			indices and sorted with a parallel radix sort, so twin edges
+	 * 			become neighbors. Vertices, edges and faces are allocated in
+	 * 			contiguous blocks.
+	 *
+	 * @param	vertices		The vertex positions
+	 * @param	numVertices		The number of vertices
+	 * @param	faces			The vertex indices of the faces
+	 * @param	numFaces		The number of faces. The up to 6 * numFaces
+	 * 							half edges have to fit into 32 bit indices.
+	 */
+	void buildFromArrays(floatArr vertices, size_t numVertices, uintArr faces, size_t numFaces);
+
+	/**
+	 * @brief	Stable parallel LSD radix sort of the given keys. The values
+	 * 			are permuted accordingly.
+	 */
+	static void radixSort(vector<uint64_t> &keys, vector<uint32_t> &values);
+
+	/// Contiguous blocks of the elements created by buildFromArrays()
+	HVertex*            m_vertexBlock;
+	size_t              m_vertexBlockSize;
+	HEdge*              m_edgeBlock;
+	HFace*              m_faceBlock;
+
 };
 
 } // namespace lvr
@@ -39,6 +39,12 @@ HalfEdgeMesh<VertexT, NormalT>::HalfEdgeMesh( )
     m_regionClassifier = ClassifierFactory<VertexT, NormalT>::get("Default", this);
     m_classifierType = "Default";
     m_depth = 100;
+    m_quadricsValid = false;
+    m_quadricsUseArea = false;
+    m_vertexBlock = 0;
+    m_vertexBlockSize = 0;
+    m_edgeBlock = 0;
+    m_faceBlock = 0;
 }
 
 template<typename VertexT, typename NormalT>
@@ -50,26 +56,48 @@ HalfEdgeMesh<VertexT, NormalT>::HalfEdgeMesh(
     m_classifierType = "Default";
     m_pointCloudManager = pm;
     m_depth = 100;
+    m_quadricsValid = false;
+    m_quadricsUseArea = false;
+    m_vertexBlock = 0;
+    m_vertexBlockSize = 0;
+    m_edgeBlock = 0;
+    m_faceBlock = 0;
 }
 
 template<typename VertexT, typename NormalT>
 HalfEdgeMesh<VertexT, NormalT>::HalfEdgeMesh(
         MeshBufferPtr mesh)
 {
+    m_quadricsValid = false;
+    m_quadricsUseArea = false;
+    m_vertexBlock = 0;
+    m_vertexBlockSize = 0;
+    m_edgeBlock = 0;
+    m_faceBlock = 0;
+
     size_t num_verts, num_faces;
     floatArr vertices = mesh->getVertexArray(num_verts);
+    uintArr faces = mesh->getFaceArray(num_faces);
 
-    // Add all vertices
-    for(size_t i = 0; i < num_verts; i++)
+    // Every face edge may get a border edge as pair, so there are up
+    // to 6 half edges per face
+    if(6 * num_faces < (size_t)std::numeric_limits<uint32_t>::max())
     {
-        addVertex(VertexT(vertices[3 * i], vertices[3 * i + 1], vertices[3 * i + 2]));
+        buildFromArrays(vertices, num_verts, faces, num_faces);
     }
-
-    // Add all faces
-    uintArr faces = mesh->getFaceArray(num_faces);
-    for(size_t i = 0; i < num_faces; i++)
+    else
     {
-        addTriangle(faces[3 * i], faces[3 * i + 1], faces[3 * i + 2]);
+        // Edge indices do not fit into 32 bits, build the
+        // topology incrementally
+        for(size_t i = 0; i < num_verts; i++)
+        {
+            addVertex(VertexT(vertices[3 * i], vertices[3 * i + 1], vertices[3 * i + 2]));
+        }
+
+        for(size_t i = 0; i < num_faces; i++)
+        {
+            addTriangle(faces[3 * i], faces[3 * i + 1], faces[3 * i + 2]);
+        }
     }
 
     // Initial remaining stuff
@@ -105,9 +133,15 @@ HalfEdgeMesh<VertexT, NormalT>::~HalfEdgeMesh()
 
     for (int i = 0 ; i < m_vertices.size() ; i++)
     {
-        delete m_vertices[i];
+        // Vertices of the bulk block are freed below
+        if(m_vertices[i] < m_vertexBlock || m_vertices[i] >= m_vertexBlock + m_vertexBlockSize)
+        {
+            delete m_vertices[i];
+        }
     }
     this->m_vertices.clear();
+    delete[] m_vertexBlock;
+    delete[] m_edgeBlock;
 
     typename set<Region<VertexT, NormalT>*>::iterator r_it;
     for(r_it = m_garbageRegions.begin(); r_it != m_garbageRegions.end(); r_it++)
@@ -124,6 +158,7 @@ HalfEdgeMesh<VertexT, NormalT>::~HalfEdgeMesh()
         delete f;
     }
     m_garbageFaces.clear();
+    delete[] m_faceBlock;
 
 }
 
@@ -336,6 +371,11 @@ void HalfEdgeMesh<VertexT, NormalT>::addTriangle(uint a, uint b, uint c, FacePtr
     face->m_indices[1] = b;
     face->m_indices[2] = c;
     f = face;
+
+    if(m_quadricsValid)
+    {
+        updateQuadrics(face, true);
+    }
 }
 
 
@@ -407,6 +447,11 @@ void HalfEdgeMesh<VertexT, NormalT>::deleteFace(FacePtr f, bool erase)
     //f->m_invalid = true;
     //m_regions[f->m_region]->deleteInvalidFaces();
 
+    if(m_quadricsValid)
+    {
+        updateQuadrics(f, false);
+    }
+
     //save references to edges and vertices
     HEdge* startEdge = (*f)[0];
     HEdge* nextEdge  = (*f)[1];
@@ -574,8 +619,12 @@ void HalfEdgeMesh<VertexT, NormalT>::collapseEdge(EdgePtr edge)
     // Don't collapse zero edges (need to fix them!!!)
     if(p1 == p2) return;
 
-    // Move p1 to the center between p1 and p2 (recycle p1)
-    p1->m_position = (p1->m_position + p2->m_position) * 0.5;
+    // Move p1 to the center between p1 and p2 (recycle p1). The
+    // position is updated after the adjacent faces were removed.
+    VertexT center = (p1->m_position + p2->m_position) * 0.5;
+
+    // The quadric of the new vertex is the sum of both quadrics
+    Quadric quadric = p1->m_quadric + p2->m_quadric;
 
     // Reorganize the pointer structure between the edges.
     // If a face will be deleted after the edge is collapsed the pair pointers
@@ -669,6 +718,12 @@ void HalfEdgeMesh<VertexT, NormalT>::collapseEdge(EdgePtr edge)
         it++;
     }
 
+    p1->m_position = center;
+    if(m_quadricsValid)
+    {
+        p1->m_quadric = quadric;
+    }
+
     //Delete p2
     //deleteVertex(p2);
 }
@@ -724,6 +779,13 @@ void HalfEdgeMesh<VertexT, NormalT>::flipEdge(EdgePtr edge)
     // This can only be done if there are two faces on both sides of the edge
     if (edge->pair()->face() != 0 && edge->face() != 0)
     {
+        // The vertices of both faces change
+        if(m_quadricsValid)
+        {
+            updateQuadrics(edge->face(), false);
+            updateQuadrics(edge->pair()->face(), false);
+        }
+
         //The old egde will be deleted while a new edge is created
 
         //save the start and end vertex of the new edge
@@ -796,6 +858,12 @@ void HalfEdgeMesh<VertexT, NormalT>::flipEdge(EdgePtr edge)
         newEdge->face()->calc_normal();
         newpair->face()->calc_normal();
 
+        if(m_quadricsValid)
+        {
+            updateQuadrics(newEdge->face(), true);
+            updateQuadrics(newpair->face(), true);
+        }
+
         //delete the old edge
         deleteEdge(edge);
     }
@@ -921,6 +989,7 @@ void HalfEdgeMesh<VertexT, NormalT>::optimizePlanes(
         }
 
         // Find all regions by regionGrowing with normal criteria
+        vector<RegionPtr> planeRegions;
         for(size_t i = 0; i < m_faces.size(); i++)
         {
             if(m_faces[i]->m_used == false)
@@ -934,7 +1003,7 @@ void HalfEdgeMesh<VertexT, NormalT>::optimizePlanes(
                 // Fit big regions into the regression plane
                 if(region_size > max(min_region_size, default_region_threshold))
                 {
-                    region->regressionPlane();
+                    planeRegions.push_back(region);
                 }
 
                 if(j == iterations - 1)
@@ -952,6 +1021,8 @@ void HalfEdgeMesh<VertexT, NormalT>::optimizePlanes(
                 }
             }
         }
+
+        fitRegionPlanes(planeRegions);
     }
 
     // Delete too small regions
@@ -983,6 +1054,26 @@ void HalfEdgeMesh<VertexT, NormalT>::optimizePlanes(
 
 }
 
+template<typename VertexT, typename NormalT>
+void HalfEdgeMesh<VertexT, NormalT>::deleteFaces(const vector<FacePtr>& faces)
+{
+    boost::unordered_set<FacePtr> deleted(faces.begin(), faces.end());
+    for(size_t i = 0; i < faces.size(); i++)
+    {
+        deleteFace(faces[i], false);
+    }
+
+    size_t n = 0;
+    for(size_t i = 0; i < m_faces.size(); i++)
+    {
+        if(!deleted.count(m_faces[i]))
+        {
+            m_faces[n++] = m_faces[i];
+        }
+    }
+    m_faces.resize(n);
+}
+
 template<typename VertexT, typename NormalT>
 void HalfEdgeMesh<VertexT, NormalT>::deleteRegions()
 {
@@ -1023,38 +1114,62 @@ void HalfEdgeMesh<VertexT, NormalT>::deleteRegions()
 template<typename VertexT, typename NormalT>
 void HalfEdgeMesh<VertexT, NormalT>::removeDanglingArtifacts(int threshold)
 {
-	cout << timestamp << "Clustering for RDA detection..." << endl;
-	int c = 0;
-	int region_number = 0;
-    for(size_t i = 0; i < m_faces.size(); i++)
+    cout << timestamp << "Clustering for RDA detection..." << endl;
+
+    if(threshold <= 0 || m_faces.empty())
     {
-        if(m_faces[i]->m_used == false)
+        return;
+    }
+
+    // Export positions and indices to label the components
+    // with a parallel union-find
+    size_t numVertices = m_vertices.size();
+    size_t numFaces = m_faces.size();
+    vector<float> vertices(3 * numVertices);
+    vector<unsigned int> faces(3 * numFaces);
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numVertices; i++)
+    {
+        m_vertices[i]->m_actIndex = i;
+        for(int j = 0; j < 3; j++)
         {
-            RegionPtr region = new Region<VertexT, NormalT>(region_number);
-            m_garbageRegions.insert(region);
-            NormalT n = m_faces[i]->getFaceNormal();
-            float angle = -1;
-            int region_size = stackSafeRegionGrowing(m_faces[i], n, angle, region) + 1;
-            if(region_size <= threshold)
-            {
-                region->m_toDelete = true;
-                c++;
-            }
-            m_regions.push_back(region);
-            region_number++;
+            vertices[3 * i + j] = m_vertices[i]->m_position[j];
+        }
+    }
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numFaces; i++)
+    {
+        for(int k = 0; k < 3; k++)
+        {
+            faces[3 * i + k] = (*m_faces[i])(k)->m_actIndex;
         }
     }
 
+    MeshComponents components(&vertices[0], numVertices, &faces[0], numFaces);
+    components.printStatistics();
+
+    vector<unsigned char> marked;
+    size_t numMarked = components.markSmallComponents(threshold, marked);
+
     //delete dangling artifacts
-    cout << timestamp << "Removing dangling artifacts" << endl;
-    deleteRegions();
+    cout << timestamp << "Removing " << numMarked << " faces of dangling artifacts" << endl;
+    if(numMarked == 0)
+    {
+        return;
+    }
 
-    //reset all used variables
-    for(size_t i = 0; i < m_faces.size(); i++)
+    for(size_t i = 0; i < numFaces; i++)
     {
-        m_faces[i]->m_used = false;
+        if(marked[i])
+        {
+            deleteFace(m_faces[i], false);
+            m_faces[i] = 0;
+        }
     }
-    m_regions.clear();
+
+    m_faces.erase(std::remove(m_faces.begin(), m_faces.end(), (FacePtr)0), m_faces.end());
 }
 
 template<typename VertexT, typename NormalT>
@@ -1378,6 +1493,7 @@ void HalfEdgeMesh<VertexT, NormalT>::dragOntoIntersection(RegionPtr plane, Regio
                     {
                         (*(plane->m_faces[i]))[k]->start()->m_position = x + direction * (((((*(plane->m_faces[i]))[k]->start()->m_position) - x) * direction) / (direction.length() * direction.length()));
                         (*(plane->m_faces[i]))[k]->end()->m_position   = x + direction * (((((*(plane->m_faces[i]))[k]->end()->m_position  ) - x) * direction) / (direction.length() * direction.length()));
+                        m_quadricsValid = false;
                     }
                 }
             }
@@ -1452,6 +1568,7 @@ void HalfEdgeMesh<VertexT, NormalT>::restorePlanes(int min_region_size)
                         if(v != 0)
                         {
                             (*(m_regions[r]->m_faces[i]))(p)->m_position = (*(m_regions[r]->m_faces[i]))(p)->m_position + (VertexT)m_regions[r]->m_normal * v;
+                            m_quadricsValid = false;
                         }
                     }
                     catch (HalfEdgeAccessException &e)
@@ -1478,6 +1595,7 @@ void HalfEdgeMesh<VertexT, NormalT>::restorePlanes(int min_region_size)
     }
 
     // Find all regions by regionGrowing with normal criteria
+    vector<RegionPtr> planeRegions;
     for(size_t i = 0; i < m_faces.size(); i++)
     {
         if(m_faces[i]->m_used == false)
@@ -1491,7 +1609,7 @@ void HalfEdgeMesh<VertexT, NormalT>::restorePlanes(int min_region_size)
 
             if(region_size > max(min_region_size, default_region_threshold))
             {
-                region->regressionPlane();
+                planeRegions.push_back(region);
             }
 
             // Save pointer to the region
@@ -1499,6 +1617,33 @@ void HalfEdgeMesh<VertexT, NormalT>::restorePlanes(int min_region_size)
             region_number++;
         }
     }
+
+    fitRegionPlanes(planeRegions);
+}
+
+template<typename VertexT, typename NormalT>
+void HalfEdgeMesh<VertexT, NormalT>::fitRegionPlanes(vector<RegionPtr>& regions)
+{
+    vector<VertexT> points(regions.size());
+    vector<NormalT> normals(regions.size());
+    vector<char>    valid(regions.size(), 0);
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for(long i = 0; i < (long)regions.size(); i++)
+    {
+        valid[i] = regions[i]->fitPlane(points[i], normals[i]);
+    }
+
+    // Regions share vertices at their borders, so the
+    // vertices are moved sequentially
+    for(size_t i = 0; i < regions.size(); i++)
+    {
+        if(valid[i])
+        {
+            regions[i]->projectToPlane(points[i], normals[i]);
+            m_quadricsValid = false;
+        }
+    }
 }
 
 
@@ -1534,23 +1679,42 @@ void HalfEdgeMesh<VertexT, NormalT>::finalize()
         vertexBuffer[3 * i + 1] = (*vertices_iter)->m_position[1];
         vertexBuffer[3 * i + 2] = (*vertices_iter)->m_position[2];
 
-        normalBuffer [3 * i] =     -(*vertices_iter)->m_normal[0];
-        normalBuffer [3 * i + 1] = -(*vertices_iter)->m_normal[1];
-        normalBuffer [3 * i + 2] = -(*vertices_iter)->m_normal[2];
-
         // Map the vertices to a position in the buffer.
         // This is necessary since the old indices might have been compromised.
         index_map[*vertices_iter] = i;
     }
 
+    // Classify the plane regions in one parallel pass, like
+    // finalizeAndRetesselate() does. Labels and colors of the other
+    // regions are still computed on demand below.
+    vector<int> regionNumbers;
+    for(size_t i = 0; i < m_regions.size(); i++)
+    {
+        if(m_regions[i]->m_inPlane && m_regions[i]->m_regionNumber >= 0)
+        {
+            regionNumbers.push_back(m_regions[i]->m_regionNumber);
+        }
+    }
+    m_regionClassifier->classifyRegions(regionNumbers);
+
+    // Reuse the areas of the classified regions
     string msg = timestamp.getElapsedTime() + "Calculating region sizes";
-       ProgressBar progress(m_regions.size(), msg);
-       for(size_t i = 0; i < m_regions.size(); i++)
-       {
-           m_regions[i]->calcArea();
-           ++progress;
-       }
-       cout << endl;
+    ProgressBar progress(m_regions.size(), msg);
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for(long i = 0; i < (long)m_regions.size(); i++)
+    {
+        if(m_regionClassifier->hasStatistics(i))
+        {
+            m_regions[i]->setArea(m_regionClassifier->getStatistics(i).area);
+        }
+        else
+        {
+            m_regions[i]->calcArea();
+        }
+        ++progress;
+    }
+    cout << endl;
 
 
     typename vector<FacePtr>::iterator face_iter = m_faces.begin();
@@ -1607,6 +1771,21 @@ void HalfEdgeMesh<VertexT, NormalT>::finalize()
         faceColorBuffer.push_back( b );*/
     }
 
+    // Calculate area weighted vertex normals from the final index
+    // buffer. Vertices that already carry a normal keep it. Stored
+    // normals follow the face winding like getFaceNormal(), so they
+    // are exported as they are (see finalizeAndRetesselate()).
+    calcVertexNormals(vertexBuffer.get(), numVertices, indexBuffer.get(), numFaces, normalBuffer.get());
+    for(size_t i = 0; i < numVertices; i++)
+    {
+        if(m_vertices[i]->m_normal.length() > 0.0001)
+        {
+            normalBuffer [3 * i] =     m_vertices[i]->m_normal[0];
+            normalBuffer [3 * i + 1] = m_vertices[i]->m_normal[1];
+            normalBuffer [3 * i + 2] = m_vertices[i]->m_normal[2];
+        }
+    }
+
     // Label regions with Classifier
     LabelRegions();
 
@@ -1718,6 +1897,12 @@ void HalfEdgeMesh<VertexT, NormalT>::resetUsedFlags()
 template<typename VertexT, typename NormalT>
 void HalfEdgeMesh<VertexT, NormalT>::writeClassificationResult()
 {
+	// Classifiers use the vertex indices to export regions
+	for(size_t i = 0; i < m_vertices.size(); i++)
+	{
+		m_vertices[i]->m_actIndex = i;
+	}
+
 	m_regionClassifier->writeMetaInfo();
 }
 
@@ -1763,6 +1948,14 @@ void HalfEdgeMesh<VertexT, NormalT>::finalizeAndRetesselate( bool genTextures, f
         }
     }
 
+    // Classify all plane regions in one parallel pass
+    vector<int> planeRegionNumbers;
+    for(size_t i = 0; i < planeRegions.size(); i++)
+    {
+        planeRegionNumbers.push_back(m_regions[planeRegions[i]]->m_regionNumber);
+    }
+    m_regionClassifier->classifyRegions(planeRegionNumbers);
+
     // keep track of used vertices to avoid doubles.
     map<Vertex<float>, unsigned int> vertexMap;
     Vertex<float> current;
@@ -1901,7 +2094,6 @@ void HalfEdgeMesh<VertexT, NormalT>::finalizeAndRetesselate( bool genTextures, f
             g = m_regionClassifier->g(surface_class);
             b = m_regionClassifier->b(surface_class);
 
-            m_regionClassifier->classifyRegion(surface_class);
             //textureBuffer.push_back( m_regions[iRegion]->m_regionNumber );
 
             // get the contours for this region
@@ -2074,6 +2266,12 @@ void HalfEdgeMesh<VertexT, NormalT>::reduceMeshByCollapse(int n_collapses, Verte
     string msg = timestamp.getElapsedTime() + "Collapsing edges...";
     ProgressBar progress(n_collapses, msg);
 
+    // The quadric based costs use the quadrics stored in the vertices
+    if(!m_quadricsValid)
+    {
+        calcQuadrics();
+    }
+
     // Try not to collapse more vertices than are in the mesh
     if(n_collapses >= (int)m_vertices.size())
     {
@@ -2146,13 +2344,773 @@ void HalfEdgeMesh<VertexT, NormalT>::reduceMeshByCollapse(int n_collapses, Verte
 
 }
 
+template<typename VertexT, typename NormalT>
+void HalfEdgeMesh<VertexT, NormalT>::radixSort(vector<uint64_t> &keys, vector<uint32_t> &values)
+{
+    const size_t n = keys.size();
+    const int bits = 16;
+    const size_t numBins = 1 << bits;
+
+    // Every thread sorts a fixed chunk, so the sort is stable
+    int numChunks = OpenMPConfig::getNumThreads();
+    vector<size_t> bounds(numChunks + 1);
+    for(int c = 0; c <= numChunks; c++)
+    {
+        bounds[c] = c * n / numChunks;
+    }
+
+    vector<uint64_t> tmpKeys(n);
+    vector<uint32_t> tmpValues(n);
+    vector<size_t> offsets(numChunks * numBins);
+
+    for(int shift = 0; shift < 64; shift += bits)
+    {
+        std::fill(offsets.begin(), offsets.end(), 0);
+
+        // Count the digits of each chunk
+        #pragma omp parallel for schedule(static)
+        for(long c = 0; c < numChunks; c++)
+        {
+            size_t* hist = &offsets[c * numBins];
+            for(size_t i = bounds[c]; i < bounds[c + 1]; i++)
+            {
+                hist[(keys[i] >> shift) & (numBins - 1)]++;
+            }
+        }
+
+        // Convert counts to output positions. Skip passes that would not
+        // change the order because all keys have the same digit.
+        size_t sum = 0;
+        bool constant = false;
+        for(size_t d = 0; d < numBins; d++)
+        {
+            size_t binSize = 0;
+            for(int c = 0; c < numChunks; c++)
+            {
+                size_t count = offsets[c * numBins + d];
+                offsets[c * numBins + d] = sum;
+                sum += count;
+                binSize += count;
+            }
+            if(binSize == n)
+            {
+                constant = true;
+            }
+        }
+        if(constant)
+        {
+            continue;
+        }
+
+        #pragma omp parallel for schedule(static)
+        for(long c = 0; c < numChunks; c++)
+        {
+            size_t* pos = &offsets[c * numBins];
+            for(size_t i = bounds[c]; i < bounds[c + 1]; i++)
+            {
+                size_t p = pos[(keys[i] >> shift) & (numBins - 1)]++;
+                tmpKeys[p] = keys[i];
+                tmpValues[p] = values[i];
+            }
+        }
+
+        keys.swap(tmpKeys);
+        values.swap(tmpValues);
+    }
+}
+
+template<typename VertexT, typename NormalT>
+void HalfEdgeMesh<VertexT, NormalT>::buildFromArrays(floatArr vertices, size_t numVertices, uintArr faces, size_t numFaces)
+{
+    const uint32_t NONE = std::numeric_limits<uint32_t>::max();
+    const size_t numFaceEdges = 3 * numFaces;
+
+    // Create all vertices
+    m_vertexBlock = new HVertex[numVertices];
+    m_vertexBlockSize = numVertices;
+    m_vertices.resize(numVertices);
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numVertices; i++)
+    {
+        HVertex* v = &m_vertexBlock[i];
+        v->m_position = VertexT(vertices[3 * i], vertices[3 * i + 1], vertices[3 * i + 2]);
+        v->m_actIndex = i;
+        m_vertices[i] = v;
+    }
+    m_globalIndex = numVertices;
+
+    // The k-th edge of face f leads from corner k to corner k + 1.
+    // Twin edges share the key of their undirected edge.
+    vector<uint64_t> keys(numFaceEdges);
+    vector<uint32_t> edges(numFaceEdges);
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numFaceEdges; i++)
+    {
+        uint64_t a = faces[i];
+        uint64_t b = faces[i % 3 == 2 ? i - 2 : i + 1];
+        keys[i] = a < b ? (a << 32) | b : (b << 32) | a;
+        edges[i] = (uint32_t)i;
+    }
+
+    radixSort(keys, edges);
+
+    // Pair the twins in each group of equal keys. Edges in the same
+    // direction or groups with more than two edges are non-manifold,
+    // unmatched edges get a new border edge as pair.
+    vector<uint32_t> pairs(numFaceEdges, NONE);
+    size_t numNonManifold = 0;
+
+    #pragma omp parallel for schedule(dynamic, 4096) reduction(+:numNonManifold)
+    for(long i = 0; i < (long)numFaceEdges; i++)
+    {
+        if(i > 0 && keys[i] == keys[i - 1])
+        {
+            continue;
+        }
+
+        size_t end = i + 1;
+        while(end < numFaceEdges && keys[end] == keys[i])
+        {
+            end++;
+        }
+
+        if(end - i == 1)
+        {
+            continue;
+        }
+
+        bool manifold = (end - i == 2);
+        for(size_t a = i; a < end; a++)
+        {
+            uint32_t ea = edges[a];
+            if(pairs[ea] != NONE)
+            {
+                continue;
+            }
+
+            for(size_t b = a + 1; b < end; b++)
+            {
+                uint32_t eb = edges[b];
+                if(pairs[eb] == NONE && faces[ea] != faces[eb])
+                {
+                    pairs[ea] = eb;
+                    pairs[eb] = ea;
+                    break;
+                }
+            }
+
+            if(pairs[ea] == NONE)
+            {
+                manifold = false;
+            }
+        }
+
+        if(!manifold)
+        {
+            numNonManifold++;
+        }
+    }
+
+    vector<uint64_t>().swap(keys);
+
+    // Assign border edges behind the face edges
+    size_t numEdges = numFaceEdges;
+    for(size_t i = 0; i < numFaceEdges; i++)
+    {
+        if(pairs[i] == NONE)
+        {
+            pairs[i] = (uint32_t)numEdges++;
+        }
+    }
+
+    if(numNonManifold > 0)
+    {
+        cout << timestamp << "Found " << numNonManifold << " non-manifold edges." << endl;
+    }
+
+    // Create and link all edges and faces
+    m_edgeBlock = new HEdge[numEdges];
+    m_faceBlock = new HFace[numFaces];
+    m_faces.resize(numFaces);
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numFaceEdges; i++)
+    {
+        size_t f = i / 3;
+        HEdge* e = &m_edgeBlock[i];
+        HVertex* start = m_vertices[faces[i]];
+        HVertex* end   = m_vertices[faces[i % 3 == 2 ? i - 2 : i + 1]];
+
+        e->setStart(start);
+        e->setEnd(end);
+        e->setFace(&m_faceBlock[f]);
+        e->setNext(&m_edgeBlock[3 * f + (i + 1) % 3]);
+        e->setPair(&m_edgeBlock[pairs[i]]);
+
+        if(pairs[i] >= numFaceEdges)
+        {
+            HEdge* p = &m_edgeBlock[pairs[i]];
+            p->setStart(end);
+            p->setEnd(start);
+            p->setFace(0);
+            p->setPair(e);
+        }
+    }
+
+    // Collect the incoming and outgoing edges of the vertices
+    vector<size_t> outOffsets(numVertices + 1, 0);
+    vector<size_t> inOffsets(numVertices + 1, 0);
+    for(size_t i = 0; i < numEdges; i++)
+    {
+        HEdge* e = &m_edgeBlock[i];
+        outOffsets[e->start()->m_actIndex + 1]++;
+        inOffsets[e->end()->m_actIndex + 1]++;
+    }
+    for(size_t i = 0; i < numVertices; i++)
+    {
+        outOffsets[i + 1] += outOffsets[i];
+        inOffsets[i + 1] += inOffsets[i];
+    }
+
+    vector<EdgePtr> outEdges(numEdges);
+    vector<EdgePtr> inEdges(numEdges);
+    {
+        vector<size_t> outPos(outOffsets.begin(), outOffsets.end() - 1);
+        vector<size_t> inPos(inOffsets.begin(), inOffsets.end() - 1);
+        for(size_t i = 0; i < numEdges; i++)
+        {
+            HEdge* e = &m_edgeBlock[i];
+            outEdges[outPos[e->start()->m_actIndex]++] = e;
+            inEdges[inPos[e->end()->m_actIndex]++] = e;
+        }
+    }
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numVertices; i++)
+    {
+        m_vertices[i]->out.assign(outEdges.begin() + outOffsets[i], outEdges.begin() + outOffsets[i + 1]);
+        m_vertices[i]->in.assign(inEdges.begin() + inOffsets[i], inEdges.begin() + inOffsets[i + 1]);
+    }
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numFaces; i++)
+    {
+        HFace* face = &m_faceBlock[i];
+        face->m_edge = &m_edgeBlock[3 * i];
+        face->calc_normal();
+        face->m_face_index = i + 1;
+        face->m_indices[0] = faces[3 * i];
+        face->m_indices[1] = faces[3 * i + 1];
+        face->m_indices[2] = faces[3 * i + 2];
+        m_faces[i] = face;
+    }
+}
+
 template<typename VertexT, typename NormalT>
 void HalfEdgeMesh<VertexT, NormalT>::getCostMap(std::map<VertexPtr, float> &costs, VertexCosts<VertexT, NormalT> &c)
 {
+	if(!m_quadricsValid)
+	{
+		calcQuadrics();
+	}
+
 	for(size_t i = 0; i < m_vertices.size(); i++)
 	{
-		costs[i] = c(*m_vertices[i]);
+		costs[m_vertices[i]] = c(*m_vertices[i]);
+	}
+}
+
+template<typename VertexT, typename NormalT>
+void HalfEdgeMesh<VertexT, NormalT>::calcQuadrics(bool useTriangleArea)
+{
+	#pragma omp parallel for schedule(dynamic, 256)
+	for(long i = 0; i < (long)m_faces.size(); i++)
+	{
+		m_faces[i]->m_quadric = m_faces[i]->getQuadric(useTriangleArea);
 	}
+
+	// Sum up the stored face quadrics, so that they can be subtracted
+	// exactly when a face is removed later
+	#pragma omp parallel for schedule(dynamic, 256)
+	for(long i = 0; i < (long)m_vertices.size(); i++)
+	{
+		list<FacePtr> adj_faces;
+		m_vertices[i]->getAdjacentFaces(adj_faces);
+
+		Quadric& q = m_vertices[i]->m_quadric;
+		q.clear();
+		typename list<FacePtr>::iterator it;
+		for(it = adj_faces.begin(); it != adj_faces.end(); it++)
+		{
+			q += (*it)->m_quadric;
+		}
+	}
+
+	m_quadricsValid = true;
+	m_quadricsUseArea = useTriangleArea;
+}
+
+template<typename VertexT, typename NormalT>
+void HalfEdgeMesh<VertexT, NormalT>::updateQuadrics(FacePtr f, bool add)
+{
+	// Vertices move after their faces were added (edge collapses,
+	// plane fitting), so the plane that was added is stored with the
+	// face and subtracted again instead of the face's current plane.
+	if(add)
+	{
+		f->m_quadric = f->getQuadric(m_quadricsUseArea);
+	}
+
+	for(int i = 0; i < 3; i++)
+	{
+		if(add)
+		{
+			(*f)(i)->m_quadric += f->m_quadric;
+		}
+		else
+		{
+			(*f)(i)->m_quadric -= f->m_quadric;
+		}
+	}
+}
+
+template<typename VertexT, typename NormalT>
+bool HalfEdgeMesh<VertexT, NormalT>::saveCheckpoint(string filename, string stage)
+{
+    const uint32_t NONE = CHECKPOINT_NONE;
+    const size_t numVertices = m_vertices.size();
+    const size_t numFaces = m_faces.size();
+
+    // Edges are numbered in the order of the out lists
+    vector<size_t> outOffsets(numVertices + 1, 0);
+    vector<size_t> inOffsets(numVertices + 1, 0);
+    for(size_t i = 0; i < numVertices; i++)
+    {
+        m_vertices[i]->m_actIndex = i;
+        outOffsets[i + 1] = outOffsets[i] + m_vertices[i]->out.size();
+        inOffsets[i + 1] = inOffsets[i] + m_vertices[i]->in.size();
+    }
+    const size_t numEdges = outOffsets[numVertices];
+
+    if(numVertices >= NONE || numEdges >= NONE || numFaces >= NONE)
+    {
+        cout << timestamp << "Mesh is too large for a checkpoint." << endl;
+        return false;
+    }
+
+    cout << timestamp << "Writing checkpoint '" << filename << "'." << endl;
+
+    boost::unordered_map<EdgePtr, uint32_t> edgeIndex(numEdges);
+    for(size_t i = 0; i < numVertices; i++)
+    {
+        for(size_t j = 0; j < m_vertices[i]->out.size(); j++)
+        {
+            edgeIndex[m_vertices[i]->out[j]] = outOffsets[i] + j;
+        }
+    }
+
+    boost::unordered_map<FacePtr, uint32_t> faceIndex(numFaces);
+    for(size_t i = 0; i < numFaces; i++)
+    {
+        faceIndex[m_faces[i]] = i;
+    }
+
+    MeshCheckpoint c;
+    c.numVertices = numVertices;
+    c.numEdges = numEdges;
+    c.numInEdges = inOffsets[numVertices];
+    c.numFaces = numFaces;
+    c.vertices = boost::shared_array<CheckpointVertex>(new CheckpointVertex[numVertices]);
+    c.edges = boost::shared_array<CheckpointEdge>(new CheckpointEdge[numEdges]);
+    c.inEdges = uintArr(new unsigned int[c.numInEdges]);
+    c.faces = boost::shared_array<CheckpointFace>(new CheckpointFace[numFaces]);
+    c.flags = (m_quadricsValid ? MeshCheckpointIO::QuadricsValid : 0)
+            | (m_quadricsUseArea ? MeshCheckpointIO::QuadricsUseArea : 0);
+    c.stage = stage;
+
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for(long i = 0; i < (long)numVertices; i++)
+    {
+        HVertex* v = m_vertices[i];
+        CheckpointVertex& cv = c.vertices[i];
+        cv.position[0] = v->m_position.x;
+        cv.position[1] = v->m_position.y;
+        cv.position[2] = v->m_position.z;
+        cv.normal[0] = v->m_normal.x;
+        cv.normal[1] = v->m_normal.y;
+        cv.normal[2] = v->m_normal.z;
+        cv.numOut = v->out.size();
+        cv.numIn = v->in.size();
+        cv.flags = (v->m_merged ? MeshCheckpointIO::VertexMerged : 0)
+                 | (v->m_fused ? MeshCheckpointIO::VertexFused : 0)
+                 | (v->m_oldFused ? MeshCheckpointIO::VertexOldFused : 0)
+                 | (v->m_fusedNeighbor ? MeshCheckpointIO::VertexFusedNeighbor : 0);
+        VertexTraits<VertexT>::getColor(v->m_position, cv.color[0], cv.color[1], cv.color[2]);
+        cv.color[3] = 0;
+
+        for(size_t j = 0; j < v->in.size(); j++)
+        {
+            typename boost::unordered_map<EdgePtr, uint32_t>::const_iterator it = edgeIndex.find(v->in[j]);
+            c.inEdges[inOffsets[i] + j] = it != edgeIndex.end() ? it->second : NONE;
+        }
+
+        for(size_t j = 0; j < v->out.size(); j++)
+        {
+            EdgePtr e = v->out[j];
+            CheckpointEdge& ce = c.edges[outOffsets[i] + j];
+            ce.start = e->start()->m_actIndex;
+            ce.end = e->end()->m_actIndex;
+            ce.next = NONE;
+            ce.pair = NONE;
+            ce.face = NONE;
+            ce.flags = e->used ? 1 : 0;
+
+            // References to deleted elements are dropped
+            if(ce.start >= numVertices || m_vertices[ce.start] != e->start())
+            {
+                ce.start = NONE;
+            }
+            if(ce.end >= numVertices || m_vertices[ce.end] != e->end())
+            {
+                ce.end = NONE;
+            }
+
+            typename boost::unordered_map<EdgePtr, uint32_t>::const_iterator it;
+            if(e->hasNext() && (it = edgeIndex.find(e->next())) != edgeIndex.end())
+            {
+                ce.next = it->second;
+            }
+            if(e->hasPair() && (it = edgeIndex.find(e->pair())) != edgeIndex.end())
+            {
+                ce.pair = it->second;
+            }
+
+            typename boost::unordered_map<FacePtr, uint32_t>::const_iterator fit;
+            if(e->hasFace() && (fit = faceIndex.find(e->face())) != faceIndex.end())
+            {
+                ce.face = fit->second;
+            }
+        }
+    }
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numFaces; i++)
+    {
+        FacePtr f = m_faces[i];
+        CheckpointFace& cf = c.faces[i];
+        typename boost::unordered_map<EdgePtr, uint32_t>::const_iterator it = edgeIndex.find(f->m_edge);
+        cf.edge = it != edgeIndex.end() ? it->second : NONE;
+        cf.textureIndex = f->m_texture_index;
+        cf.region = f->m_region;
+        cf.normal[0] = f->m_normal.x;
+        cf.normal[1] = f->m_normal.y;
+        cf.normal[2] = f->m_normal.z;
+        cf.flags = (f->m_used ? MeshCheckpointIO::FaceUsed : 0)
+                 | (f->m_region_used ? MeshCheckpointIO::FaceRegionUsed : 0)
+                 | (f->m_invalid ? MeshCheckpointIO::FaceInvalid : 0)
+                 | (f->m_fusion_face ? MeshCheckpointIO::FaceFusion : 0);
+    }
+
+    // Regions, their faces and labels
+    vector<CheckpointRegion> regions;
+    vector<unsigned int> regionFaces;
+    string labels;
+    for(size_t i = 0; i < m_regions.size(); i++)
+    {
+        RegionPtr r = m_regions[i];
+        if(!r)
+        {
+            continue;
+        }
+
+        CheckpointRegion cr;
+        cr.regionNumber = r->m_regionNumber;
+        cr.flags = (r->m_inPlane ? MeshCheckpointIO::RegionInPlane : 0)
+                 | (r->m_unfinished ? MeshCheckpointIO::RegionUnfinished : 0)
+                 | (r->m_toDelete ? MeshCheckpointIO::RegionToDelete : 0)
+                 | (r->hasLabel() ? MeshCheckpointIO::RegionLabeled : 0);
+        cr.normal[0] = r->m_normal.x;
+        cr.normal[1] = r->m_normal.y;
+        cr.normal[2] = r->m_normal.z;
+        cr.stuetzvektor[0] = r->m_stuetzvektor.x;
+        cr.stuetzvektor[1] = r->m_stuetzvektor.y;
+        cr.stuetzvektor[2] = r->m_stuetzvektor.z;
+
+        // Regions may still reference deleted faces
+        cr.firstFace = regionFaces.size();
+        for(size_t j = 0; j < r->m_faces.size(); j++)
+        {
+            typename boost::unordered_map<FacePtr, uint32_t>::const_iterator it = faceIndex.find(r->m_faces[j]);
+            if(it != faceIndex.end())
+            {
+                regionFaces.push_back(it->second);
+            }
+        }
+        cr.numFaces = regionFaces.size() - cr.firstFace;
+
+        string label = r->hasLabel() ? r->getLabel() : string();
+        cr.labelOffset = labels.size();
+        cr.labelLength = label.size();
+        labels += label;
+
+        regions.push_back(cr);
+    }
+
+    c.numRegions = regions.size();
+    c.regions = boost::shared_array<CheckpointRegion>(new CheckpointRegion[regions.size()]);
+    std::copy(regions.begin(), regions.end(), c.regions.get());
+
+    c.numRegionFaces = regionFaces.size();
+    c.regionFaces = uintArr(new unsigned int[regionFaces.size()]);
+    std::copy(regionFaces.begin(), regionFaces.end(), c.regionFaces.get());
+
+    c.numLabelBytes = labels.size();
+    c.labels = boost::shared_array<char>(new char[labels.size()]);
+    std::copy(labels.begin(), labels.end(), c.labels.get());
+
+    return MeshCheckpointIO::write(filename, c);
+}
+
+template<typename VertexT, typename NormalT>
+bool HalfEdgeMesh<VertexT, NormalT>::loadCheckpoint(string filename, string* stage)
+{
+    const uint32_t NONE = CHECKPOINT_NONE;
+
+    if(!m_vertices.empty() || !m_faces.empty())
+    {
+        cout << timestamp << "Checkpoints can only be loaded into an empty mesh." << endl;
+        return false;
+    }
+
+    MeshCheckpoint c;
+    if(!MeshCheckpointIO::read(filename, c))
+    {
+        return false;
+    }
+
+    cout << timestamp << "Loading checkpoint '" << filename << "'";
+    if(c.stage.size())
+    {
+        cout << " written after '" << c.stage << "'";
+    }
+    cout << "." << endl;
+
+    const size_t numVertices = c.numVertices;
+    const size_t numEdges = c.numEdges;
+    const size_t numFaces = c.numFaces;
+
+    // Check all references before anything is linked
+    vector<size_t> outOffsets(numVertices + 1, 0);
+    vector<size_t> inOffsets(numVertices + 1, 0);
+    for(size_t i = 0; i < numVertices; i++)
+    {
+        outOffsets[i + 1] = outOffsets[i] + c.vertices[i].numOut;
+        inOffsets[i + 1] = inOffsets[i] + c.vertices[i].numIn;
+    }
+
+    size_t numErrors = 0;
+    if(outOffsets[numVertices] != numEdges || inOffsets[numVertices] != c.numInEdges)
+    {
+        numErrors++;
+    }
+
+    #pragma omp parallel for schedule(static) reduction(+:numErrors)
+    for(long i = 0; i < (long)numEdges; i++)
+    {
+        const CheckpointEdge& ce = c.edges[i];
+        if((ce.start != NONE && ce.start >= numVertices)
+           || (ce.end != NONE && ce.end >= numVertices)
+           || (ce.next != NONE && ce.next >= numEdges)
+           || (ce.pair != NONE && ce.pair >= numEdges)
+           || (ce.face != NONE && ce.face >= numFaces))
+        {
+            numErrors++;
+        }
+    }
+
+    for(size_t i = 0; i < c.numInEdges; i++)
+    {
+        if(c.inEdges[i] != NONE && c.inEdges[i] >= numEdges)
+        {
+            numErrors++;
+        }
+    }
+
+    for(size_t i = 0; i < numFaces; i++)
+    {
+        if(c.faces[i].edge != NONE && c.faces[i].edge >= numEdges)
+        {
+            numErrors++;
+        }
+    }
+
+    for(size_t i = 0; i < c.numRegionFaces; i++)
+    {
+        if(c.regionFaces[i] >= numFaces)
+        {
+            numErrors++;
+        }
+    }
+
+    for(size_t i = 0; i < c.numRegions; i++)
+    {
+        const CheckpointRegion& cr = c.regions[i];
+        if(cr.firstFace > c.numRegionFaces || cr.numFaces > c.numRegionFaces - cr.firstFace
+           || cr.labelOffset > c.numLabelBytes || cr.labelLength > c.numLabelBytes - cr.labelOffset)
+        {
+            numErrors++;
+        }
+    }
+
+    if(numErrors)
+    {
+        cout << timestamp << "Checkpoint '" << filename << "' is damaged." << endl;
+        return false;
+    }
+
+    // The (empty) blocks of a previous bulk build are replaced
+    delete[] m_vertexBlock;
+    delete[] m_edgeBlock;
+    delete[] m_faceBlock;
+
+    m_vertexBlock = new HVertex[numVertices];
+    m_vertexBlockSize = numVertices;
+    m_edgeBlock = new HEdge[numEdges];
+    m_faceBlock = new HFace[numFaces];
+    m_vertices.resize(numVertices);
+    m_faces.resize(numFaces);
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numVertices; i++)
+    {
+        const CheckpointVertex& cv = c.vertices[i];
+        HVertex* v = &m_vertexBlock[i];
+        v->m_position = VertexT(cv.position[0], cv.position[1], cv.position[2]);
+        VertexTraits<VertexT>::setColor(v->m_position, cv.color[0], cv.color[1], cv.color[2]);
+        v->m_normal.x = cv.normal[0];
+        v->m_normal.y = cv.normal[1];
+        v->m_normal.z = cv.normal[2];
+        v->m_merged = cv.flags & MeshCheckpointIO::VertexMerged;
+        v->m_fused = cv.flags & MeshCheckpointIO::VertexFused;
+        v->m_oldFused = cv.flags & MeshCheckpointIO::VertexOldFused;
+        v->m_fusedNeighbor = cv.flags & MeshCheckpointIO::VertexFusedNeighbor;
+        v->m_actIndex = i;
+        m_vertices[i] = v;
+
+        v->out.resize(cv.numOut);
+        for(size_t j = 0; j < cv.numOut; j++)
+        {
+            v->out[j] = &m_edgeBlock[outOffsets[i] + j];
+        }
+
+        v->in.reserve(cv.numIn);
+        for(size_t j = 0; j < cv.numIn; j++)
+        {
+            uint32_t e = c.inEdges[inOffsets[i] + j];
+            if(e != NONE)
+            {
+                v->in.push_back(&m_edgeBlock[e]);
+            }
+        }
+    }
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numEdges; i++)
+    {
+        const CheckpointEdge& ce = c.edges[i];
+        HEdge* e = &m_edgeBlock[i];
+        e->setStart(ce.start != NONE ? &m_vertexBlock[ce.start] : 0);
+        e->setEnd(ce.end != NONE ? &m_vertexBlock[ce.end] : 0);
+        e->setNext(ce.next != NONE ? &m_edgeBlock[ce.next] : 0);
+        e->setPair(ce.pair != NONE ? &m_edgeBlock[ce.pair] : 0);
+        e->setFace(ce.face != NONE ? &m_faceBlock[ce.face] : 0);
+        e->used = ce.flags & 1;
+    }
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numFaces; i++)
+    {
+        const CheckpointFace& cf = c.faces[i];
+        HFace* f = &m_faceBlock[i];
+        f->m_edge = cf.edge != NONE ? &m_edgeBlock[cf.edge] : 0;
+        f->m_texture_index = cf.textureIndex;
+        f->m_region = cf.region;
+        f->m_normal.x = cf.normal[0];
+        f->m_normal.y = cf.normal[1];
+        f->m_normal.z = cf.normal[2];
+        f->m_used = cf.flags & MeshCheckpointIO::FaceUsed;
+        f->m_region_used = cf.flags & MeshCheckpointIO::FaceRegionUsed;
+        f->m_invalid = cf.flags & MeshCheckpointIO::FaceInvalid;
+        f->m_fusion_face = cf.flags & MeshCheckpointIO::FaceFusion;
+        f->m_face_index = i + 1;
+
+        // The k-th edge of a face starts at its k-th corner
+        uint32_t e = cf.edge;
+        for(int k = 0; k < 3; k++)
+        {
+            f->m_indices[k] = 0;
+            if(e != NONE)
+            {
+                if(c.edges[e].start != NONE)
+                {
+                    f->m_indices[k] = c.edges[e].start;
+                }
+                e = c.edges[e].next;
+            }
+        }
+        m_faces[i] = f;
+    }
+
+    m_regions.clear();
+    for(size_t i = 0; i < c.numRegions; i++)
+    {
+        const CheckpointRegion& cr = c.regions[i];
+        RegionPtr r = new Region<VertexT, NormalT>(cr.regionNumber);
+        m_garbageRegions.insert(r);
+
+        r->m_inPlane = cr.flags & MeshCheckpointIO::RegionInPlane;
+        r->m_unfinished = cr.flags & MeshCheckpointIO::RegionUnfinished;
+        r->m_toDelete = cr.flags & MeshCheckpointIO::RegionToDelete;
+        r->m_normal.x = cr.normal[0];
+        r->m_normal.y = cr.normal[1];
+        r->m_normal.z = cr.normal[2];
+        r->m_stuetzvektor = VertexT(cr.stuetzvektor[0], cr.stuetzvektor[1], cr.stuetzvektor[2]);
+
+        // The faces keep their stored region numbers
+        r->m_faces.resize(cr.numFaces);
+        for(size_t j = 0; j < cr.numFaces; j++)
+        {
+            r->m_faces[j] = m_faces[c.regionFaces[cr.firstFace + j]];
+        }
+        r->calcArea();
+
+        if(cr.flags & MeshCheckpointIO::RegionLabeled)
+        {
+            r->setLabel(string(c.labels.get() + cr.labelOffset, cr.labelLength));
+        }
+
+        m_regions.push_back(r);
+    }
+
+    m_globalIndex = numVertices;
+
+    m_quadricsValid = false;
+    if(c.flags & MeshCheckpointIO::QuadricsValid)
+    {
+        calcQuadrics(c.flags & MeshCheckpointIO::QuadricsUseArea);
+    }
+
+    if(stage)
+    {
+        *stage = c.stage;
+    }
+
+    cout << timestamp << "Loaded " << numVertices << " vertices, " << numFaces << " faces and "
+         << m_regions.size() << " regions." << endl;
+
+    return true;
 }
 
 } // namespace lvr
@@ -34,6 +34,7 @@
 using namespace std;
 
 #include "Matrix4.hpp"
+#include "Quadric.hpp"
 #include "Vertex.hpp"
 #include "Normal.hpp"
 #include "HalfEdge.hpp"
@@ -90,6 +91,11 @@ public:
 
 	void calcQuadric(Matrix4<float>& q, bool use_tri);
 
+	/**
+	 * @brief	Calculates the sum of the error quadrics of the adjacent faces
+	 */
+	void calcQuadric(Quadric& q, bool use_tri);
+
 	/// The vertex's position
 	VertexT 			m_position;
 
@@ -104,6 +110,10 @@ public:
 	bool				m_fusedNeighbor;
 	size_t              m_actIndex;
 
+	/// The error quadric of the vertex. Only valid if the mesh
+	/// maintains quadrics, see HalfEdgeMesh::calcQuadrics()
+	Quadric             m_quadric;
+
 	/// The list incoming edges
 	vector<HEdge*> in;
 
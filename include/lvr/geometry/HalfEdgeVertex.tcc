@@ -29,54 +29,25 @@ namespace lvr
 
 template<typename VertexT, typename NormalT>
 void HalfEdgeVertex<VertexT, NormalT>::calcQuadric(Matrix4<float> &q, bool use_tri)
+{
+	Quadric quadric;
+	calcQuadric(quadric, use_tri);
+	quadric.toMatrix(q);
+}
+
+template<typename VertexT, typename NormalT>
+void HalfEdgeVertex<VertexT, NormalT>::calcQuadric(Quadric &q, bool use_tri)
 {
 	// Get adjacent faces
 	list<FacePtr> adj_faces;
 	getAdjacentFaces(adj_faces);
 
-	// Init quadric data
-	float* data = q.getData();
-	for(int i = 0; i < 16; i++) data[i] = 0;
-
-	// Calculate quadric entries
+	// Sum up the quadrics of the face planes
+	q.clear();
 	typename list<FacePtr>::iterator it;
 	for(it = adj_faces.begin(); it != adj_faces.end(); it++)
 	{
-		FacePtr f = *it;
-
-		float triangle_area = 1;
-		if(use_tri)
-		{
-			triangle_area = f->getArea();
-		}
-
-		NormalT n = f->getFaceNormal();
-
-		float a = n[0];
-		float b = n[1];
-		float c = n[2];
-		float d = f->getD();
-
-		data[0] += triangle_area * a * a;
-		data[1] += triangle_area * a * b;
-		data[2] += triangle_area * a * c;
-		data[3] += triangle_area * a * d;
-
-		data[4] += triangle_area * b * a;
-		data[5] += triangle_area * b * b;
-		data[6] += triangle_area * b * c;
-		data[7] += triangle_area * b * d;
-
-		data[8] += triangle_area * c * a;
-		data[9] += triangle_area * c * b;
-		data[10] += triangle_area * c * c;
-		data[11] += triangle_area * c * d;
-
-		data[12] += triangle_area * d * a;
-		data[13] += triangle_area * d * b;
-		data[14] += triangle_area * d * c;
-		data[15] += triangle_area * d * d;
-
+		q += (*it)->getQuadric(use_tri);
 	}
 }
 
@@ -96,14 +67,15 @@ void HalfEdgeVertex<VertexT, NormalT>::getAdjacentFaces(list<FacePtr> &adj )
 		EdgePtr e = *it;
 		if(e)
 		{
-			if(e->face())
+			// The accessors throw for border edges
+			if(e->hasFace())
 			{
 				adj_faces.insert(e->face());
 			}
 
-			if(e->pair())
+			if(e->hasPair())
 			{
-				if(e->pair()->face())
+				if(e->pair()->hasFace())
 				{
 					adj_faces.insert(e->pair()->face());
 				}
@@ -0,0 +1,137 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * MeshComponents.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef MESHCOMPONENTS_HPP_
+#define MESHCOMPONENTS_HPP_
+
+#include <lvr/io/MeshBuffer.hpp>
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+namespace lvr
+{
+
+/**
+ * @brief   Statistics of a connected component of a triangle mesh
+ */
+struct MeshComponent
+{
+    /// Number of faces in the component
+    size_t  numFaces;
+
+    /// Surface area of the component
+    float   area;
+
+    /// Axis aligned bounding box of the component
+    float   bbMin[3];
+    float   bbMax[3];
+};
+
+/**
+ * @brief   Labels the connected components of an indexed triangle mesh.
+ *
+ *          Two faces belong to the same component if they share an edge.
+ *          The components are computed with a ConcurrentUnionFind over
+ *          the edges of the index buffer: The edges are bucketed by their
+ *          smaller vertex index (CSR layout) and the faces of all edges with
+ *          the same end points are united in parallel. Sets are always
+ *          linked to the root with the smaller face index, so the labels do
+ *          not depend on the number of threads. Components are numbered in
+ *          the order of their first face.
+ *
+ *          The labels can be used on plain mesh buffers before a half edge
+ *          mesh is built (see \ref removeSmallComponents) as well as for
+ *          bulk deletions in HalfEdgeMesh.
+ */
+class MeshComponents
+{
+public:
+
+    /**
+     * @brief   Computes the components of the given mesh.
+     *
+     * @param   vertices    Interlaced vertex array (x, y, z)
+     * @param   numVertices Number of vertices in \ref vertices
+     * @param   faces       Index buffer with three indices per face
+     * @param   numFaces    Number of faces in \ref faces
+     */
+    MeshComponents(
+            const float* vertices,
+            size_t numVertices,
+            const unsigned int* faces,
+            size_t numFaces);
+
+    /// Returns the number of connected components
+    size_t numComponents() const { return m_components.size(); }
+
+    /// Returns the statistics of all components
+    const std::vector<MeshComponent>& components() const { return m_components; }
+
+    /// Returns the component index of every face
+    const std::vector<uint32_t>& faceComponents() const { return m_faceComponents; }
+
+    /**
+     * @brief   Returns a histogram of the component sizes. Bucket k counts
+     *          the components with 2^k to 2^(k+1) - 1 faces.
+     */
+    std::vector<size_t> sizeHistogram() const;
+
+    /// Prints the number of components and the size histogram
+    void printStatistics() const;
+
+    /**
+     * @brief   Marks all faces that belong to a component with at most
+     *          threshold faces.
+     *
+     * @return  The number of marked faces
+     */
+    size_t markSmallComponents(size_t threshold, std::vector<unsigned char>& marked) const;
+
+    /**
+     * @brief   Removes all components with at most threshold faces from
+     *          the given mesh buffer. Vertices that are no longer referenced
+     *          are removed, too. Per vertex attributes (normals, colors,
+     *          confidences, intensities and texture coordinates) and face
+     *          material indices are kept for the remaining elements.
+     *
+     * @return  A new mesh buffer or the given one if nothing was removed
+     */
+    static MeshBufferPtr removeSmallComponents(MeshBufferPtr mesh, size_t threshold);
+
+private:
+
+    /// Statistics per component
+    std::vector<MeshComponent>  m_components;
+
+    /// Component index per face
+    std::vector<uint32_t>       m_faceComponents;
+};
+
+} // namespace lvr
+
+#endif /* MESHCOMPONENTS_HPP_ */
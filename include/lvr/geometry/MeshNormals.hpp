@@ -0,0 +1,78 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * MeshNormals.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef MESHNORMALS_HPP_
+#define MESHNORMALS_HPP_
+
+#include <lvr/io/MeshBuffer.hpp>
+
+#include <cstddef>
+
+namespace lvr
+{
+
+/**
+ * @brief   Calculates area weighted vertex normals for an indexed triangle
+ *          mesh.
+ *
+ *          The normal of each vertex is the normalized sum of the normals
+ *          of all adjacent faces, weighted by the face area. Face normals
+ *          follow the usual counter-clockwise convention, i.e., for a face
+ *          (a, b, c) the normal is (b - a) x (c - a).
+ *
+ *          The computation is done in three parallel passes: face normals,
+ *          a vertex to face incidence list (CSR layout) and a gather pass
+ *          that sums up the incident face normals per vertex. No vertex is
+ *          written by more than one thread.
+ *
+ * @param   vertices    Interlaced vertex array (x, y, z)
+ * @param   numVertices Number of vertices in \ref vertices
+ * @param   faces       Index buffer with three indices per face
+ * @param   numFaces    Number of faces in \ref faces
+ * @param   normals     Output array. Has to provide space for 3 * numVertices
+ *                      floats. Vertices that do not belong to a face or that
+ *                      only belong to degenerated faces get a zero normal.
+ */
+void calcVertexNormals(
+        const float* vertices,
+        size_t numVertices,
+        const unsigned int* faces,
+        size_t numFaces,
+        float* normals);
+
+/**
+ * @brief   Calculates area weighted vertex normals for the given mesh buffer
+ *          and stores them as its vertex normal array.
+ *
+ * @param   mesh        A mesh buffer with vertex and face information
+ * @return  The new vertex normal array. An empty array is returned if the
+ *          buffer does not contain a triangle mesh.
+ */
+floatArr calcVertexNormals(MeshBufferPtr mesh);
+
+} // namespace lvr
+
+#endif /* MESHNORMALS_HPP_ */
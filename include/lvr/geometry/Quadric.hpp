@@ -0,0 +1,122 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+/*
+ * Quadric.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef QUADRIC_HPP_
+#define QUADRIC_HPP_
+
+#include "Matrix4.hpp"
+
+namespace lvr
+{
+
+/**
+ * @brief   A symmetric 4x4 error quadric as used by Garland and Heckbert's
+ *          mesh simplification. Only the ten distinct entries are stored:
+ *
+ *          | m[0] m[1] m[2] m[3] |
+ *          | m[1] m[4] m[5] m[6] |
+ *          | m[2] m[5] m[7] m[8] |
+ *          | m[3] m[6] m[8] m[9] |
+ */
+class Quadric
+{
+public:
+
+    /// Creates a zero quadric
+    Quadric()
+    {
+        clear();
+    }
+
+    /**
+     * @brief   Creates the quadric of the plane ax + by + cz + d = 0
+     *          weighted by w.
+     */
+    Quadric(float a, float b, float c, float d, float w = 1.0f)
+    {
+        m[0] = w * a * a; m[1] = w * a * b; m[2] = w * a * c; m[3] = w * a * d;
+        m[4] = w * b * b; m[5] = w * b * c; m[6] = w * b * d;
+        m[7] = w * c * c; m[8] = w * c * d;
+        m[9] = w * d * d;
+    }
+
+    /// Sets all entries to zero
+    void clear()
+    {
+        for(int i = 0; i < 10; i++) m[i] = 0.0f;
+    }
+
+    Quadric& operator+=(const Quadric& o)
+    {
+        for(int i = 0; i < 10; i++) m[i] += o.m[i];
+        return *this;
+    }
+
+    Quadric& operator-=(const Quadric& o)
+    {
+        for(int i = 0; i < 10; i++) m[i] -= o.m[i];
+        return *this;
+    }
+
+    Quadric operator+(const Quadric& o) const
+    {
+        Quadric q(*this);
+        q += o;
+        return q;
+    }
+
+    /// Returns the error v^T Q v of the homogeneous point (x, y, z, 1)
+    float evaluate(float x, float y, float z) const
+    {
+        return        x * x * m[0] + 2 * x * y * m[1] + 2 * x * z * m[2] + 2 * x * m[3]
+                    + y * y * m[4] + 2 * y * z * m[5] + 2 * y * m[6]
+                    + z * z * m[7] + 2 * z * m[8]
+                    + m[9];
+    }
+
+    /// Returns the error of the given point
+    template<typename VertexT>
+    float evaluate(const VertexT& v) const
+    {
+        return evaluate(v[0], v[1], v[2]);
+    }
+
+    /// Copies the quadric into a full 4x4 matrix
+    void toMatrix(Matrix4<float>& q) const
+    {
+        float* data = q.getData();
+        data[0]  = m[0]; data[1]  = m[1]; data[2]  = m[2]; data[3]  = m[3];
+        data[4]  = m[1]; data[5]  = m[4]; data[6]  = m[5]; data[7]  = m[6];
+        data[8]  = m[2]; data[9]  = m[5]; data[10] = m[7]; data[11] = m[8];
+        data[12] = m[3]; data[13] = m[6]; data[14] = m[8]; data[15] = m[9];
+    }
+
+    /// The distinct entries of the matrix
+    float m[10];
+};
+
+} /* namespace lvr */
+
+#endif /* QUADRIC_HPP_ */
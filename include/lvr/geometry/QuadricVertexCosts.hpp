@@ -57,13 +57,14 @@ public:
 	/**
 	 * @brief 	Implementation of Garland and Heckberts cost function. If the object
 	 * 			was created with the useTriangleArea flag, the weighted costs function
-	 * 			will be used.
+	 * 			will be used. The quadrics stored in the vertices are used, so
+	 * 			they have to be calculated with HalfEdgeMesh::calcQuadrics() before.
 	 */
 	virtual float operator()(HalfEdgeVertex<VertexT, NormalT> &v);
 
 private:
 
-	float calcQuadricError(Matrix4<float> &quadric, HVertex* v, float area);
+	float calcQuadricError(const Quadric &quadric, HVertex* v, float area);
 
 	bool m_useTri;
 
@@ -33,9 +33,6 @@ float QuadricVertexCosts<VertexT, NormalT>::operator()(HalfEdgeVertex<VertexT, N
 	float mincost = std::numeric_limits<float>::max();
 	bool hasNeighbors = false;
 
-	Matrix4<float> q1;
-	v.calcQuadric(q1, false);
-
 	// Iterator over all neighbour vertices
 	typename vector<HEdge* >::iterator it;
 	for (it = v.out.begin(); it != v.out.end(); it++)
@@ -43,18 +40,8 @@ float QuadricVertexCosts<VertexT, NormalT>::operator()(HalfEdgeVertex<VertexT, N
 
 		HVertex* n = (*it)->end();
 
-		Matrix4<float> q2;
-
-		// Add two 4x4 Q matrices
-		n->calcQuadric(q2, false);
-
-		Matrix4<float> qsum = q1 + q2;
-
-		/*double triArea = 0;
-			if (QUADRICTRI == _cost)
-			{
-				triArea = v.getQuadricSummedTriArea() + n.getQuadricSummedTriArea();
-			}*/
+		// Add the two quadrics
+		Quadric qsum = v.m_quadric + n->m_quadric;
 
 		float triArea = 0;
 		// calc cost
@@ -78,26 +65,11 @@ float QuadricVertexCosts<VertexT, NormalT>::operator()(HalfEdgeVertex<VertexT, N
 }
 
 template<typename VertexT, typename NormalT>
-float QuadricVertexCosts<VertexT, NormalT>::calcQuadricError(Matrix4<float> &quadric, HVertex* v, float area)
+float QuadricVertexCosts<VertexT, NormalT>::calcQuadricError(const Quadric &quadric, HVertex* v, float area)
 {
-	float cost;
-
-	// 1st, consider vertex v a 1x4 matrix: [v.x v.y v.z 1]
-	// Multiply it by the Qsum 4x4 matrix, resulting in a 1x4 matrix
-
-	float result[4];
-
-	VertexT v3 = v->m_position;
-
-	result[0] = v3.x * quadric[0 ] + v3.y * quadric[1 ] + v3.z * quadric[2 ] + 1 * quadric[3 ];
-	result[1] = v3.x * quadric[4 ] + v3.y * quadric[5 ] + v3.z * quadric[6 ] + 1 * quadric[7 ];
-	result[2] = v3.x * quadric[8 ] + v3.y * quadric[9 ] + v3.z * quadric[10] + 1 * quadric[11];
-	result[3] = v3.x * quadric[12] + v3.y * quadric[13] + v3.z * quadric[14] + 1 * quadric[15];
-
-	// Multiply this 1 x 4 matrix by the vertex v transpose (a 4 x 1 matrix).
-	// This is just the dot product.
-
-	cost =	result[0] * v3.x + result[1] * v3.y + result[2] * v3.z + result[3] * 1;
+	// Consider vertex v a 1x4 matrix [v.x v.y v.z 1] and
+	// calculate v * Q * v^T
+	float cost = quadric.evaluate(v->m_position);
 
 	if (m_useTri && area != 0)
 	{
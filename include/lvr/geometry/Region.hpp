@@ -121,6 +121,26 @@ public:
 	 */
 	virtual void regressionPlane();
 
+	/**
+	 * @brief Fits a plane to the face centroids of the region. The plane is
+	 *        initialized by an area weighted PCA and refined by iteratively
+	 *        reweighted least squares with Tukey's biweight, so outlier faces
+	 *        do not tilt the plane. The mesh is only read and the result does
+	 *        not depend on random numbers, so several regions can be fitted
+	 *        in parallel.
+	 *
+	 * @param	point	Returns a point on the plane
+	 * @param	normal	Returns the normal of the plane
+	 *
+	 * @return	false if the region is too small or degenerated
+	 */
+	bool fitPlane(VertexT& point, NormalT& normal) const;
+
+	/**
+	 * @brief Drags all vertices of the region into the given plane
+	 */
+	void projectToPlane(const VertexT& point, const NormalT& normal);
+
 	/**
 	 * @brief tells if the given face is flickering
 	 *
@@ -162,6 +182,9 @@ public:
 
 	void calcArea();
 
+	/// Sets an area that was computed elsewhere, e.g. by a classifier
+	void setArea(float area) { m_area = area; }
+
 	BoundingBox<VertexT> getBoundingBox();
 private:
 
@@ -26,10 +26,14 @@
  *  @author Thomas Wiemann (twiemann@uos.de)
  */
  
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <vector>
 #include <psimpl.h>
 
+#include <Eigen/Dense>
+
 namespace lvr
 {
 
@@ -60,6 +64,7 @@ float Region<VertexT, NormalT>::getArea()
 template<typename VertexT, typename NormalT>
 void Region<VertexT, NormalT>::calcArea()
 {
+    m_area = 0;
     for(size_t i = 0; i < m_faces.size(); i++)
     {
         m_area += m_faces[i]->getArea();
@@ -412,8 +417,6 @@ size_t Region<VertexT, NormalT>::size()
 template<typename VertexT, typename NormalT>
 void Region<VertexT, NormalT>::regressionPlane()
 {
-//    srand(time(NULL));
-
     // Quick and dirty fox to avoid hanging when
     // degenrated faces are in buffer
     if(m_faces.size() < 3)
@@ -422,76 +425,160 @@ void Region<VertexT, NormalT>::regressionPlane()
         return;
     }
 
-    VertexT point1;
-    VertexT point2;
-    VertexT point3;
+    VertexT point;
+    NormalT normal;
+    if(fitPlane(point, normal))
+    {
+        projectToPlane(point, normal);
+    }
+}
+
+template<typename VertexT, typename NormalT>
+bool Region<VertexT, NormalT>::fitPlane(VertexT& point, NormalT& normal) const
+{
+    const size_t n = m_faces.size();
+    if(n < 3)
+    {
+        return false;
+    }
+
+    // Centroids and areas of the faces. All sums are computed in
+    // double precision and in face order to get reproducible results.
+    std::vector<Eigen::Vector3d> centroids(n);
+    std::vector<double> areas(n);
+    Eigen::Vector3d normalSum = Eigen::Vector3d::Zero();
+    double totalArea = 0.0;
+    for(size_t i = 0; i < n; i++)
+    {
+        Eigen::Vector3d v[3];
+        for(int j = 0; j < 3; j++)
+        {
+            VertexT p = (*m_faces[i])(j)->m_position;
+            v[j] = Eigen::Vector3d(p[0], p[1], p[2]);
+        }
 
-    //representation of best regression plane by point and normal
-    VertexT bestpoint;
-    NormalT bestNorm;
+        Eigen::Vector3d cross = (v[1] - v[0]).cross(v[2] - v[0]);
+        centroids[i] = (v[0] + v[1] + v[2]) / 3.0;
+        areas[i] = 0.5 * cross.norm();
+        normalSum += cross;
+        totalArea += areas[i];
+    }
 
-    float bestdist = std::numeric_limits<float>::max();
-    float dist     = 0;
+    if(totalArea <= 0.0)
+    {
+        return false;
+    }
 
-    int iterations              = 0;
-    int nonimproving_iterations = 0;
+    // Weighted PCA, the normal is the direction of least variance
+    std::vector<double> weights(areas);
+    Eigen::Vector3d mean;
+    Eigen::Vector3d planeNormal;
 
-    while((nonimproving_iterations < 30) && (iterations < 200))
+    const int maxIterations = 5;
+    for(int it = 0; it <= maxIterations; it++)
     {
-    	NormalT n0;
-        //randomly choose 3 disjoint points
-        do{
-            point1 = (*m_faces[rand() % m_faces.size()])(0)->m_position;
-            point2 = (*m_faces[rand() % m_faces.size()])(1)->m_position;
-            point3 = (*m_faces[rand() % m_faces.size()])(2)->m_position;
-
-            //compute normal of the plane given by the 3 points
-            n0 = (point1 - point2).cross(point1 - point3);
-            n0.normalize();
-
-        }while(point1 == point2 || point2 == point3 || point3 == point1 || n0.length() == 0);
-
-        //compute error to at most 50 other randomly chosen points
-        dist = 0;
-        for(int i = 0; i < min(50, (int)m_faces.size()); i++)
+        double weightSum = 0.0;
+        mean = Eigen::Vector3d::Zero();
+        for(size_t i = 0; i < n; i++)
         {
-            VertexT refpoint = (*m_faces[rand() % m_faces.size()])(0)->m_position;
-            dist += fabs(refpoint * n0 - point1 * n0) / min(50, (int)m_faces.size());
+            mean += weights[i] * centroids[i];
+            weightSum += weights[i];
         }
 
-        //a new optimum is found
-        if(dist < bestdist)
+        if(weightSum <= 0.0)
         {
-            bestdist = dist;
+            break;
+        }
+        mean /= weightSum;
 
-            bestpoint = point1;
-            bestNorm = n0;
+        Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+        for(size_t i = 0; i < n; i++)
+        {
+            Eigen::Vector3d d = centroids[i] - mean;
+            covariance += weights[i] * d * d.transpose();
+        }
 
-            nonimproving_iterations = 0;
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(covariance);
+        Eigen::Vector3d eigenvalues = solver.eigenvalues();
+
+        Eigen::Vector3d estimate;
+        if(eigenvalues[1] <= 1e-12 * eigenvalues[2])
+        {
+            // Centroids are collinear (e.g., a strip of triangles),
+            // so the plane is defined by the face normals
+            if(normalSum.norm() == 0.0)
+            {
+                return false;
+            }
+            estimate = normalSum.normalized();
         }
         else
         {
-            nonimproving_iterations++;
+            estimate = solver.eigenvectors().col(0);
+        }
+
+        // Keep the orientation of the faces
+        if(estimate.dot(normalSum) < 0.0)
+        {
+            estimate = -estimate;
+        }
+
+        bool converged = it > 0 && estimate.dot(planeNormal) > 1.0 - 1e-12;
+        planeNormal = estimate;
+        if(converged || it == maxIterations)
+        {
+            break;
+        }
+
+        // Robust scale of the residuals (median absolute deviation)
+        std::vector<double> residuals(n);
+        for(size_t i = 0; i < n; i++)
+        {
+            residuals[i] = fabs(planeNormal.dot(centroids[i] - mean));
         }
 
-        iterations++;
+        std::vector<double> sorted(residuals);
+        std::nth_element(sorted.begin(), sorted.begin() + n / 2, sorted.end());
+        double sigma = 1.4826 * sorted[n / 2];
+
+        // All centroids are (almost) in the plane
+        if(sigma <= 1e-12 * sqrt(totalArea))
+        {
+            break;
+        }
+
+        // Tukey's biweight
+        double c = 4.685 * sigma;
+        for(size_t i = 0; i < n; i++)
+        {
+            double u = residuals[i] / c;
+            weights[i] = u < 1.0 ? areas[i] * (1.0 - u * u) * (1.0 - u * u) : 0.0;
+        }
     }
 
+    point  = VertexT(mean[0], mean[1], mean[2]);
+    normal = NormalT(planeNormal[0], planeNormal[1], planeNormal[2]);
+    return true;
+}
+
+template<typename VertexT, typename NormalT>
+void Region<VertexT, NormalT>::projectToPlane(const VertexT& point, const NormalT& normal)
+{
     //drag points into the regression plane
     for(size_t i = 0; i < m_faces.size(); i++)
     {
         for(int p = 0; p < 3; p++)
         {
-            float v = ((bestpoint - (*m_faces[i])(p)->m_position) * bestNorm) / (bestNorm * bestNorm);
+            float v = ((point - (*m_faces[i])(p)->m_position) * normal) / (normal * normal);
             if(v != 0)
             {
-                (*m_faces[i])(p)->m_position = (*m_faces[i])(p)->m_position + (VertexT)bestNorm * v;
+                (*m_faces[i])(p)->m_position = (*m_faces[i])(p)->m_position + (VertexT)normal * v;
             }
         }
     }
     this->m_inPlane = true;
     this->m_normal = calcNormal();
-    this->m_stuetzvektor = point1;
+    this->m_stuetzvektor = point;
 }
 
 template<typename VertexT, typename NormalT>
@@ -38,6 +38,12 @@ struct VertexTraits
 
 	/// Wrapper function to set colors. Does nothing if colors are not supported.
 	static void setColor(VertexT& v, unsigned char r, unsigned char g, unsigned char b) {}
+
+	/// Wrapper function to get colors. Returns black if colors are not supported.
+	static void getColor(const VertexT& v, unsigned char& r, unsigned char& g, unsigned char& b)
+	{
+		r = g = b = 0;
+	}
 };
 
 template<>
@@ -52,6 +58,14 @@ struct VertexTraits<ColorVertex<float, unsigned char> >
 		v.g = g;
 		v.b = b;
 	}
+
+	/// Wrapper function to get the rgb fields of an vertex that supports colors
+	static void getColor(const ColorVertex<float, unsigned char> & v, unsigned char& r, unsigned char& g, unsigned char& b)
+	{
+		r = v.r;
+		g = v.g;
+		b = v.b;
+	}
 };
 
 }
@@ -0,0 +1,208 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * BoctreeScans.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef BOCTREESCANS_HPP_
+#define BOCTREESCANS_HPP_
+
+#include <lvr/io/PointBuffer.hpp>
+#include <lvr/geometry/Matrix4.hpp>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Forward declarations of the slam6d octree types
+template <typename T> class BOctTree;
+class bitoct;
+template <class T> union bitunion;
+
+namespace lvr
+{
+
+/**
+ * @brief   A set of registered scans that are stored as slam6d octrees.
+ *
+ *          The octrees are kept in the deserialized form and the points are
+ *          read in place from their leaves. Every scan has a pose that maps
+ *          the octree coordinates to world coordinates. The points of all
+ *          scans are enumerated in scan order and in depth first order of
+ *          the octree leaves. This is the order of \ref flatten, so search
+ *          results can be used as indices into the flattened point buffer.
+ *
+ *          Nearest neighbor queries are transformed into the local frame of
+ *          each scan and answered by a best bin first traversal of the
+ *          octree. The poses have to be rigid transformations, so distances
+ *          are the same in both frames. All queries are const and can be
+ *          called from multiple threads.
+ */
+class BoctreeScans
+{
+public:
+
+    /**
+     * @brief   Constructor.
+     *
+     * @param   maxRange    Points with a larger distance to the origin (in
+     *                      world coordinates) are ignored
+     */
+    BoctreeScans(float maxRange = 10000.0f);
+
+    ~BoctreeScans();
+
+    /**
+     * @brief   Deserializes the octree in the given file and adds it with
+     *          the given pose.
+     *
+     * @return  False if the file is not a valid octree file
+     */
+    bool addScan(const std::string& filename, const Matrix4<float>& pose);
+
+    /// Returns the number of scans
+    size_t numScans() const { return m_scans.size(); }
+
+    /// Returns the number of points of all scans (without ignored points)
+    size_t numPoints() const { return m_numPoints; }
+
+    /**
+     * @brief   Writes the transformed points of all scans into the given
+     *          buffer. Colors and reflectances are copied if present, every
+     *          scan is defined as a sub cloud. The leaves are processed in
+     *          parallel.
+     */
+    void flatten(PointBuffer& buffer) const;
+
+    /**
+     * @brief   Searches the k nearest neighbors of the given point.
+     *
+     * @param   qp          Query point in world coordinates
+     * @param   k           Number of neighbors
+     * @param   indices     The indices of the neighbors are appended in
+     *                      order of increasing distance
+     * @param   distances   The squared distances of the neighbors
+     */
+    void kSearch(const float* qp, size_t k, std::vector<int>& indices, std::vector<float>& distances) const;
+
+    /**
+     * @brief   Appends the indices of all points within distance r of the
+     *          query point in order of increasing distance.
+     */
+    void radiusSearch(const float* qp, float r, std::vector<int>& indices) const;
+
+private:
+
+    /// A scan and its pose
+    struct Scan
+    {
+        BOctTree<float>*    tree;
+
+        /// Pose and inverse pose (column major)
+        float               pose[16];
+        float               inverse[16];
+
+        /// Dimension of the points in the tree and attribute positions (or -1)
+        unsigned int        dim;
+        int                 reflectance;
+        int                 color;
+
+        /// Index of the first point in the flattened order
+        size_t              offset;
+        size_t              numPoints;
+    };
+
+    /// A leaf of an octree
+    struct Leaf
+    {
+        const float*        points;
+        unsigned int        length;
+        size_t              scan;
+
+        /// Index of the first point in the flattened order and in m_removed
+        size_t              offset;
+        size_t              rawOffset;
+    };
+
+    /// A found neighbor (squared distance, index)
+    typedef std::pair<float, size_t> Neighbor;
+
+    /// Appends the leaves below the given node in depth first order
+    void collectLeaves(const bitoct& node, size_t scan, size_t& rawOffset);
+
+    /// Searches all scans. k = 0 returns all points within maxDist2.
+    void search(const float* qp, size_t k, float maxDist2, std::vector<Neighbor>& heap) const;
+
+    /// Traverses the children of the given node in order of their distance
+    void searchNode(const Scan& scan, const bitoct& node, const float* center, float size,
+                    const float* q, size_t k, float maxDist2, std::vector<Neighbor>& heap) const;
+
+    /// Tests all points of a leaf
+    void searchLeaf(const Scan& scan, const bitunion<float>* leaf,
+                    const float* q, size_t k, float maxDist2, std::vector<Neighbor>& heap) const;
+
+    /// Points with a larger distance to the origin are ignored
+    float                   m_maxRange;
+
+    /// Number of used points of all scans
+    size_t                  m_numPoints;
+
+    std::vector<Scan>       m_scans;
+    std::vector<Leaf>       m_leaves;
+
+    /// Maps the point array of a leaf to its index in m_leaves
+    boost::unordered_map<const float*, size_t> m_leafIndex;
+
+    /// Flags of ignored points in leaf order. Empty if no point was ignored.
+    std::vector<unsigned char> m_removed;
+};
+
+typedef boost::shared_ptr<BoctreeScans> BoctreeScansPtr;
+
+/**
+ * @brief   A point buffer that contains the flattened points of octree scans
+ *          and keeps the octrees for searching.
+ */
+class BoctreePointBuffer : public PointBuffer
+{
+public:
+
+    /// Flattens the given scans into this buffer
+    BoctreePointBuffer(BoctreeScansPtr scans);
+
+    /// Returns the octree scans of this buffer
+    BoctreeScansPtr getScans() { return m_scans; }
+
+private:
+
+    BoctreeScansPtr m_scans;
+};
+
+typedef boost::shared_ptr<BoctreePointBuffer> BoctreePointBufferPtr;
+
+} // namespace lvr
+
+#endif /* BOCTREESCANS_HPP_ */
@@ -28,26 +28,108 @@
 
 #include "DataStruct.hpp"
 
+#include <stdint.h>
+
 #include <string>
 
 namespace lvr
 {
 
+/**
+ * @brief   Header of the binary grid format. The header is followed by
+ *          two sections that start at 64 byte aligned offsets: the query
+ *          points (x, y, z, distance as float) and the eight corner indices
+ *          of every cell (uint32). Uncompressed sections can be mapped
+ *          directly into memory. All values are stored in the byte order
+ *          of the writing machine, which is checked via byteOrder.
+ */
+struct GridFileHeader
+{
+    /// "LVRGRID" followed by a zero byte
+    char            magic[8];
+
+    /// Always 0x01020304 in the byte order of the writer
+    uint32_t        byteOrder;
+
+    /// Format version
+    uint32_t        version;
+
+    /// Number of query points
+    uint64_t        numPoints;
+
+    /// Number of cells
+    uint64_t        numBoxes;
+
+    /// Voxel size of the grid
+    float           voxelsize;
+
+    /// Codec of the point and box section (see GridIO::Codec)
+    uint16_t        pointCodec;
+    uint16_t        boxCodec;
+
+    /// File offsets and stored sizes of the sections in bytes
+    uint64_t        pointOffset;
+    uint64_t        pointBytes;
+    uint64_t        boxOffset;
+    uint64_t        boxBytes;
+};
+
 class GridIO
 {
 public:
+
+    /// Storage of a section in the binary format
+    enum Codec
+    {
+        Raw     = 0,
+        Deflate = 1
+    };
+
     GridIO();
+
+    /**
+     * @brief   Reads a grid. Binary grids are detected by their magic
+     *          number, all other files are parsed as text grids as written
+     *          by earlier versions of HashGrid::saveGrid(). Uncompressed
+     *          binary sections are not copied, the returned arrays point
+     *          into a private mapping of the file.
+     */
     void read( std::string filename );
+
+    /**
+     * @brief   Writes a grid in the binary format.
+     *
+     * @param   points      4 * numPoints floats (position and distance)
+     * @param   boxes       8 * numBoxes corner indices
+     * @param   compress    Deflate the sections (requires zlib). Compressed
+     *                      grids are smaller but have to be decoded on read.
+     */
+    static bool write( std::string filename,
+                       floatArr points, size_t numPoints,
+                       uintArr boxes, size_t numBoxes,
+                       float voxelsize, bool compress = false );
+
     virtual ~GridIO();
 
     floatArr getPoints( size_t &n );
     uintArr  getBoxes(  size_t &n );
 
+    /// Voxel size of the last read grid
+    float    getVoxelsize() const { return m_voxelsize; }
+
 private:
+
+    /// Parses the text format
+    void readText( std::string filename );
+
+    /// Reads the binary format. Returns false if the file is no binary grid.
+    bool readBinary( std::string filename );
+
     floatArr m_points;
     uintArr  m_boxes;
     size_t   m_numPoints;
     size_t   m_numBoxes;
+    float    m_voxelsize;
 };
 
 } /* namespace lvr */
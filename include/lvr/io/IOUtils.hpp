@@ -94,6 +94,46 @@ size_t getReductionFactor(ModelPtr model, size_t targetSize);
  */
 size_t getReductionFactorASCII(boost::filesystem::path& inFile, size_t targetSize);
 
+/**
+ * @brief   Builds a transformation matrix that scales and switches the
+ *          coordinates of a point in the same way as \ref
+ *          transformAndReducePointCloud does. Concatenating the result with
+ *          other transformations allows to do all conversions in a single
+ *          pass over the data.
+ *
+ * @param   sx          Scaling factor in x direction
+ * @param   sy          Scaling factor in y direction
+ * @param   sz          Scaling factor in z direction
+ * @param   xPos        Position of the x coordinate in the input data
+ * @param   yPos        Position of the y coordinate in the input data
+ * @param   zPos        Position of the z coordinate in the input data
+ */
+Eigen::Matrix4d buildSwizzleTransformation(int sx, int sy, int sz, int xPos, int yPos, int zPos);
+
+/**
+ * @brief   Applies an affine transformation to every n-th point of an
+ *          interlaced float array and writes the results consecutively
+ *          into the output array. The points are processed in parallel.
+ *
+ * @param   in          Interlaced input points (x, y, z)
+ * @param   n           Number of points in \ref in
+ * @param   out         Output array. Has to provide space for
+ *                      3 * ceil(n / modulo) floats. May be identical to
+ *                      \ref in if modulo is 1.
+ * @param   transform   A 4x4 transformation matrix in column major order
+ *                      (the storage order of Eigen and Matrix4)
+ * @param   modulo      Only every modulo-th point is transformed and written
+ * @param   translate   If false, only the rotational part is applied, which
+ *                      is what you want for normals.
+ * @return  The number of points written to \ref out.
+ */
+size_t transformAndReducePointArray(const float* in, size_t n, float* out, const double* transform, size_t modulo = 1, bool translate = true);
+
+/**
+ * @brief   Same as above for single precision transformation matrices.
+ */
+size_t transformAndReducePointArray(const float* in, size_t n, float* out, const float* transform, size_t modulo = 1, bool translate = true);
+
 /**
  * @brief   Transforms (scale and switch coordinates) and reduces a model
  *          containing point cloud data using a modulo filter. Use this
@@ -113,6 +153,19 @@ size_t getReductionFactorASCII(boost::filesystem::path& inFile, size_t targetSiz
  */
 void transformAndReducePointCloud(ModelPtr model, int modulo, int sx, int sy, int sz, int xPos, int yPos, int zPos);
 
+/**
+ * @brief   Transforms and reduces a model containing point cloud data in a
+ *          single pass using a modulo filter. Colors are reduced and
+ *          normals are reduced and transformed with the inverse transpose
+ *          of the linear part, then normalized, so scaling and shearing
+ *          matrices are supported. The original arrays are not modified.
+ *
+ * @param   model           A model containing point cloud data
+ * @param   modulo          The reduction factor for the modulo filter
+ * @param   transformation  The transformation to apply to the kept points
+ */
+void transformAndReducePointCloud(ModelPtr model, int modulo, const Eigen::Matrix4d& transformation);
+
 /**
  * @brief   Transforms a model containing a point cloud according to the given
  *          transformation (usually from a .frames file)
@@ -146,6 +199,12 @@ void transformPointCloudAndAppend(PointBufferPtr& buffer, boost::filesystem::pat
  */
 void writePointsAndNormals(std::vector<float>& p, std::vector<float>& n, std::string outfile);
 
+/**
+ * @brief   Creates a deep copy of the given point buffer, i.e., all point
+ *          attributes are copied into newly allocated arrays.
+ */
+PointBufferPtr clonePointBuffer(PointBufferPtr buffer);
+
 
 } // namespace lvr
 
@@ -0,0 +1,129 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+/*
+ * LabeledMeshIO.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef LABELEDMESHIO_HPP_
+#define LABELEDMESHIO_HPP_
+
+#include <lvr/io/BaseIO.hpp>
+#include <lvr/io/DataStruct.hpp>
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace lvr
+{
+
+/**
+ * @brief   Metadata of a region in a labeled mesh
+ */
+struct LabeledRegion
+{
+    /// Index into the label table
+    uint32_t    label;
+
+    /// Number of faces of the region
+    uint32_t    numFaces;
+
+    /// Sum of the face areas
+    float       area;
+
+    /// Region normal
+    float       normal[3];
+
+    /// Area weighted centroid
+    float       centroid[3];
+
+    /// Bounding box
+    float       bbMin[3];
+    float       bbMax[3];
+};
+
+/**
+ * @brief   A triangle mesh with a label and a region for every face
+ */
+struct LabeledMesh
+{
+    LabeledMesh() : numVertices(0), numFaces(0) {}
+
+    floatArr                    vertices;
+    floatArr                    normals;
+    ucharArr                    colors;
+    size_t                      numVertices;
+
+    uintArr                     faces;
+    uintArr                     faceRegions;
+    uintArr                     faceLabels;
+    size_t                      numFaces;
+
+    std::vector<std::string>    labels;
+    std::vector<LabeledRegion>  regions;
+};
+
+/**
+ * @brief   Reader / Writer for binary labeled meshes (.lbm). A file
+ *          contains a header, the label names, the region table, the
+ *          vertex data (positions and optional normals and colors), the
+ *          triangles and the region and label index of every triangle.
+ *          All data is written in the byte order of the writing machine.
+ *
+ *          When read into a MeshBuffer, the labels are stored in the
+ *          labeled faces map of the buffer.
+ */
+class LabeledMeshIO : public BaseIO
+{
+public:
+
+    LabeledMeshIO() {}
+    virtual ~LabeledMeshIO() {}
+
+    /**
+     * @brief   Reads a labeled mesh. The complete data including the
+     *          region table is available via getLabeledMesh().
+     */
+    virtual ModelPtr read( string filename );
+
+    /**
+     * @brief   Saves the mesh of the current model. Each entry of the
+     *          labeled faces map forms one region, unlabeled faces are
+     *          assigned to a region with the label "unknown".
+     */
+    virtual void save( string filename );
+
+    /// Writes the given mesh. Returns false if the file could not be written.
+    static bool write( string filename, const LabeledMesh& mesh );
+
+    /// The mesh read by the last call of read()
+    const LabeledMesh& getLabeledMesh() const { return m_mesh; }
+
+private:
+
+    LabeledMesh m_mesh;
+};
+
+} // namespace lvr
+
+#endif /* LABELEDMESHIO_HPP_ */
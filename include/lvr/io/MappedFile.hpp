@@ -0,0 +1,95 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+/*
+ * MappedFile.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef MAPPEDFILE_HPP_
+#define MAPPEDFILE_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace lvr
+{
+
+/**
+ * @brief   Read only view of a complete file. On POSIX systems the file
+ *          is memory mapped, otherwise it is read into memory.
+ */
+class MappedFile
+{
+public:
+
+    /**
+     * @brief   Maps the given file. Use good() to check for errors.
+     *
+     * @param   writable    If true, the mapping is private and writable,
+     *                      i.e., modified pages are copied on write and
+     *                      the changes never reach the file.
+     */
+    MappedFile(const std::string& filename, bool writable = false);
+
+    /// Unmaps the file
+    ~MappedFile();
+
+    /// True if the file was mapped successfully
+    bool good() const { return m_data != 0 || (m_open && m_size == 0); }
+
+    /// Pointer to the first byte of the file
+    const char* data() const { return m_data; }
+
+    /// Writable pointer to the first byte. Only valid for writable mappings.
+    char* writableData() { return m_writable ? const_cast<char*>(m_data) : 0; }
+
+    /// Size of the file in bytes
+    size_t size() const { return m_size; }
+
+private:
+
+    // Non-copyable
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    /// Start of the mapped data
+    const char*         m_data;
+
+    /// Size of the mapped data
+    size_t              m_size;
+
+    /// True if the file could be opened
+    bool                m_open;
+
+    /// True if the data was mapped (and not read into m_buffer)
+    bool                m_mapped;
+
+    /// True if the data may be modified
+    bool                m_writable;
+
+    /// Fallback storage if mapping is not supported
+    std::vector<char>   m_buffer;
+};
+
+} // namespace lvr
+
+#endif /* MAPPEDFILE_HPP_ */
@@ -0,0 +1,231 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * MeshCheckpointIO.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef MESHCHECKPOINTIO_HPP_
+#define MESHCHECKPOINTIO_HPP_
+
+#include "DataStruct.hpp"
+
+#include <stdint.h>
+
+#include <string>
+
+namespace lvr
+{
+
+/// Marks a missing reference in a checkpoint
+const uint32_t CHECKPOINT_NONE = 0xffffffff;
+
+/// Stage names of the post-processing passes stored in checkpoints. The
+/// reconstruct and meshoptimizer tools use the same names, so checkpoints
+/// written by one can be resumed by the other.
+const char* const CHECKPOINT_STAGE_REMOVE_DANGLING_ARTIFACTS    = "removeDanglingArtifacts";
+const char* const CHECKPOINT_STAGE_CLEAN_CONTOURS               = "cleanContours";
+const char* const CHECKPOINT_STAGE_OPTIMIZE_PLANES              = "optimizePlanes";
+const char* const CHECKPOINT_STAGE_FILL_HOLES                   = "fillHoles";
+const char* const CHECKPOINT_STAGE_OPTIMIZE_PLANE_INTERSECTIONS = "optimizePlaneIntersections";
+const char* const CHECKPOINT_STAGE_RESTORE_PLANES               = "restorePlanes";
+const char* const CHECKPOINT_STAGE_REDUCE_MESH_BY_COLLAPSE      = "reduceMeshByCollapse";
+const char* const CHECKPOINT_STAGE_CLUSTER_REGIONS              = "clusterRegions";
+
+/**
+ * @brief   Vertex record of a mesh checkpoint. The outgoing edges of a
+ *          vertex are stored consecutively in the edge table in the order
+ *          of the vertex's out list, the incoming edges are listed in the
+ *          in edge table.
+ */
+struct CheckpointVertex
+{
+    float       position[3];
+    float       normal[3];
+    uint32_t    numOut;
+    uint32_t    numIn;
+
+    /// See MeshCheckpointIO::VertexFlags
+    uint32_t    flags;
+
+    /// RGB color (if supported by the vertex type) and padding
+    uint8_t     color[4];
+};
+
+/**
+ * @brief   Edge record of a mesh checkpoint. All references are indices
+ *          into the respective tables or CHECKPOINT_NONE.
+ */
+struct CheckpointEdge
+{
+    uint32_t    start;
+    uint32_t    end;
+    uint32_t    next;
+    uint32_t    pair;
+    uint32_t    face;
+
+    /// 1 if the edge's used flag is set
+    uint32_t    flags;
+};
+
+/**
+ * @brief   Face record of a mesh checkpoint
+ */
+struct CheckpointFace
+{
+    /// Index of the face's first edge
+    uint32_t    edge;
+
+    int32_t     textureIndex;
+
+    /// Region number of the face or -1
+    int64_t     region;
+
+    float       normal[3];
+
+    /// See MeshCheckpointIO::FaceFlags
+    uint32_t    flags;
+};
+
+/**
+ * @brief   Region record of a mesh checkpoint. The faces of a region are
+ *          a range of the region face table, the label is a range of the
+ *          label table.
+ */
+struct CheckpointRegion
+{
+    int32_t     regionNumber;
+
+    /// See MeshCheckpointIO::RegionFlags
+    uint32_t    flags;
+
+    float       normal[3];
+    float       stuetzvektor[3];
+
+    uint64_t    firstFace;
+    uint64_t    numFaces;
+    uint64_t    labelOffset;
+    uint64_t    labelLength;
+};
+
+/**
+ * @brief   The tables of a mesh checkpoint
+ */
+struct MeshCheckpoint
+{
+    MeshCheckpoint()
+        : numVertices(0), numEdges(0), numInEdges(0), numFaces(0),
+          numRegions(0), numRegionFaces(0), numLabelBytes(0), flags(0) {}
+
+    boost::shared_array<CheckpointVertex>   vertices;
+    size_t                                  numVertices;
+
+    boost::shared_array<CheckpointEdge>     edges;
+    size_t                                  numEdges;
+
+    /// Edge indices of the in lists of all vertices
+    uintArr                                 inEdges;
+    size_t                                  numInEdges;
+
+    boost::shared_array<CheckpointFace>     faces;
+    size_t                                  numFaces;
+
+    boost::shared_array<CheckpointRegion>   regions;
+    size_t                                  numRegions;
+
+    /// Face indices of all regions
+    uintArr                                 regionFaces;
+    size_t                                  numRegionFaces;
+
+    /// Concatenated region labels
+    boost::shared_array<char>               labels;
+    size_t                                  numLabelBytes;
+
+    /// See MeshCheckpointIO::MeshFlags
+    uint32_t                                flags;
+
+    /// Name of the last processing step before the checkpoint was written
+    std::string                             stage;
+};
+
+/**
+ * @brief   Reader / Writer for binary snapshots of the complete state of a
+ *          half edge mesh (.hem). The header is followed by the vertex,
+ *          edge, in edge, face, region, region face and label tables. Every
+ *          table starts at a 64 byte aligned offset, so the tables of a
+ *          read checkpoint point directly into a private mapping of the
+ *          file. All data is written in the byte order of the writing
+ *          machine.
+ */
+class MeshCheckpointIO
+{
+public:
+
+    enum VertexFlags
+    {
+        VertexMerged        = 1,
+        VertexFused         = 2,
+        VertexOldFused      = 4,
+        VertexFusedNeighbor = 8
+    };
+
+    enum FaceFlags
+    {
+        FaceUsed            = 1,
+        FaceRegionUsed      = 2,
+        FaceInvalid         = 4,
+        FaceFusion          = 8
+    };
+
+    enum RegionFlags
+    {
+        RegionInPlane       = 1,
+        RegionUnfinished    = 2,
+        RegionToDelete      = 4,
+        RegionLabeled       = 8
+    };
+
+    enum MeshFlags
+    {
+        QuadricsValid       = 1,
+        QuadricsUseArea     = 2
+    };
+
+    /**
+     * @brief   Reads a checkpoint. Returns false if the file is no valid
+     *          checkpoint.
+     */
+    static bool read( std::string filename, MeshCheckpoint& checkpoint );
+
+    /**
+     * @brief   Writes the given checkpoint. Returns false if the file could
+     *          not be written.
+     */
+    static bool write( std::string filename, const MeshCheckpoint& checkpoint );
+
+    /// Returns true if the given file starts like a checkpoint
+    static bool isCheckpoint( std::string filename );
+};
+
+} // namespace lvr
+
+#endif /* MESHCHECKPOINTIO_HPP_ */
@@ -47,32 +47,77 @@ namespace lvr
 
 /**
  * @brief An implementation of the PPM file format.
+ *
+ * Supports ASCII (P2, P3) and binary (P5, P6) gray and color images with
+ * 8 or 16 bit samples and PFM float images (Pf, PF). Files are read with a
+ * single mapped block and written with a single block write. 16 bit samples
+ * are available via getPixels16(), float images via getFloats(). The read
+ * arrays are owned by the PPMIO object and freed in the destructor, an array
+ * passed to setDataArray() stays owned by the caller.
  */
 class PPMIO
 {
 public:
     PPMIO();
     PPMIO( string filename );
-    virtual ~PPMIO() {};
+    virtual ~PPMIO();
 
+    /// Writes the 8 bit data set with setDataArray() as P5 or P6 file
     void write( string filename );
-    void setDataArray( unsigned char* array, int width, int height );
+    void setDataArray( unsigned char* array, int width, int height, int channels = 3 );
 
-    int            getHeight() const { return m_height; }
-    int            getWidth()  const { return m_width;  }
-    unsigned char* getPixels() const { return m_pixels; }
+    int             getHeight()   const { return m_height;   }
+    int             getWidth()    const { return m_width;    }
+    int             getChannels() const { return m_channels; }
+    int             getMaxValue() const { return m_maxValue; }
+    unsigned char*  getPixels()   const { return m_pixels;   }
+    unsigned short* getPixels16() const { return m_pixels16; }
+    float*          getFloats()   const { return m_floats;   }
 
-private:
-    int            m_width;  // The width of the image
-    int            m_height; // The height of the image
-    unsigned char* m_pixels; // The image/pixel data
+    /**
+     * @brief   Returns a copy of the image with 3 channels and 8 bit samples.
+     *          Gray images are replicated to all channels, 16 bit samples
+     *          are scaled by the maximum value and float samples are
+     *          clamped to [0, 1]. The array is allocated with new[] and
+     *          owned by the caller. Returns 0 if no image was read.
+     */
+    unsigned char*  getRGB8()     const;
+
+    /**
+     * @brief   Writes a binary PGM (1 channel) or PPM (3 channels) file
+     *          with 8 bit samples.
+     */
+    static bool writePNM( string filename, const unsigned char* data,
+                          int width, int height, int channels );
 
     /**
-     * Reads a new line from the given stream that is no comment
-     * @param   in      The stream to read from
-     * @param   buffer  The extracted information
+     * @brief   Writes a binary PGM or PPM file with 16 bit samples. The
+     *          samples are converted to big endian as required by the format.
      */
-    void readLine( ifstream & in, char* buffer );
+    static bool writePNM16( string filename, const unsigned short* data,
+                            int width, int height, int channels,
+                            int maxValue = 65535 );
+
+    /**
+     * @brief   Writes a PFM file with 1 or 3 float channels. Rows are
+     *          expected top to bottom.
+     */
+    static bool writePFM( string filename, const float* data,
+                          int width, int height, int channels );
+
+private:
+    int             m_width;    // The width of the image
+    int             m_height;   // The height of the image
+    int             m_channels; // Number of channels (1 or 3)
+    int             m_maxValue; // Maximum sample value (0 for float images)
+    unsigned char*  m_pixels;   // 8 bit image/pixel data
+    unsigned short* m_pixels16; // 16 bit image/pixel data
+    float*          m_floats;   // Float image data
+    bool            m_ownsPixels; // False if m_pixels was set with setDataArray()
+
+    // The pixel arrays are owned, so copies are not allowed
+    PPMIO( const PPMIO& );
+    PPMIO& operator=( const PPMIO& );
 };
 
 }
@@ -13,8 +13,9 @@
 namespace lvr {
 
 /****
- * @brief 	Reader / Writer for STL file. Currently only binary STL files
- * 			are supported.
+ * @brief 	Reader / Writer for STL file. Files are written in binary
+ * 			format. The reader supports binary and ASCII files and merges
+ * 			identical vertices.
  */
 class STLIO : public BaseIO
 {
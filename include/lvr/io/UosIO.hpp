@@ -42,6 +42,7 @@
 
 #include <lvr/geometry/Vertex.hpp>
 #include <lvr/geometry/Matrix4.hpp>
+#include <lvr/reconstruction/PointCloudReduction.hpp>
 
 using std::string;
 using std::fstream;
@@ -112,6 +113,16 @@ public:
     void reduce(string dir, string target, int reduction = 1);
 
 
+    /**
+     * @brief Sets a spatial reduction engine that is used by \ref reduce.
+     *        The scan points are passed block wise to the engine after
+     *        transformation and the reduced cloud is written after all
+     *        scans were processed. Remission values are only exported
+     *        as colors in this mode.
+     */
+    void setReductionEngine(PointCloudReductionPtr engine) { m_reductionEngine = engine;}
+
+
     /**
      * \todo Implement this!
      * \warning This function is not yet implemented!
@@ -230,6 +241,9 @@ private:
     /// If true, the original remission information will be saved
     bool    m_saveRemission;
 
+    /// Optional spatial reduction for the points written by \ref reduce
+    PointCloudReductionPtr  m_reductionEngine;
+
 };
 
 } // namespace lvr
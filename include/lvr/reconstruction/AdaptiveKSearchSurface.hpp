@@ -41,6 +41,8 @@
 #include <lvr/geometry/BoundingBox.hpp>
 
 #include "PointsetSurface.hpp"
+#include "PointsetSurfaceQuery.hpp"
+#include "NormalOrientation.hpp"
 
 #include "boost/shared_ptr.hpp"
 
@@ -51,6 +53,7 @@
 
 #include "SearchTreeNanoflann.hpp"
 #include "SearchTreeFlann.hpp"
+#include "SearchTreeBoctree.hpp"
 
 // SearchTreePCL
 #ifdef LVR_USE_PCL
@@ -177,6 +180,20 @@ public:
      */
     virtual void distance(VertexT v, float &projectedDistance, float &euklideanDistance);
 
+    /**
+     * @brief Same as distance(v, projectedDistance, euklideanDistance), but
+     *        uses the given buffers for the search results. Does not modify
+     *        the surface.
+     */
+    virtual void distance(const VertexT& v, float &projectedDistance, float &euklideanDistance,
+            vector<int>& id, vector<float>& di) const;
+
+    /**
+     * @brief Queries only read the points, normals and the search tree,
+     *        so they are thread safe if the search tree is.
+     */
+    virtual bool isThreadSafe() const { return this->m_searchTree && this->m_searchTree->isThreadSafe(); }
+
 
     virtual void colorizePointCloud( typename AdaptiveKSearchSurface<VertexT, NormalT>::Ptr pcm,
           const float &sqrtMaxDist = std::numeric_limits<float>::max(),
@@ -188,11 +205,43 @@ public:
      */
     void calculateSurfaceNormals();
 
+    /**
+     * @brief Calculates the normals of the given points only. All other
+     *        normals are taken from the point buffer. The normals are
+     *        interpolated from the raw estimates of the neighbors like in
+     *        interpolateSurfaceNormals(), so updating all points whose
+     *        neighborhoods changed gives the same normals as a complete
+     *        estimation. MST based orientation is not supported. Used to
+     *        update the normals of a point cloud after new points were
+     *        added.
+     *
+     * @param indices       Indices of the points to update
+     * @param rawNormals    Estimated normals of all points before the
+     *                      interpolation (3 floats per point). The entries
+     *                      of the given points are updated.
+     */
+    void calculateSurfaceNormals(const vector<size_t>& indices, floatArr rawNormals);
+
+    /**
+     * @brief Returns the largest neighborhood a normal was estimated from
+     *        in the last call of calculateSurfaceNormals(). The
+     *        neighborhood grows up to 32 * kn points if it is degenerated.
+     */
+    size_t getMaxNormalNeighbors() const { return m_maxNormalNeighbors; }
+
     /**
      * @brief If set to true, normals will be calculated using RANSAC instead of
      *        plane fitting
      */
     void useRansac(bool use_it) { m_useRANSAC = use_it;}
+
+    /**
+     * @brief If set to true, the estimated normals are oriented consistently
+     *        along a minimum spanning tree of the \ref m_kn nearest neighbor
+     *        graph before they are interpolated (see orientNormalsMST). The
+     *        scan poses or the centroid are used as hints.
+     */
+    void orientNormalsByMST(bool use_it) { m_orientNormalsMST = use_it;}
     
     
     void setKD( int kd )
@@ -215,7 +264,9 @@ public:
     color3bArr                  m_colors;
 
 	/**
-         * @brief Interpolate the initial normals with the \ref m_ki neighbors
+         * @brief Interpolate the initial normals with the \ref m_ki neighbors.
+         *        Only the initial normals are averaged, so the result does
+         *        not depend on the order of the points.
          */
         void interpolateSurfaceNormals();
 
@@ -243,6 +294,34 @@ private:
      */
     void init();
 
+    /**
+     * @brief Estimates the normal of the given point from an adaptive
+     *        k-neighborhood and flips it towards the nearest scan pose
+     *        or the centroid
+     *
+     * @param i             Index of the point
+     * @param viewpoint     Returns the position used for flipping
+     * @param k             Returns the size of the used neighborhood
+     * @param query         Query object of the search tree
+     * @param ctx           Search buffers of the calling thread
+     */
+    NormalT estimateNormal(size_t i, VertexT& viewpoint, size_t& k,
+            const PointsetSurfaceQuery<VertexT>& query,
+            typename PointsetSurfaceQuery<VertexT>::Context& ctx);
+
+    /**
+     * @brief Returns the mean of the given normals of the \ref m_ki
+     *        nearest neighbors of a point
+     *
+     * @param i             Index of the point
+     * @param normals       Normals of all points (3 floats per point)
+     * @param query         Query object of the search tree
+     * @param ctx           Search buffers of the calling thread
+     */
+    NormalT interpolateNormal(size_t i, const float* normals,
+            const PointsetSurfaceQuery<VertexT>& query,
+            typename PointsetSurfaceQuery<VertexT>::Context& ctx);
+
 	/**
 	 * @brief Checks if the bounding box of a point set is "well formed",
 	 *        i.e. no dimension is significantly larger than the other.
@@ -307,6 +386,9 @@ private:
     /// Should a randomized algorithm be used to determine planes?
 	bool                        m_useRANSAC;
 
+    /// Orient the normals along a minimum spanning tree?
+    bool                        m_orientNormalsMST;
+
     /// The currently stored points
     coord3fArr                  m_points;
 
@@ -333,6 +415,9 @@ private:
     /// Type of used search tree
     string						m_searchTreeName;
 
+    /// The largest neighborhood used for normal estimation
+    size_t                      m_maxNormalNeighbors;
+
 };
 
 
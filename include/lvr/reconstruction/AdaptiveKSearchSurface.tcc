@@ -47,6 +47,8 @@ template<typename VertexT, typename NormalT>
 AdaptiveKSearchSurface<VertexT, NormalT>::AdaptiveKSearchSurface()
 {
 	m_useRANSAC = true;
+    m_orientNormalsMST = false;
+    m_maxNormalNeighbors = 0;
     this->m_ki = 10;
     this->m_kn = 10;
     this->m_kd = 10;
@@ -85,6 +87,8 @@ AdaptiveKSearchSurface<VertexT, NormalT>::AdaptiveKSearchSurface(
     this->m_kd = kd;
 
     m_useRANSAC = useRansac;
+    m_orientNormalsMST = false;
+    m_maxNormalNeighbors = 0;
 
     init();
 
@@ -115,6 +119,15 @@ AdaptiveKSearchSurface<VertexT, NormalT>::AdaptiveKSearchSurface(
     {
         this->m_searchTree = search_tree::Ptr( new SearchTreeFlann<VertexT>(loader, this->m_numPoints, kn, ki, kd) );
     }
+    if( searchTreeName == "boctree" || searchTreeName == "BOCTREE")
+    {
+        // Only possible if the points were read from octree files
+        BoctreePointBufferPtr octree_points = boost::dynamic_pointer_cast<BoctreePointBuffer>(loader);
+        if(octree_points)
+        {
+            this->m_searchTree = search_tree::Ptr( new SearchTreeBoctree<VertexT>(octree_points, this->m_numPoints, kn, ki, kd) );
+        }
+    }
 
     if( !this->m_searchTree )
     {
@@ -235,10 +248,126 @@ void AdaptiveKSearchSurface<VertexT, NormalT>::init()
 
 
 template<typename VertexT, typename NormalT>
-void AdaptiveKSearchSurface<VertexT, NormalT>::calculateSurfaceNormals()
+NormalT AdaptiveKSearchSurface<VertexT, NormalT>::estimateNormal(size_t i, VertexT& viewpoint, size_t& k,
+        const PointsetSurfaceQuery<VertexT>& query,
+        typename PointsetSurfaceQuery<VertexT>::Context& ctx)
 {
-    int k_0 = this->m_kn;
+    Vertexf query_point;
+    Normalf normal;
+
+    // Search results are stored in the buffers of the calling thread
+    vector<int>& id = ctx.indices;
+
+    int n = 0;
+    k = this->m_kn;
+
+    while(n < 5){
+
+        n++;
+        /**
+         *  @todo Maybe this should be done at the end of the loop
+         *        after the bounding box check
+         */
+        k = k * 2;
+
+        //T* point = this->m_points[i];
+        query.kSearch(VertexT(this->m_points[i][0], this->m_points[i][1], this->m_points[i][2]), k, ctx);
+
+        float min_x = 1e15f;
+        float min_y = 1e15f;
+        float min_z = 1e15f;
+        float max_x = - min_x;
+        float max_y = - min_y;
+        float max_z = - min_z;
+
+        float dx, dy, dz;
+        dx = dy = dz = 0;
+
+        // Calculate the bounding box of found point set
+        /**
+         * @todo Use the bounding box object from the old model3d
+         *       library for bounding box calculation...
+         */
+        for(size_t j = 0; j < k; j++){
+            min_x = min(min_x, this->m_points[id[j]][0]);
+            min_y = min(min_y, this->m_points[id[j]][1]);
+            min_z = min(min_z, this->m_points[id[j]][2]);
+
+            max_x = max(max_x, this->m_points[id[j]][0]);
+            max_y = max(max_y, this->m_points[id[j]][1]);
+            max_z = max(max_z, this->m_points[id[j]][2]);
+
+//                cout << "Points: " << this->m_numPoints << "Point[" << id[j] << "].x: " <<  this->m_points[id[j]][0] << endl ;
+//                cout << "Points: " << this->m_numPoints << "Point[" << id[j] << "].y: " <<  this->m_points[id[j]][1] << endl ;
+//                cout << "Points: " << this->m_numPoints << "Point[" << id[j] << "].z: " <<  this->m_points[id[j]][2] << endl ;
+
+
+            dx = max_x - min_x;
+            dy = max_y - min_y;
+            dz = max_z - min_z;
+        }
+
+        if(boundingBoxOK(dx, dy, dz)) break;
+        //break;
+
+    }
+
+    // Create a query point for the current point
+    query_point = VertexT(this->m_points[i][0],
+            			  this->m_points[i][1],
+            			  this->m_points[i][2]);
+
+    // Interpolate a plane based on the k-neighborhood
+    Plane<VertexT, NormalT> p;
+    bool ransac_ok;
+    if(m_useRANSAC)
+    {
+        p = calcPlaneRANSAC(query_point, k, id, ransac_ok);
+        // Fallback if RANSAC failed
+        if(!ransac_ok)
+        {
+            p = calcPlane(query_point, k, id);
+        }
+    }
+    else
+    {
+        p = calcPlane(query_point, k, id);
+    }
+    // Get the mean distance to the tangent plane
+    //mean_distance = meanDistance(p, id, k);
 
+    // Flip normals towards the center of the scene or nearest scan pose
+    viewpoint = m_centroid;
+    if(m_poseTree)
+    {
+    	vector<VertexT> nearestPoses;
+    	m_poseTree->kSearch(query_point, 1, nearestPoses);
+    	if(nearestPoses.size() == 1)
+    	{
+    		VertexT nearest = nearestPoses[0];
+    		normal = p.n;
+    		if(normal * (query_point - nearest) < 0) normal = normal * -1;
+    		viewpoint = nearest;
+    	}
+    	else
+    	{
+    		cout << timestamp << "Could not get nearest scan pose. Defaulting to centroid." << endl;
+    		normal =  p.n;
+    		if(normal * (query_point - m_centroid) < 0) normal = normal * -1;
+    	}
+    }
+    else
+    {
+        normal =  p.n;
+        if(normal * (query_point - m_centroid) < 0) normal = normal * -1;
+    }
+
+    return normal;
+}
+
+template<typename VertexT, typename NormalT>
+void AdaptiveKSearchSurface<VertexT, NormalT>::calculateSurfaceNormals()
+{
     cout << timestamp << "Initializing normal array..." << endl;
 
     //Initialize normal array
@@ -250,185 +379,177 @@ void AdaptiveKSearchSurface<VertexT, NormalT>::calculateSurfaceNormals()
     string comment = timestamp.getElapsedTime() + "Estimating normals ";
     ProgressBar progress(this->m_numPoints, comment);
 
-    #pragma omp parallel for schedule(static)
-    for( int i = 0; i < (int)this->m_numPoints; i++){
-
-        Vertexf query_point;
-        Normalf normal;
-
-        // We have to fit these vector to have the
-        // correct return values when performing the
-        // search on the stann kd tree. So we don't use
-        // the template parameter T for di
-        vector<int> id;
-        vector<float> di;
-
-        int n = 0;
-        size_t k = k_0;
-
-        while(n < 5){
-
-            n++;
-            /**
-             *  @todo Maybe this should be done at the end of the loop
-             *        after the bounding box check
-             */
-            k = k * 2;
-
-            //T* point = this->m_points[i];
-            this->m_searchTree->kSearch(this->m_points[i], k, id, di);
-
-            float min_x = 1e15f;
-            float min_y = 1e15f;
-            float min_z = 1e15f;
-            float max_x = - min_x;
-            float max_y = - min_y;
-            float max_z = - min_z;
-
-            float dx, dy, dz;
-            dx = dy = dz = 0;
-
-            // Calculate the bounding box of found point set
-            /**
-             * @todo Use the bounding box object from the old model3d
-             *       library for bounding box calculation...
-             */
-            for(size_t j = 0; j < k; j++){
-                min_x = min(min_x, this->m_points[id[j]][0]);
-                min_y = min(min_y, this->m_points[id[j]][1]);
-                min_z = min(min_z, this->m_points[id[j]][2]);
-
-                max_x = max(max_x, this->m_points[id[j]][0]);
-                max_y = max(max_y, this->m_points[id[j]][1]);
-                max_z = max(max_z, this->m_points[id[j]][2]);
-
-//                cout << "Points: " << this->m_numPoints << "Point[" << id[j] << "].x: " <<  this->m_points[id[j]][0] << endl ;
-//                cout << "Points: " << this->m_numPoints << "Point[" << id[j] << "].y: " <<  this->m_points[id[j]][1] << endl ;
-//                cout << "Points: " << this->m_numPoints << "Point[" << id[j] << "].z: " <<  this->m_points[id[j]][2] << endl ;
-
+    // Viewpoints that were used for flipping. They are the
+    // hints for the MST based orientation.
+    vector<float> viewpoints;
+    if(m_orientNormalsMST)
+    {
+        viewpoints.resize(3 * this->m_numPoints);
+    }
 
-                dx = max_x - min_x;
-                dy = max_y - min_y;
-                dz = max_z - min_z;
-            }
+    // Searches of trees that are not thread safe are serialized
+    PointsetSurfaceQuery<VertexT> query(this->m_searchTree);
+    m_maxNormalNeighbors = 0;
 
-            if(boundingBoxOK(dx, dy, dz)) break;
-            //break;
+    #pragma omp parallel
+    {
+        typename PointsetSurfaceQuery<VertexT>::Context ctx;
+        size_t maxNeighbors = 0;
 
-        }
+        #pragma omp for schedule(static)
+        for( int i = 0; i < (int)this->m_numPoints; i++){
 
-        // Create a query point for the current point
-        query_point = VertexT(this->m_points[i][0],
-                			  this->m_points[i][1],
-                			  this->m_points[i][2]);
+            VertexT viewpoint;
+            size_t k;
+            NormalT normal = estimateNormal(i, viewpoint, k, query, ctx);
+            maxNeighbors = std::max(maxNeighbors, k);
 
-        // Interpolate a plane based on the k-neighborhood
-        Plane<VertexT, NormalT> p;
-        bool ransac_ok;
-        if(m_useRANSAC)
-        {
-            p = calcPlaneRANSAC(query_point, k, id, ransac_ok);
-            // Fallback if RANSAC failed
-            if(!ransac_ok)
+            if(m_orientNormalsMST)
             {
-                p = calcPlane(query_point, k, id);
+                viewpoints[3 * i]     = viewpoint[0];
+                viewpoints[3 * i + 1] = viewpoint[1];
+                viewpoints[3 * i + 2] = viewpoint[2];
             }
-        }
-        else
-        {
-            p = calcPlane(query_point, k, id);
-        }
-        // Get the mean distance to the tangent plane
-        //mean_distance = meanDistance(p, id, k);
 
-        // Flip normals towards the center of the scene or nearest scan pose
-        if(m_poseTree)
-        {
-        	vector<VertexT> nearestPoses;
-        	m_poseTree->kSearch(query_point, 1, nearestPoses);
-        	if(nearestPoses.size() == 1)
-        	{
-        		VertexT nearest = nearestPoses[0];
-        		normal = p.n;
-        		if(normal * (query_point - nearest) < 0) normal = normal * -1;
-        	}
-        	else
-        	{
-        		cout << timestamp << "Could not get nearest scan pose. Defaulting to centroid." << endl;
-        		normal =  p.n;
-        		if(normal * (query_point - m_centroid) < 0) normal = normal * -1;
-        	}
-        }
-        else
-        {
-            normal =  p.n;
-            if(normal * (query_point - m_centroid) < 0) normal = normal * -1;
+            // Save result in normal array
+            this->m_normals[i][0] = normal[0];
+            this->m_normals[i][1] = normal[1];
+            this->m_normals[i][2] = normal[2];
+            ++progress;
         }
 
-        // Save result in normal array
-        this->m_normals[i][0] = normal[0];
-        this->m_normals[i][1] = normal[1];
-        this->m_normals[i][2] = normal[2];
-        ++progress;
+        #pragma omp critical
+        m_maxNormalNeighbors = std::max(m_maxNormalNeighbors, maxNeighbors);
     }
     cout << endl;
 
+    // Orient before interpolating, interpolation of inconsistent
+    // normals would cancel them out
+    if(m_orientNormalsMST && this->m_numPoints)
+    {
+        orientNormalsMST<VertexT>(
+                this->m_searchTree,
+                &this->m_points[0][0],
+                &this->m_normals[0][0],
+                this->m_numPoints,
+                this->m_kn,
+                &viewpoints[0]);
+    }
+
     if(this->m_ki) interpolateSurfaceNormals();
 }
 
 
 template<typename VertexT, typename NormalT>
-void AdaptiveKSearchSurface<VertexT, NormalT>::interpolateSurfaceNormals()
+void AdaptiveKSearchSurface<VertexT, NormalT>::calculateSurfaceNormals(const vector<size_t>& indices, floatArr rawNormals)
 {
-    // Create a temporal normal array for the
-    vector<NormalT> tmp(this->m_numPoints, NormalT());
+    // Reuse the normals of the point buffer for all other points
+    if(!this->m_normals)
+    {
+        this->m_normals = coord3fArr( new coord<float>[this->m_numPoints] );
+        this->m_pointBuffer->setIndexedPointNormalArray(this->m_normals, this->m_numPoints);
+    }
 
-    // Create progress output
-    string comment = timestamp.getElapsedTime() + "Interpolating normals ";
-    ProgressBar progress(this->m_numPoints, comment);
+    string comment = timestamp.getElapsedTime() + "Estimating normals ";
+    ProgressBar progress(indices.size(), comment);
 
-    // Interpolate normals
-    #pragma omp parallel for schedule(static)
-    for( int i = 0; i < (int)this->m_numPoints; i++){
+    PointsetSurfaceQuery<VertexT> query(this->m_searchTree);
+    m_maxNormalNeighbors = 0;
 
-        vector<int> id;
-        vector<float> di;
+    #pragma omp parallel
+    {
+        typename PointsetSurfaceQuery<VertexT>::Context ctx;
+        size_t maxNeighbors = 0;
 
-        this->m_searchTree->kSearch(this->m_points[i], this->m_ki, id, di);
+        #pragma omp for schedule(static)
+        for(long i = 0; i < (long)indices.size(); i++)
+        {
+            VertexT viewpoint;
+            size_t k;
+            NormalT normal = estimateNormal(indices[i], viewpoint, k, query, ctx);
+            maxNeighbors = std::max(maxNeighbors, k);
+
+            float* raw = rawNormals.get() + 3 * indices[i];
+            raw[0] = normal[0];
+            raw[1] = normal[1];
+            raw[2] = normal[2];
+            ++progress;
+        }
 
-        VertexT mean;
-        NormalT mean_normal;
+        #pragma omp critical
+        m_maxNormalNeighbors = std::max(m_maxNormalNeighbors, maxNeighbors);
+    }
+    cout << endl;
+
+    // Interpolate from the raw normals of the neighbors. The
+    // interpolated normals are not read, so they are written directly.
+    #pragma omp parallel
+    {
+        typename PointsetSurfaceQuery<VertexT>::Context ctx;
 
-        for(int j = 0; j < this->m_ki; j++)
+        #pragma omp for schedule(static)
+        for(long i = 0; i < (long)indices.size(); i++)
         {
-            mean += VertexT(this->m_normals[id[j]][0],
-                            this->m_normals[id[j]][1],
-                            this->m_normals[id[j]][2]);
+            if(this->m_ki)
+            {
+                NormalT normal = interpolateNormal(indices[i], rawNormals.get(), query, ctx);
+                this->m_normals[indices[i]][0] = normal[0];
+                this->m_normals[indices[i]][1] = normal[1];
+                this->m_normals[indices[i]][2] = normal[2];
+            }
+            else
+            {
+                const float* raw = rawNormals.get() + 3 * indices[i];
+                this->m_normals[indices[i]][0] = raw[0];
+                this->m_normals[indices[i]][1] = raw[1];
+                this->m_normals[indices[i]][2] = raw[2];
+            }
         }
-        mean_normal = NormalT(mean);
+    }
+}
 
-        tmp[i] = mean;
+template<typename VertexT, typename NormalT>
+NormalT AdaptiveKSearchSurface<VertexT, NormalT>::interpolateNormal(size_t i, const float* normals,
+        const PointsetSurfaceQuery<VertexT>& query,
+        typename PointsetSurfaceQuery<VertexT>::Context& ctx)
+{
+    coord<float>& p = this->m_points[i];
+    query.kSearch(VertexT(p[0], p[1], p[2]), this->m_ki, ctx);
 
-        ///todo Try to remove this code. Should improve the results at all.
-        for(int j = 0; j < this->m_ki; j++)
-        {
-            NormalT n(this->m_normals[id[j]][0],
-                      this->m_normals[id[j]][1],
-                      this->m_normals[id[j]][2]);
+    const vector<int>& id = ctx.indices;
+    VertexT mean;
+    for(size_t j = 0; j < id.size(); j++)
+    {
+        const float* n = normals + 3 * id[j];
+        mean += VertexT(n[0], n[1], n[2]);
+    }
+    return NormalT(mean);
+}
 
+template<typename VertexT, typename NormalT>
+void AdaptiveKSearchSurface<VertexT, NormalT>::interpolateSurfaceNormals()
+{
+    // Create a temporal normal array for the
+    vector<NormalT> tmp(this->m_numPoints, NormalT());
 
-            // Only override existing normals if the interpolated
-            // normals is significantly different from the initial
-            // estimation. This helps to avoid a too smooth normal
-            // field
-            if(fabs(n * mean_normal) > 0.2 )
-            {
-                this->m_normals[id[j]][0] = mean_normal[0];
-                this->m_normals[id[j]][1] = mean_normal[1];
-                this->m_normals[id[j]][2] = mean_normal[2];
-            }
+    // Create progress output
+    string comment = timestamp.getElapsedTime() + "Interpolating normals ";
+    ProgressBar progress(this->m_numPoints, comment);
+
+    // Searches of trees that are not thread safe are serialized
+    PointsetSurfaceQuery<VertexT> query(this->m_searchTree);
+
+    // Interpolate normals. The initial normals are not changed
+    // before all points are interpolated.
+    #pragma omp parallel
+    {
+        typename PointsetSurfaceQuery<VertexT>::Context ctx;
+
+        #pragma omp for schedule(static)
+        for( int i = 0; i < (int)this->m_numPoints; i++){
+            tmp[i] = interpolateNormal(i, &this->m_normals[0][0], query, ctx);
+            ++progress;
         }
-        ++progress;
     }
     cout << endl;
     cout << timestamp << "Copying normals..." << endl;
@@ -521,10 +642,23 @@ float AdaptiveKSearchSurface<VertexT, NormalT>::distance(VertexT v, Plane<Vertex
 template<typename VertexT, typename NormalT>
 void AdaptiveKSearchSurface<VertexT, NormalT>::distance(VertexT v, float &projectedDistance, float &euklideanDistance)
 {
-    int k = this->m_kd;
-
     vector<int> id;
     vector<float> di;
+    distance(v, projectedDistance, euklideanDistance, id, di);
+}
+
+template<typename VertexT, typename NormalT>
+void AdaptiveKSearchSurface<VertexT, NormalT>::distance(const VertexT& v,
+        float &projectedDistance,
+        float &euklideanDistance,
+        vector<int>& id,
+        vector<float>& di) const
+{
+    int k = this->m_kd;
+
+    // Some trees append to the result buffers
+    id.clear();
+    di.clear();
 
     //Allocate ANN point
     {
@@ -28,6 +28,7 @@
 
 #include "FastBox.hpp"
 #include "PointsetSurface.hpp"
+#include "PointsetSurfaceQuery.hpp"
 #include <lvr/geometry/HalfEdgeMesh.hpp>
 #include <lvr/geometry/HalfEdgeFace.hpp>
 
@@ -57,13 +58,36 @@ public:
             vector<QueryPoint<VertexT> > &query_points,
             uint &globalIndex);
 
+    /**
+     * @brief Moves the vertices of the contour edges of this box to the
+     *        centroid of their kc nearest points.
+     */
     void optimizePlanarFaces(size_t kc);
 
+    /**
+     * @brief Moves the vertices of the contour edges of all given boxes to
+     *        the centroid of their kc nearest points. The unique contour
+     *        vertices are collected once and queried in parallel. The new
+     *        positions are applied after all queries are done.
+     *
+     * @param boxes         The boxes to optimize
+     * @param kc            The number of nearest neighbors
+     */
+    static void optimizePlanarFaces(vector<BilinearFastBox<VertexT, NormalT>* >& boxes, size_t kc);
+
     // the point set surface
     static typename PointsetSurface<VertexT>::Ptr m_surface;
 
 
 private:
+
+    /**
+     * @brief Appends the start and end vertices of the contour edges of
+     *        the box to the given vector. Nothing is added if the box is
+     *        not a contour box.
+     */
+    void getContourVertices(vector<HalfEdgeVertex<VertexT, NormalT>* >& vertices);
+
     vector<HalfEdgeFace<VertexT, NormalT>* > m_faces;
     int                                      m_mcIndex;
 
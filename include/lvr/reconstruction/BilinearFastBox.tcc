@@ -25,6 +25,8 @@
 
 #include "FastBox.hpp"
 
+#include <algorithm>
+
 namespace lvr
 {
 
@@ -128,89 +130,130 @@ void BilinearFastBox<VertexT, NormalT>::getSurface(
 }
 
 template<typename VertexT, typename NormalT>
-void BilinearFastBox<VertexT, NormalT>::optimizePlanarFaces(size_t kc)
+void BilinearFastBox<VertexT, NormalT>::getContourVertices(vector<HalfEdgeVertex<VertexT, NormalT>* >& vertices)
 {
-	if(this->m_surface)
-	{
-		typedef HalfEdge<HalfEdgeVertex<VertexT, NormalT>, HalfEdgeFace<VertexT, NormalT> > HEdge;
-
-		typename SearchTree<VertexT>::Ptr tree = this->m_surface->searchTree();
+	typedef HalfEdge<HalfEdgeVertex<VertexT, NormalT>, HalfEdgeFace<VertexT, NormalT> > HEdge;
 
-		// Detect triangles that are on the border of the mesh
-		vector<HEdge*> out_edges;
+	// Detect triangles that are on the border of the mesh
+	vector<HEdge*> out_edges;
 
-		for(int i = 0; i < m_faces.size(); i++)
+	for(int i = 0; i < m_faces.size(); i++)
+	{
+		HalfEdgeFace<VertexT, NormalT>* face = m_faces[i];
+		HEdge* e = face->m_edge;
+		for(int j = 0; j < 2; j++)
 		{
-			HalfEdgeFace<VertexT, NormalT>* face = m_faces[i];
-			HEdge* e = face->m_edge;
-			for(int j = 0; j < 2; j++)
+			// Catch null pointer from outer faces
+			try
 			{
-				// Catch null pointer from outer faces
-				try
-				{
-					e->pair()->face();
-				}
-				catch (HalfEdgeAccessException& ex)
-				{
-					out_edges.push_back(e);
-				}
-
-				// Check integrity
-				try
-				{
-					e = e->next();
-				}
-				catch (HalfEdgeAccessException& ex)
-				{
-					// Face corrupted, abort
-					cout << "Warning, corrupted face" << endl;
-					break;
-				}
+				e->pair()->face();
+			}
+			catch (HalfEdgeAccessException& ex)
+			{
+				out_edges.push_back(e);
 			}
 
+			// Check integrity
+			try
+			{
+				e = e->next();
+			}
+			catch (HalfEdgeAccessException& ex)
+			{
+				// Face corrupted, abort
+				cout << "Warning, corrupted face" << endl;
+				break;
+			}
 		}
 
-		// Handle different cases
-		if(out_edges.size() == 1 || out_edges.size() == 2 )
+	}
+
+	// Handle different cases
+	if(out_edges.size() == 1 || out_edges.size() == 2 )
+	{
+		for(int i = 0; i < out_edges.size(); i++)
 		{
-			// Get nearest points
-			for(int i = 0; i < out_edges.size(); i++)
-			{
-				vector<VertexT> nearest1, nearest2;
-				this->m_surface->searchTree()->kSearch( out_edges[i]->start()->m_position, kc, nearest1);
+			vertices.push_back(out_edges[i]->start());
+			vertices.push_back(out_edges[i]->end());
+		}
+	}
+}
 
-				size_t nk = min(kc, nearest1.size());
+template<typename VertexT, typename NormalT>
+void BilinearFastBox<VertexT, NormalT>::optimizePlanarFaces(size_t kc)
+{
+	vector<BilinearFastBox<VertexT, NormalT>* > boxes(1, this);
+	optimizePlanarFaces(boxes, kc);
+}
 
+template<typename VertexT, typename NormalT>
+void BilinearFastBox<VertexT, NormalT>::optimizePlanarFaces(
+		vector<BilinearFastBox<VertexT, NormalT>* >& boxes,
+		size_t kc)
+{
+	typedef HalfEdgeVertex<VertexT, NormalT> HVertex;
 
-				// Hmmm, sometimes the k-search seems to fail...
-				if(nk > 0)
-				{
-					VertexT centroid1;
-					for(int a = 0; a < nk; a++)
-					{
-						centroid1 += nearest1[a];
-					}
-					centroid1 /= nk;
-					out_edges[i]->start()->m_position = centroid1;
-				}
+	if(!m_surface || boxes.empty())
+	{
+		return;
+	}
+
+	PointsetSurfaceQuery<VertexT> query(m_surface);
+
+	// Collect the contour vertices of all boxes. Vertices are
+	// shared by neighboring boxes, so they are made unique.
+	vector<vector<HVertex*> > contours(boxes.size());
+
+	#pragma omp parallel for schedule(dynamic, 64)
+	for(long i = 0; i < (long)boxes.size(); i++)
+	{
+		boxes[i]->getContourVertices(contours[i]);
+	}
 
-				this->m_surface->searchTree()->kSearch( out_edges[i]->end()->m_position, kc, nearest2);
-				nk = min(kc, nearest2.size());
+	vector<HVertex*> vertices;
+	for(size_t i = 0; i < contours.size(); i++)
+	{
+		vertices.insert(vertices.end(), contours[i].begin(), contours[i].end());
+	}
+	std::sort(vertices.begin(), vertices.end());
+	vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+	vector<VertexT> centroids(vertices.size());
+
+	// Get nearest points
+	#pragma omp parallel
+	{
+		typename PointsetSurfaceQuery<VertexT>::Context ctx;
 
-				if(nk > 0)
+		#pragma omp for schedule(dynamic, 256)
+		for(long i = 0; i < (long)vertices.size(); i++)
+		{
+			VertexT position = vertices[i]->m_position;
+			query.kSearchPoints(position, kc, ctx);
+			vector<VertexT>& nearest = ctx.neighbors;
+			size_t nk = min(kc, nearest.size());
+
+			// Hmmm, sometimes the k-search seems to fail...
+			VertexT centroid = position;
+			if(nk > 0)
+			{
+				centroid = VertexT();
+				for(size_t a = 0; a < nk; a++)
 				{
-					VertexT centroid2;
-					for(int a = 0; a < nk; a++)
-					{
-						centroid2 += nearest2[a];
-					}
-					centroid2 /= nk;
-					out_edges[i]->end()->m_position = centroid2;
+					centroid += nearest[a];
 				}
-
+				centroid /= nk;
 			}
+			centroids[i] = centroid;
 		}
 	}
+
+	// Apply the new positions after all queries are done
+	#pragma omp parallel for schedule(static)
+	for(long i = 0; i < (long)vertices.size(); i++)
+	{
+		vertices[i]->m_position = centroids[i];
+	}
 }
 
 template<typename VertexT, typename NormalT>
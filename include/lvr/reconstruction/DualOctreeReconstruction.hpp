@@ -0,0 +1,106 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * DualOctreeReconstruction.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef DUALOCTREERECONSTRUCTION_HPP_
+#define DUALOCTREERECONSTRUCTION_HPP_
+
+#include <lvr/reconstruction/FastReconstruction.hpp>
+#include <lvr/reconstruction/OctreeGrid.hpp>
+
+#include <stdint.h>
+#include <vector>
+
+namespace lvr
+{
+
+/**
+ * @brief   Dual marching cubes (Schaefer and Warren 2004) on an OctreeGrid.
+ *
+ *          The corners of the dual grid are the centers of the octree's
+ *          leaves. Every octree vertex is surrounded by (up to) eight leaves,
+ *          whose centers form a dual cell that is polygonized with the
+ *          marching cubes table. Where leaves of different size meet, some
+ *          corners of a dual cell coincide. Since neighboring dual cells share
+ *          their faces, the mesh is free of cracks across octree levels.
+ *          Vertices on a dual edge are identified by the two leaves of the
+ *          edge, so they are shared between all adjacent dual cells.
+ */
+template<typename VertexT, typename NormalT>
+class DualOctreeReconstruction : public FastReconstructionBase<VertexT, NormalT>
+{
+public:
+
+    /**
+     * @brief   Constructor.
+     *
+     * @param   grid    An octree with calculated distance values
+     */
+    DualOctreeReconstruction(OctreeGrid<VertexT, NormalT>* grid);
+
+    virtual ~DualOctreeReconstruction() {}
+
+    /**
+     * @brief   Returns the surface reconstruction of the given point set.
+     */
+    virtual void getMesh(BaseMesh<VertexT, NormalT>& mesh);
+
+private:
+
+    typedef typename OctreeGrid<VertexT, NormalT>::Node Node;
+
+    /// A dual cell given by the leaves at its corners (marching cubes order)
+    struct DualCell
+    {
+        uint32_t corners[8];
+    };
+
+    /**
+     * @brief   Enumerates the dual cells of the given configuration of nodes.
+     *
+     *          The nodes are arranged in a 2 x 2 x 2 block of slots. The bits of
+     *          the mask denote the axes along which the slots refer to
+     *          different nodes: 0 for a single node, one bit for two nodes
+     *          sharing a face, two bits for four nodes sharing an edge and all
+     *          bits for eight nodes sharing a vertex. Dual cells are created
+     *          for vertex configurations of leaves.
+     */
+    void dualProc(const uint32_t nodes[8], int mask, std::vector<DualCell>& cells) const;
+
+    /// Returns the key of the dual edge between two leaves
+    static uint64_t edgeKey(uint32_t a, uint32_t b)
+    {
+        return a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+    }
+
+    /// The octree
+    OctreeGrid<VertexT, NormalT>*   m_grid;
+};
+
+} // namespace lvr
+
+#include "DualOctreeReconstruction.tcc"
+
+#endif /* DUALOCTREERECONSTRUCTION_HPP_ */
@@ -0,0 +1,305 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * DualOctreeReconstruction.tcc
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/reconstruction/MCTable.hpp>
+#include <lvr/io/Timestamp.hpp>
+
+#include <algorithm>
+
+namespace lvr
+{
+
+/// Slot of a dual cell (x, y, z bits) for every marching cubes corner
+const static int dual_corner_slots[8] = {0, 1, 3, 2, 4, 5, 7, 6};
+
+/// Corners of the twelve marching cubes edges
+const static int dual_edge_corners[12][2] = {
+    {0, 1}, {1, 2}, {3, 2}, {0, 3},
+    {4, 5}, {5, 6}, {7, 6}, {4, 7},
+    {0, 4}, {1, 5}, {3, 7}, {2, 6}
+};
+
+template<typename VertexT, typename NormalT>
+DualOctreeReconstruction<VertexT, NormalT>::DualOctreeReconstruction(OctreeGrid<VertexT, NormalT>* grid)
+    : m_grid(grid)
+{
+
+}
+
+template<typename VertexT, typename NormalT>
+void DualOctreeReconstruction<VertexT, NormalT>::dualProc(
+        const uint32_t nodes[8],
+        int mask,
+        vector<DualCell>& cells) const
+{
+    const vector<Node>& tree = m_grid->getNodes();
+
+    bool leaves = true;
+    for(int s = 0; s < 8; s++)
+    {
+        if(tree[nodes[s]].children >= 0)
+        {
+            leaves = false;
+            break;
+        }
+    }
+
+    if(leaves)
+    {
+        if(mask == 7)
+        {
+            DualCell cell;
+            for(int c = 0; c < 8; c++)
+            {
+                cell.corners[c] = nodes[dual_corner_slots[c]];
+            }
+            cells.push_back(cell);
+        }
+        return;
+    }
+
+    // Replace the inner nodes by their children. Along an axis of the
+    // mask only the configuration that straddles the boundary between
+    // the slots is new. Along the other axes the configurations in both
+    // halves and the one straddling the center of the nodes are visited.
+    for(int o = 0; o < 27; o++)
+    {
+        int option[3] = {o % 3, (o / 3) % 3, o / 9};
+
+        bool valid = true;
+        int subMask = 0;
+        for(int a = 0; a < 3; a++)
+        {
+            if((mask >> a) & 1)
+            {
+                valid = valid && option[a] == 1;
+            }
+            if(option[a] == 1)
+            {
+                subMask |= 1 << a;
+            }
+        }
+
+        if(!valid)
+        {
+            continue;
+        }
+
+        uint32_t sub[8];
+        for(int t = 0; t < 8; t++)
+        {
+            int slot = 0;
+            int child = 0;
+            for(int a = 0; a < 3; a++)
+            {
+                int bit = (t >> a) & 1;
+                if(option[a] != 1)
+                {
+                    child |= (option[a] / 2) << a;
+                }
+                else if((mask >> a) & 1)
+                {
+                    slot |= bit << a;
+                    child |= (1 - bit) << a;
+                }
+                else
+                {
+                    child |= bit << a;
+                }
+            }
+
+            const Node& node = tree[nodes[slot]];
+            sub[t] = node.children >= 0 ? node.children + child : nodes[slot];
+        }
+
+        dualProc(sub, subMask, cells);
+    }
+}
+
+template<typename VertexT, typename NormalT>
+void DualOctreeReconstruction<VertexT, NormalT>::getMesh(BaseMesh<VertexT, NormalT>& mesh)
+{
+    const vector<Node>& tree = m_grid->getNodes();
+
+    cout << timestamp << "Creating dual cells" << endl;
+
+    // Enumerate the dual cells. The configurations of the root's children
+    // are traversed in parallel and concatenated in a fixed order.
+    vector<vector<DualCell> > parts(27);
+    if(tree[0].children >= 0)
+    {
+        #pragma omp parallel for schedule(dynamic, 1)
+        for(int o = 0; o < 27; o++)
+        {
+            int option[3] = {o % 3, (o / 3) % 3, o / 9};
+            int mask = 0;
+            uint32_t sub[8];
+            for(int a = 0; a < 3; a++)
+            {
+                if(option[a] == 1)
+                {
+                    mask |= 1 << a;
+                }
+            }
+            for(int t = 0; t < 8; t++)
+            {
+                int child = 0;
+                for(int a = 0; a < 3; a++)
+                {
+                    int bit = option[a] == 1 ? (t >> a) & 1 : option[a] / 2;
+                    child |= bit << a;
+                }
+                sub[t] = tree[0].children + child;
+            }
+            dualProc(sub, mask, parts[o]);
+        }
+    }
+
+    vector<DualCell> cells;
+    for(size_t i = 0; i < parts.size(); i++)
+    {
+        cells.insert(cells.end(), parts[i].begin(), parts[i].end());
+        vector<DualCell>().swap(parts[i]);
+    }
+
+    // Marching cubes index of every cell and the dual edges that
+    // contain a vertex
+    vector<int> indices(cells.size(), -1);
+    vector<uint64_t> edges;
+    const float voxelsize = m_grid->getVoxelsize();
+
+    #pragma omp parallel
+    {
+        vector<uint64_t> local;
+
+        #pragma omp for schedule(static)
+        for(long i = 0; i < (long)cells.size(); i++)
+        {
+            const DualCell& cell = cells[i];
+
+            int index = 0;
+            uint32_t size = 0;
+            float euklidean = 0.0f;
+            for(int c = 0; c < 8; c++)
+            {
+                const Node& node = tree[cell.corners[c]];
+                size = std::max(size, node.size);
+                euklidean = std::max(euklidean, node.euklidean);
+                if(node.distance > 0)
+                {
+                    index |= 1 << c;
+                }
+            }
+
+            // The distance values are only reliable close to the
+            // surface, relative to the size of the dual cell
+            if(euklidean > 1.7320 * size * voxelsize)
+            {
+                continue;
+            }
+
+            indices[i] = index;
+            for(int a = 0; MCTable[index][a] != -1; a++)
+            {
+                const int* e = dual_edge_corners[MCTable[index][a]];
+                local.push_back(edgeKey(cell.corners[e[0]], cell.corners[e[1]]));
+            }
+        }
+
+        #pragma omp critical
+        edges.insert(edges.end(), local.begin(), local.end());
+    }
+
+    sort(edges.begin(), edges.end());
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+
+    // Interpolate the vertex positions along the dual edges
+    vector<VertexT> positions(edges.size());
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)edges.size(); i++)
+    {
+        const Node& a = tree[edges[i] >> 32];
+        const Node& b = tree[edges[i] & 0xffffffff];
+
+        float t = 0.5f;
+        if(a.distance != b.distance)
+        {
+            t = std::min(std::max(a.distance / (a.distance - b.distance), 0.001f), 0.999f);
+        }
+
+        VertexT pa = m_grid->getCenter(a);
+        VertexT pb = m_grid->getCenter(b);
+        positions[i] = VertexT(
+                pa[0] + t * (pb[0] - pa[0]),
+                pa[1] + t * (pb[1] - pa[1]),
+                pa[2] + t * (pb[2] - pa[2]));
+    }
+
+    // The vertex index in the mesh equals the index of the edge. The
+    // normals are interpolated later.
+    for(size_t i = 0; i < positions.size(); i++)
+    {
+        mesh.addVertex(positions[i]);
+        mesh.addNormal(NormalT());
+    }
+
+    size_t numTriangles = 0;
+    for(size_t i = 0; i < cells.size(); i++)
+    {
+        int index = indices[i];
+        if(index < 0)
+        {
+            continue;
+        }
+
+        const DualCell& cell = cells[i];
+        for(int a = 0; MCTable[index][a] != -1; a += 3)
+        {
+            uint32_t triangle[3];
+            for(int b = 0; b < 3; b++)
+            {
+                const int* e = dual_edge_corners[MCTable[index][a + b]];
+                uint64_t key = edgeKey(cell.corners[e[0]], cell.corners[e[1]]);
+                triangle[b] = (uint32_t)(lower_bound(edges.begin(), edges.end(), key) - edges.begin());
+            }
+
+            // Collapsed corners of the dual cell result in degenerated
+            // triangles
+            if(triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2])
+            {
+                continue;
+            }
+
+            mesh.addTriangle(triangle[0], triangle[1], triangle[2]);
+            numTriangles++;
+        }
+    }
+
+    cout << timestamp << "Created " << numTriangles << " triangles from " << cells.size() << " dual cells" << endl;
+}
+
+} // namespace lvr
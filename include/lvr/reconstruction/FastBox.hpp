@@ -198,6 +198,7 @@ protected:
     uint                  		m_vertices[8];
 
     template<typename Q, typename V> friend class BilinearFastBox;
+    template<typename Q, typename V> friend class IncrementalReconstruction;
 
     typedef FastBox<VertexT, NormalT> BoxType;
 };
@@ -40,6 +40,44 @@ FastReconstruction<VertexT, NormalT, BoxT>::FastReconstruction(HashGrid<VertexT,
 template<typename VertexT, typename NormalT, typename BoxT>
 void FastReconstruction<VertexT, NormalT, BoxT>::getMesh(BaseMesh<VertexT, NormalT> &mesh)
 {
+	BoxTraits<BoxT> traits;
+	bool sharpBoxes = (traits.type == "SharpBox");
+
+	typename HashGrid<VertexT, BoxT>::box_map_it it;
+
+	// Classify all boxes w.r.t. sharp features in parallel. The
+	// results are cached in the boxes and used during extraction.
+	if(sharpBoxes)
+	{
+		vector<SharpBox<VertexT, NormalT>* > boxes;
+		boxes.reserve(m_grid->getNumberOfCells());
+		for(it = m_grid->firstCell(); it != m_grid->lastCell(); it++)
+		{
+			boxes.push_back(reinterpret_cast<SharpBox<VertexT, NormalT>* >(it->second));
+		}
+
+		string comment = timestamp.getElapsedTime() + "Detecting sharp features ";
+		ProgressBar progress(boxes.size(), comment);
+
+		vector<QueryPoint<VertexT> >& query_points = m_grid->getQueryPoints();
+
+		SharpBox<VertexT, NormalT>::m_query.reset(
+				new PointsetSurfaceQuery<VertexT>(SharpBox<VertexT, NormalT>::m_surface));
+
+		#pragma omp parallel for schedule(dynamic, 64)
+		for(long i = 0; i < (long)boxes.size(); i++)
+		{
+			boxes[i]->classifyFeatures(query_points);
+			if(!timestamp.isQuiet())
+				++progress;
+		}
+
+		SharpBox<VertexT, NormalT>::m_query.reset();
+
+		if(!timestamp.isQuiet())
+			cout << endl;
+	}
+
 	// Status message for mesh generation
 	string comment = timestamp.getElapsedTime() + "Creating Mesh ";
 	ProgressBar progress(m_grid->getNumberOfCells(), comment);
@@ -48,44 +86,51 @@ void FastReconstruction<VertexT, NormalT, BoxT>::getMesh(BaseMesh<VertexT, Norma
 	BoxT* b;
 	unsigned int global_index = mesh.meshSize();
 
-	// Iterate through cells and calculate local approximations
-	typename HashGrid<VertexT, BoxT>::box_map_it it;
-	for(it = m_grid->firstCell(); it != m_grid->lastCell(); it++)
+	// Boxes with sharp features need edge flipping
+	vector<SharpBox<VertexT, NormalT>* > featureBoxes;
+
+	if(traits.type == "TetraederBox")
 	{
-		b = it->second;
-		b->getSurface(mesh, m_grid->getQueryPoints(), global_index);
-		if(!timestamp.isQuiet())
-			++progress;
+		// Extract all boxes at once using a shared edge cache
+		vector<TetraederBox<VertexT, NormalT>* > boxes;
+		boxes.reserve(m_grid->getNumberOfCells());
+		for(it = m_grid->firstCell(); it != m_grid->lastCell(); it++)
+		{
+			boxes.push_back(reinterpret_cast<TetraederBox<VertexT, NormalT>* >(it->second));
+		}
+		TetraederBox<VertexT, NormalT>::getSurfaces(mesh, boxes, m_grid->getQueryPoints(), global_index,
+				timestamp.isQuiet() ? 0 : &progress);
+	}
+	else
+	{
+		// Iterate through cells and calculate local approximations
+		for(it = m_grid->firstCell(); it != m_grid->lastCell(); it++)
+		{
+			b = it->second;
+			b->getSurface(mesh, m_grid->getQueryPoints(), global_index);
+			if(sharpBoxes)
+			{
+				SharpBox<VertexT, NormalT>* sb = reinterpret_cast<SharpBox<VertexT, NormalT>* >(b);
+				if(sb->m_containsSharpFeature)
+				{
+					featureBoxes.push_back(sb);
+				}
+			}
+			if(!timestamp.isQuiet())
+				++progress;
+		}
 	}
 
 	if(!timestamp.isQuiet())
 		cout << endl;
 
-	BoxTraits<BoxT> traits;
-
-	if(traits.type == "SharpBox")  // Perform edge flipping for extended marching cubes
+	if(sharpBoxes)  // Perform edge flipping for extended marching cubes
 	{
 		string SFComment = timestamp.getElapsedTime() + "Flipping edges  ";
-		ProgressBar SFProgress(this->m_grid->getNumberOfCells(), SFComment);
-		for(it = this->m_grid->firstCell(); it != this->m_grid->lastCell(); it++)
+		ProgressBar SFProgress(featureBoxes.size(), SFComment);
+		for(size_t i = 0; i < featureBoxes.size(); i++)
 		{
-
-			SharpBox<VertexT, NormalT>* sb;
-			sb = reinterpret_cast<SharpBox<VertexT, NormalT>* >(it->second);
-			if(sb->m_containsSharpFeature)
-			{
-				if(sb->m_containsSharpCorner)
-				{
-					mesh.flipEdge(sb->m_intersections[ExtendedMCTable[sb->m_extendedMCIndex][0]], sb->m_intersections[ExtendedMCTable[sb->m_extendedMCIndex][1]]);
-					mesh.flipEdge(sb->m_intersections[ExtendedMCTable[sb->m_extendedMCIndex][2]], sb->m_intersections[ExtendedMCTable[sb->m_extendedMCIndex][3]]);
-					mesh.flipEdge(sb->m_intersections[ExtendedMCTable[sb->m_extendedMCIndex][4]], sb->m_intersections[ExtendedMCTable[sb->m_extendedMCIndex][5]]);
-				}
-				else
-				{
-					mesh.flipEdge(sb->m_intersections[ExtendedMCTable[sb->m_extendedMCIndex][0]], sb->m_intersections[ExtendedMCTable[sb->m_extendedMCIndex][1]]);
-					mesh.flipEdge(sb->m_intersections[ExtendedMCTable[sb->m_extendedMCIndex][4]], sb->m_intersections[ExtendedMCTable[sb->m_extendedMCIndex][5]]);
-				}
-			}
+			featureBoxes[i]->flipEdges(mesh);
 			++SFProgress;
 		}
 		cout << endl;
@@ -93,16 +138,16 @@ void FastReconstruction<VertexT, NormalT, BoxT>::getMesh(BaseMesh<VertexT, Norma
 
 	if(traits.type == "BilinearFastBox")
 	{
-	    string comment = timestamp.getElapsedTime() + "Optimizing plane contours  ";
-	    ProgressBar progress(this->m_grid->getNumberOfCells(), comment);
+	    cout << timestamp << "Optimizing plane contours" << endl;
+
+	    // F... type safety. According to traits object this is OK!
+	    vector<BilinearFastBox<VertexT, NormalT>* > boxes;
+	    boxes.reserve(this->m_grid->getNumberOfCells());
 	    for(it = this->m_grid->firstCell(); it != this->m_grid->lastCell(); it++)
 	    {
-	    	// F... type safety. According to traits object this is OK!
-	        BilinearFastBox<VertexT, NormalT>* box = reinterpret_cast<BilinearFastBox<VertexT, NormalT>*>(it->second);
-	        box->optimizePlanarFaces(5);
-	        ++progress;
+	        boxes.push_back(reinterpret_cast<BilinearFastBox<VertexT, NormalT>*>(it->second));
 	    }
-	    cout << endl;
+	    BilinearFastBox<VertexT, NormalT>::optimizePlanarFaces(boxes, 5);
 	}
 
 }
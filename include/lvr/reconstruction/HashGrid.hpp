@@ -45,8 +45,9 @@ public:
 	 * @brief	Saves a representation of the grid to the given file
 	 *
 	 * @param file		Output file name.
+	 * @param compress	Deflate the grid data (requires zlib)
 	 */
-	virtual void saveGrid(string file) = 0;
+	virtual void saveGrid(string file, bool compress = false) = 0;
 
 	/***
 	 * @brief	Is extrude is set to true, additional cells within the
@@ -116,8 +117,9 @@ public:
 	 * @brief	Saves a representation of the grid to the given file
 	 *
 	 * @param file		Output file name.
+	 * @param compress	Deflate the grid data (requires zlib)
 	 */
-	virtual void saveGrid(string file);
+	virtual void saveGrid(string file, bool compress = false);
 
 	virtual void serialize(string file);
 
@@ -152,6 +154,15 @@ public:
 
 	box_map getCells() { return m_cells; }
 
+	/**
+	 * @brief	Returns the cell with the given hash value or 0
+	 */
+	BoxT* getCell(size_t hash)
+	{
+		box_map_it it = m_cells.find(hash);
+		return it == m_cells.end() ? 0 : it->second;
+	}
+
 	/***
 	 * @brief	Destructor
 	 */
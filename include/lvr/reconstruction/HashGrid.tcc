@@ -37,6 +37,7 @@
 #include "FastReconstructionTables.hpp"
 #include "SharpBox.hpp"
 #include <lvr/io/Progress.hpp>
+#include <lvr/io/GridIO.hpp>
 
 namespace lvr
 {
@@ -407,50 +408,39 @@ unsigned int HashGrid<VertexT, BoxT>::findQueryPoint(
 
 
 template<typename VertexT, typename BoxT>
-void HashGrid<VertexT, BoxT>::saveGrid(string filename)
+void HashGrid<VertexT, BoxT>::saveGrid(string filename, bool compress)
 {
 	cout << timestamp << "Writing grid..." << endl;
 
-	// Open file for writing
-	ofstream out(filename.c_str());
+	size_t numPoints = m_queryPoints.size();
+	size_t numBoxes = m_cells.size();
 
-	// Write data
-	if(out.good())
-	{
-		// Write header
-		out << m_queryPoints.size() << " " << m_voxelsize << " " << m_cells.size() << endl;
-
-		// Write query points and distances
-		for(size_t i = 0; i < m_queryPoints.size(); i++)
-		{
-			out << m_queryPoints[i].m_position[0] << " "
-					<< m_queryPoints[i].m_position[1] << " "
-					<< m_queryPoints[i].m_position[2] << " ";
-
-			if(!isnan(m_queryPoints[i].m_distance))
-			{
-				out << m_queryPoints[i].m_distance << endl;
-			}
-			else
-			{
-				out << 0 << endl;
-			}
+	// Query points and distances
+	floatArr points(new float[4 * numPoints]);
 
-		}
+	#pragma omp parallel for schedule(static)
+	for(long i = 0; i < (long)numPoints; i++)
+	{
+		points[4 * i]     = m_queryPoints[i].m_position[0];
+		points[4 * i + 1] = m_queryPoints[i].m_position[1];
+		points[4 * i + 2] = m_queryPoints[i].m_position[2];
+		points[4 * i + 3] = isnan(m_queryPoints[i].m_distance) ? 0.0f : m_queryPoints[i].m_distance;
+	}
 
-		// Write box definitions
-		typename unordered_map<size_t, BoxT* >::iterator it;
-		BoxT* box;
-		for(it = m_cells.begin(); it != m_cells.end(); it++)
+	// Box definitions
+	uintArr boxes(new unsigned int[8 * numBoxes]);
+	typename unordered_map<size_t, BoxT* >::iterator it;
+	size_t pos = 0;
+	for(it = m_cells.begin(); it != m_cells.end(); it++)
+	{
+		BoxT* box = it->second;
+		for(int i = 0; i < 8; i++)
 		{
-			box = it->second;
-			for(int i = 0; i < 8; i++)
-			{
-				out << box->getVertex(i) << " ";
-			}
-			out << endl;
+			boxes[pos++] = box->getVertex(i);
 		}
 	}
+
+	GridIO::write(filename, points, numPoints, boxes, numBoxes, m_voxelsize, compress);
 }
 
 
@@ -0,0 +1,250 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * IncrementalReconstruction.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef INCREMENTALRECONSTRUCTION_HPP_
+#define INCREMENTALRECONSTRUCTION_HPP_
+
+#include <lvr/reconstruction/FastReconstruction.hpp>
+#include <lvr/reconstruction/AdaptiveKSearchSurface.hpp>
+#include <lvr/reconstruction/PointsetSurfaceQuery.hpp>
+#include <lvr/reconstruction/HashGrid.hpp>
+#include <lvr/reconstruction/FastBox.hpp>
+#include <lvr/geometry/HalfEdgeMesh.hpp>
+#include <lvr/io/PointBuffer.hpp>
+
+#include <boost/unordered_map.hpp>
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace lvr
+{
+
+/**
+ * @brief   Marching cubes reconstruction that is updated when new scans
+ *          are added to the point cloud.
+ *
+ *          The point normals before and after their interpolation, the
+ *          HashGrid with its distance values and the extracted HalfEdgeMesh
+ *          are kept between the passes. When new points are added, the
+ *          cells within reach of their normal estimation neighborhoods are
+ *          marked as dirty. The reach is measured with the largest
+ *          neighborhood that a normal was estimated from so far. Only the normals
+ *          of points in dirty cells and the distances of query points near
+ *          dirty cells are recalculated. Distances that change by less than
+ *          a thousandth of the voxel size keep their old value. The faces of
+ *          all cells with a changed corner are deleted from the mesh and the
+ *          cells are extracted again. Vertices on edges with unchanged
+ *          corners are shared with the surrounding mesh, vertices on changed
+ *          edges are moved, so the spliced patch stays connected.
+ *
+ *          The grid covers the bounding box of the first pass enlarged by
+ *          its longest side in every direction. If new points leave this
+ *          frame, everything is rebuilt with a new frame.
+ *
+ *          The mesh of the last pass is the raw marching cubes mesh. Post
+ *          processing has to be applied to a copy (see getMesh()), since it
+ *          would invalidate the faces referenced by the grid cells.
+ */
+template<typename VertexT, typename NormalT>
+class IncrementalReconstruction : public FastReconstructionBase<VertexT, NormalT>
+{
+public:
+
+    typedef FastBox<VertexT, NormalT>                   BoxT;
+    typedef HashGrid<VertexT, BoxT>                     GridT;
+    typedef HalfEdgeMesh<VertexT, NormalT>              MeshT;
+    typedef AdaptiveKSearchSurface<VertexT, NormalT>    SurfaceT;
+
+    /**
+     * @brief   Constructor.
+     *
+     * @param   voxelsize       Voxel size of the grid
+     * @param   searchTreeName  Search tree used by the point set surface
+     * @param   kn              Neighbors for normal estimation
+     * @param   ki              Neighbors for normal interpolation
+     * @param   kd              Neighbors for distance evaluation
+     * @param   useRansac       Use RANSAC for normal estimation
+     * @param   poseFile        Scan poses used to flip the normals
+     */
+    IncrementalReconstruction(float voxelsize,
+            std::string searchTreeName,
+            int kn = 10,
+            int ki = 10,
+            int kd = 5,
+            bool useRansac = false,
+            std::string poseFile = "");
+
+    virtual ~IncrementalReconstruction();
+
+    /**
+     * @brief   Integrates the given points and updates normals, distances
+     *          and mesh in the affected region. The first call performs a
+     *          complete reconstruction.
+     */
+    void addPoints(PointBufferPtr points);
+
+    /**
+     * @brief   Copies the current mesh into the given mesh. Vertices that
+     *          are not referenced by any face are skipped.
+     */
+    virtual void getMesh(BaseMesh<VertexT, NormalT>& mesh);
+
+    /**
+     * @brief   Returns the incrementally updated mesh
+     */
+    MeshT& mesh() { return *m_mesh; }
+
+    /**
+     * @brief   Returns a surface of all points added so far (with normals)
+     */
+    typename PointsetSurface<VertexT>::Ptr getSurface() { return m_surface; }
+
+    /**
+     * @brief   Returns the grid or 0 before the first pass
+     */
+    GridT* getGrid() { return m_grid; }
+
+    /**
+     * @brief   Writes the state to the given file. The mesh is written as
+     *          checkpoint to filename + ".hem".
+     *
+     * @return  False if a file could not be written
+     */
+    bool saveState(std::string filename);
+
+    /**
+     * @brief   Restores a state written by saveState(). The reconstruction
+     *          parameters are taken from the file.
+     *
+     * @return  False if a file could not be read
+     */
+    bool loadState(std::string filename);
+
+private:
+
+    /// Maps cell hashes to a radius in cells
+    typedef boost::unordered_map<size_t, int> CellMap;
+
+    /// Header of a state file
+    struct StateHeader
+    {
+        char        magic[8];
+        uint32_t    byteOrder;
+        uint32_t    version;
+        float       voxelsize;
+        int32_t     kn;
+        int32_t     ki;
+        int32_t     kd;
+        int32_t     normalNeighbors;
+        float       frame[6];
+        uint64_t    numPoints;
+        uint64_t    numQueryPoints;
+        uint64_t    numCells;
+        uint64_t    numFaces;
+    };
+
+    /// Intersections of a cell in a state file
+    struct StateCell
+    {
+        uint64_t    hash;
+        uint32_t    intersections[12];
+    };
+
+    /// Rounds the given value to the nearest integer value
+    static int calcIndex(float f)
+    {
+        return f < 0 ? f - .5 : f + .5;
+    }
+
+    /// Creates an empty grid and mesh for the current surface
+    void reset();
+
+    /// Removes all points, the grid and the mesh
+    void clear();
+
+    /// Returns true if the point is in the frame of the grid
+    bool inFrame(const float* p);
+
+    /// Returns the hash of the cell that contains the given point
+    size_t cellHash(const float* p);
+
+    /// Returns the hash of the given cell
+    size_t cellHash(BoxT* cell);
+
+    /// Adds the points [begin, end) to the grid
+    void insertPoints(const float* points, size_t begin, size_t end);
+
+    /// Adds the cubes of the given radii around the cells to the map
+    void dilate(CellMap& cells);
+
+    /// Calculates the distance values of the given query points and
+    /// sets the flag of all query points that changed
+    void updateDistances(const std::vector<size_t>& queryPoints, std::vector<char>& changed);
+
+    /// Replaces the faces of the given cells in the mesh
+    void extract(std::vector<BoxT*>& cells, std::vector<char>& changed);
+
+    /// Voxel size of the grid
+    float                               m_voxelsize;
+
+    /// Parameters of the point set surface
+    std::string                         m_searchTreeName;
+    int                                 m_kn;
+    int                                 m_ki;
+    int                                 m_kd;
+    bool                                m_useRansac;
+    std::string                         m_poseFile;
+
+    /// All points added so far with their normals
+    typename SurfaceT::Ptr              m_surface;
+
+    /// The normals of all points before the interpolation
+    floatArr                            m_rawNormals;
+
+    /// The largest neighborhood a normal was estimated from
+    size_t                              m_normalNeighbors;
+
+    /// The grid or 0 before the first pass
+    GridT*                              m_grid;
+
+    /// Volume covered by the grid
+    BoundingBox<VertexT>                m_frame;
+
+    /// The raw marching cubes mesh
+    MeshT*                              m_mesh;
+
+    /// The cell that created each face of m_mesh
+    std::vector<BoxT*>                  m_faceCells;
+};
+
+} // namespace lvr
+
+#include "IncrementalReconstruction.tcc"
+
+#endif /* INCREMENTALRECONSTRUCTION_HPP_ */
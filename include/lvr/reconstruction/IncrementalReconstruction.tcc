@@ -0,0 +1,871 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * IncrementalReconstruction.tcc
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/reconstruction/FastBoxTables.hpp>
+#include <lvr/io/Timestamp.hpp>
+#include <lvr/io/Progress.hpp>
+
+#include <boost/unordered_set.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace lvr
+{
+
+namespace
+{
+
+const char      INCREMENTAL_MAGIC[8]        = {'L', 'V', 'R', 'I', 'N', 'C', '\0', '\0'};
+const uint32_t  INCREMENTAL_BYTE_ORDER      = 0x01020304;
+const uint32_t  INCREMENTAL_VERSION         = 2;
+
+} // namespace
+
+template<typename VertexT, typename NormalT>
+IncrementalReconstruction<VertexT, NormalT>::IncrementalReconstruction(
+        float voxelsize,
+        std::string searchTreeName,
+        int kn,
+        int ki,
+        int kd,
+        bool useRansac,
+        std::string poseFile)
+    : m_voxelsize(voxelsize),
+      m_searchTreeName(searchTreeName),
+      m_kn(kn),
+      m_ki(ki),
+      m_kd(kd),
+      m_useRansac(useRansac),
+      m_poseFile(poseFile),
+      m_normalNeighbors(0),
+      m_grid(0),
+      m_mesh(new MeshT)
+{
+
+}
+
+template<typename VertexT, typename NormalT>
+IncrementalReconstruction<VertexT, NormalT>::~IncrementalReconstruction()
+{
+    delete m_grid;
+    delete m_mesh;
+}
+
+template<typename VertexT, typename NormalT>
+void IncrementalReconstruction<VertexT, NormalT>::reset()
+{
+    delete m_grid;
+    delete m_mesh;
+
+    m_grid = new GridT(m_voxelsize, m_frame, true, true);
+    m_mesh = new MeshT;
+    m_faceCells.clear();
+}
+
+template<typename VertexT, typename NormalT>
+void IncrementalReconstruction<VertexT, NormalT>::clear()
+{
+    delete m_grid;
+    delete m_mesh;
+
+    m_grid = 0;
+    m_mesh = new MeshT;
+    m_faceCells.clear();
+    m_surface.reset();
+    m_rawNormals.reset();
+    m_normalNeighbors = 0;
+}
+
+template<typename VertexT, typename NormalT>
+bool IncrementalReconstruction<VertexT, NormalT>::inFrame(const float* p)
+{
+    // Keep some cells to the border for the extrusion of the grid
+    VertexT min = m_frame.getMin();
+    VertexT max = m_frame.getMax();
+    float border = 2 * m_voxelsize;
+    for(int j = 0; j < 3; j++)
+    {
+        if(p[j] < min[j] + border || p[j] > max[j] - border)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename VertexT, typename NormalT>
+size_t IncrementalReconstruction<VertexT, NormalT>::cellHash(const float* p)
+{
+    VertexT min = m_grid->getBoundingBox().getMin();
+    return m_grid->hashValue(
+            calcIndex((p[0] - min[0]) / m_voxelsize),
+            calcIndex((p[1] - min[1]) / m_voxelsize),
+            calcIndex((p[2] - min[2]) / m_voxelsize));
+}
+
+template<typename VertexT, typename NormalT>
+size_t IncrementalReconstruction<VertexT, NormalT>::cellHash(BoxT* cell)
+{
+    VertexT center = cell->getCenter();
+    float p[3] = {center[0], center[1], center[2]};
+    return cellHash(p);
+}
+
+template<typename VertexT, typename NormalT>
+void IncrementalReconstruction<VertexT, NormalT>::insertPoints(const float* points, size_t begin, size_t end)
+{
+    VertexT min = m_grid->getBoundingBox().getMin();
+    for(size_t i = begin; i < end; i++)
+    {
+        m_grid->addLatticePoint(
+                calcIndex((points[3 * i]     - min[0]) / m_voxelsize),
+                calcIndex((points[3 * i + 1] - min[1]) / m_voxelsize),
+                calcIndex((points[3 * i + 2] - min[2]) / m_voxelsize));
+    }
+}
+
+template<typename VertexT, typename NormalT>
+void IncrementalReconstruction<VertexT, NormalT>::dilate(CellMap& cells)
+{
+    // A cube is dilated by growing it along each axis separately
+    const long maxIndex = m_grid->getMaxIndex();
+    for(int axis = 0; axis < 3; axis++)
+    {
+        CellMap next;
+        for(typename CellMap::iterator it = cells.begin(); it != cells.end(); it++)
+        {
+            long c[3];
+            c[0] = it->first / (maxIndex * maxIndex);
+            c[1] = (it->first / maxIndex) % maxIndex;
+            c[2] = it->first % maxIndex;
+
+            int r = it->second;
+            long center = c[axis];
+            for(long v = center - r; v <= center + r; v++)
+            {
+                if(v < 0 || v >= maxIndex)
+                {
+                    continue;
+                }
+
+                c[axis] = v;
+                std::pair<typename CellMap::iterator, bool> res =
+                        next.insert(std::make_pair(m_grid->hashValue(c[0], c[1], c[2]), r));
+                if(!res.second && res.first->second < r)
+                {
+                    res.first->second = r;
+                }
+            }
+        }
+        cells.swap(next);
+    }
+}
+
+template<typename VertexT, typename NormalT>
+void IncrementalReconstruction<VertexT, NormalT>::addPoints(PointBufferPtr points)
+{
+    size_t n;
+    floatArr newPoints = points->getPointArray(n);
+    if(n == 0)
+    {
+        return;
+    }
+
+    // Merge the old and new points. The old normals are kept.
+    size_t first = 0;
+    floatArr oldPoints;
+    floatArr oldNormals;
+    if(m_surface)
+    {
+        size_t numNormals;
+        oldPoints = m_surface->pointBuffer()->getPointArray(first);
+        oldNormals = m_surface->pointBuffer()->getPointNormalArray(numNormals);
+    }
+
+    size_t numPoints = first + n;
+    floatArr merged(new float[3 * numPoints]);
+    floatArr normals(new float[3 * numPoints]);
+    floatArr rawNormals(new float[3 * numPoints]);
+    if(first)
+    {
+        std::copy(oldPoints.get(), oldPoints.get() + 3 * first, merged.get());
+        std::copy(oldNormals.get(), oldNormals.get() + 3 * first, normals.get());
+        std::copy(m_rawNormals.get(), m_rawNormals.get() + 3 * first, rawNormals.get());
+    }
+    std::copy(newPoints.get(), newPoints.get() + 3 * n, merged.get() + 3 * first);
+    std::fill(normals.get() + 3 * first, normals.get() + 3 * numPoints, 0.0f);
+    std::fill(rawNormals.get() + 3 * first, rawNormals.get() + 3 * numPoints, 0.0f);
+    m_rawNormals = rawNormals;
+
+    PointBufferPtr buffer(new PointBuffer);
+    buffer->setPointArray(merged, numPoints);
+    buffer->setPointNormalArray(normals, numPoints);
+
+    // Everything is rebuilt if the new points leave the grid
+    bool rebuild = (m_grid == 0);
+    for(size_t i = 0; i < n && !rebuild; i++)
+    {
+        if(!inFrame(newPoints.get() + 3 * i))
+        {
+            cout << timestamp << "New points are outside of the grid. Rebuilding." << endl;
+            rebuild = true;
+        }
+    }
+
+    m_surface = typename SurfaceT::Ptr(new SurfaceT(buffer, m_searchTreeName, m_kn, m_ki, m_kd, m_useRansac, m_poseFile));
+
+    if(rebuild)
+    {
+        BoundingBox<VertexT>& bb = m_surface->getBoundingBox();
+        VertexT min = bb.getMin();
+        VertexT max = bb.getMax();
+        float margin = std::max(bb.getLongestSide(), 10 * m_voxelsize);
+
+        m_frame = BoundingBox<VertexT>();
+        m_frame.expand(min[0] - margin, min[1] - margin, min[2] - margin);
+        m_frame.expand(max[0] + margin, max[1] + margin, max[2] + margin);
+        reset();
+        first = 0;
+    }
+
+    // Update the normals of all points whose neighborhood may contain
+    // new points
+    CellMap dirtyCells;
+    std::vector<size_t> indices;
+    if(first == 0)
+    {
+        // The raw normals are kept, so all points are updated
+        // instead of calculating the normals from scratch
+        indices.resize(numPoints);
+        for(size_t i = 0; i < numPoints; i++)
+        {
+            indices[i] = i;
+        }
+        m_normalNeighbors = 0;
+    }
+    else
+    {
+        // The normal of a point changes if a new point is within its
+        // neighborhood, the interpolated normal changes if such a point
+        // is within its interpolation neighborhood. Both are estimated by
+        // the size of the new points' neighborhoods. Normal estimation
+        // grows degenerated neighborhoods up to 32 * kn points, so the
+        // largest neighborhood used so far is searched.
+        std::vector<std::pair<size_t, int> > reach(n);
+        int k = std::max((int)m_normalNeighbors, std::max(2 * m_kn, m_ki));
+
+        PointsetSurfaceQuery<VertexT> query(m_surface->searchTree());
+
+        #pragma omp parallel
+        {
+            typename PointsetSurfaceQuery<VertexT>::Context ctx;
+            const std::vector<int>& id = ctx.indices;
+
+            #pragma omp for schedule(static)
+            for(long i = 0; i < (long)n; i++)
+            {
+                float* p = merged.get() + 3 * (first + i);
+                query.kSearch(VertexT(p[0], p[1], p[2]), k, ctx);
+
+                float r2 = 0.0f;
+                for(size_t j = 0; j < id.size(); j++)
+                {
+                    float* q = merged.get() + 3 * id[j];
+                    float dx = q[0] - p[0];
+                    float dy = q[1] - p[1];
+                    float dz = q[2] - p[2];
+                    r2 = std::max(r2, dx * dx + dy * dy + dz * dz);
+                }
+                reach[i] = std::make_pair(cellHash(p), (int)ceil(2 * sqrt(r2) / m_voxelsize));
+            }
+        }
+
+        // Sorted pairs are ordered by reach within a cell
+        std::sort(reach.begin(), reach.end());
+        for(size_t i = 0; i < n; i++)
+        {
+            if(i + 1 == n || reach[i].first != reach[i + 1].first)
+            {
+                dirtyCells[reach[i].first] = reach[i].second;
+            }
+        }
+        dilate(dirtyCells);
+
+        std::vector<char> dirty(first, 0);
+
+        #pragma omp parallel for schedule(static)
+        for(long i = 0; i < (long)first; i++)
+        {
+            dirty[i] = dirtyCells.find(cellHash(merged.get() + 3 * i)) != dirtyCells.end();
+        }
+
+        for(size_t i = 0; i < first; i++)
+        {
+            if(dirty[i])
+            {
+                indices.push_back(i);
+            }
+        }
+        for(size_t i = first; i < numPoints; i++)
+        {
+            indices.push_back(i);
+        }
+
+        cout << timestamp << "Updating normals of " << indices.size() << " of " << numPoints << " points." << endl;
+    }
+    m_surface->calculateSurfaceNormals(indices, m_rawNormals);
+    m_normalNeighbors = std::max(m_normalNeighbors, m_surface->getMaxNormalNeighbors());
+
+    // Remember the cells that do not exist yet and insert the new points
+    std::vector<size_t> newHashes;
+    {
+        VertexT min = m_grid->getBoundingBox().getMin();
+        for(size_t i = first; i < numPoints; i++)
+        {
+            const float* p = merged.get() + 3 * i;
+            int x = calcIndex((p[0] - min[0]) / m_voxelsize);
+            int y = calcIndex((p[1] - min[1]) / m_voxelsize);
+            int z = calcIndex((p[2] - min[2]) / m_voxelsize);
+            for(int j = 0; j < 8; j++)
+            {
+                size_t h = m_grid->hashValue(x + HGCreateTable[j][0], y + HGCreateTable[j][1], z + HGCreateTable[j][2]);
+                if(!m_grid->getCell(h))
+                {
+                    newHashes.push_back(h);
+                }
+            }
+        }
+        std::sort(newHashes.begin(), newHashes.end());
+        newHashes.erase(std::unique(newHashes.begin(), newHashes.end()), newHashes.end());
+    }
+
+    std::vector<QueryPoint<VertexT> >& qp = m_grid->getQueryPoints();
+    size_t numQueryPoints = qp.size();
+    insertPoints(merged.get(), first, numPoints);
+
+    // New query points always count as changed
+    std::vector<char> changed(qp.size(), 0);
+    std::fill(changed.begin() + numQueryPoints, changed.end(), 1);
+
+    // Calculate the distances of query points near the dirty cells and
+    // collect the cells that have a changed corner
+    std::vector<BoxT*> cells;
+    if(first == 0)
+    {
+        std::vector<size_t> queryPoints(qp.size());
+        for(size_t i = 0; i < qp.size(); i++)
+        {
+            queryPoints[i] = i;
+        }
+        updateDistances(queryPoints, changed);
+
+        std::vector<std::pair<size_t, BoxT*> > sorted;
+        sorted.reserve(m_grid->getNumberOfCells());
+        for(typename GridT::box_map_it it = m_grid->firstCell(); it != m_grid->lastCell(); it++)
+        {
+            sorted.push_back(std::make_pair(it->first, it->second));
+        }
+        std::sort(sorted.begin(), sorted.end());
+        for(size_t i = 0; i < sorted.size(); i++)
+        {
+            cells.push_back(sorted[i].second);
+        }
+    }
+    else
+    {
+        // Distances are evaluated with the normals of the nearest
+        // points, so the query points next to dirty cells are included
+        CellMap candidates = dirtyCells;
+        for(typename CellMap::iterator it = candidates.begin(); it != candidates.end(); it++)
+        {
+            it->second = 1;
+        }
+        dilate(candidates);
+
+        std::vector<BoxT*> candidateCells;
+        for(typename CellMap::iterator it = candidates.begin(); it != candidates.end(); it++)
+        {
+            BoxT* cell = m_grid->getCell(it->first);
+            if(cell)
+            {
+                candidateCells.push_back(cell);
+            }
+        }
+        for(size_t i = 0; i < newHashes.size(); i++)
+        {
+            if(candidates.find(newHashes[i]) == candidates.end())
+            {
+                candidateCells.push_back(m_grid->getCell(newHashes[i]));
+            }
+        }
+
+        std::vector<char> selected(qp.size(), 0);
+        for(size_t i = 0; i < candidateCells.size(); i++)
+        {
+            for(int j = 0; j < 8; j++)
+            {
+                selected[candidateCells[i]->getVertex(j)] = 1;
+            }
+        }
+
+        std::vector<size_t> queryPoints;
+        for(size_t i = 0; i < qp.size(); i++)
+        {
+            if(selected[i] || changed[i])
+            {
+                queryPoints.push_back(i);
+            }
+        }
+        updateDistances(queryPoints, changed);
+
+        // All cells that share a changed query point are neighbors of
+        // a candidate cell
+        boost::unordered_set<BoxT*> visited;
+        std::vector<std::pair<size_t, BoxT*> > sorted;
+        for(size_t i = 0; i < candidateCells.size(); i++)
+        {
+            for(int j = 0; j < 27; j++)
+            {
+                BoxT* cell = (j == 13) ? candidateCells[i] : candidateCells[i]->getNeighbor(j);
+                if(!cell || !visited.insert(cell).second)
+                {
+                    continue;
+                }
+
+                for(int c = 0; c < 8; c++)
+                {
+                    if(changed[cell->getVertex(c)])
+                    {
+                        sorted.push_back(std::make_pair(cellHash(cell), cell));
+                        break;
+                    }
+                }
+            }
+        }
+        std::sort(sorted.begin(), sorted.end());
+        for(size_t i = 0; i < sorted.size(); i++)
+        {
+            cells.push_back(sorted[i].second);
+        }
+    }
+
+    cout << timestamp << "Extracting " << cells.size() << " of " << m_grid->getNumberOfCells() << " cells." << endl;
+    extract(cells, changed);
+}
+
+template<typename VertexT, typename NormalT>
+void IncrementalReconstruction<VertexT, NormalT>::updateDistances(
+        const std::vector<size_t>& queryPoints, std::vector<char>& changed)
+{
+    std::vector<QueryPoint<VertexT> >& qp = m_grid->getQueryPoints();
+
+    // Smaller changes are ignored, so the mesh is only touched
+    // where the surface actually moved
+    const float epsilon = 0.001f * m_voxelsize;
+
+    string comment = timestamp.getElapsedTime() + "Calculating distance values ";
+    ProgressBar progress(queryPoints.size(), comment);
+
+    PointsetSurfaceQuery<VertexT> query(m_surface);
+
+    #pragma omp parallel
+    {
+        typename PointsetSurfaceQuery<VertexT>::Context ctx;
+
+        #pragma omp for schedule(static)
+        for(long i = 0; i < (long)queryPoints.size(); i++)
+        {
+            size_t q = queryPoints[i];
+
+            float projectedDistance;
+            float euklideanDistance;
+            query.distance(qp[q].m_position, projectedDistance, euklideanDistance, ctx);
+
+            bool invalid = euklideanDistance > 1.7320 * m_voxelsize;
+            if(changed[q]
+               || invalid != qp[q].m_invalid
+               || fabs(projectedDistance - qp[q].m_distance) > epsilon)
+            {
+                qp[q].m_distance = projectedDistance;
+                qp[q].m_invalid = invalid;
+                changed[q] = 1;
+            }
+            ++progress;
+        }
+    }
+    cout << endl;
+}
+
+template<typename VertexT, typename NormalT>
+void IncrementalReconstruction<VertexT, NormalT>::extract(std::vector<BoxT*>& cells, std::vector<char>& changed)
+{
+    typedef typename MeshT::FacePtr FacePtr;
+
+    const uint INVALID = BoxT::INVALID_INDEX;
+    std::vector<QueryPoint<VertexT> >& qp = m_grid->getQueryPoints();
+
+    // Delete the old faces of the cells
+    boost::unordered_set<BoxT*> cellSet(cells.begin(), cells.end());
+    typename MeshT::FaceVector& faces = m_mesh->getFaces();
+    std::vector<FacePtr> deleted;
+    size_t numKept = 0;
+    for(size_t i = 0; i < faces.size(); i++)
+    {
+        if(cellSet.count(m_faceCells[i]))
+        {
+            deleted.push_back(faces[i]);
+        }
+        else
+        {
+            m_faceCells[numKept++] = m_faceCells[i];
+        }
+    }
+    m_faceCells.resize(numKept);
+    m_mesh->deleteFaces(deleted);
+
+    typename MeshT::VertexVector& vertices = m_mesh->getVertices();
+    for(size_t i = 0; i < cells.size(); i++)
+    {
+        BoxT* cell = cells[i];
+
+        // New cells take the vertices of shared edges from their neighbors
+        for(int e = 0; e < 12; e++)
+        {
+            for(int j = 0; j < 3 && cell->m_intersections[e] == INVALID; j++)
+            {
+                BoxT* neighbor = cell->m_neighbors[neighbor_table[e][j]];
+                if(neighbor)
+                {
+                    cell->m_intersections[e] = neighbor->m_intersections[neighbor_vertex_table[e][j]];
+                }
+            }
+        }
+
+        // Existing vertices on changed edges are moved. This is done
+        // before extraction, so the new faces get correct normals.
+        bool valid = true;
+        for(int c = 0; c < 8; c++)
+        {
+            valid = valid && !qp[cell->m_vertices[c]].m_invalid;
+        }
+        if(!valid)
+        {
+            continue;
+        }
+
+        VertexT corners[8];
+        VertexT positions[12];
+        float distances[8];
+        cell->getCorners(corners, qp);
+        cell->getDistances(distances, qp);
+        cell->getIntersections(corners, distances, positions);
+
+        for(int e = 0; e < 12; e++)
+        {
+            int a = vertex_edge_table[e][0];
+            int b = vertex_edge_table[e][1];
+            if(cell->m_intersections[e] == INVALID
+               || (distances[a] > 0) == (distances[b] > 0)
+               || !(changed[cell->m_vertices[a]] || changed[cell->m_vertices[b]]))
+            {
+                continue;
+            }
+            vertices[cell->m_intersections[e]]->m_position = positions[e];
+        }
+    }
+
+    // Extract the cells
+    string comment = timestamp.getElapsedTime() + "Creating Mesh ";
+    ProgressBar progress(cells.size(), comment);
+
+    uint globalIndex = m_mesh->meshSize();
+    for(size_t i = 0; i < cells.size(); i++)
+    {
+        size_t numFaces = faces.size();
+        cells[i]->getSurface(*m_mesh, qp, globalIndex);
+        m_faceCells.insert(m_faceCells.end(), faces.size() - numFaces, cells[i]);
+        if(!timestamp.isQuiet())
+            ++progress;
+    }
+
+    if(!timestamp.isQuiet())
+        cout << endl;
+}
+
+template<typename VertexT, typename NormalT>
+void IncrementalReconstruction<VertexT, NormalT>::getMesh(BaseMesh<VertexT, NormalT>& mesh)
+{
+    typename MeshT::VertexVector& vertices = m_mesh->getVertices();
+    typename MeshT::FaceVector& faces = m_mesh->getFaces();
+
+    for(size_t i = 0; i < vertices.size(); i++)
+    {
+        vertices[i]->m_actIndex = i;
+    }
+
+    // Skip vertices of deleted faces
+    std::vector<uint> index(vertices.size(), BoxT::INVALID_INDEX);
+    for(size_t i = 0; i < faces.size(); i++)
+    {
+        for(int k = 0; k < 3; k++)
+        {
+            index[(*faces[i])(k)->m_actIndex] = 0;
+        }
+    }
+
+    uint globalIndex = mesh.meshSize();
+    for(size_t i = 0; i < vertices.size(); i++)
+    {
+        if(index[i] != BoxT::INVALID_INDEX)
+        {
+            index[i] = globalIndex++;
+            mesh.addVertex(vertices[i]->m_position);
+            mesh.addNormal(NormalT());
+        }
+    }
+
+    for(size_t i = 0; i < faces.size(); i++)
+    {
+        mesh.addTriangle(
+                index[(*faces[i])(0)->m_actIndex],
+                index[(*faces[i])(1)->m_actIndex],
+                index[(*faces[i])(2)->m_actIndex]);
+    }
+}
+
+template<typename VertexT, typename NormalT>
+bool IncrementalReconstruction<VertexT, NormalT>::saveState(std::string filename)
+{
+    if(!m_surface)
+    {
+        return false;
+    }
+
+    std::ofstream out(filename.c_str(), std::ios::binary);
+    if(!out.good())
+    {
+        cout << timestamp << "Unable to write reconstruction state '" << filename << "'." << endl;
+        return false;
+    }
+
+    cout << timestamp << "Writing reconstruction state '" << filename << "'." << endl;
+
+    size_t numPoints;
+    size_t numNormals;
+    floatArr points = m_surface->pointBuffer()->getPointArray(numPoints);
+    floatArr normals = m_surface->pointBuffer()->getPointNormalArray(numNormals);
+    std::vector<QueryPoint<VertexT> >& qp = m_grid->getQueryPoints();
+    typename MeshT::FaceVector& faces = m_mesh->getFaces();
+
+    StateHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, INCREMENTAL_MAGIC, sizeof(header.magic));
+    header.byteOrder = INCREMENTAL_BYTE_ORDER;
+    header.version = INCREMENTAL_VERSION;
+    header.voxelsize = m_voxelsize;
+    header.kn = m_kn;
+    header.ki = m_ki;
+    header.kd = m_kd;
+    header.normalNeighbors = m_normalNeighbors;
+    for(int j = 0; j < 3; j++)
+    {
+        header.frame[j] = m_frame.getMin()[j];
+        header.frame[j + 3] = m_frame.getMax()[j];
+    }
+    header.numPoints = numPoints;
+    header.numQueryPoints = qp.size();
+    header.numCells = m_grid->getNumberOfCells();
+    header.numFaces = faces.size();
+    out.write((const char*)&header, sizeof(header));
+
+    out.write((const char*)points.get(), 3 * numPoints * sizeof(float));
+    out.write((const char*)normals.get(), 3 * numPoints * sizeof(float));
+    out.write((const char*)m_rawNormals.get(), 3 * numPoints * sizeof(float));
+
+    // Query point positions and cells are restored by inserting the points
+    std::vector<float> distances(qp.size());
+    std::vector<uint8_t> invalid(qp.size());
+    for(size_t i = 0; i < qp.size(); i++)
+    {
+        distances[i] = qp[i].m_distance;
+        invalid[i] = qp[i].m_invalid;
+    }
+    out.write((const char*)distances.data(), distances.size() * sizeof(float));
+    out.write((const char*)invalid.data(), invalid.size());
+
+    std::vector<StateCell> cells;
+    cells.reserve(m_grid->getNumberOfCells());
+    for(typename GridT::box_map_it it = m_grid->firstCell(); it != m_grid->lastCell(); it++)
+    {
+        StateCell cell;
+        cell.hash = it->first;
+        memcpy(cell.intersections, it->second->m_intersections, sizeof(cell.intersections));
+        cells.push_back(cell);
+    }
+    out.write((const char*)cells.data(), cells.size() * sizeof(StateCell));
+
+    std::vector<uint64_t> faceCells(m_faceCells.size());
+    for(size_t i = 0; i < m_faceCells.size(); i++)
+    {
+        faceCells[i] = cellHash(m_faceCells[i]);
+    }
+    out.write((const char*)faceCells.data(), faceCells.size() * sizeof(uint64_t));
+
+    if(!out.good())
+    {
+        cout << timestamp << "Unable to write reconstruction state '" << filename << "'." << endl;
+        return false;
+    }
+    out.close();
+
+    return m_mesh->saveCheckpoint(filename + ".hem", "incremental");
+}
+
+template<typename VertexT, typename NormalT>
+bool IncrementalReconstruction<VertexT, NormalT>::loadState(std::string filename)
+{
+    std::ifstream in(filename.c_str(), std::ios::binary);
+
+    StateHeader header;
+    if(!in.read((char*)&header, sizeof(header))
+       || memcmp(header.magic, INCREMENTAL_MAGIC, sizeof(header.magic)) != 0
+       || header.byteOrder != INCREMENTAL_BYTE_ORDER
+       || header.version != INCREMENTAL_VERSION)
+    {
+        cout << timestamp << "'" << filename << "' is no reconstruction state." << endl;
+        return false;
+    }
+
+    // Check the counts against the file size before anything is
+    // allocated. Every single size is bounded by the file size, so
+    // their sum does not overflow.
+    in.seekg(0, std::ios::end);
+    uint64_t available = (uint64_t)in.tellg() - sizeof(header);
+    in.seekg(sizeof(header));
+
+    const uint64_t pointSize = 9 * sizeof(float);
+    const uint64_t queryPointSize = sizeof(float) + sizeof(uint8_t);
+    if(header.kn <= 0 || header.ki < 0 || header.kd <= 0 || header.normalNeighbors < 0
+       || header.numPoints > available / pointSize
+       || header.numQueryPoints > available / queryPointSize
+       || header.numCells > available / sizeof(StateCell)
+       || header.numFaces > available / sizeof(uint64_t)
+       || header.numPoints * pointSize + header.numQueryPoints * queryPointSize
+          + header.numCells * sizeof(StateCell) + header.numFaces * sizeof(uint64_t) != available)
+    {
+        cout << timestamp << "Reconstruction state '" << filename << "' is corrupt or truncated." << endl;
+        return false;
+    }
+
+    cout << timestamp << "Loading reconstruction state '" << filename << "'." << endl;
+
+    m_voxelsize = header.voxelsize;
+    m_kn = header.kn;
+    m_ki = header.ki;
+    m_kd = header.kd;
+
+    size_t numPoints = header.numPoints;
+    floatArr points(new float[3 * numPoints]);
+    floatArr normals(new float[3 * numPoints]);
+    floatArr rawNormals(new float[3 * numPoints]);
+    in.read((char*)points.get(), 3 * numPoints * sizeof(float));
+    in.read((char*)normals.get(), 3 * numPoints * sizeof(float));
+    in.read((char*)rawNormals.get(), 3 * numPoints * sizeof(float));
+
+    std::vector<float> distances(header.numQueryPoints);
+    std::vector<uint8_t> invalid(header.numQueryPoints);
+    std::vector<StateCell> cells(header.numCells);
+    std::vector<uint64_t> faceCells(header.numFaces);
+    in.read((char*)distances.data(), distances.size() * sizeof(float));
+    in.read((char*)invalid.data(), invalid.size());
+    in.read((char*)cells.data(), cells.size() * sizeof(StateCell));
+    in.read((char*)faceCells.data(), faceCells.size() * sizeof(uint64_t));
+    if(!in.good())
+    {
+        cout << timestamp << "Reconstruction state '" << filename << "' is truncated." << endl;
+        return false;
+    }
+
+    PointBufferPtr buffer(new PointBuffer);
+    buffer->setPointArray(points, numPoints);
+    buffer->setPointNormalArray(normals, numPoints);
+    m_surface = typename SurfaceT::Ptr(new SurfaceT(buffer, m_searchTreeName, m_kn, m_ki, m_kd, m_useRansac, m_poseFile));
+    m_rawNormals = rawNormals;
+    m_normalNeighbors = header.normalNeighbors;
+
+    // The points were inserted in this order, so the grid is
+    // recreated with the same query point indices
+    m_frame = BoundingBox<VertexT>();
+    m_frame.expand(header.frame[0], header.frame[1], header.frame[2]);
+    m_frame.expand(header.frame[3], header.frame[4], header.frame[5]);
+    reset();
+    insertPoints(points.get(), 0, numPoints);
+
+    std::vector<QueryPoint<VertexT> >& qp = m_grid->getQueryPoints();
+    if(qp.size() != distances.size() || m_grid->getNumberOfCells() != cells.size())
+    {
+        cout << timestamp << "Grid of reconstruction state '" << filename << "' does not match its points." << endl;
+        clear();
+        return false;
+    }
+
+    for(size_t i = 0; i < qp.size(); i++)
+    {
+        qp[i].m_distance = distances[i];
+        qp[i].m_invalid = invalid[i];
+    }
+
+    for(size_t i = 0; i < cells.size(); i++)
+    {
+        BoxT* cell = m_grid->getCell(cells[i].hash);
+        if(cell)
+        {
+            memcpy(cell->m_intersections, cells[i].intersections, sizeof(cells[i].intersections));
+        }
+    }
+
+    if(!m_mesh->loadCheckpoint(filename + ".hem") || m_mesh->getFaces().size() != faceCells.size())
+    {
+        cout << timestamp << "Unable to restore the mesh of reconstruction state '" << filename << "'." << endl;
+        clear();
+        return false;
+    }
+
+    m_faceCells.resize(faceCells.size());
+    for(size_t i = 0; i < faceCells.size(); i++)
+    {
+        m_faceCells[i] = m_grid->getCell(faceCells[i]);
+    }
+
+    return true;
+}
+
+} // namespace lvr
@@ -4,7 +4,7 @@
 
 #include "lvr/geometry/LBPointArray.hpp"
 
-#include <ctpl.h>
+#include "lvr/config/TaskScheduler.hpp"
 
 #include <stdlib.h>
 #include <math.h>
@@ -22,7 +22,14 @@ namespace lvr
 class LBKdTree {
 public:
 
-    LBKdTree( LBPointArray<float>& vertices , int num_threads=8);
+    /**
+     * @brief   Builds the tree. The sub trees are generated in parallel
+     *          on the shared task scheduler.
+     *
+     * @param   num_threads     Number of parallel sub trees. If 0, the
+     *                          thread count of the scheduler is used.
+     */
+    LBKdTree( LBPointArray<float>& vertices , int num_threads=0);
 
     void generateKdTree( LBPointArray<float>& vertices );
 
@@ -42,19 +49,15 @@ private:
     
     // Static member
 
-    static int st_num_threads;
-    static int st_depth_threads;
-
-    static ctpl::thread_pool *pool;
+    /// Depth up to which the sub trees are generated in parallel tasks
+    int m_depth_threads;
 
     static void fillCriticalIndices(const LBPointArray<float>& V, LBPointArray<unsigned int>& sorted_indices, unsigned int current_dim,
              float split_value, unsigned int split_index,
              std::list<unsigned int>& critical_indices_left, std::list<unsigned int>& critical_indices_right);
 
 
-    static void generateKdTreeRecursive(int id, LBPointArray<float>& V, LBPointArray<unsigned int>* sorted_indices, int current_dim, int max_dim, LBPointArray<float> *values, LBPointArray<unsigned char> *splits, int size, int max_tree_depth, int position, int current_depth);
-
-    static void test(int id, LBPointArray<float>* sorted_indices);
+    static void generateKdTreeRecursive(LBPointArray<float>& V, LBPointArray<unsigned int>* sorted_indices, int current_dim, int max_dim, LBPointArray<float> *values, LBPointArray<unsigned char> *splits, int size, int max_tree_depth, int position, int current_depth, int depth_threads);
     
 
 };
@@ -30,6 +30,7 @@
 
 #include <opencv/cv.h>
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 using std::vector;
@@ -134,7 +135,8 @@ public:
             CoordinateSystem system = NATIVE);
 
     ///
-    /// \brief Writes the scan panaroma to an pgm file
+    /// \brief Writes the scan panaroma to an pgm file. The file is written
+    ///        as binary PGM (P5), earlier versions wrote ASCII PGM (P2).
     ///
     /// \param filename     Filename of the bitmap
     /// \param cutoff       Max range cutoff. Reduce this to enhance contrast on
@@ -142,6 +144,13 @@ public:
     ///
     void writePGM(string filename, float cutoff);
 
+    ///
+    /// \brief Writes the unscaled ranges of the scan panorama to a PFM file
+    ///
+    /// \param filename     Filename of the float image
+    ///
+    void writePFM(string filename);
+
     /// Destructor
 	virtual ~ModelToImage();
 
@@ -0,0 +1,127 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * NormalOrientation.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef NORMALORIENTATION_HPP_
+#define NORMALORIENTATION_HPP_
+
+#include <lvr/reconstruction/SearchTree.hpp>
+#include <lvr/reconstruction/PointsetSurfaceQuery.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace lvr
+{
+
+/**
+ * @brief   Orients normals consistently by propagating the orientation
+ *          along a minimum spanning tree of the Riemannian graph (Hoppe et
+ *          al. 1992).
+ *
+ *          The graph connects every point with its k nearest neighbors,
+ *          the weight of an edge is 1 - |n_i * n_j|, so the orientation is
+ *          preferably propagated between nearly parallel normals. The MST
+ *          is computed with a parallel Borůvka algorithm on a
+ *          ConcurrentUnionFind. Ties are broken by the edge index, so the
+ *          tree does not depend on the number of threads.
+ *
+ *          Every connected component of the graph is traversed from the
+ *          point whose normal points most clearly away from its viewpoint.
+ *          This root is oriented away from its viewpoint. The viewpoint is
+ *          also used for edges whose normals are nearly perpendicular,
+ *          where the propagation is ambiguous. The convention matches
+ *          the viewpoint flipping in AdaptiveKSearchSurface.
+ *
+ * @param   points      Interlaced point array (x, y, z)
+ * @param   normals     Interlaced normal array. Normals are flipped in place.
+ * @param   numPoints   Number of points
+ * @param   neighbors   Indices of the k nearest neighbors of every point.
+ *                      Negative indices and the point itself are ignored.
+ * @param   k           Number of neighbors per point
+ * @param   viewpoints  Optional viewpoint (e.g., the scan origin) for every
+ *                      point (x, y, z). If null, the roots keep their
+ *                      orientation and no tie breaking is done.
+ * @return  The number of flipped normals
+ */
+size_t orientNormalsMST(
+        const float* points,
+        float* normals,
+        size_t numPoints,
+        const int* neighbors,
+        size_t k,
+        const float* viewpoints);
+
+/**
+ * @brief   Searches the k nearest neighbors of all points in parallel with
+ *          the given search tree and orients the normals as described
+ *          above. Searches of trees that are not thread safe are
+ *          serialized (see PointsetSurfaceQuery).
+ */
+template<typename VertexT>
+size_t orientNormalsMST(
+        typename SearchTree<VertexT>::Ptr tree,
+        const float* points,
+        float* normals,
+        size_t numPoints,
+        size_t k,
+        const float* viewpoints)
+{
+    if(numPoints == 0 || k == 0)
+    {
+        return 0;
+    }
+
+    std::vector<int> neighbors(numPoints * k, -1);
+    PointsetSurfaceQuery<VertexT> query(tree);
+
+    #pragma omp parallel
+    {
+        typename PointsetSurfaceQuery<VertexT>::Context ctx;
+        const std::vector<int>& id = ctx.indices;
+
+        #pragma omp for schedule(dynamic, 1024)
+        for(long i = 0; i < (long)numPoints; i++)
+        {
+            // The point itself is found, too
+            query.kSearch(VertexT(points[3 * i], points[3 * i + 1], points[3 * i + 2]), k + 1, ctx);
+
+            size_t c = 0;
+            for(size_t j = 0; j < id.size() && c < k; j++)
+            {
+                if(id[j] != i)
+                {
+                    neighbors[i * k + c++] = id[j];
+                }
+            }
+        }
+    }
+
+    return orientNormalsMST(points, normals, numPoints, &neighbors[0], k, viewpoints);
+}
+
+} // namespace lvr
+
+#endif /* NORMALORIENTATION_HPP_ */
@@ -0,0 +1,186 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * OctreeGrid.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef OCTREEGRID_HPP_
+#define OCTREEGRID_HPP_
+
+#include <lvr/geometry/BoundingBox.hpp>
+#include <lvr/reconstruction/PointsetSurface.hpp>
+#include <lvr/reconstruction/PointsetSurfaceQuery.hpp>
+
+#include <stdint.h>
+#include <vector>
+
+namespace lvr
+{
+
+/**
+ * @brief   Adaptive octree lattice for multi-resolution marching cubes.
+ *
+ *          In contrast to the HashGrid, whose cells all have the same
+ *          size, the octree is refined by the local point density and
+ *          surface curvature. A node that contains points is split until it
+ *          is not larger than a maximum leaf size. Smaller leaves are only
+ *          created if the node contains enough points and the normals of
+ *          the points vary, i.e., 1 - |mean normal| exceeds a threshold.
+ *          Flat or sparsely sampled regions are thus represented by a few
+ *          large leaves, curved regions by leaves of the given voxel size.
+ *          Empty leaves next to a leaf with points are split to the size of
+ *          that leaf, so the surface is sampled on both sides with the same
+ *          resolution.
+ *
+ *          The signed distance is evaluated at the centers of the leaves,
+ *          which are the corners of the dual grid that is polygonized by
+ *          the DualOctreeReconstruction. The euclidean distance to the
+ *          points is stored as well, since the reliability of a distance
+ *          value depends on the size of the dual cell it is used in.
+ */
+template<typename VertexT, typename NormalT>
+class OctreeGrid
+{
+public:
+
+    /// A node of the octree
+    struct Node
+    {
+        /// Index of the first of the eight children or -1 for leaves. The
+        /// bits of the child index are the x, y, z half of the child.
+        int32_t     children;
+
+        /// Side length in voxels (a power of two)
+        uint32_t    size;
+
+        /// Minimum corner in voxels
+        int32_t     x, y, z;
+
+        /// Range of the node's points in the point index array
+        uint32_t    begin, end;
+
+        /// Signed distance at the center (leaves only)
+        float       distance;
+
+        /// Distance of the center to the nearest point (leaves only)
+        float       euklidean;
+    };
+
+    /**
+     * @brief   Constructor. Builds the octree.
+     *
+     * @param   cellSize        Voxel size (size of the smallest leaves) or
+     *                          number of intersections
+     * @param   surface         Point set surface with normals
+     * @param   bb              Bounding box of the points
+     * @param   isVoxelsize     If true, cellSize is a voxel size
+     * @param   levels          The largest leaves that contain points have
+     *                          a size of 2^levels voxels
+     * @param   curvature       Leaves whose normals vary more than this
+     *                          threshold are split
+     * @param   minPoints       Leaves with less points are not split below
+     *                          the largest leaf size
+     */
+    OctreeGrid(
+            float cellSize,
+            typename PointsetSurface<VertexT>::Ptr surface,
+            BoundingBox<VertexT> bb,
+            bool isVoxelsize = true,
+            int levels = 3,
+            float curvature = 0.05,
+            int minPoints = 10);
+
+    virtual ~OctreeGrid() {}
+
+    /// Calculates the signed distance values at the centers of all leaves
+    void calcDistanceValues();
+
+    /// Returns all nodes. The root is the first node.
+    const std::vector<Node>& getNodes() const { return m_nodes; }
+
+    /// Returns the center of the given node
+    VertexT getCenter(const Node& node) const;
+
+    /// Returns the size of the smallest leaves
+    float getVoxelsize() const { return m_voxelsize; }
+
+    /// Returns the number of leaves
+    size_t getNumberOfLeaves() const;
+
+private:
+
+    /// Returns true if the given node has to be split
+    bool refine(const Node& node) const;
+
+    /// Initializes the eight children of the given node, starting at
+    /// index first, and distributes the node's points among them
+    void partition(uint32_t index, uint32_t first);
+
+    /// Splits the given leaf
+    void split(uint32_t index);
+
+    /// Returns the leaf that contains the given voxel
+    uint32_t findLeaf(int64_t x, int64_t y, int64_t z) const;
+
+    /// Splits the empty leaves next to leaves with points
+    void refineNeighbors();
+
+    /// The point set surface used for distance evaluation
+    typename PointsetSurface<VertexT>::Ptr  m_surface;
+
+    /// Point array of the surface
+    coord3fArr              m_points;
+
+    /// Normal array of the surface (may be empty)
+    coord3fArr              m_normals;
+
+    /// Number of points
+    size_t                  m_numPoints;
+
+    /// Indices of the points sorted by node
+    std::vector<uint32_t>   m_indices;
+
+    /// Size of the smallest leaves
+    float                   m_voxelsize;
+
+    /// Minimum corner of the root
+    VertexT                 m_origin;
+
+    /// Largest size of a leaf with points in voxels
+    uint32_t                m_maxLeafSize;
+
+    /// Threshold for the normal variation
+    float                   m_curvature;
+
+    /// Minimum number of points for curvature based refinement
+    size_t                  m_minPoints;
+
+    /// The nodes
+    std::vector<Node>       m_nodes;
+};
+
+} // namespace lvr
+
+#include "OctreeGrid.tcc"
+
+#endif /* OCTREEGRID_HPP_ */
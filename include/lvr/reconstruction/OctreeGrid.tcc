@@ -0,0 +1,367 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * OctreeGrid.tcc
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/io/Timestamp.hpp>
+#include <lvr/io/Progress.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace lvr
+{
+
+template<typename VertexT, typename NormalT>
+OctreeGrid<VertexT, NormalT>::OctreeGrid(
+        float cellSize,
+        typename PointsetSurface<VertexT>::Ptr surface,
+        BoundingBox<VertexT> bb,
+        bool isVoxelsize,
+        int levels,
+        float curvature,
+        int minPoints)
+    : m_surface(surface),
+      m_numPoints(0),
+      m_curvature(curvature),
+      m_minPoints(std::max(minPoints, 1))
+{
+    m_voxelsize = isVoxelsize ? cellSize : bb.getLongestSide() / cellSize;
+    m_maxLeafSize = 1 << std::min(std::max(levels, 0), 16);
+
+    cout << timestamp << "Used voxelsize is " << m_voxelsize << endl;
+    cout << timestamp << "Creating octree..." << endl;
+
+    m_points = surface->pointBuffer()->getIndexedPointArray(m_numPoints);
+
+    size_t numNormals = 0;
+    m_normals = surface->pointBuffer()->getIndexedPointNormalArray(numNormals);
+    if(numNormals != m_numPoints)
+    {
+        m_normals.reset();
+    }
+
+    // The root cube contains the bounding box and a margin of
+    // one maximum leaf size
+    float extent = bb.getLongestSide() + 2 * m_maxLeafSize * m_voxelsize;
+    int depth = (int)ceil(log2(std::max(extent / m_voxelsize, 1.0f)));
+    depth = std::min(depth, 30);
+    uint32_t rootSize = (uint32_t)1 << depth;
+
+    VertexT centroid = bb.getCentroid();
+    m_origin = VertexT(
+            centroid[0] - 0.5f * rootSize * m_voxelsize,
+            centroid[1] - 0.5f * rootSize * m_voxelsize,
+            centroid[2] - 0.5f * rootSize * m_voxelsize);
+
+    m_indices.resize(m_numPoints);
+    for(size_t i = 0; i < m_numPoints; i++)
+    {
+        m_indices[i] = (uint32_t)i;
+    }
+
+    Node root;
+    root.children = -1;
+    root.size = rootSize;
+    root.x = root.y = root.z = 0;
+    root.begin = 0;
+    root.end = (uint32_t)m_numPoints;
+    root.distance = 0;
+    root.euklidean = 0;
+    m_nodes.push_back(root);
+
+    // Refine depth by depth. The nodes of a depth are processed
+    // in parallel, their children are allocated in advance.
+    vector<uint32_t> current(1, 0);
+    while(!current.empty())
+    {
+        vector<unsigned char> splits(current.size());
+
+        #pragma omp parallel for schedule(dynamic, 16)
+        for(long i = 0; i < (long)current.size(); i++)
+        {
+            splits[i] = refine(m_nodes[current[i]]);
+        }
+
+        vector<uint32_t> first(current.size());
+        uint32_t next = (uint32_t)m_nodes.size();
+        for(size_t i = 0; i < current.size(); i++)
+        {
+            first[i] = next;
+            if(splits[i])
+            {
+                m_nodes[current[i]].children = next;
+                next += 8;
+            }
+        }
+        m_nodes.resize(next);
+
+        #pragma omp parallel for schedule(dynamic, 16)
+        for(long i = 0; i < (long)current.size(); i++)
+        {
+            if(splits[i])
+            {
+                partition(current[i], first[i]);
+            }
+        }
+
+        vector<uint32_t> children;
+        for(size_t i = 0; i < current.size(); i++)
+        {
+            if(splits[i])
+            {
+                for(uint32_t c = 0; c < 8; c++)
+                {
+                    children.push_back(first[i] + c);
+                }
+            }
+        }
+        current.swap(children);
+    }
+
+    refineNeighbors();
+
+    cout << timestamp << "Created octree with " << getNumberOfLeaves() << " leaves" << endl;
+}
+
+template<typename VertexT, typename NormalT>
+bool OctreeGrid<VertexT, NormalT>::refine(const Node& node) const
+{
+    size_t count = node.end - node.begin;
+    if(count == 0 || node.size <= 1)
+    {
+        return false;
+    }
+
+    if(node.size > m_maxLeafSize)
+    {
+        return true;
+    }
+
+    if(count < m_minPoints)
+    {
+        return false;
+    }
+
+    if(!m_normals)
+    {
+        return true;
+    }
+
+    // Variation of the normals
+    float sum[3] = {0.0f, 0.0f, 0.0f};
+    for(uint32_t i = node.begin; i < node.end; i++)
+    {
+        coord<float>& n = m_normals[m_indices[i]];
+        sum[0] += n[0];
+        sum[1] += n[1];
+        sum[2] += n[2];
+    }
+    float length = sqrt(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]);
+    return 1.0f - length / count > m_curvature;
+}
+
+template<typename VertexT, typename NormalT>
+void OctreeGrid<VertexT, NormalT>::partition(uint32_t index, uint32_t first)
+{
+    Node& node = m_nodes[index];
+    uint32_t half = node.size / 2;
+
+    float center[3] = {
+            m_origin[0] + (node.x + half) * m_voxelsize,
+            m_origin[1] + (node.y + half) * m_voxelsize,
+            m_origin[2] + (node.z + half) * m_voxelsize};
+
+    // Sort the points by child (counting sort)
+    vector<unsigned char> child(node.end - node.begin);
+    uint32_t counts[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for(uint32_t i = node.begin; i < node.end; i++)
+    {
+        coord<float>& p = m_points[m_indices[i]];
+        int c = (p[0] >= center[0]) | ((p[1] >= center[1]) << 1) | ((p[2] >= center[2]) << 2);
+        child[i - node.begin] = (unsigned char)c;
+        counts[c]++;
+    }
+
+    uint32_t offsets[8];
+    uint32_t offset = node.begin;
+    for(int c = 0; c < 8; c++)
+    {
+        Node& n = m_nodes[first + c];
+        n.children = -1;
+        n.size = half;
+        n.x = node.x + (c & 1) * half;
+        n.y = node.y + ((c >> 1) & 1) * half;
+        n.z = node.z + ((c >> 2) & 1) * half;
+        n.begin = offset;
+        n.end = offset + counts[c];
+        n.distance = 0;
+        n.euklidean = 0;
+
+        offsets[c] = offset;
+        offset += counts[c];
+    }
+
+    vector<uint32_t> sorted(node.end - node.begin);
+    for(uint32_t i = node.begin; i < node.end; i++)
+    {
+        sorted[offsets[child[i - node.begin]]++ - node.begin] = m_indices[i];
+    }
+    std::copy(sorted.begin(), sorted.end(), m_indices.begin() + node.begin);
+}
+
+template<typename VertexT, typename NormalT>
+void OctreeGrid<VertexT, NormalT>::split(uint32_t index)
+{
+    uint32_t first = (uint32_t)m_nodes.size();
+    m_nodes.resize(first + 8);
+    m_nodes[index].children = first;
+    partition(index, first);
+}
+
+template<typename VertexT, typename NormalT>
+uint32_t OctreeGrid<VertexT, NormalT>::findLeaf(int64_t x, int64_t y, int64_t z) const
+{
+    uint32_t index = 0;
+    while(m_nodes[index].children >= 0)
+    {
+        const Node& node = m_nodes[index];
+        int64_t half = node.size / 2;
+        int c = (x >= node.x + half) | ((y >= node.y + half) << 1) | ((z >= node.z + half) << 2);
+        index = node.children + c;
+    }
+    return index;
+}
+
+template<typename VertexT, typename NormalT>
+void OctreeGrid<VertexT, NormalT>::refineNeighbors()
+{
+    const int64_t rootSize = m_nodes[0].size;
+    size_t numNodes = m_nodes.size();
+
+    for(size_t i = 0; i < numNodes; i++)
+    {
+        if(m_nodes[i].children >= 0 || m_nodes[i].begin == m_nodes[i].end)
+        {
+            continue;
+        }
+
+        const int64_t size = m_nodes[i].size;
+        const int64_t x = m_nodes[i].x;
+        const int64_t y = m_nodes[i].y;
+        const int64_t z = m_nodes[i].z;
+
+        for(int dx = -1; dx <= 1; dx++)
+        {
+            for(int dy = -1; dy <= 1; dy++)
+            {
+                for(int dz = -1; dz <= 1; dz++)
+                {
+                    int64_t nx = x + dx * size;
+                    int64_t ny = y + dy * size;
+                    int64_t nz = z + dz * size;
+                    if(nx < 0 || ny < 0 || nz < 0 || nx >= rootSize || ny >= rootSize || nz >= rootSize)
+                    {
+                        continue;
+                    }
+
+                    uint32_t leaf = findLeaf(nx, ny, nz);
+                    while(m_nodes[leaf].size > size)
+                    {
+                        split(leaf);
+                        leaf = findLeaf(nx, ny, nz);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<typename VertexT, typename NormalT>
+VertexT OctreeGrid<VertexT, NormalT>::getCenter(const Node& node) const
+{
+    float half = 0.5f * node.size;
+    return VertexT(
+            m_origin[0] + (node.x + half) * m_voxelsize,
+            m_origin[1] + (node.y + half) * m_voxelsize,
+            m_origin[2] + (node.z + half) * m_voxelsize);
+}
+
+template<typename VertexT, typename NormalT>
+size_t OctreeGrid<VertexT, NormalT>::getNumberOfLeaves() const
+{
+    size_t count = 0;
+    for(size_t i = 0; i < m_nodes.size(); i++)
+    {
+        if(m_nodes[i].children < 0)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+template<typename VertexT, typename NormalT>
+void OctreeGrid<VertexT, NormalT>::calcDistanceValues()
+{
+    vector<uint32_t> leaves;
+    for(size_t i = 0; i < m_nodes.size(); i++)
+    {
+        if(m_nodes[i].children < 0)
+        {
+            leaves.push_back((uint32_t)i);
+        }
+    }
+
+    // Status message output
+    string comment = timestamp.getElapsedTime() + "Calculating distance values ";
+    ProgressBar progress(leaves.size(), comment);
+
+    Timestamp ts;
+
+    PointsetSurfaceQuery<VertexT> query(m_surface);
+
+    #pragma omp parallel
+    {
+        typename PointsetSurfaceQuery<VertexT>::Context ctx;
+
+        #pragma omp for schedule(dynamic, 64)
+        for(long i = 0; i < (long)leaves.size(); i++)
+        {
+            Node& node = m_nodes[leaves[i]];
+
+            float projectedDistance;
+            float euklideanDistance;
+            query.distance(getCenter(node), projectedDistance, euklideanDistance, ctx);
+
+            node.distance = projectedDistance;
+            node.euklidean = euklideanDistance;
+            ++progress;
+        }
+    }
+    cout << endl;
+    cout << timestamp << "Elapsed time: " << ts << endl;
+}
+
+} // namespace lvr
@@ -0,0 +1,120 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+/*
+ * PointCloudFiltering.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef POINTCLOUDFILTERING_HPP_
+#define POINTCLOUDFILTERING_HPP_
+
+#include <lvr/io/PointBuffer.hpp>
+#include <lvr/geometry/ColorVertex.hpp>
+#include <lvr/reconstruction/SearchTree.hpp>
+
+#include <string>
+#include <vector>
+
+namespace lvr
+{
+
+/**
+ * @brief   Outlier removal and smoothing filters for point clouds that are
+ *          implemented on top of the search trees of liblvr, i.e., they
+ *          do not require PCL.
+ *
+ *          All filters work directly on the arrays of the given point
+ *          buffer. Removed points are eliminated by a stable compaction
+ *          pass that also compacts all per point attributes (colors,
+ *          normals, intensities and confidences). Neighbor queries run
+ *          through a PointsetSurfaceQuery, so searches of backends that
+ *          are not thread safe (STANN, PCL) are serialized.
+ */
+class PointCloudFiltering
+{
+public:
+
+    typedef ColorVertex<float, unsigned char> VertexT;
+
+    /**
+     * @brief   Constructor.
+     *
+     * @param   buffer          The point buffer to filter
+     * @param   searchTreeName  Search tree backend that is used for the
+     *                          neighbor queries (flann, nanoflann, stann,
+     *                          nabo or pcl)
+     */
+    PointCloudFiltering(PointBufferPtr buffer, std::string searchTreeName = "nanoflann");
+
+    virtual ~PointCloudFiltering() {}
+
+    /**
+     * @brief   Statistical outlier removal. For each point the mean
+     *          distance to its k nearest neighbors is calculated. Points
+     *          with a mean distance larger than mu + thresh * sigma of all
+     *          mean distances are removed.
+     *
+     * @return  The number of removed points
+     */
+    size_t applyOutlierRemoval(int meank, float thresh);
+
+    /**
+     * @brief   Removes all points with less than minNeighbors neighbors
+     *          within the given radius.
+     *
+     * @return  The number of removed points
+     */
+    size_t applyRadiusOutlierRemoval(float radius, int minNeighbors);
+
+    /**
+     * @brief   Moving least squares smoothing. Each point is projected
+     *          onto the weighted least squares plane of its neighbors
+     *          within the given radius. At most k neighbors are used.
+     */
+    void applyMLSProjection(float searchRadius, int k = 30);
+
+    /**
+     * @brief   Returns the filtered point buffer (the one that was passed
+     *          to the constructor).
+     */
+    PointBufferPtr getPointBuffer() { return m_buffer; }
+
+private:
+
+    /// (Re-)builds the search tree if necessary
+    void buildSearchTree();
+
+    /// Removes all points i with keep[i] == 0 from the buffer
+    size_t compact(const std::vector<unsigned char>& keep);
+
+    /// Filtered point buffer
+    PointBufferPtr                  m_buffer;
+
+    /// Name of the used search tree backend
+    std::string                     m_searchTreeName;
+
+    /// Search tree for the current point set
+    SearchTree<VertexT>::Ptr        m_searchTree;
+};
+
+} /* namespace lvr */
+
+#endif /* POINTCLOUDFILTERING_HPP_ */
@@ -0,0 +1,197 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+/*
+ * PointCloudReduction.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef POINTCLOUDREDUCTION_HPP_
+#define POINTCLOUDREDUCTION_HPP_
+
+#include <lvr/io/PointBuffer.hpp>
+
+#include <boost/shared_ptr.hpp>
+
+#include <stdint.h>
+#include <cmath>
+
+namespace lvr
+{
+
+/**
+ * @brief   Abstract interface for spatial point cloud reduction engines.
+ *
+ *          In contrast to the modulo filters used in the IO classes the
+ *          engines reduce a point cloud based on the spatial distribution
+ *          of the points, which results in a uniform point density. Points
+ *          can be passed block by block (e.g., while parsing a scan file),
+ *          so the input never has to be held in memory completely. Only
+ *          the reduced point set is stored.
+ */
+class PointCloudReduction
+{
+public:
+
+    typedef boost::shared_ptr<PointCloudReduction> Ptr;
+
+    virtual ~PointCloudReduction() {}
+
+    /**
+     * @brief   Adds a block of points to the reduction.
+     *
+     * @param   points      Interlaced point coordinates (x, y, z)
+     * @param   colors      Interlaced colors (r, g, b) or 0 if no color
+     *                      information is present. Color information
+     *                      has to be given for all or for no block.
+     * @param   normals     Interlaced normals (x, y, z) or 0. Like the
+     *                      colors they are carried over to the reduced
+     *                      points.
+     * @param   n           Number of points in the block
+     *
+     * @throws  std::range_error if a point is too far away from the first
+     *          added point to be stored in the cell grid of the engine
+     */
+    virtual void addPoints(const float* points, const unsigned char* colors, const float* normals, size_t n) = 0;
+
+    /**
+     * @brief   Adds a block of points without normals to the reduction.
+     */
+    void addPoints(const float* points, const unsigned char* colors, size_t n)
+    {
+        addPoints(points, colors, 0, n);
+    }
+
+    /**
+     * @brief   Returns a point buffer containing the reduced points of all
+     *          blocks that were added so far.
+     */
+    virtual PointBufferPtr getReducedPoints() = 0;
+
+    /**
+     * @brief   Resets the internal state, i.e., removes all points.
+     */
+    virtual void clear() = 0;
+
+    /**
+     * @brief   Convenience function that reduces the given point buffer in
+     *          a single block. The internal state is cleared before.
+     */
+    PointBufferPtr reduce(PointBufferPtr buffer)
+    {
+        size_t n_points = 0;
+        size_t n_colors = 0;
+        size_t n_normals = 0;
+        floatArr points  = buffer->getPointArray(n_points);
+        ucharArr colors  = buffer->getPointColorArray(n_colors);
+        floatArr normals = buffer->getPointNormalArray(n_normals);
+
+        clear();
+        addPoints(points.get(),
+                n_colors  == n_points ? colors.get()  : 0,
+                n_normals == n_points ? normals.get() : 0,
+                n_points);
+        return getReducedPoints();
+    }
+
+protected:
+
+    PointCloudReduction() : m_anchored(false) {}
+
+    /// Largest cell index (relative to the anchor) that can be keyed
+    static const int64_t MaxCellIndex = (1 << 20) - 3;
+
+    /**
+     * @brief   Packs the given cell indices into a single hash key. Each
+     *          index uses 21 bits, i.e., 2^20 cells in each direction
+     *          around the anchor cell can be addressed without collisions.
+     *          Indices have to be checked with \ref cellIndices before.
+     */
+    static uint64_t cellKey(int64_t i, int64_t j, int64_t k)
+    {
+        const int64_t offset = 1 << 20;
+        const uint64_t mask  = (1 << 21) - 1;
+        return  ((uint64_t)(i + offset) & mask)
+             | (((uint64_t)(j + offset) & mask) << 21)
+             | (((uint64_t)(k + offset) & mask) << 42);
+    }
+
+    /// Returns the index of the cell containing the given coordinate
+    static int64_t cellIndex(float coord, float cellSize)
+    {
+        return (int64_t)floor(coord / cellSize);
+    }
+
+    /**
+     * @brief   Makes the cell of the given point the anchor cell if no
+     *          anchor was set since the last call of \ref resetAnchor.
+     *          Cell indices are relative to the anchor, so georeferenced
+     *          clouds far away from the origin can be keyed, too.
+     */
+    void setAnchor(const float* p, float cellSize)
+    {
+        if(!m_anchored)
+        {
+            for(int j = 0; j < 3; j++)
+            {
+                m_anchor[j] = cellIndex(p[j], cellSize);
+            }
+            m_anchored = true;
+        }
+    }
+
+    /// Removes the anchor cell
+    void resetAnchor()
+    {
+        m_anchored = false;
+    }
+
+    /**
+     * @brief   Calculates the cell indices of the given point relative to
+     *          the anchor cell.
+     *
+     * @return  False if the point is too far away from the anchor, i.e.,
+     *          if its key would collide with another cell.
+     */
+    bool cellIndices(const float* p, float cellSize, int64_t* index) const
+    {
+        bool valid = true;
+        for(int j = 0; j < 3; j++)
+        {
+            index[j] = cellIndex(p[j], cellSize) - m_anchor[j];
+            valid = valid && index[j] >= -MaxCellIndex && index[j] <= MaxCellIndex;
+        }
+        return valid;
+    }
+
+private:
+
+    /// Absolute index of the anchor cell
+    int64_t m_anchor[3];
+
+    /// True if the anchor cell is set
+    bool    m_anchored;
+};
+
+typedef PointCloudReduction::Ptr PointCloudReductionPtr;
+
+} // namespace lvr
+
+#endif /* POINTCLOUDREDUCTION_HPP_ */
@@ -11,6 +11,7 @@
 #include "HashGrid.hpp"
 
 #include "PointsetSurface.hpp"
+#include "PointsetSurfaceQuery.hpp"
 
 namespace lvr
 {
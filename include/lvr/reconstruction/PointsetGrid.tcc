@@ -48,21 +48,26 @@ void PointsetGrid<VertexT, BoxT>::calcDistanceValues()
 
 	Timestamp ts;
 
-	// Calculate a distance value for each query point
-	#pragma omp parallel for
-	for( int i = 0; i < (int)this->m_queryPoints.size(); i++){
-		float projectedDistance;
-		float euklideanDistance;
-
-		//cout << euklideanDistance << " " << projectedDistance << endl;
+	PointsetSurfaceQuery<VertexT> query(this->m_surface);
 
-		this->m_surface->distance(this->m_queryPoints[i].m_position, projectedDistance, euklideanDistance);
-		if (euklideanDistance > 1.7320 * this->m_voxelsize)
-		{
-			this->m_queryPoints[i].m_invalid = true;
+	// Calculate a distance value for each query point
+	#pragma omp parallel
+	{
+		typename PointsetSurfaceQuery<VertexT>::Context ctx;
+
+		#pragma omp for
+		for( int i = 0; i < (int)this->m_queryPoints.size(); i++){
+			float projectedDistance;
+			float euklideanDistance;
+
+			query.distance(this->m_queryPoints[i].m_position, projectedDistance, euklideanDistance, ctx);
+			if (euklideanDistance > 1.7320 * this->m_voxelsize)
+			{
+				this->m_queryPoints[i].m_invalid = true;
+			}
+			this->m_queryPoints[i].m_distance = projectedDistance;
+			++progress;
 		}
-		this->m_queryPoints[i].m_distance = projectedDistance;
-		++progress;
 	}
 	cout << endl;
 	cout << timestamp << "Elapsed time: " << ts << endl;
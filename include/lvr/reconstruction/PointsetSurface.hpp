@@ -60,6 +60,26 @@ public:
             float &projectedDistance,
             float &euklideanDistance) = 0;
 
+    /**
+     * @brief   Same as distance(v, projectedDistance, euklideanDistance), but
+     *          the search results are stored in the given buffers. The
+     *          default implementation calls the non-const version, surfaces
+     *          that return true in isThreadSafe() override it without
+     *          modifying any state.
+     */
+    virtual void distance(const VertexT& v,
+            float &projectedDistance,
+            float &euklideanDistance,
+            vector<int>& indices,
+            vector<float>& distances) const;
+
+    /**
+     * @brief   Returns true if the const query functions distance() and
+     *          interpolateNormal() may be called concurrently. Use a
+     *          PointsetSurfaceQuery to query surfaces from several threads.
+     */
+    virtual bool isThreadSafe() const { return false; }
+
     /**
      * @brief   Calculates surface normals for each data point in the given
      *          PointBuffeer. If the buffer alreay contains normal information
@@ -75,6 +95,14 @@ public:
      */
     virtual VertexT getInterpolatedNormal(VertexT position);
 
+    /**
+     * @brief   Same as getInterpolatedNormal(), but the neighbor indices are
+     *          stored in the given buffer. Surfaces that override
+     *          getInterpolatedNormal() and return true in isThreadSafe()
+     *          have to override this function, too.
+     */
+    virtual VertexT interpolateNormal(const VertexT& position, vector<int>& indices) const;
+
     /**
      * @brief   Returns the internal point buffer. After a call of
      *          @ref calculateSurfaceNormals the buffer will contain
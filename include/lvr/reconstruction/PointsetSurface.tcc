@@ -48,18 +48,37 @@ void PointsetSurface<VertexT>::expandBoundingBox(
     this->m_boundingBox.expand(xmax, ymax, zmax);
 }
 
+template<typename VertexT>
+void PointsetSurface<VertexT>::distance(const VertexT& v,
+        float &projectedDistance,
+        float &euklideanDistance,
+        vector<int>& indices,
+        vector<float>& distances) const
+{
+    const_cast<PointsetSurface<VertexT>*>(this)->distance(v, projectedDistance, euklideanDistance);
+}
+
 template<typename VertexT>
 VertexT PointsetSurface<VertexT>::getInterpolatedNormal(VertexT position)
 {
 	vector<int> indices;
+	return interpolateNormal(position, indices);
+}
+
+template<typename VertexT>
+VertexT PointsetSurface<VertexT>::interpolateNormal(const VertexT& position, vector<int>& indices) const
+{
 	VertexT result(0,0,0);
 	size_t n;
-	this->searchTree()->kSearch(position, this->m_kn, indices);
+	coord3fArr normals = m_pointBuffer->getIndexedPointNormalArray(n);
+
+	indices.clear();
+	m_searchTree->kSearch(position, this->m_kn, indices);
 	for (int i = 0; i < this->m_kn; i++)
 	{
-		result[0] += this->pointBuffer()->getIndexedPointNormalArray(n)[indices[i]][0];
-		result[1] += this->pointBuffer()->getIndexedPointNormalArray(n)[indices[i]][1];
-		result[2] += this->pointBuffer()->getIndexedPointNormalArray(n)[indices[i]][2];
+		result[0] += normals[indices[i]][0];
+		result[1] += normals[indices[i]][1];
+		result[2] += normals[indices[i]][2];
 	}
 	result /= this->m_kn;
 	return result;
@@ -0,0 +1,161 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * PointsetSurfaceQuery.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef POINTSETSURFACEQUERY_HPP_
+#define POINTSETSURFACEQUERY_HPP_
+
+#include "PointsetSurface.hpp"
+#include "SearchTree.hpp"
+
+#include <mutex>
+#include <vector>
+
+namespace lvr
+{
+
+/**
+ * @brief   Read-only query interface of a PointsetSurface that can be used
+ *          from several threads at once.
+ *
+ *          Every thread passes its own Context with the buffers for the
+ *          search results, so repeated queries do not allocate memory.
+ *          Queries of surfaces and search trees that report to be thread
+ *          safe run concurrently, all others are serialized by a mutex:
+ *
+ *          Search tree | concurrent
+ *          ------------|-----------
+ *          FLANN       | yes
+ *          NANOFLANN   | yes
+ *          NABO        | yes
+ *          BOCTREE     | yes
+ *          STANN       | no
+ *          PCL         | no
+ *
+ *          Distance values and normals of an AdaptiveKSearchSurface are
+ *          evaluated concurrently if its search tree is thread safe. Other
+ *          surfaces (e.g. PCLKSurface) are always serialized.
+ *
+ *          The surface must not be changed while the query object is used,
+ *          i.e., the normals have to be calculated before.
+ */
+template<typename VertexT>
+class PointsetSurfaceQuery
+{
+public:
+
+    /// Scratch buffers of a single thread
+    struct Context
+    {
+        /// Indices of the last search
+        std::vector<int>        indices;
+
+        /// Squared distances of the last search
+        std::vector<float>      distances;
+
+        /// Neighbors of the last call of kSearchPoints()
+        std::vector<VertexT>    neighbors;
+    };
+
+    /**
+     * @brief   Constructor.
+     *
+     * @param   surface     A surface with point normals
+     */
+    PointsetSurfaceQuery(typename PointsetSurface<VertexT>::Ptr surface);
+
+    /**
+     * @brief   Constructor for nearest neighbor queries of a plain search
+     *          tree. Only kSearch() and kSearchPoints() may be used.
+     *
+     * @param   tree        A search tree
+     */
+    PointsetSurfaceQuery(typename SearchTree<VertexT>::Ptr tree);
+
+    /**
+     * @brief   Returns true if distance() and interpolatedNormal() of
+     *          different threads run concurrently
+     */
+    bool isConcurrent() const { return m_concurrentSurface; }
+
+    /**
+     * @brief   Returns true if kSearch() and kSearchPoints() of different
+     *          threads run concurrently
+     */
+    bool isSearchConcurrent() const { return m_concurrentTree; }
+
+    /**
+     * @brief   Evaluates the distance function of the surface, see
+     *          PointsetSurface::distance()
+     */
+    void distance(const VertexT& v, float& projectedDistance, float& euklideanDistance, Context& ctx) const;
+
+    /**
+     * @brief   Interpolates a surface normal at the given position, see
+     *          PointsetSurface::getInterpolatedNormal()
+     */
+    VertexT interpolatedNormal(const VertexT& position, Context& ctx) const;
+
+    /**
+     * @brief   Searches the k nearest points of qp. The results are stored
+     *          in ctx.indices and ctx.distances.
+     */
+    void kSearch(const VertexT& qp, int k, Context& ctx) const;
+
+    /**
+     * @brief   Searches the k nearest points of qp. The points (with colors
+     *          if present) are stored in ctx.neighbors.
+     */
+    void kSearchPoints(const VertexT& qp, int k, Context& ctx) const;
+
+    /**
+     * @brief   Returns the queried surface (empty if only a search tree
+     *          is queried)
+     */
+    typename PointsetSurface<VertexT>::Ptr surface() const { return m_surface; }
+
+private:
+
+    /// The queried surface
+    typename PointsetSurface<VertexT>::Ptr  m_surface;
+
+    /// Search tree of the surface
+    typename SearchTree<VertexT>::Ptr       m_tree;
+
+    /// True if the surface queries are thread safe
+    bool                                    m_concurrentSurface;
+
+    /// True if the search tree queries are thread safe
+    bool                                    m_concurrentTree;
+
+    /// Serializes queries that are not thread safe
+    mutable std::mutex                      m_mutex;
+};
+
+} // namespace lvr
+
+#include "PointsetSurfaceQuery.tcc"
+
+#endif /* POINTSETSURFACEQUERY_HPP_ */
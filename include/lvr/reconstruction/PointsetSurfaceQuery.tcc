@@ -0,0 +1,112 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * PointsetSurfaceQuery.tcc
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+namespace lvr
+{
+
+template<typename VertexT>
+PointsetSurfaceQuery<VertexT>::PointsetSurfaceQuery(typename PointsetSurface<VertexT>::Ptr surface)
+    : m_surface(surface)
+{
+    m_tree = m_surface->searchTree();
+    m_concurrentSurface = m_surface->isThreadSafe();
+    m_concurrentTree = m_tree && m_tree->isThreadSafe();
+}
+
+template<typename VertexT>
+PointsetSurfaceQuery<VertexT>::PointsetSurfaceQuery(typename SearchTree<VertexT>::Ptr tree)
+    : m_tree(tree)
+{
+    m_concurrentSurface = false;
+    m_concurrentTree = m_tree && m_tree->isThreadSafe();
+}
+
+template<typename VertexT>
+void PointsetSurfaceQuery<VertexT>::distance(const VertexT& v,
+        float& projectedDistance,
+        float& euklideanDistance,
+        Context& ctx) const
+{
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    if(!m_concurrentSurface)
+    {
+        lock.lock();
+    }
+
+    m_surface->distance(v, projectedDistance, euklideanDistance, ctx.indices, ctx.distances);
+}
+
+template<typename VertexT>
+VertexT PointsetSurfaceQuery<VertexT>::interpolatedNormal(const VertexT& position, Context& ctx) const
+{
+    if(m_concurrentSurface)
+    {
+        return m_surface->interpolateNormal(position, ctx.indices);
+    }
+
+    // Surfaces may override getInterpolatedNormal() only
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_surface->getInterpolatedNormal(position);
+}
+
+template<typename VertexT>
+void PointsetSurfaceQuery<VertexT>::kSearch(const VertexT& qp, int k, Context& ctx) const
+{
+    ctx.indices.clear();
+    ctx.distances.clear();
+    if(!m_tree)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    if(!m_concurrentTree)
+    {
+        lock.lock();
+    }
+
+    m_tree->kSearch(qp, k, ctx.indices, ctx.distances);
+}
+
+template<typename VertexT>
+void PointsetSurfaceQuery<VertexT>::kSearchPoints(const VertexT& qp, int k, Context& ctx) const
+{
+    ctx.neighbors.clear();
+    if(!m_tree)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    if(!m_concurrentTree)
+    {
+        lock.lock();
+    }
+
+    m_tree->kSearch(qp, k, ctx.neighbors);
+}
+
+} // namespace lvr
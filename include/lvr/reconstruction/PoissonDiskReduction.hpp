@@ -0,0 +1,105 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+/*
+ * PoissonDiskReduction.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef POISSONDISKREDUCTION_HPP_
+#define POISSONDISKREDUCTION_HPP_
+
+#include <lvr/reconstruction/PointCloudReduction.hpp>
+
+#include <boost/unordered_map.hpp>
+
+#include <vector>
+
+namespace lvr
+{
+
+/**
+ * @brief   Approximate Poisson disk subsampling of a point cloud, i.e., the
+ *          reduced cloud contains no two points that are closer than a
+ *          given radius.
+ *
+ *          The accepted samples are stored in a hashed grid with a cell
+ *          size of r / sqrt(3), so every cell holds at most one sample and
+ *          all conflicting samples are found in the 5 x 5 x 5 neighbourhood
+ *          of a cell. The cells of a block are processed in 27 phases.
+ *          Cells of the same phase are at least three cells apart and do
+ *          not influence each other, so they are processed in parallel.
+ *          The result does not depend on the number of used threads.
+ */
+class PoissonDiskReduction : public PointCloudReduction
+{
+public:
+
+    /**
+     * @brief   Constructor.
+     *
+     * @param   radius      Minimum distance between two points in the
+     *                      reduced cloud
+     */
+    PoissonDiskReduction(float radius);
+
+    virtual ~PoissonDiskReduction() {}
+
+    using PointCloudReduction::addPoints;
+
+    virtual void addPoints(const float* points, const unsigned char* colors, const float* normals, size_t n);
+
+    virtual PointBufferPtr getReducedPoints();
+
+    virtual void clear();
+
+private:
+
+    /// Returns true if the given point has no accepted sample within m_radius
+    bool isFree(const float* p, int64_t i, int64_t j, int64_t k) const;
+
+    /// Minimum distance between two samples
+    float                   m_radius;
+
+    /// Cell size of the sample grid
+    float                   m_cellSize;
+
+    /// True if color information was passed
+    bool                    m_hasColors;
+
+    /// True if normals were passed
+    bool                    m_hasNormals;
+
+    /// Maps cell keys to the sample index in m_points
+    boost::unordered_map<uint64_t, size_t> m_cells;
+
+    /// Accepted samples
+    std::vector<float>      m_points;
+
+    /// Colors of the accepted samples
+    std::vector<unsigned char> m_colors;
+
+    /// Normals of the accepted samples
+    std::vector<float>      m_normals;
+};
+
+} // namespace lvr
+
+#endif /* POISSONDISKREDUCTION_HPP_ */
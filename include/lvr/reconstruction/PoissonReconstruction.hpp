@@ -0,0 +1,118 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * PoissonReconstruction.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef POISSONRECONSTRUCTION_HPP_
+#define POISSONRECONSTRUCTION_HPP_
+
+#include <lvr/reconstruction/PointsetMeshGenerator.hpp>
+#include <lvr/reconstruction/ScreenedPoissonSolver.hpp>
+#include <lvr/reconstruction/HashGrid.hpp>
+#include <lvr/reconstruction/FastBox.hpp>
+
+namespace lvr
+{
+
+/**
+ * @brief   Screened Poisson surface reconstruction. The implicit function
+ *          is computed from the points and normals of the point set surface
+ *          with a ScreenedPoissonSolver. Its zero set is extracted with
+ *          marching cubes on a HashGrid that contains the cells of the
+ *          finest octree depth and their direct neighbors, so gaps of a
+ *          few voxels are closed. Optionally, larger holes are closed by
+ *          following the zero set into the regions without samples.
+ */
+template<typename VertexT, typename NormalT>
+class PoissonReconstruction : public PointsetMeshGenerator<VertexT, NormalT>
+{
+public:
+
+    typedef HashGrid<VertexT, FastBox<VertexT, NormalT> > GridType;
+
+    /**
+     * @brief   Constructor.
+     *
+     * @param   surface         Point set surface with (oriented) normals
+     * @param   resolution      Voxel size or number of intersections along
+     *                          the longest side of the bounding box. Used to
+     *                          determine the depth of the octree.
+     * @param   isVoxelsize     If true, resolution is a voxel size
+     */
+    PoissonReconstruction(
+            typename PointsetSurface<VertexT>::Ptr surface,
+            float resolution,
+            bool isVoxelsize = true);
+
+    virtual ~PoissonReconstruction();
+
+    /// Sets the weight of the screening term
+    void setScreeningWeight(float weight) { m_screeningWeight = weight; }
+
+    /// Sets the depth of the coarsest (dense) grid
+    void setMinDepth(int depth) { m_minDepth = depth; }
+
+    /// If true, holes of any size are closed. Default is false.
+    void setCloseHoles(bool close) { m_closeHoles = close; }
+
+    /// Sets the maximum number of solver iterations per octree depth
+    void setMaxIterations(int n) { m_maxIterations = n; }
+
+    /**
+     * @brief   Solves the screened Poisson equation and extracts the surface.
+     */
+    virtual void getMesh(BaseMesh<VertexT, NormalT>& mesh);
+
+    /// Returns the grid used for extraction. Valid after getMesh().
+    GridType* getGrid() { return m_grid; }
+
+private:
+
+    /// Voxel size or number of intersections
+    float       m_resolution;
+
+    /// True if m_resolution is a voxel size
+    bool        m_isVoxelsize;
+
+    /// Weight of the screening term
+    float       m_screeningWeight;
+
+    /// Depth of the coarsest grid
+    int         m_minDepth;
+
+    /// Maximum number of solver iterations per depth
+    int         m_maxIterations;
+
+    /// Close holes of any size
+    bool        m_closeHoles;
+
+    /// The extraction grid
+    GridType*   m_grid;
+};
+
+} // namespace lvr
+
+#include "PoissonReconstruction.tcc"
+
+#endif /* POISSONRECONSTRUCTION_HPP_ */
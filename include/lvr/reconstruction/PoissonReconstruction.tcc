@@ -0,0 +1,126 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * PoissonReconstruction.tcc
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/reconstruction/FastReconstruction.hpp>
+#include <lvr/io/Timestamp.hpp>
+
+#include <cmath>
+
+namespace lvr
+{
+
+template<typename VertexT, typename NormalT>
+PoissonReconstruction<VertexT, NormalT>::PoissonReconstruction(
+        typename PointsetSurface<VertexT>::Ptr surface,
+        float resolution,
+        bool isVoxelsize)
+    : PointsetMeshGenerator<VertexT, NormalT>(surface),
+      m_resolution(resolution),
+      m_isVoxelsize(isVoxelsize),
+      m_screeningWeight(4.0f),
+      m_minDepth(5),
+      m_maxIterations(100),
+      m_closeHoles(false),
+      m_grid(0)
+{
+
+}
+
+template<typename VertexT, typename NormalT>
+PoissonReconstruction<VertexT, NormalT>::~PoissonReconstruction()
+{
+    delete m_grid;
+}
+
+template<typename VertexT, typename NormalT>
+void PoissonReconstruction<VertexT, NormalT>::getMesh(BaseMesh<VertexT, NormalT>& mesh)
+{
+    size_t numPoints = 0;
+    size_t numNormals = 0;
+    coord3fArr points = this->m_surface->pointBuffer()->getIndexedPointArray(numPoints);
+    coord3fArr normals = this->m_surface->pointBuffer()->getIndexedPointNormalArray(numNormals);
+
+    if(numPoints == 0 || numNormals != numPoints)
+    {
+        cout << timestamp << "PoissonReconstruction: Point set has no normals." << endl;
+        return;
+    }
+
+    // Choose the depth of the octree so that the cells of the finest
+    // depth have the given voxel size and the cube contains the
+    // bounding box with a margin of 10 percent
+    BoundingBox<VertexT>& bb = this->m_surface->getBoundingBox();
+    float voxelsize = m_isVoxelsize ? m_resolution : bb.getLongestSide() / m_resolution;
+    int depth = (int)ceil(log2(1.1 * bb.getLongestSide() / voxelsize));
+    depth = std::min(std::max(depth, 1), 20);
+
+    float size = voxelsize * (float)((int64_t)1 << depth);
+    VertexT centroid = bb.getCentroid();
+    float origin[3] = {
+            centroid[0] - 0.5f * size,
+            centroid[1] - 0.5f * size,
+            centroid[2] - 0.5f * size};
+
+    cout << timestamp << "Screened Poisson reconstruction with octree depth " << depth << endl;
+
+    ScreenedPoissonSolver solver(&points[0][0], &normals[0][0], numPoints, origin, size, depth);
+    solver.setMinDepth(m_minDepth);
+    solver.setScreeningWeight(m_screeningWeight);
+    solver.setMaxIterations(m_maxIterations);
+    solver.solve();
+
+    // The boxes of the grid are the cells of the finest depth, i.e.,
+    // the query points are the nodes of the solver
+    float vsh = 0.5f * voxelsize;
+    BoundingBox<VertexT> cube;
+    cube.expand(origin[0] + vsh, origin[1] + vsh, origin[2] + vsh);
+    cube.expand(origin[0] + size + vsh, origin[1] + size + vsh, origin[2] + size + vsh);
+
+    delete m_grid;
+    m_grid = new GridType(voxelsize, cube, true, false);
+
+    vector<int> cells;
+    solver.getFinestCells(cells, m_closeHoles);
+    for(size_t c = 0; c < cells.size(); c += 3)
+    {
+        m_grid->addLatticePoint(cells[c], cells[c + 1], cells[c + 2]);
+    }
+
+    vector<QueryPoint<VertexT> >& queryPoints = m_grid->getQueryPoints();
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)queryPoints.size(); i++)
+    {
+        const VertexT& v = queryPoints[i].m_position;
+        float p[3] = {v[0], v[1], v[2]};
+        queryPoints[i].m_distance = solver.value(p);
+    }
+
+    FastReconstruction<VertexT, NormalT, FastBox<VertexT, NormalT> > reconstruction(m_grid);
+    reconstruction.getMesh(mesh);
+}
+
+} // namespace lvr
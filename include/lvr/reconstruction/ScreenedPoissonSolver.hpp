@@ -0,0 +1,252 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * ScreenedPoissonSolver.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef SCREENEDPOISSONSOLVER_HPP_
+#define SCREENEDPOISSONSOLVER_HPP_
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace lvr
+{
+
+/**
+ * @brief   Solves the screened Poisson equation (Kazhdan and Hoppe 2013)
+ *          for an oriented point set on a sparse octree.
+ *
+ *          The implicit function chi is sought whose gradient matches the
+ *          normal field of the samples while chi vanishes at the sample
+ *          positions:
+ *
+ *              E(chi) = |grad chi - V|^2 + alpha * sum_p chi(p)^2
+ *
+ *          Every depth d of the octree is a grid of 2^d cells in each
+ *          direction. The coarsest depth is dense, finer depths contain
+ *          only the cells with samples and their direct neighbors. chi is
+ *          stored at the cell corners and interpolated trilinearly, the
+ *          gradient term is discretized with finite differences along the
+ *          grid edges. The normals are averaged at the corners, so chi
+ *          approximates the signed distance close to the samples.
+ *
+ *          The depths are solved from coarse to fine (cascadic multigrid).
+ *          The interpolated coarse solution is the initial guess of the
+ *          next depth and is kept fixed at its boundary. Each depth is
+ *          solved with a Jacobi preconditioned conjugate gradient method.
+ *          All loops of a depth run in parallel.
+ */
+class ScreenedPoissonSolver
+{
+public:
+
+    /**
+     * @brief   Constructor.
+     *
+     * @param   points      Interlaced sample positions (x, y, z)
+     * @param   normals     Interlaced normals (x, y, z) of the samples. The
+     *                      normals have to point outwards.
+     * @param   n           Number of samples
+     * @param   origin      Minimum corner of the octree's bounding cube.
+     *                      All samples must be inside of the cube.
+     * @param   size        Side length of the bounding cube
+     * @param   maxDepth    Depth of the finest grid (at most 20)
+     */
+    ScreenedPoissonSolver(
+            const float* points,
+            const float* normals,
+            size_t n,
+            const float origin[3],
+            float size,
+            int maxDepth);
+
+    /// Sets the depth of the dense coarsest grid. Default is 5.
+    void setMinDepth(int depth);
+
+    /// Sets the weight alpha of the screening term. Default is 4.
+    void setScreeningWeight(float weight) { m_screeningWeight = weight; }
+
+    /// Sets the maximum number of CG iterations per depth. Default is 100.
+    void setMaxIterations(int n) { m_maxIterations = n; }
+
+    /// Sets the relative residual that terminates the CG iterations
+    void setTolerance(float tolerance) { m_tolerance = tolerance; }
+
+    /**
+     * @brief   Solves all depths. The iso value is chosen as the mean value
+     *          of chi at the samples and subtracted from the solution, so the
+     *          surface is the zero set of value().
+     */
+    void solve();
+
+    /// Returns the value of the implicit function at the given position
+    float value(const float* p) const;
+
+    /// Returns the depth of the finest grid
+    int maxDepth() const { return m_maxDepth; }
+
+    /// Returns the cell size at the given depth
+    float cellSize(int depth) const;
+
+    /**
+     * @brief   Returns the indices of the cells at the finest depth. A cell
+     *          (i, j, k) is the cube with minimum corner origin + (i, j, k)
+     *          * cellSize(maxDepth()). The indices are stored interlaced.
+     *
+     * @param   closeHoles  If true, the zero set is followed from these
+     *                      cells into the regions without samples, so
+     *                      the extracted surface is closed where the
+     *                      solution permits.
+     */
+    void getFinestCells(std::vector<int>& cells, bool closeHoles = false) const;
+
+private:
+
+    /// Sample data of the depth that is currently solved
+    struct Samples
+    {
+        /// Node indices of the eight corners of the sample's cell
+        std::vector<uint32_t>   nodes;
+
+        /// Trilinear interpolation weights of the eight corners
+        std::vector<float>      weights;
+
+        /// Start of the sample references of every node
+        std::vector<size_t>     offsets;
+
+        /// Sample references (8 * sample + corner) grouped by node
+        std::vector<uint32_t>   references;
+    };
+
+    /// The grid of one depth
+    struct Level
+    {
+        /// Octree depth
+        int                     depth;
+
+        /// Number of cells in each direction
+        int64_t                 resolution;
+
+        /// Cell size
+        float                   cellSize;
+
+        /// Sorted keys of the cells
+        std::vector<uint64_t>   cells;
+
+        /// Sorted keys of the cell corners (nodes)
+        std::vector<uint64_t>   nodes;
+
+        /// Six neighbors (-x, +x, -y, +y, -z, +z) of every node
+        std::vector<uint32_t>   neighbors;
+
+        /// Nodes with a missing neighbor keep the coarse solution
+        std::vector<unsigned char> fixed;
+
+        /// Solution at the nodes
+        std::vector<float>      x;
+    };
+
+    /// Packs grid indices into a sortable key
+    static uint64_t key(int64_t i, int64_t j, int64_t k)
+    {
+        return ((uint64_t)i << 42) | ((uint64_t)j << 21) | (uint64_t)k;
+    }
+
+    /// Unpacks a key into grid indices
+    static void unpack(uint64_t key, int64_t& i, int64_t& j, int64_t& k)
+    {
+        const uint64_t mask = (1 << 21) - 1;
+        i = (int64_t)(key >> 42);
+        j = (int64_t)((key >> 21) & mask);
+        k = (int64_t)(key & mask);
+    }
+
+    /// Returns the index of the node with the given key or NONE
+    static uint32_t findNode(const Level& level, uint64_t key);
+
+    /// Creates cells, nodes and neighborhoods of the given depth
+    void buildLevel(Level& level, int depth);
+
+    /// Creates the interpolation data of the samples for the given depth
+    void buildSamples(const Level& level, Samples& samples);
+
+    /// Solves the given depth
+    void solveLevel(Level& level);
+
+    /// Computes y = A * x for the free nodes
+    void multiply(const Level& level, const Samples& samples, float screening,
+                  const std::vector<float>& x, std::vector<float>& y,
+                  std::vector<float>& tmp) const;
+
+    /**
+     * @brief   Interpolates the solution of the given level at the given
+     *          position (in node units of the level). Falls back to the
+     *          coarser levels where the level has no cell.
+     */
+    float interpolate(size_t level, float u, float v, float w) const;
+
+    /// Marker for missing nodes
+    static const uint32_t NONE = 0xffffffff;
+
+    /// Sample positions
+    const float*            m_points;
+
+    /// Sample normals
+    const float*            m_normals;
+
+    /// Number of samples
+    size_t                  m_numPoints;
+
+    /// Minimum corner of the bounding cube
+    float                   m_origin[3];
+
+    /// Side length of the bounding cube
+    float                   m_size;
+
+    /// Depth of the finest grid
+    int                     m_maxDepth;
+
+    /// Depth of the dense coarsest grid
+    int                     m_minDepth;
+
+    /// Weight of the screening term
+    float                   m_screeningWeight;
+
+    /// Maximum number of CG iterations per depth
+    int                     m_maxIterations;
+
+    /// Relative residual that terminates the CG iterations
+    float                   m_tolerance;
+
+    /// Value of the solution at the surface
+    float                   m_isoValue;
+
+    /// The grids from m_minDepth to m_maxDepth
+    std::vector<Level>      m_levels;
+};
+
+} // namespace lvr
+
+#endif /* SCREENEDPOISSONSOLVER_HPP_ */
@@ -93,6 +93,14 @@ public:
     virtual void radiusSearch( coord< float >&       qp, float r, vector< int > &indices ) = 0;
     virtual void radiusSearch( const coord< float >& qp, float r, vector< int > &indices ) = 0;
 
+    /**
+     * @brief Returns true if the search functions may be called concurrently
+     *        from several threads. Backends that keep state between queries
+     *        return false, their queries have to be serialized by the caller
+     *        (see PointsetSurfaceQuery).
+     */
+    virtual bool isThreadSafe() const { return false; }
+
 
     /**
      * @brief Set the number of neighbours used to estimate and interpolate normals.
@@ -134,7 +134,7 @@ void SearchTree< VertexT >::kSearch( const coord< float > &qp, int neighbours, v
     qp_arr[0] = qpcpy[0];
     qp_arr[1] = qpcpy[1];
     qp_arr[2] = qpcpy[2];
-    this->kSearch( qp, neighbours, indices, distances);
+    this->kSearch( qpcpy, neighbours, indices, distances);
 }
 
 
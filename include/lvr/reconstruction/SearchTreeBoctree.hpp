@@ -0,0 +1,107 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/**
+ * SearchTreeBoctree.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef SEARCHTREEBOCTREE_HPP_
+#define SEARCHTREEBOCTREE_HPP_
+
+#include "SearchTree.hpp"
+
+#include <lvr/io/BoctreeScans.hpp>
+
+namespace lvr
+{
+
+/**
+ * @brief SearchClass for point data that was read from slam6d octree files.
+ *
+ *      The queries are answered by the deserialized octrees of the scans
+ *      (see BoctreeScans), so no additional index is built. The returned
+ *      indices refer to the flattened points of the given buffer.
+ */
+template< typename VertexT >
+class SearchTreeBoctree : public SearchTree<VertexT>
+{
+public:
+
+    /**
+     *  @brief Constructor. Takes the point-data and the octrees it was
+     *         created from.
+     *
+     *  @param points  A point buffer with octree information.
+     *  @param kn      The number of neighbour points used for normal estimation.
+     *  @param ki      The number of neighbour points used for normal interpolation.
+     *  @param kd      The number of neighbour points used for distance value calculation.
+     */
+    SearchTreeBoctree( BoctreePointBufferPtr points,
+            size_t &n_points,
+            const int &kn = 10,
+            const int &ki = 10,
+            const int &kd = 10,
+            const bool &useRansac = false );
+
+    /**
+     * @brief This function performs a k-next-neighbor search on the
+                       data that were given in the constructor.
+
+     * @param qp          A float array which contains the query point for which the neighbours are searched.
+     * @param neighbours  The number of neighbours that should be searched.
+     * @param indices     A vector that stores the indices for the neighbours whithin the dataset.
+     * @param distances   A vector that stores the squared distances for the neighbours that are found.
+     */
+    virtual void kSearch(
+            coord < float >& qp,
+            int neighbours, vector< int > &indices,
+            vector< float > &distances );
+
+
+    virtual void kSearch(VertexT qp, int k, vector< VertexT > &neighbors);
+
+
+    virtual void radiusSearch( float              qp[3], float r, vector< int > &indices );
+    virtual void radiusSearch( VertexT&              qp, float r, vector< int > &indices );
+    virtual void radiusSearch( const VertexT&        qp, float r, vector< int > &indices );
+    virtual void radiusSearch( coord< float >&       qp, float r, vector< int > &indices );
+    virtual void radiusSearch( const coord< float >& qp, float r, vector< int > &indices );
+
+    /**
+     * @brief The octrees are only read, see BoctreeScans::kSearch()
+     */
+    virtual bool isThreadSafe() const { return true; }
+
+    /// Destructor
+    virtual ~SearchTreeBoctree() {};
+
+private:
+
+    /// The octrees of the scans
+    BoctreeScansPtr     m_scans;
+};
+
+} /* namespace lvr */
+
+#include "SearchTreeBoctree.tcc"
+
+#endif /* SEARCHTREEBOCTREE_HPP_ */
@@ -0,0 +1,120 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/**
+ * SearchTreeBoctree.tcc
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/geometry/VertexTraits.hpp>
+
+namespace lvr
+{
+
+template<typename VertexT>
+SearchTreeBoctree<VertexT>::SearchTreeBoctree(
+        BoctreePointBufferPtr points,
+        size_t &n_points,
+        const int &kn,
+        const int &ki,
+        const int &kd,
+        const bool &useRansac )
+{
+    this->initBuffers(points);
+    this->m_kn = kn;
+    this->m_ki = ki;
+    this->m_kd = kd;
+
+    m_scans = points->getScans();
+}
+
+template<typename VertexT>
+void SearchTreeBoctree<VertexT>::kSearch(
+           coord < float >& qp,
+           int neighbors, vector< int > &indices,
+           vector< float > &distances )
+{
+    float query_point[3] = {qp[0], qp[1], qp[2]};
+    m_scans->kSearch(query_point, neighbors, indices, distances);
+}
+
+template<typename VertexT>
+void SearchTreeBoctree<VertexT>::kSearch(VertexT qp, int k, vector< VertexT > &nb)
+{
+    float query_point[3] = {qp[0], qp[1], qp[2]};
+    vector<int> neighbors;
+    vector<float> dist;
+    m_scans->kSearch(query_point, k, neighbors, dist);
+
+    for(size_t i = 0; i < neighbors.size(); i++)
+    {
+        VertexT v(this->m_pointData[3 * neighbors[i]],
+                  this->m_pointData[3 * neighbors[i] + 1],
+                  this->m_pointData[3 * neighbors[i] + 2]);
+
+        if(this->m_haveColors)
+        {
+            VertexTraits<VertexT>::setColor(
+                    v,
+                    this->m_pointColorData[3 * neighbors[i]],
+                    this->m_pointColorData[3 * neighbors[i] + 1],
+                    this->m_pointColorData[3 * neighbors[i] + 2]);
+        }
+
+        nb.push_back(v);
+    }
+}
+
+template<typename VertexT>
+void SearchTreeBoctree<VertexT>::radiusSearch( float              qp[3], float r, vector< int > &indices )
+{
+    m_scans->radiusSearch(qp, r, indices);
+}
+
+template<typename VertexT>
+void SearchTreeBoctree<VertexT>::radiusSearch( VertexT&              qp, float r, vector< int > &indices )
+{
+    float query_point[3] = {qp[0], qp[1], qp[2]};
+    m_scans->radiusSearch(query_point, r, indices);
+}
+
+template<typename VertexT>
+void SearchTreeBoctree<VertexT>::radiusSearch( const VertexT&        qp, float r, vector< int > &indices )
+{
+    float query_point[3] = {qp[0], qp[1], qp[2]};
+    m_scans->radiusSearch(query_point, r, indices);
+}
+
+template<typename VertexT>
+void SearchTreeBoctree<VertexT>::radiusSearch( coord< float >&       qp, float r, vector< int > &indices )
+{
+    float query_point[3] = {qp[0], qp[1], qp[2]};
+    m_scans->radiusSearch(query_point, r, indices);
+}
+
+template<typename VertexT>
+void SearchTreeBoctree<VertexT>::radiusSearch( const coord< float >& qp, float r, vector< int > &indices )
+{
+    float query_point[3] = {qp.x, qp.y, qp.z};
+    m_scans->radiusSearch(query_point, r, indices);
+}
+
+} /* namespace lvr */
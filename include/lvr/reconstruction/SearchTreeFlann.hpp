@@ -76,6 +76,12 @@ public:
     virtual void radiusSearch( coord< float >&       qp, float r, vector< int > &indices );
     virtual void radiusSearch( const coord< float >& qp, float r, vector< int > &indices );
 
+    /**
+     * @brief Searches of the single kd-tree index of FLANN only read the
+     *        tree, all result buffers are local to the call.
+     */
+    virtual bool isThreadSafe() const { return true; }
+
 protected:
 
     /// Pointer to the FLANN search tree structure
@@ -84,9 +90,6 @@ protected:
     /// FLANN matrix representation of the points
     flann::Matrix<float>  	 										m_flannPoints;
 
-    vector<int>														m_ind;
-    vector<float>													m_dst;
-
 
 }; // SearchTreeFlann
 
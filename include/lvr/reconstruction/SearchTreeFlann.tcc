@@ -40,10 +40,8 @@ SearchTreeFlann< VertexT >::~SearchTreeFlann() {
 template<typename VertexT>
 void SearchTreeFlann< VertexT >::kSearch( coord< float > &qp, int k, vector< int > &indices, vector< float > &distances )
 {
-	flann::Matrix<float> query_point(new float[3], 1, 3);
-	query_point[0][0] = qp.x;
-	query_point[0][1] = qp.y;
-	query_point[0][2] = qp.z;
+	float q[3] = {qp.x, qp.y, qp.z};
+	flann::Matrix<float> query_point(q, 1, 3);
 
 	indices.resize(k);
 	distances.resize(k);
@@ -57,22 +55,21 @@ void SearchTreeFlann< VertexT >::kSearch( coord< float > &qp, int k, vector< int
 template<typename VertexT>
 void SearchTreeFlann< VertexT >::kSearch(VertexT qp, int k, vector< VertexT > &nb)
 {
-	flann::Matrix<float> query_point(new float[3], 1, 3);
-	query_point[0][0] = qp.x;
-	query_point[0][1] = qp.y;
-	query_point[0][2] = qp.z;
+	float q[3] = {qp.x, qp.y, qp.z};
+	flann::Matrix<float> query_point(q, 1, 3);
 
-	m_dst.resize(k);
-	m_ind.resize(k);
+	// Local buffers, the search is called concurrently
+	vector<int> indices(k);
+	vector<float> distances(k);
 
-	flann::Matrix<int> ind (&m_ind[0], 1, k);
-	flann::Matrix<float> dist (&m_dst[0], 1, k);
+	flann::Matrix<int> ind (&indices[0], 1, k);
+	flann::Matrix<float> dist (&distances[0], 1, k);
 
 	m_tree->knnSearch(query_point, ind, dist, k, flann::SearchParams());
 
 	for(size_t i = 0; i < k; i++)
 	{
-		int index = m_ind[i];
+		int index = indices[i];
 		if(index < this->m_numPoints)
 		{
 			VertexT v(this->m_pointData[3 * index], this->m_pointData[3 * index + 1], this->m_pointData[3 * index + 2]);
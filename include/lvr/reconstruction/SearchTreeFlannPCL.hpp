@@ -100,6 +100,12 @@ public:
     virtual void radiusSearch( coord< float >&       qp, float r, vector< int > &indices );
     virtual void radiusSearch( const coord< float >& qp, float r, vector< int > &indices );
 
+    /**
+     * @brief Not thread safe. Depending on the PCL version the kd-tree
+     *        reuses internal buffers between queries.
+     */
+    virtual bool isThreadSafe() const { return false; }
+
 protected:
 
     /// Store the pcl kd-tree
@@ -90,6 +90,11 @@ public:
     virtual void radiusSearch( const VertexT&        qp, float r, vector< int > &indices );
     virtual void radiusSearch( coord< float >&       qp, float r, vector< int > &indices );
     virtual void radiusSearch( const coord< float >& qp, float r, vector< int > &indices );
+
+    /**
+     * @brief libnabo searches are const and use local heaps
+     */
+    virtual bool isThreadSafe() const { return true; }
     virtual void kSearch( VertexT      qp, int k, vector< VertexT > &neighbors ) {};
 protected:
 
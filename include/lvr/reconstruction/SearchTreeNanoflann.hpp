@@ -84,6 +84,11 @@ public:
     virtual void radiusSearch( coord< float >&       qp, float r, vector< int > &indices );
     virtual void radiusSearch( const coord< float >& qp, float r, vector< int > &indices );
 
+    /**
+     * @brief nanoflann searches are const and use local result sets
+     */
+    virtual bool isThreadSafe() const { return true; }
+
     /// Destructor
     virtual ~SearchTreeNanoflann() {};
 
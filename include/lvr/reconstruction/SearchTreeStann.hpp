@@ -92,6 +92,12 @@ public:
     virtual void radiusSearch( coord< float >&       qp, float r, vector< int > &indices );
     virtual void radiusSearch( const coord< float >& qp, float r, vector< int > &indices );
 
+    /**
+     * @brief Not thread safe. The STANN search keeps state in the sfcnn
+     *        object, concurrent queries have to be serialized.
+     */
+    virtual bool isThreadSafe() const { return false; }
+
 protected:
 
     /// Store wether to use a randomized algorithm for plane calculation
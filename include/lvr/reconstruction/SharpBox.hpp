@@ -29,7 +29,9 @@
 
 
 #include "FastBox.hpp"
+#include "PointsetSurfaceQuery.hpp"
 #include <float.h>
+#include <algorithm>
 #include "ExtendedMCTable.hpp"
 
 namespace lvr
@@ -60,6 +62,24 @@ public:
             vector<QueryPoint<VertexT> > &query_points,
             uint &globalIndex);
 
+    /**
+     * @brief Classifies the box w.r.t. sharp features and corners and
+     *        computes the position of the feature vertex. The result is
+     *        cached in the box, so this can be done for all boxes in
+     *        parallel before the mesh is extracted.
+     *
+     * @param query_points  A vector containing the query points of the
+     *                      reconstruction grid
+     */
+    void classifyFeatures(vector<QueryPoint<VertexT> > &query_points);
+
+    /**
+     * @brief Flips the edges between the extended marching cubes triangles
+     *        of this box and its neighbors. Must be called after the
+     *        surfaces of all boxes were added to the mesh.
+     */
+    void flipEdges(BaseMesh<VertexT, NormalT> &mesh);
+
     // Threshold angle for sharp feature detection
     static float m_theta_sharp;
 
@@ -78,9 +98,18 @@ public:
     // used for Edge Flipping
     uint m_extendedMCIndex;
 
+    // True if the feature classification is up to date
+    bool m_classified;
+
+    // The vertex of the sharp feature or corner
+    VertexT m_featureVertex;
+
     // the point set surface
     static typename PointsetSurface<VertexT>::Ptr m_surface;
 
+    // Thread safe queries of m_surface, set during parallel classification
+    static boost::shared_ptr<PointsetSurfaceQuery<VertexT> > m_query;
+
 private:
     /**
      * @brief gets the normals for the given vertices
@@ -89,10 +118,23 @@ private:
      * @param vertex_normals	This array holds the normals of the given vertices
      * 							after calling the method.
      */
-    void getNormals(VertexT vertex_positions[], NormalT vertex_normals[]);
+    void getNormals(VertexT vertex_positions[], NormalT vertex_normals[], int edges[], int numEdges);
 
     void detectSharpFeatures(VertexT vertex_positions[], NormalT vertex_normals[], uint index);
 
+    /**
+     * @brief Calculates the feature vertex as the least squares solution
+     *        of the tangent planes at the given intersections. Directions
+     *        that are not constrained by the planes are pulled towards the
+     *        box center.
+     *
+     * @param vertex_positions  The intersections of the box
+     * @param vertex_normals    The normals at the intersections
+     * @param edges             The indices of the used intersections
+     * @param numEdges          The number of used intersections
+     */
+    VertexT solveFeatureVertex(VertexT vertex_positions[], NormalT vertex_normals[], int edges[], int numEdges);
+
 
     typedef SharpBox<VertexT, NormalT> BoxType;
 };
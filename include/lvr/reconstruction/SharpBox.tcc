@@ -40,11 +40,16 @@ float SharpBox<VertexT, NormalT>::m_phi_corner = 0.7f;
 template<typename VertexT, typename NormalT>
 typename PointsetSurface<VertexT>::Ptr SharpBox<VertexT, NormalT>::m_surface;
 
+template<typename VertexT, typename NormalT>
+boost::shared_ptr<PointsetSurfaceQuery<VertexT> > SharpBox<VertexT, NormalT>::m_query;
+
 template<typename VertexT, typename NormalT>
 SharpBox<VertexT, NormalT>::SharpBox(VertexT v) : FastBox<VertexT, NormalT>(v)
 {
 	m_containsSharpFeature = false;
 	m_containsSharpCorner = false;
+	m_classified = false;
+	m_extendedMCIndex = 0;
 }
 
 template<typename VertexT, typename NormalT>
@@ -54,54 +59,74 @@ SharpBox<VertexT, NormalT>::~SharpBox()
 }
 
 template<typename VertexT, typename NormalT>
-void SharpBox<VertexT, NormalT>::getNormals(VertexT vertex_positions[], NormalT vertex_normals[])
+void SharpBox<VertexT, NormalT>::getNormals(VertexT vertex_positions[], NormalT vertex_normals[], int edges[], int numEdges)
 {
-	for (int i = 0; i < 12; i++)
+	// Only the intersections that are used by the MC
+	// configuration are queried
+	if(m_query)
+	{
+		typename PointsetSurfaceQuery<VertexT>::Context ctx;
+		for (int i = 0; i < numEdges; i++)
+		{
+			vertex_normals[edges[i]] = (NormalT) m_query->interpolatedNormal(vertex_positions[edges[i]], ctx);
+		}
+		return;
+	}
+
+	for (int i = 0; i < numEdges; i++)
 	{
-		vertex_normals[i] = (NormalT) m_surface->getInterpolatedNormal(vertex_positions[i]);
+		vertex_normals[edges[i]] = (NormalT) m_surface->getInterpolatedNormal(vertex_positions[edges[i]]);
 	}
 }
 
 template<typename VertexT, typename NormalT>
 void SharpBox<VertexT, NormalT>::detectSharpFeatures(VertexT vertex_positions[], NormalT vertex_normals[], uint index)
 {
+	m_containsSharpCorner = m_containsSharpFeature = false;
+
 	//  skip unhandled configurations
 	if (ExtendedMCTable[index][0] == -1)
 	{
-		m_containsSharpCorner = m_containsSharpFeature = false;
 		return;
 	}
 
-	getNormals(vertex_positions, vertex_normals);
+	// Collect the intersections of the configuration. Every
+	// intersection is shared by several triangles, so comparing
+	// the distinct intersections is sufficient.
+	int edges[12];
+	int numEdges = 0;
+	int mask = 0;
+	for(int a = 0; MCTable[index][a] != -1; a++)
+	{
+		mask |= 1 << MCTable[index][a];
+	}
+	for(int i = 0; i < 12; i++)
+	{
+		if(mask & (1 << i))
+		{
+			edges[numEdges++] = i;
+		}
+	}
+
+	getNormals(vertex_positions, vertex_normals, edges, numEdges);
 
 	NormalT n_asterisk;
 	float phi = FLT_MAX;
 
-	int edge_index1, edge_index2;
-	for(int a = 0; MCTable[index][a] != -1; a+= 3)
+	for(int a = 0; a < numEdges; a++)
 	{
-		for(int b = 0; b < 3; b++)
+		for(int b = a + 1; b < numEdges; b++)
 		{
-			edge_index1 = MCTable[index][a + b];
-			for(int c = 0; MCTable[index][c] != -1; c+= 3)
+			//save n_i x n_j if they enclose the largest angle
+			float angle = vertex_normals[edges[a]] * vertex_normals[edges[b]];
+			if(angle < phi)
 			{
-				for(int d = 0; d < 3; d++)
-				{
-					edge_index2 = MCTable[index][c + d];
-					if (edge_index1 != edge_index2)
-					{
-						//save n_i x n_j if they enclose the largest angle
-						if(vertex_normals[edge_index1] * vertex_normals[edge_index2] < phi)
-						{
-							phi = vertex_normals[edge_index1] * vertex_normals[edge_index2];
-							n_asterisk = vertex_normals[edge_index1].cross(vertex_normals[edge_index2]);
-						}
-						if (vertex_normals[edge_index1] * vertex_normals[edge_index2] < m_theta_sharp)
-						{
-							m_containsSharpFeature = true;
-						}
-					}
-				}
+				phi = angle;
+				n_asterisk = vertex_normals[edges[a]].cross(vertex_normals[edges[b]]);
+			}
+			if (angle < m_theta_sharp)
+			{
+				m_containsSharpFeature = true;
 			}
 		}
 	}
@@ -109,15 +134,12 @@ void SharpBox<VertexT, NormalT>::detectSharpFeatures(VertexT vertex_positions[],
 	// Check for presence of sharp corners
 	if (m_containsSharpFeature)
 	{
-		for(int a = 0; MCTable[index][a] != -1; a+= 3)
+		for(int a = 0; a < numEdges; a++)
 		{
-			for(int b = 0; b < 3; b++)
+			if (fabs(vertex_normals[edges[a]] * n_asterisk) > m_phi_corner)
 			{
-				edge_index1 = MCTable[index][a + b];
-				if (fabs(vertex_normals[edge_index1] * n_asterisk) > m_phi_corner)
-				{
-					m_containsSharpCorner = true;
-				}
+				m_containsSharpCorner = true;
+				break;
 			}
 		}
 	}
@@ -137,15 +159,98 @@ void SharpBox<VertexT, NormalT>::detectSharpFeatures(VertexT vertex_positions[],
 	{
 		m_containsSharpCorner = false;
 	}
+
+	if (m_containsSharpFeature)
+	{
+		m_extendedMCIndex = index;
+		m_featureVertex = solveFeatureVertex(vertex_positions, vertex_normals, edges, numEdges);
+	}
 }
 
+template<typename VertexT, typename NormalT>
+VertexT SharpBox<VertexT, NormalT>::solveFeatureVertex(VertexT vertex_positions[], NormalT vertex_normals[], int edges[], int numEdges)
+{
+	// Planes in structure of arrays layout relative to the box
+	// center, so that the accumulation below is vectorized
+	float nx[12], ny[12], nz[12], d[12];
+	for(int i = 0; i < numEdges; i++)
+	{
+		NormalT n = vertex_normals[edges[i]];
+		n.normalize();
+		VertexT p = vertex_positions[edges[i]] - this->m_center;
+		nx[i] = n[0];
+		ny[i] = n[1];
+		nz[i] = n[2];
+		d[i]  = n[0] * p[0] + n[1] * p[1] + n[2] * p[2];
+	}
+
+	// Normal equations A^T A x = A^T b
+	float a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+	float b0 = 0, b1 = 0, b2 = 0;
+	for(int i = 0; i < numEdges; i++)
+	{
+		a00 += nx[i] * nx[i];
+		a01 += nx[i] * ny[i];
+		a02 += nx[i] * nz[i];
+		a11 += ny[i] * ny[i];
+		a12 += ny[i] * nz[i];
+		a22 += nz[i] * nz[i];
+		b0  += nx[i] * d[i];
+		b1  += ny[i] * d[i];
+		b2  += nz[i] * d[i];
+	}
+
+	// Regularization towards the center (x = 0). For two planes
+	// this yields the projection of the center onto the feature line.
+	double lambda = 0.01 * numEdges;
+	double m00 = a00 + lambda, m11 = a11 + lambda, m22 = a22 + lambda;
+
+	// Solve the symmetric 3x3 system with Cramer's rule
+	double c00 = m11 * m22 - a12 * a12;
+	double c01 = a02 * a12 - a01 * m22;
+	double c02 = a01 * a12 - a02 * m11;
+	double det = m00 * c00 + a01 * c01 + a02 * c02;
+
+	VertexT v = this->m_center;
+	if(fabs(det) < 1e-12)
+	{
+		return v;
+	}
+
+	double c11 = m00 * m22 - a02 * a02;
+	double c12 = a01 * a02 - m00 * a12;
+	double c22 = m00 * m11 - a01 * a01;
+
+	double x[3];
+	x[0] = (c00 * b0 + c01 * b1 + c02 * b2) / det;
+	x[1] = (c01 * b0 + c11 * b1 + c12 * b2) / det;
+	x[2] = (c02 * b0 + c12 * b1 + c22 * b2) / det;
+
+	// Keep the vertex inside of the box
+	double h = 0.5 * this->m_voxelsize;
+	for(int i = 0; i < 3; i++)
+	{
+		v[i] += (float)std::max(-h, std::min(h, x[i]));
+	}
+
+	return v;
+}
 
 template<typename VertexT, typename NormalT>
-void SharpBox<VertexT, NormalT>::getSurface(
-        BaseMesh<VertexT, NormalT> &mesh,
-        vector<QueryPoint<VertexT> > &query_points,
-        uint &globalIndex)
+void SharpBox<VertexT, NormalT>::classifyFeatures(vector<QueryPoint<VertexT> > &query_points)
 {
+	m_classified = true;
+	m_containsSharpCorner = m_containsSharpFeature = false;
+
+	// No triangles are created for invalid boxes
+	for (int i = 0; i < 8; i++)
+	{
+		if (query_points[this->m_vertices[i]].m_invalid)
+		{
+			return;
+		}
+	}
+
 	VertexT corners[8];
 	VertexT vertex_positions[12];
 	NormalT vertex_normals[12];
@@ -156,8 +261,33 @@ void SharpBox<VertexT, NormalT>::getSurface(
 	this->getDistances(distances, query_points);
 	this->getIntersections(corners, distances, vertex_positions);
 
-	int index = this->getIndex(query_points);
+	detectSharpFeatures(vertex_positions, vertex_normals, this->getIndex(query_points));
+}
+
+template<typename VertexT, typename NormalT>
+void SharpBox<VertexT, NormalT>::flipEdges(BaseMesh<VertexT, NormalT> &mesh)
+{
+	if (!m_containsSharpFeature)
+	{
+		return;
+	}
+
+	const int* table = ExtendedMCTable[m_extendedMCIndex];
+	mesh.flipEdge(this->m_intersections[table[0]], this->m_intersections[table[1]]);
+	if (m_containsSharpCorner)
+	{
+		mesh.flipEdge(this->m_intersections[table[2]], this->m_intersections[table[3]]);
+	}
+	mesh.flipEdge(this->m_intersections[table[4]], this->m_intersections[table[5]]);
+}
+
 
+template<typename VertexT, typename NormalT>
+void SharpBox<VertexT, NormalT>::getSurface(
+        BaseMesh<VertexT, NormalT> &mesh,
+        vector<QueryPoint<VertexT> > &query_points,
+        uint &globalIndex)
+{
 	// Do not create traingles for invalid boxes
 	for (int i = 0; i < 8; i++)
 	{
@@ -167,8 +297,23 @@ void SharpBox<VertexT, NormalT>::getSurface(
 		}
 	}
 
-	// Check for presence of sharp features in the box
-	this->detectSharpFeatures(vertex_positions, vertex_normals, index);
+	// Check for presence of sharp features in the box if
+	// this was not done in advance
+	if (!m_classified)
+	{
+		classifyFeatures(query_points);
+	}
+
+	VertexT corners[8];
+	VertexT vertex_positions[12];
+
+	float distances[8];
+
+	this->getCorners(corners, query_points);
+	this->getDistances(distances, query_points);
+	this->getIntersections(corners, distances, vertex_positions);
+
+	int index = this->getIndex(query_points);
 
 	uint edge_index = 0;
 	int triangle_indices[3];
@@ -218,75 +363,7 @@ void SharpBox<VertexT, NormalT>::getSurface(
 	// Sharp feature detected -> use extended marching cubes
 	if (m_containsSharpFeature)
 	{
-		// save for edge flipping
-		m_extendedMCIndex = index;
-		//calculate intersection for the new vertex position
-		VertexT v = this->m_center;
-		if (m_containsSharpCorner)
-		{
-			//First plane
-			VertexT v1 = vertex_positions[ExtendedMCTable[index][0]];
-			NormalT n1 = vertex_normals[ExtendedMCTable[index][0]];
-
-			//Second plane
-			VertexT v2 = vertex_positions[ExtendedMCTable[index][1]];
-			NormalT n2 = vertex_normals[ExtendedMCTable[index][1]];
-
-			//Third plane
-			VertexT v3 = vertex_positions[ExtendedMCTable[index][3]];
-			NormalT n3 = vertex_normals[ExtendedMCTable[index][3]];
-
-			//calculate intersection between plane 1 and 2
-			if (fabs(n1 * n2) < 0.9)
-			{
-				float d1 = n1 * v1;
-				float d2 = n2 * v2;
-
-				VertexT direction = n1.cross(n2);
-
-				float denom = direction * direction;
-				VertexT x = ((n2 * d1 - n1 * d2).cross(direction)) * (1 / denom);
-
-				//calculate intersection between plane 3 and the intersection line between plane 1 and 2
-				float denom2 = n3 * direction;
-				if(fabs(denom2) > 0.0001)
-				{
-					float d = n3 * v3;
-					float t = (d - n3 * x) / (denom2);
-
-					VertexT intersection = x + direction * t;
-
-					v = intersection;
-				}
-			}
-		}
-		else
-		{
-			//First plane
-			VertexT v1 = (vertex_positions[ExtendedMCTable[index][2]] + vertex_positions[ExtendedMCTable[index][3]]) * 0.5;
-			NormalT n1 = (vertex_normals[ExtendedMCTable[index][2]] + vertex_normals[ExtendedMCTable[index][3]]) * 0.5;
-			//Second plane
-			VertexT v2 = (vertex_positions[ExtendedMCTable[index][6]] + vertex_positions[ExtendedMCTable[index][7]]) * 0.5;
-			NormalT n2 = (vertex_normals[ExtendedMCTable[index][6]] + vertex_normals[ExtendedMCTable[index][7]]) * 0.5;
-
-			//calculate intersection between plane 1 and 2
-			if (fabs(n1 * n2) < 0.9)
-			{
-				float d1 = n1 * v1;
-				float d2 = n2 * v2;
-
-				VertexT direction = n1.cross(n2);
-
-				float denom = direction * direction;
-				VertexT x = ((n2 * d1 - n1 * d2).cross(direction)) * (1 / denom);
-
-				// project center of the box onto intersection line of the two planes
-				v = x + direction * (((v - x) * direction) / (direction.length() * direction.length()));
-			}
-
-		}
-
-		mesh.addVertex(v);
+		mesh.addVertex(m_featureVertex);
 		mesh.addNormal(NormalT());
 		uint index_center = globalIndex++;
 		// Add triangle actually does the normal interpolation for us.
@@ -28,6 +28,9 @@
 
 
 #include "FastBox.hpp"
+#include <lvr/io/Progress.hpp>
+
+#include <stdint.h>
 
 namespace lvr
 {
@@ -59,9 +62,41 @@ public:
             vector<QueryPoint<VertexT> > &query_points,
             uint &globalIndex);
 
+    /**
+     * @brief Performs the reconstruction for all given boxes. The triangles
+     *        are computed in parallel for slabs of boxes. The vertices are
+     *        shared by a cache that maps the grid edge of an intersection
+     *        (cube edges, face diagonals and inner diagonals) to its vertex
+     *        index, so no neighbor bookkeeping is needed. Vertices and
+     *        triangles are inserted in the order of the boxes.
+     *
+     * @param mesh          The reconstructed mesh
+     * @param boxes         The boxes to process
+     * @param query_points  A vector containing the query points of the
+     *                      reconstruction grid
+     * @param globalIndex   The index of the newest vertex in the mesh
+     * @param progress      If not null, incremented once for every box
+     */
+    static void getSurfaces(
+            BaseMesh<VertexT, NormalT> &mesh,
+            vector<TetraederBox<VertexT, NormalT>* > &boxes,
+            vector<QueryPoint<VertexT> > &query_points,
+            uint &globalIndex,
+            ProgressBar* progress = 0);
+
 
 private:
 
+    /// Returns a key for the grid edge between two query points
+    static uint64_t edgeKey(uint v1, uint v2)
+    {
+        if(v1 > v2)
+        {
+            std::swap(v1, v2);
+        }
+        return ((uint64_t)v1 << 32) | v2;
+    }
+
     int calcPatternIndex(float distances[4])
     {
         int index = 0;
@@ -83,6 +118,12 @@ private:
 
 };
 
+template<typename VertexT, typename NormalT>
+struct BoxTraits<TetraederBox<VertexT, NormalT> >
+{
+	static const string type;
+};
+
 } /* namespace lvr */
 
 #include "TetraederBox.tcc"
@@ -25,9 +25,15 @@
 
 #include "TetraederTables.hpp"
 
+#include <boost/unordered_map.hpp>
+#include <algorithm>
+
 namespace lvr
 {
 
+template<typename VertexT, typename NormalT>
+const string BoxTraits<TetraederBox<VertexT, NormalT> >::type = "TetraederBox";
+
 template<typename VertexT, typename NormalT>
 TetraederBox<VertexT, NormalT>::TetraederBox(VertexT v) : FastBox<VertexT, NormalT>(v)
 {
@@ -204,5 +210,119 @@ void TetraederBox<VertexT, NormalT>::getSurface(
     }
 }
 
+template<typename VertexT, typename NormalT>
+void TetraederBox<VertexT, NormalT>::getSurfaces(
+        BaseMesh<VertexT, NormalT> &mesh,
+        vector<TetraederBox<VertexT, NormalT>* > &boxes,
+        vector<QueryPoint<VertexT> > &query_points,
+        uint &globalIndex,
+        ProgressBar* progress)
+{
+    if(boxes.empty())
+    {
+        return;
+    }
+
+    // Split the boxes into slabs. Each slab collects the grid
+    // edges of its triangles, three per triangle.
+    size_t slabSize = 1024;
+    size_t numSlabs = (boxes.size() + slabSize - 1) / slabSize;
+    vector<vector<uint64_t> > slabEdges(numSlabs);
+
+    #pragma omp parallel for schedule(dynamic)
+    for(long s = 0; s < (long)numSlabs; s++)
+    {
+        vector<uint64_t>& edges = slabEdges[s];
+        size_t end = std::min(boxes.size(), (s + 1) * slabSize);
+        for(size_t i = s * slabSize; i < end; i++)
+        {
+            const uint* vertices = boxes[i]->m_vertices;
+            for(int t_number = 0; t_number < 6; t_number++)
+            {
+                // Calculate the index for the surface generation
+                // look up table
+                int index = 0;
+                for(int j = 0; j < 4; j++)
+                {
+                    if(query_points[vertices[TetraederDefinitionTable[t_number][j]]].m_distance > 0)
+                    {
+                        index |= (1 << j);
+                    }
+                }
+
+                for(int a = 0; TetraederTable[index][a] != -1; a++)
+                {
+                    const unsigned char* corners = TetraederCornerTable[t_number][TetraederTable[index][a]];
+                    edges.push_back(edgeKey(vertices[corners[0]], vertices[corners[1]]));
+                }
+            }
+
+            if(progress)
+            {
+                ++(*progress);
+            }
+        }
+    }
+
+    // Assign vertex indices to the grid edges in the order of the boxes
+    size_t numIndices = 0;
+    for(size_t s = 0; s < numSlabs; s++)
+    {
+        numIndices += slabEdges[s].size();
+    }
+
+    boost::unordered_map<uint64_t, uint> cache;
+    cache.reserve(numIndices / 3);
+
+    vector<uint> indices;
+    indices.reserve(numIndices);
+
+    vector<uint64_t> newEdges;
+    for(size_t s = 0; s < numSlabs; s++)
+    {
+        const vector<uint64_t>& edges = slabEdges[s];
+        for(size_t i = 0; i < edges.size(); i++)
+        {
+            std::pair<typename boost::unordered_map<uint64_t, uint>::iterator, bool> res =
+                    cache.insert(std::make_pair(edges[i], globalIndex + (uint)newEdges.size()));
+            if(res.second)
+            {
+                newEdges.push_back(edges[i]);
+            }
+            indices.push_back(res.first->second);
+        }
+        vector<uint64_t>().swap(slabEdges[s]);
+    }
+
+    // Interpolate the new vertices
+    vector<VertexT> positions(newEdges.size());
+    TetraederBox<VertexT, NormalT>* box = boxes[0];
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)newEdges.size(); i++)
+    {
+        const QueryPoint<VertexT>& q1 = query_points[(uint)(newEdges[i] >> 32)];
+        const QueryPoint<VertexT>& q2 = query_points[(uint)(newEdges[i] & 0xFFFFFFFF)];
+        positions[i] = VertexT(
+                box->calcIntersection(q1.m_position.x, q2.m_position.x, q1.m_distance, q2.m_distance),
+                box->calcIntersection(q1.m_position.y, q2.m_position.y, q1.m_distance, q2.m_distance),
+                box->calcIntersection(q1.m_position.z, q2.m_position.z, q1.m_distance, q2.m_distance));
+    }
+
+    // Insert vertices and a new temp normal into mesh. The actual
+    // normals are interpolated later.
+    for(size_t i = 0; i < positions.size(); i++)
+    {
+        mesh.addVertex(positions[i]);
+        mesh.addNormal(NormalT());
+    }
+    globalIndex += (uint)positions.size();
+
+    // Add triangle actually does the normal interpolation for us.
+    for(size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        mesh.addTriangle(indices[i], indices[i + 1], indices[i + 2]);
+    }
+}
 
 } /* namespace lvr */
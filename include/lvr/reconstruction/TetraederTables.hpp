@@ -89,6 +89,18 @@ const static int TetraederDefinitionTable[6][4] =
         {2, 5, 6, 7}    // 5
 };
 
+/// The box corners of the six intersection edges of each tetraeder in
+/// the order used by the TetraederTable
+const static unsigned char TetraederCornerTable[6][6][2] =
+{
+        {{0, 1}, {1, 4}, {4, 0}, {0, 3}, {1, 3}, {4, 3}},   // 0
+        {{3, 1}, {1, 4}, {4, 3}, {3, 2}, {1, 2}, {4, 2}},   // 1
+        {{4, 2}, {2, 7}, {7, 4}, {4, 3}, {2, 3}, {7, 3}},   // 2
+        {{1, 5}, {5, 4}, {4, 1}, {1, 2}, {5, 2}, {4, 2}},   // 3
+        {{4, 5}, {5, 7}, {7, 4}, {4, 2}, {5, 2}, {7, 2}},   // 4
+        {{2, 5}, {5, 7}, {7, 2}, {2, 6}, {5, 6}, {7, 6}}    // 5
+};
+
 const static int TetraederNeighborTable[19][3] =
 {
         {12, 10,  9}, // 0
@@ -0,0 +1,115 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+/*
+ * VoxelGridReduction.hpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#ifndef VOXELGRIDREDUCTION_HPP_
+#define VOXELGRIDREDUCTION_HPP_
+
+#include <lvr/reconstruction/PointCloudReduction.hpp>
+
+#include <boost/unordered_map.hpp>
+
+#include <vector>
+
+namespace lvr
+{
+
+/**
+ * @brief   Reduces a point cloud to (at most) one point per voxel of a
+ *          regular grid.
+ *
+ *          The occupied voxels are stored in a hash map that is split into
+ *          shards. The points of a block are partitioned by shard in a
+ *          parallel counting pass, afterwards each shard is updated by
+ *          exactly one thread, so blocks are processed in parallel without
+ *          any locking.
+ */
+class VoxelGridReduction : public PointCloudReduction
+{
+public:
+
+    /// Determines which point represents a voxel
+    enum Mode
+    {
+        /// Mean position (and color) of all points in the voxel
+        Centroid,
+
+        /// The original point that is closest to the voxel center
+        ClosestToCenter
+    };
+
+    /**
+     * @brief   Constructor.
+     *
+     * @param   voxelSize   Edge length of the voxels
+     * @param   mode        Representative point of each voxel
+     */
+    VoxelGridReduction(float voxelSize, Mode mode = Centroid);
+
+    virtual ~VoxelGridReduction() {}
+
+    using PointCloudReduction::addPoints;
+
+    virtual void addPoints(const float* points, const unsigned char* colors, const float* normals, size_t n);
+
+    virtual PointBufferPtr getReducedPoints();
+
+    virtual void clear();
+
+private:
+
+    /// Accumulated information for a single voxel
+    struct Voxel
+    {
+        double  sum[3];
+        double  colorSum[3];
+        float   normalSum[3];
+        float   point[3];
+        float   normal[3];
+        unsigned char color[3];
+        float   distance;
+        size_t  count;
+    };
+
+    typedef boost::unordered_map<uint64_t, Voxel> VoxelMap;
+
+    /// Edge length of the voxels
+    float                   m_voxelSize;
+
+    /// Selected representative
+    Mode                    m_mode;
+
+    /// True if color information was passed
+    bool                    m_hasColors;
+
+    /// True if normals were passed
+    bool                    m_hasNormals;
+
+    /// Sharded hash maps of occupied voxels
+    std::vector<VoxelMap>   m_shards;
+};
+
+} // namespace lvr
+
+#endif /* VOXELGRIDREDUCTION_HPP_ */
@@ -28,6 +28,7 @@
 #define TEXTURIZER_HPP_
 
 #include <lvr/reconstruction/PointsetSurface.hpp>
+#include <lvr/reconstruction/PointsetSurfaceQuery.hpp>
 #include <lvr/io/TextureIO.hpp>
 #include "TextureToken.hpp"
 #include "ImageProcessor.hpp"
@@ -312,28 +312,32 @@ TextureToken<VertexT, NormalT>* Texturizer<VertexT, NormalT>::createInitialTextu
     string msg = timestamp.getElapsedTime() + "Calculating Texture Pixels... ";
     ProgressBar progress(sizeX * sizeY, msg);
 
-    #pragma omp parallel for
-	for(int y = 0; y < sizeY; y++)
-	{
-		for(int x = 0; x < sizeX; x++)
-		{
-			vector<VertexT> cv;
+    PointsetSurfaceQuery<VertexT> query(m_pm);
 
-			VertexT current_position = p + best_v1
-				* (x * Texture::m_texelSize + best_a_min - Texture::m_texelSize / 2.0)
-				+ best_v2
-				* (y * Texture::m_texelSize + best_b_min - Texture::m_texelSize / 2.0);
+    #pragma omp parallel
+    {
+        typename PointsetSurfaceQuery<VertexT>::Context ctx;
 
-			int one = 1;
-			m_pm->searchTree()->kSearch(current_position, one, cv);
+        #pragma omp for
+        for(int y = 0; y < sizeY; y++)
+        {
+            for(int x = 0; x < sizeX; x++)
+            {
+                VertexT current_position = p + best_v1
+                    * (x * Texture::m_texelSize + best_a_min - Texture::m_texelSize / 2.0)
+                    + best_v2
+                    * (y * Texture::m_texelSize + best_b_min - Texture::m_texelSize / 2.0);
 
-			texture->m_data[(sizeY - y - 1) * (sizeX * 3) + 3 * x + 0] = cv[0].r;
-			texture->m_data[(sizeY - y - 1) * (sizeX * 3) + 3 * x + 1] = cv[0].g;
-			texture->m_data[(sizeY - y - 1) * (sizeX * 3) + 3 * x + 2] = cv[0].b;
+                query.kSearchPoints(current_position, 1, ctx);
+                const vector<VertexT>& cv = ctx.neighbors;
 
-		}
-        ++progress;
-	}
+                texture->m_data[(sizeY - y - 1) * (sizeX * 3) + 3 * x + 0] = cv[0].r;
+                texture->m_data[(sizeY - y - 1) * (sizeX * 3) + 3 * x + 1] = cv[0].g;
+                texture->m_data[(sizeY - y - 1) * (sizeX * 3) + 3 * x + 2] = cv[0].b;
+            }
+            ++progress;
+        }
+    }
 
 	//calculate SURF features of  texture
 	ImageProcessor::calcSURF(texture);
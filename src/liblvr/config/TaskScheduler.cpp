@@ -0,0 +1,335 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+/*
+ * TaskScheduler.cpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/config/TaskScheduler.hpp>
+
+#ifdef LVR_USE_OPEN_MP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+
+using namespace std;
+
+namespace lvr
+{
+
+namespace
+{
+
+/// Index of the worker that runs on the current thread
+thread_local int t_workerIndex = -1;
+
+} // namespace
+
+TaskScheduler& TaskScheduler::instance()
+{
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+TaskScheduler::TaskScheduler()
+    : m_numThreads(1), m_numQueued(0), m_stop(false)
+{
+    m_numThreads = max(1, (int)thread::hardware_concurrency());
+    start();
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    stop();
+}
+
+int TaskScheduler::workerIndex()
+{
+    return t_workerIndex;
+}
+
+void TaskScheduler::setNumThreads(int n)
+{
+    n = max(1, n);
+    if(n == m_numThreads)
+    {
+        return;
+    }
+
+    stop();
+    m_numThreads = n;
+    start();
+}
+
+void TaskScheduler::start()
+{
+    m_stop = false;
+
+    // One queue per worker and one shared queue for
+    // all other threads
+    int numWorkers = m_numThreads - 1;
+    for(int i = 0; i <= numWorkers; i++)
+    {
+        m_queues.push_back(new Queue);
+    }
+
+    for(int i = 0; i < numWorkers; i++)
+    {
+        m_workers.push_back(thread(&TaskScheduler::workerLoop, this, i));
+    }
+}
+
+void TaskScheduler::stop()
+{
+    {
+        lock_guard<mutex> lock(m_sleepMutex);
+        m_stop = true;
+    }
+    m_sleepCondition.notify_all();
+
+    for(size_t i = 0; i < m_workers.size(); i++)
+    {
+        m_workers[i].join();
+    }
+    m_workers.clear();
+
+    for(size_t i = 0; i < m_queues.size(); i++)
+    {
+        delete m_queues[i];
+    }
+    m_queues.clear();
+}
+
+void TaskScheduler::spawn(const Task& task, TaskGroup* group)
+{
+    group->m_pending++;
+
+    // Workers push to their own queue, all other
+    // threads use the shared queue
+    int index = t_workerIndex >= 0 ? t_workerIndex : (int)m_queues.size() - 1;
+    Queue* queue = m_queues[index];
+    {
+        lock_guard<mutex> lock(queue->mutex);
+        Item item;
+        item.task = task;
+        item.group = group;
+        queue->items.push_back(item);
+    }
+    m_numQueued++;
+
+    {
+        lock_guard<mutex> lock(m_sleepMutex);
+    }
+    m_sleepCondition.notify_one();
+}
+
+bool TaskScheduler::executeOne()
+{
+    if(m_numQueued.load() <= 0)
+    {
+        return false;
+    }
+
+    Item item;
+    bool found = false;
+
+    int own = t_workerIndex >= 0 ? t_workerIndex : (int)m_queues.size() - 1;
+
+    // Take the newest task of the own queue
+    {
+        Queue* queue = m_queues[own];
+        lock_guard<mutex> lock(queue->mutex);
+        if(!queue->items.empty())
+        {
+            item = queue->items.back();
+            queue->items.pop_back();
+            found = true;
+        }
+    }
+
+    // Steal the oldest task of another queue
+    for(size_t i = 1; !found && i < m_queues.size(); i++)
+    {
+        Queue* queue = m_queues[(own + i) % m_queues.size()];
+        lock_guard<mutex> lock(queue->mutex);
+        if(!queue->items.empty())
+        {
+            item = queue->items.front();
+            queue->items.pop_front();
+            found = true;
+        }
+    }
+
+    if(!found)
+    {
+        return false;
+    }
+
+    m_numQueued--;
+
+    exception_ptr error;
+    try
+    {
+        item.task();
+    }
+    catch(...)
+    {
+        error = current_exception();
+    }
+    item.group->finished(error);
+
+    return true;
+}
+
+void TaskScheduler::workerLoop(int index)
+{
+    t_workerIndex = index;
+
+#ifdef LVR_USE_OPEN_MP
+    // Parallel OpenMP loops inside of tasks run sequentially
+    omp_set_num_threads(1);
+#endif
+
+    while(true)
+    {
+        if(executeOne())
+        {
+            continue;
+        }
+
+        unique_lock<mutex> lock(m_sleepMutex);
+        m_sleepCondition.wait(lock, [this]() { return m_stop.load() || m_numQueued.load() > 0; });
+        if(m_stop)
+        {
+            return;
+        }
+    }
+}
+
+void TaskScheduler::chunks(size_t begin, size_t end, size_t grain, vector<size_t>& bounds) const
+{
+    bounds.clear();
+    if(end <= begin)
+    {
+        return;
+    }
+
+    size_t n = end - begin;
+    if(grain == 0)
+    {
+        // A few chunks per thread for load balancing
+        grain = max((size_t)1, n / (4 * m_numThreads));
+    }
+
+    size_t numChunks = max((size_t)1, n / grain);
+    for(size_t i = 0; i < numChunks; i++)
+    {
+        bounds.push_back(begin + i * n / numChunks);
+    }
+    bounds.push_back(end);
+}
+
+void TaskScheduler::parallelFor(size_t begin, size_t end,
+                                const function<void(size_t, size_t)>& body,
+                                size_t grain)
+{
+    vector<size_t> bounds;
+    chunks(begin, end, grain, bounds);
+
+    if(bounds.size() == 2 || m_numThreads == 1)
+    {
+        if(!bounds.empty())
+        {
+            body(begin, end);
+        }
+        return;
+    }
+
+    TaskGroup group;
+    for(size_t i = 0; i + 1 < bounds.size(); i++)
+    {
+        size_t b = bounds[i];
+        size_t e = bounds[i + 1];
+        group.run([&body, b, e]() { body(b, e); });
+    }
+    group.wait();
+}
+
+TaskGroup::TaskGroup() : m_pending(0)
+{
+
+}
+
+TaskGroup::~TaskGroup()
+{
+    // Tasks reference the group, so we have to wait for them
+    while(m_pending.load() > 0)
+    {
+        if(!TaskScheduler::instance().executeOne())
+        {
+            this_thread::yield();
+        }
+    }
+}
+
+void TaskGroup::run(const TaskScheduler::Task& task)
+{
+    TaskScheduler::instance().spawn(task, this);
+}
+
+void TaskGroup::wait()
+{
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    while(m_pending.load() > 0)
+    {
+        if(!scheduler.executeOne())
+        {
+            this_thread::yield();
+        }
+    }
+
+    exception_ptr error;
+    {
+        lock_guard<mutex> lock(m_errorMutex);
+        swap(error, m_error);
+    }
+
+    if(error)
+    {
+        rethrow_exception(error);
+    }
+}
+
+void TaskGroup::finished(exception_ptr error)
+{
+    if(error)
+    {
+        lock_guard<mutex> lock(m_errorMutex);
+        if(!m_error)
+        {
+            m_error = error;
+        }
+    }
+    m_pending--;
+}
+
+} // namespace lvr
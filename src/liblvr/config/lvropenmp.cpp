@@ -25,6 +25,7 @@
  */
 
 #include <lvr/config/lvropenmp.hpp>
+#include <lvr/config/TaskScheduler.hpp>
 
 #ifdef LVR_USE_OPEN_MP
 #include <omp.h>
@@ -50,6 +51,7 @@ void OpenMPConfig::setNumThreads(int n)
 #ifdef LVR_USE_OPEN_MP
 	omp_set_num_threads(n);
 #endif
+	TaskScheduler::instance().setNumThreads(n);
 }
 
 void OpenMPConfig::setMaxNumThreads()
@@ -57,6 +59,7 @@ void OpenMPConfig::setMaxNumThreads()
 #ifdef LVR_USE_OPEN_MP
 	omp_set_num_threads(omp_get_num_procs());
 #endif
+	TaskScheduler::instance().setNumThreads(std::thread::hardware_concurrency());
 }
 
 int OpenMPConfig::getNumThreads()
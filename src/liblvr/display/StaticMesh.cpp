@@ -25,6 +25,7 @@
  */
 
 #include <lvr/display/StaticMesh.hpp>
+#include <lvr/geometry/MeshNormals.hpp>
 
 #include <cassert>
 
@@ -298,64 +299,10 @@ void StaticMesh::interpolateNormals()
 	assert(m_vertices);
 	assert(m_faces);
 
-	// Alloc new normal array
+	// Alloc new normal array and sum up the area weighted
+	// face normals at each vertex position
 	m_faceNormals = new float[3 * m_numVertices];
-	memset(m_faceNormals, 0, 3 * m_numVertices * sizeof(float));
-
-	// Interpolate surface m_normals for each face
-	// and interpolate sum up the normal coordinates
-	// at each vertex position
-	size_t a, b, c, buffer_pos;
-	for(size_t i = 0; i < m_numFaces; i++)
-	{
-		buffer_pos = i * 3;
-
-		// Interpolate a perpendicular vector to the
-		// current triangle (p)
-		//
-		// CAUTION:
-		// --------
-		// buffer_pos is the face number
-		// to get real position of the vertex in the buffer
-		// we have to remember, that each vertex has three
-		// coordinates!		cout << 1 << endl;
-		a = m_faces[buffer_pos]     * 3;
-		b = m_faces[buffer_pos + 1] * 3;
-		c = m_faces[buffer_pos + 2] * 3;
-
-		Vertex<float> v0(m_vertices[a], m_vertices[a + 1], m_vertices[a + 2]);
-		Vertex<float> v1(m_vertices[b], m_vertices[b + 1], m_vertices[b + 2]);
-		Vertex<float> v2(m_vertices[c], m_vertices[c + 1], m_vertices[c + 2]);
-
-		Vertex<float> d1 = v0 - v1;
-		Vertex<float> d2 = v2 - v1;
-
-		Normal<float> p(d1.cross(d2));
-		p = p * -1;
-
-		// Sum up coordinate values in normal array
-		m_faceNormals[a    ] = p.x;
-		m_faceNormals[a + 1] = p.y;
-		m_faceNormals[a + 2] = p.z;
-
-		m_faceNormals[b    ] = p.x;
-		m_faceNormals[b + 1] = p.y;
-		m_faceNormals[b + 2] = p.z;
-
-		m_faceNormals[c    ] = p.x;
-		m_faceNormals[c + 1] = p.y;
-		m_faceNormals[c + 2] = p.z;
-
-	}
-
-	// Normalize
-	for(size_t i = 0; i < m_numVertices; i++)
-	{
-		Normal<float> n(m_faceNormals[i * 3], m_faceNormals[i * 3 + 1], m_faceNormals[i * 3 + 2]);
-		m_faceNormals[i * 3]     = n.x;
-		m_faceNormals[i * 3 + 1] = n.y;
-		m_faceNormals[i * 3 + 2] = n.z;
-	}
+	calcVertexNormals(m_vertices.get(), m_numVertices, m_faces.get(), m_numFaces, m_faceNormals);
 
 }
 
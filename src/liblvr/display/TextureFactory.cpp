@@ -46,7 +46,9 @@ GlTexture* TextureFactory::getTexture(string filename) const
 	if(filename.substr(filename.find_last_of(".") + 1, 3) == "ppm")
 	{
 		lvr::PPMIO reader(filename.substr(0, filename.find_last_of(".") + 4));
-		data    = reader.getPixels();
+
+		// Gray, 16 bit and float images are converted to 8 bit RGB
+		data    = reader.getRGB8();
 
 //		cv::Mat mat = cv::imread(filename.substr(0, filename.find_last_of(".") + 4));
 //		data    = mat.data;
@@ -24,6 +24,7 @@
  */
 
 #include <lvr/display/TexturedMesh.hpp>
+#include <lvr/geometry/MeshNormals.hpp>
 
 #include <map>
 using std::multimap;
@@ -50,14 +51,22 @@ TexturedMesh::TexturedMesh(MeshBufferPtr mesh)
 {
 	// Store internal buffers
 	size_t	dummy;
+	size_t	n_normals;
 	m_faces 		= mesh->getFaceArray(m_numFaces);
 	m_faceMaterials = mesh->getFaceMaterialIndexArray(dummy);
 	m_vertices 		= mesh->getVertexArray(m_numVertices);
-	m_normals		= mesh->getVertexNormalArray(dummy);
+	m_normals		= mesh->getVertexNormalArray(n_normals);
 	m_texcoords		= mesh->getVertexTextureCoordinateArray(dummy);
 	m_textures		= mesh->getTextureArray(m_numTextures);
 	m_materials		= mesh->getMaterialArray(m_numMaterials);
 
+	// Calculate vertex normals if the buffer does not provide them
+	if(!m_normals || n_normals != m_numVertices)
+	{
+		m_normals = floatArr(new float[3 * m_numVertices]);
+		calcVertexNormals(m_vertices.get(), m_numVertices, m_faces.get(), m_numFaces, m_normals.get());
+	}
+
 	// Calc bounding box
 	for(size_t i = 0; i < m_numVertices; i++)
 	{
@@ -0,0 +1,414 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * MeshComponents.cpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/geometry/MeshComponents.hpp>
+#include <lvr/geometry/ConcurrentUnionFind.hpp>
+#include <lvr/io/Timestamp.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+using namespace std;
+
+namespace lvr
+{
+
+MeshComponents::MeshComponents(
+        const float* vertices,
+        size_t numVertices,
+        const unsigned int* faces,
+        size_t numFaces)
+{
+    m_faceComponents.resize(numFaces);
+    if(numFaces == 0)
+    {
+        return;
+    }
+
+    // Bucket the face edges by their smaller vertex index
+    vector<size_t> offsets(numVertices + 1, 0);
+    for(size_t i = 0; i < 3 * numFaces; i++)
+    {
+        unsigned int a = faces[i];
+        unsigned int b = faces[i - i % 3 + (i + 1) % 3];
+        offsets[min(a, b) + 1]++;
+    }
+    for(size_t i = 0; i < numVertices; i++)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+
+    // Edges are stored as (larger vertex index, face) pairs
+    vector<pair<uint32_t, uint32_t> > edges(3 * numFaces);
+    vector<size_t> pos(offsets.begin(), offsets.end() - 1);
+    for(size_t i = 0; i < 3 * numFaces; i++)
+    {
+        unsigned int a = faces[i];
+        unsigned int b = faces[i - i % 3 + (i + 1) % 3];
+        edges[pos[min(a, b)]++] = make_pair((uint32_t)max(a, b), (uint32_t)(i / 3));
+    }
+
+    ConcurrentUnionFind sets(numFaces);
+
+    // Unite all faces that share an edge. Buckets are small,
+    // so sorting them is cheap.
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for(long v = 0; v < (long)numVertices; v++)
+    {
+        vector<pair<uint32_t, uint32_t> >::iterator begin = edges.begin() + offsets[v];
+        vector<pair<uint32_t, uint32_t> >::iterator end   = edges.begin() + offsets[v + 1];
+        sort(begin, end);
+
+        for(vector<pair<uint32_t, uint32_t> >::iterator it = begin; it != end; ++it)
+        {
+            if(it != begin && (it - 1)->first == it->first)
+            {
+                sets.unite((it - 1)->second, it->second);
+            }
+        }
+    }
+
+    // Number the components in the order of their roots
+    const uint32_t invalid = numeric_limits<uint32_t>::max();
+    vector<uint32_t> rootComponent(numFaces, invalid);
+    size_t numComponents = 0;
+    for(size_t i = 0; i < numFaces; i++)
+    {
+        if(sets.isRoot((uint32_t)i))
+        {
+            rootComponent[i] = (uint32_t)numComponents++;
+        }
+    }
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numFaces; i++)
+    {
+        m_faceComponents[i] = rootComponent[sets.find((uint32_t)i)];
+    }
+
+    // Face areas in parallel, component statistics in a
+    // single pass afterwards
+    vector<float> areas(numFaces);
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numFaces; i++)
+    {
+        const float* a = vertices + 3 * faces[3 * i];
+        const float* b = vertices + 3 * faces[3 * i + 1];
+        const float* c = vertices + 3 * faces[3 * i + 2];
+
+        float u[3], w[3];
+        for(int j = 0; j < 3; j++)
+        {
+            u[j] = b[j] - a[j];
+            w[j] = c[j] - a[j];
+        }
+
+        float nx = u[1] * w[2] - u[2] * w[1];
+        float ny = u[2] * w[0] - u[0] * w[2];
+        float nz = u[0] * w[1] - u[1] * w[0];
+        areas[i] = 0.5f * sqrt(nx * nx + ny * ny + nz * nz);
+    }
+
+    MeshComponent empty;
+    empty.numFaces = 0;
+    empty.area = 0.0f;
+    for(int j = 0; j < 3; j++)
+    {
+        empty.bbMin[j] = numeric_limits<float>::max();
+        empty.bbMax[j] = -numeric_limits<float>::max();
+    }
+    m_components.assign(numComponents, empty);
+
+    for(size_t i = 0; i < numFaces; i++)
+    {
+        MeshComponent& comp = m_components[m_faceComponents[i]];
+        comp.numFaces++;
+        comp.area += areas[i];
+        for(int k = 0; k < 3; k++)
+        {
+            const float* p = vertices + 3 * faces[3 * i + k];
+            for(int j = 0; j < 3; j++)
+            {
+                comp.bbMin[j] = min(comp.bbMin[j], p[j]);
+                comp.bbMax[j] = max(comp.bbMax[j], p[j]);
+            }
+        }
+    }
+}
+
+vector<size_t> MeshComponents::sizeHistogram() const
+{
+    vector<size_t> histogram;
+    for(size_t i = 0; i < m_components.size(); i++)
+    {
+        size_t bucket = 0;
+        for(size_t n = m_components[i].numFaces; n > 1; n >>= 1)
+        {
+            bucket++;
+        }
+
+        if(bucket >= histogram.size())
+        {
+            histogram.resize(bucket + 1, 0);
+        }
+        histogram[bucket]++;
+    }
+    return histogram;
+}
+
+void MeshComponents::printStatistics() const
+{
+    cout << timestamp << "Found " << m_components.size() << " connected components" << endl;
+
+    vector<size_t> histogram = sizeHistogram();
+    for(size_t i = 0; i < histogram.size(); i++)
+    {
+        if(histogram[i])
+        {
+            cout << timestamp << "  " << (1ul << i) << " - " << (2ul << i) - 1
+                 << " faces: " << histogram[i] << endl;
+        }
+    }
+}
+
+size_t MeshComponents::markSmallComponents(size_t threshold, vector<unsigned char>& marked) const
+{
+    marked.resize(m_faceComponents.size());
+
+    size_t numMarked = 0;
+
+    #pragma omp parallel for schedule(static) reduction(+:numMarked)
+    for(long i = 0; i < (long)m_faceComponents.size(); i++)
+    {
+        marked[i] = m_components[m_faceComponents[i]].numFaces <= threshold;
+        numMarked += marked[i];
+    }
+
+    return numMarked;
+}
+
+MeshBufferPtr MeshComponents::removeSmallComponents(MeshBufferPtr mesh, size_t threshold)
+{
+    size_t numVertices = 0;
+    size_t numFaces = 0;
+    floatArr vertices = mesh->getVertexArray(numVertices);
+    uintArr faces = mesh->getFaceArray(numFaces);
+
+    if(!vertices || !faces || numFaces == 0)
+    {
+        return mesh;
+    }
+
+    MeshComponents components(vertices.get(), numVertices, faces.get(), numFaces);
+    components.printStatistics();
+
+    vector<unsigned char> removed;
+    size_t numRemoved = components.markSmallComponents(threshold, removed);
+    if(numRemoved == 0)
+    {
+        return mesh;
+    }
+
+    cout << timestamp << "Removing " << numRemoved << " faces of small components" << endl;
+
+    // Keep the faces of the large components and all vertices
+    // that are referenced by them
+    vector<size_t> faceMap;
+    faceMap.reserve(numFaces - numRemoved);
+    vector<unsigned char> usedVertex(numVertices, 0);
+    for(size_t i = 0; i < numFaces; i++)
+    {
+        if(!removed[i])
+        {
+            faceMap.push_back(i);
+            for(int k = 0; k < 3; k++)
+            {
+                usedVertex[faces[3 * i + k]] = 1;
+            }
+        }
+    }
+
+    const unsigned int invalid = numeric_limits<unsigned int>::max();
+    vector<unsigned int> newIndex(numVertices, invalid);
+    vector<size_t> vertexMap;
+    for(size_t i = 0; i < numVertices; i++)
+    {
+        if(usedVertex[i])
+        {
+            newIndex[i] = (unsigned int)vertexMap.size();
+            vertexMap.push_back(i);
+        }
+    }
+
+    size_t newNumVertices = vertexMap.size();
+    size_t newNumFaces = faceMap.size();
+
+    MeshBufferPtr result(new MeshBuffer);
+
+    uintArr newFaces(new unsigned int[3 * newNumFaces]);
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)newNumFaces; i++)
+    {
+        for(int k = 0; k < 3; k++)
+        {
+            newFaces[3 * i + k] = newIndex[faces[3 * faceMap[i] + k]];
+        }
+    }
+    result->setFaceArray(newFaces, newNumFaces);
+
+    // Copy the per vertex attributes with the given number
+    // of components per vertex
+    size_t n = 0;
+
+    floatArr normals = mesh->getVertexNormalArray(n);
+    floatArr confidences;
+    floatArr intensities;
+    floatArr texCoords;
+    ucharArr colors;
+
+    floatArr newVertices(new float[3 * newNumVertices]);
+    floatArr newNormals;
+    floatArr newConfidences;
+    floatArr newIntensities;
+    floatArr newTexCoords;
+    ucharArr newColors;
+
+    if(normals && n == numVertices)
+    {
+        newNormals = floatArr(new float[3 * newNumVertices]);
+    }
+
+    confidences = mesh->getVertexConfidenceArray(n);
+    if(confidences && n == numVertices)
+    {
+        newConfidences = floatArr(new float[newNumVertices]);
+    }
+
+    intensities = mesh->getVertexIntensityArray(n);
+    if(intensities && n == numVertices)
+    {
+        newIntensities = floatArr(new float[newNumVertices]);
+    }
+
+    texCoords = mesh->getVertexTextureCoordinateArray(n);
+    if(texCoords && n == numVertices)
+    {
+        newTexCoords = floatArr(new float[3 * newNumVertices]);
+    }
+
+    colors = mesh->getVertexColorArray(n);
+    if(colors && n == numVertices)
+    {
+        newColors = ucharArr(new unsigned char[3 * newNumVertices]);
+    }
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)newNumVertices; i++)
+    {
+        size_t old = vertexMap[i];
+        for(int j = 0; j < 3; j++)
+        {
+            newVertices[3 * i + j] = vertices[3 * old + j];
+            if(newNormals)
+            {
+                newNormals[3 * i + j] = normals[3 * old + j];
+            }
+            if(newTexCoords)
+            {
+                newTexCoords[3 * i + j] = texCoords[3 * old + j];
+            }
+            if(newColors)
+            {
+                newColors[3 * i + j] = colors[3 * old + j];
+            }
+        }
+
+        if(newConfidences)
+        {
+            newConfidences[i] = confidences[old];
+        }
+        if(newIntensities)
+        {
+            newIntensities[i] = intensities[old];
+        }
+    }
+
+    result->setVertexArray(newVertices, newNumVertices);
+    if(newNormals)
+    {
+        result->setVertexNormalArray(newNormals, newNumVertices);
+    }
+    if(newConfidences)
+    {
+        result->setVertexConfidenceArray(newConfidences, newNumVertices);
+    }
+    if(newIntensities)
+    {
+        result->setVertexIntensityArray(newIntensities, newNumVertices);
+    }
+    if(newTexCoords)
+    {
+        result->setVertexTextureCoordinateArray(newTexCoords, newNumVertices);
+    }
+    if(newColors)
+    {
+        result->setVertexColorArray(newColors, newNumVertices);
+    }
+
+    // Materials and textures are shared, only the per face
+    // material indices have to be compacted
+    uintArr materialIndices = mesh->getFaceMaterialIndexArray(n);
+    if(materialIndices && n == numFaces)
+    {
+        uintArr newMaterialIndices(new unsigned int[newNumFaces]);
+        for(size_t i = 0; i < newNumFaces; i++)
+        {
+            newMaterialIndices[i] = materialIndices[faceMap[i]];
+        }
+        result->setFaceMaterialIndexArray(newMaterialIndices, newNumFaces);
+    }
+
+    materialArr materials = mesh->getMaterialArray(n);
+    if(materials)
+    {
+        result->setMaterialArray(materials, n);
+    }
+
+    textureArr textures = mesh->getTextureArray(n);
+    if(textures)
+    {
+        result->setTextureArray(textures, n);
+    }
+
+    return result;
+}
+
+} // namespace lvr
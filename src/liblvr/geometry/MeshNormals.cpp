@@ -0,0 +1,139 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * MeshNormals.cpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/geometry/MeshNormals.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace lvr
+{
+
+void calcVertexNormals(
+        const float* vertices,
+        size_t numVertices,
+        const unsigned int* faces,
+        size_t numFaces,
+        float* normals)
+{
+    // Unnormalized face normals. The length of the cross product
+    // is twice the face area, so summing them up gives the area
+    // weighting for free. The loop body only works on plain floats
+    // so the compiler is able to vectorize the cross products.
+    std::vector<float> faceNormals(3 * numFaces);
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numFaces; i++)
+    {
+        const float* a = vertices + 3 * faces[3 * i];
+        const float* b = vertices + 3 * faces[3 * i + 1];
+        const float* c = vertices + 3 * faces[3 * i + 2];
+
+        float ux = b[0] - a[0];
+        float uy = b[1] - a[1];
+        float uz = b[2] - a[2];
+
+        float vx = c[0] - a[0];
+        float vy = c[1] - a[1];
+        float vz = c[2] - a[2];
+
+        faceNormals[3 * i]     = uy * vz - uz * vy;
+        faceNormals[3 * i + 1] = uz * vx - ux * vz;
+        faceNormals[3 * i + 2] = ux * vy - uy * vx;
+    }
+
+    // Build vertex -> face incidence lists in CSR layout. The
+    // offsets are calculated by counting and a prefix sum.
+    std::vector<size_t> offsets(numVertices + 1, 0);
+    for(size_t i = 0; i < 3 * numFaces; i++)
+    {
+        offsets[faces[i] + 1]++;
+    }
+
+    for(size_t i = 0; i < numVertices; i++)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+
+    std::vector<unsigned int> incidentFaces(3 * numFaces);
+    std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+    for(size_t i = 0; i < 3 * numFaces; i++)
+    {
+        incidentFaces[fill[faces[i]]++] = (unsigned int)(i / 3);
+    }
+
+    // Gather the face normals for each vertex. Every vertex is
+    // only touched by one thread, so no synchronization is needed.
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numVertices; i++)
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+
+        for(size_t j = offsets[i]; j < offsets[i + 1]; j++)
+        {
+            const float* n = &faceNormals[3 * incidentFaces[j]];
+            x += n[0];
+            y += n[1];
+            z += n[2];
+        }
+
+        float length = sqrt(x * x + y * y + z * z);
+        if(length > 0.0f)
+        {
+            x /= length;
+            y /= length;
+            z /= length;
+        }
+
+        normals[3 * i]     = x;
+        normals[3 * i + 1] = y;
+        normals[3 * i + 2] = z;
+    }
+}
+
+floatArr calcVertexNormals(MeshBufferPtr mesh)
+{
+    size_t numVertices = 0;
+    size_t numFaces = 0;
+
+    floatArr vertices = mesh->getVertexArray(numVertices);
+    uintArr  faces    = mesh->getFaceArray(numFaces);
+
+    if(!vertices || !faces || numVertices == 0 || numFaces == 0)
+    {
+        return floatArr();
+    }
+
+    floatArr normals(new float[3 * numVertices]);
+    calcVertexNormals(vertices.get(), numVertices, faces.get(), numFaces, normals.get());
+    mesh->setVertexNormalArray(normals, numVertices);
+
+    return normals;
+}
+
+} // namespace lvr
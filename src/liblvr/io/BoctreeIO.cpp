@@ -26,6 +26,7 @@
 #include <stdio.h>
 
 #include <lvr/io/BoctreeIO.hpp>
+#include <lvr/io/BoctreeScans.hpp>
 #include <lvr/io/Timestamp.hpp>
 
 #include <lvr/geometry/Matrix4.hpp>
@@ -75,7 +76,9 @@ ModelPtr BoctreeIO::read(string directory )
 
 
 
-    list<Point> allPoints;
+    // The octrees are kept for searching, the points are
+    // transformed and flattened directly from their leaves
+    BoctreeScansPtr scans(new BoctreeScans);
     if(numScans)
     {
 
@@ -87,8 +90,6 @@ ModelPtr BoctreeIO::read(string directory )
             cout << timestamp << "Reading " << scanfile << endl;
 
             Matrix4<float> tf;
-            vector<Point> points;
-            BOctTree<float>::deserialize(scanfile, points);
 
             // Try to get transformation from .frames file
             boost::filesystem::path frame_path(
@@ -128,83 +129,17 @@ ModelPtr BoctreeIO::read(string directory )
 
             }
 
-            // Ugly hack to transform scan data
-            for(int j = 0; j < points.size(); j++)
-            {
-                Vertex<float> v(points[j].x, points[j].y, points[j].z);
-                v = tf * v;
-                if(v.length() < 10000)
-                {
-                    points[j].x = v[0];
-                    points[j].y = v[1];
-                    points[j].z = v[2];
-                    allPoints.push_back(points[j]);
-                }
-
-            }
-
-
+            scans->addScan(scanfile, tf);
         }
     }
 
-    cout << timestamp << "Read " << allPoints.size() << " points." << endl;
+    cout << timestamp << "Read " << scans->numPoints() << " points." << endl;
 
     ModelPtr model( new Model );
 
-    if(allPoints.size())
+    if(scans->numPoints())
     {
-        floatArr points(new float[3 * allPoints.size()]);
-        ucharArr colors(new unsigned char[3 * allPoints.size()]);
-        floatArr intensities( new float[allPoints.size()]);
-
-        int i = 0;
-        bool found_color = false;
-        float min_r = 1e10;
-        float max_r = -1e10;
-        for(list<Point>::iterator it = allPoints.begin(); it != allPoints.end(); it++)
-        {
-            Point p = *it;
-
-            points[3 * i    ] = p.x;
-            points[3 * i + 1] = p.y;
-            points[3 * i + 2] = p.z;
-
-            colors[3 * i    ] = p.rgb[0];
-            colors[3 * i + 1] = p.rgb[1];
-            colors[3 * i + 2] = p.rgb[2];
-
-            if(p.rgb[0] != 255 && p.rgb[1] != 255 && p.rgb[2] != 255)
-            {
-                found_color = true;
-            }
-
-            intensities[i] = p.reflectance;
-            if(intensities[i] < min_r) min_r = intensities[i];
-            if(intensities[i] > max_r) max_r = intensities[i];
-            //cout << p.reflectance << " " << p.amplitude << " " << p.deviation << endl;
-            i++;
-        }
-
-//        // Map reflectances to 0..255
-//        float r_diff = max_r - min_r;
-//        if(r_diff > 0)
-//        {
-//            size_t np = allPoints.size();
-//            float b_size = r_diff / 255.0;
-//            for(int a = 0; a < np; a++)
-//            {
-//                float value = intensities[a];
-//                value -= min_r;
-//                value /= b_size;
-//                //cout << value << endl;
-//                intensities[a] = value;
-//            }
-//        }
-
-        model->m_pointCloud = PointBufferPtr( new PointBuffer );
-        model->m_pointCloud->setPointArray(points, allPoints.size());
-        model->m_pointCloud->setPointColorArray(colors, allPoints.size());
-        model->m_pointCloud->setPointIntensityArray(intensities, allPoints.size());
+        model->m_pointCloud = PointBufferPtr( new BoctreePointBuffer(scans) );
     }
 
     return model;
@@ -0,0 +1,430 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * BoctreeScans.cpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/io/BoctreeScans.hpp>
+#include <lvr/io/Timestamp.hpp>
+
+#include "slam6d/Boctree.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+using namespace std;
+
+namespace lvr
+{
+
+namespace
+{
+
+/// Applies a column major transformation to a point
+inline void transformPoint(const float* m, const float* p, float* out)
+{
+    out[0] = m[0] * p[0] + m[4] * p[1] + m[ 8] * p[2] + m[12];
+    out[1] = m[1] * p[0] + m[5] * p[1] + m[ 9] * p[2] + m[13];
+    out[2] = m[2] * p[0] + m[6] * p[1] + m[10] * p[2] + m[14];
+}
+
+/// Squared distance of a point to an axis aligned cube
+inline float boxDistance2(const float* q, const float* center, float halfSize)
+{
+    float d2 = 0.0f;
+    for(int j = 0; j < 3; j++)
+    {
+        float d = fabs(q[j] - center[j]) - halfSize;
+        if(d > 0.0f)
+        {
+            d2 += d * d;
+        }
+    }
+    return d2;
+}
+
+/// A child of an octree node during the traversal
+struct Child
+{
+    float                       distance;
+    float                       center[3];
+    const bitunion<float>*      node;
+    bool                        leaf;
+
+    bool operator<(const Child& other) const { return distance < other.distance; }
+};
+
+} // namespace
+
+BoctreeScans::BoctreeScans(float maxRange)
+    : m_maxRange(maxRange), m_numPoints(0)
+{
+
+}
+
+BoctreeScans::~BoctreeScans()
+{
+    for(size_t i = 0; i < m_scans.size(); i++)
+    {
+        delete m_scans[i].tree;
+    }
+}
+
+bool BoctreeScans::addScan(const string& filename, const Matrix4<float>& pose)
+{
+    // BOctTree does not report invalid files, so check the magic bits first
+    {
+        ifstream in(filename.c_str(), ios::in | ios::binary);
+        char magic[2] = {0, 0};
+        in.read(magic, 2);
+        if(!in.good() || magic[0] != 'X' || magic[1] != 'T')
+        {
+            cout << timestamp << "BoctreeScans: " << filename << " is not an octree file." << endl;
+            return false;
+        }
+    }
+
+    PointType type = BOctTree<float>::readType(filename);
+
+    Scan scan;
+    scan.tree = new BOctTree<float>(filename);
+    scan.dim = scan.tree->getPointdim();
+
+    // PointType::hasType() tests for missing flags, so the
+    // flags are evaluated directly
+    unsigned int flags = type.toFlags();
+    scan.reflectance = (flags & PointType::USE_REFLECTANCE) ? (int)type.getReflectance() : -1;
+
+    // Colors are stored as three bytes in the attribute after
+    // reflectance, amplitude, deviation and type
+    scan.color = -1;
+    if(flags & PointType::USE_COLOR)
+    {
+        scan.color = 3
+                + ((flags & PointType::USE_REFLECTANCE) != 0)
+                + ((flags & PointType::USE_AMPLITUDE) != 0)
+                + ((flags & PointType::USE_DEVIATION) != 0)
+                + ((flags & PointType::USE_TYPE) != 0);
+    }
+
+    Matrix4<float> tf(pose);
+    bool success = true;
+    Matrix4<float> inverse = tf.inv(success);
+    for(int i = 0; i < 16; i++)
+    {
+        scan.pose[i] = tf[i];
+        scan.inverse[i] = inverse[i];
+    }
+
+    size_t scanIndex = m_scans.size();
+    size_t firstLeaf = m_leaves.size();
+    size_t firstRaw = m_leaves.empty() ? 0 : m_leaves.back().rawOffset + m_leaves.back().length;
+    size_t rawOffset = firstRaw;
+    collectLeaves(scan.tree->getRoot(), scanIndex, rawOffset);
+
+    // Flag the points that are out of range in parallel
+    size_t numLeaves = m_leaves.size() - firstLeaf;
+    vector<unsigned char> removed(rawOffset - firstRaw, 0);
+    vector<size_t> kept(numLeaves, 0);
+    float maxRange2 = m_maxRange * m_maxRange;
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for(long i = 0; i < (long)numLeaves; i++)
+    {
+        const Leaf& leaf = m_leaves[firstLeaf + i];
+        const float* p = leaf.points;
+        for(unsigned int j = 0; j < leaf.length; j++, p += scan.dim)
+        {
+            float w[3];
+            transformPoint(scan.pose, p, w);
+            if(w[0] * w[0] + w[1] * w[1] + w[2] * w[2] < maxRange2)
+            {
+                kept[i]++;
+            }
+            else
+            {
+                removed[leaf.rawOffset - firstRaw + j] = 1;
+            }
+        }
+    }
+
+    // Assign the flattened indices
+    scan.offset = m_numPoints;
+    for(size_t i = 0; i < numLeaves; i++)
+    {
+        m_leaves[firstLeaf + i].offset = m_numPoints;
+        m_numPoints += kept[i];
+    }
+    scan.numPoints = m_numPoints - scan.offset;
+
+    size_t numRemoved = removed.size() - scan.numPoints;
+    if(numRemoved || !m_removed.empty())
+    {
+        m_removed.resize(firstRaw, 0);
+        m_removed.insert(m_removed.end(), removed.begin(), removed.end());
+    }
+
+    if(numRemoved)
+    {
+        cout << timestamp << "BoctreeScans: Ignored " << numRemoved << " points out of range." << endl;
+    }
+
+    m_scans.push_back(scan);
+    return true;
+}
+
+void BoctreeScans::collectLeaves(const bitoct& node, size_t scan, size_t& rawOffset)
+{
+    bitunion<float>* children;
+    bitoct::getChildren(node, children);
+
+    for(unsigned char i = 0; i < 8; i++)
+    {
+        if(!((1 << i) & node.valid))
+        {
+            continue;
+        }
+
+        if((1 << i) & node.leaf)
+        {
+            Leaf leaf;
+            leaf.points = children->getPoints();
+            leaf.length = children->getLength();
+            leaf.scan = scan;
+            leaf.offset = 0;
+            leaf.rawOffset = rawOffset;
+            rawOffset += leaf.length;
+
+            m_leafIndex[leaf.points] = m_leaves.size();
+            m_leaves.push_back(leaf);
+        }
+        else
+        {
+            collectLeaves(children->node, scan, rawOffset);
+        }
+        ++children;
+    }
+}
+
+void BoctreeScans::flatten(PointBuffer& buffer) const
+{
+    size_t n = m_numPoints;
+
+    floatArr points(new float[3 * n]);
+    ucharArr colors(new unsigned char[3 * n]);
+    floatArr intensities(new float[n]);
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for(long i = 0; i < (long)m_leaves.size(); i++)
+    {
+        const Leaf& leaf = m_leaves[i];
+        const Scan& scan = m_scans[leaf.scan];
+        const unsigned char* removed = m_removed.empty() ? 0 : &m_removed[leaf.rawOffset];
+
+        size_t index = leaf.offset;
+        const float* p = leaf.points;
+        for(unsigned int j = 0; j < leaf.length; j++, p += scan.dim)
+        {
+            if(removed && removed[j])
+            {
+                continue;
+            }
+
+            transformPoint(scan.pose, p, &points[3 * index]);
+
+            if(scan.color >= 0)
+            {
+                memcpy(&colors[3 * index], &p[scan.color], 3);
+            }
+            else
+            {
+                colors[3 * index] = colors[3 * index + 1] = colors[3 * index + 2] = 255;
+            }
+
+            intensities[index] = scan.reflectance >= 0 ? p[scan.reflectance] : 0.0f;
+            index++;
+        }
+    }
+
+    buffer.setPointArray(points, n);
+    buffer.setPointColorArray(colors, n);
+    buffer.setPointIntensityArray(intensities, n);
+
+    for(size_t i = 0; i < m_scans.size(); i++)
+    {
+        if(m_scans[i].numPoints)
+        {
+            indexPair range(m_scans[i].offset, m_scans[i].offset + m_scans[i].numPoints - 1);
+            buffer.defineSubCloud(range);
+        }
+    }
+}
+
+void BoctreeScans::kSearch(const float* qp, size_t k, vector<int>& indices, vector<float>& distances) const
+{
+    if(k == 0)
+    {
+        return;
+    }
+
+    vector<Neighbor> heap;
+    heap.reserve(k);
+    search(qp, k, numeric_limits<float>::max(), heap);
+
+    sort_heap(heap.begin(), heap.end());
+    for(size_t i = 0; i < heap.size(); i++)
+    {
+        indices.push_back((int)heap[i].second);
+        distances.push_back(heap[i].first);
+    }
+}
+
+void BoctreeScans::radiusSearch(const float* qp, float r, vector<int>& indices) const
+{
+    vector<Neighbor> found;
+    search(qp, 0, r * r, found);
+
+    sort(found.begin(), found.end());
+    for(size_t i = 0; i < found.size(); i++)
+    {
+        indices.push_back((int)found[i].second);
+    }
+}
+
+void BoctreeScans::search(const float* qp, size_t k, float maxDist2, vector<Neighbor>& heap) const
+{
+    for(size_t i = 0; i < m_scans.size(); i++)
+    {
+        const Scan& scan = m_scans[i];
+
+        float q[3];
+        transformPoint(scan.inverse, qp, q);
+
+        float bound = (k && heap.size() == k) ? heap.front().first : maxDist2;
+        if(boxDistance2(q, scan.tree->getCenter(), scan.tree->getSize()) > bound)
+        {
+            continue;
+        }
+
+        searchNode(scan, scan.tree->getRoot(), scan.tree->getCenter(), scan.tree->getSize(),
+                   q, k, maxDist2, heap);
+    }
+}
+
+void BoctreeScans::searchNode(const Scan& scan, const bitoct& node, const float* center, float size,
+                              const float* q, size_t k, float maxDist2, vector<Neighbor>& heap) const
+{
+    bitunion<float>* children;
+    bitoct::getChildren(node, children);
+
+    // Children are centered at +-size/2 and have half the size
+    // of their parent
+    Child candidates[8];
+    int n = 0;
+    for(unsigned char i = 0; i < 8; i++)
+    {
+        if(!((1 << i) & node.valid))
+        {
+            continue;
+        }
+
+        Child& c = candidates[n++];
+        BOctTree<float>::childcenter(center, c.center, size, i);
+        c.node = children++;
+        c.leaf = (1 << i) & node.leaf;
+        c.distance = boxDistance2(q, c.center, 0.5f * size);
+    }
+    sort(candidates, candidates + n);
+
+    for(int i = 0; i < n; i++)
+    {
+        float bound = (k && heap.size() == k) ? heap.front().first : maxDist2;
+        if(candidates[i].distance > bound)
+        {
+            break;
+        }
+
+        if(candidates[i].leaf)
+        {
+            searchLeaf(scan, candidates[i].node, q, k, maxDist2, heap);
+        }
+        else
+        {
+            searchNode(scan, candidates[i].node->node, candidates[i].center, 0.5f * size,
+                       q, k, maxDist2, heap);
+        }
+    }
+}
+
+void BoctreeScans::searchLeaf(const Scan& scan, const bitunion<float>* leaf,
+                              const float* q, size_t k, float maxDist2, vector<Neighbor>& heap) const
+{
+    const float* p = leaf->getPoints();
+    const Leaf& info = m_leaves[m_leafIndex.find(p)->second];
+    const unsigned char* removed = m_removed.empty() ? 0 : &m_removed[info.rawOffset];
+
+    size_t index = info.offset;
+    for(unsigned int j = 0; j < info.length; j++, p += scan.dim)
+    {
+        if(removed && removed[j])
+        {
+            continue;
+        }
+
+        float dx = p[0] - q[0];
+        float dy = p[1] - q[1];
+        float dz = p[2] - q[2];
+        float d2 = dx * dx + dy * dy + dz * dz;
+
+        if(k == 0)
+        {
+            if(d2 <= maxDist2)
+            {
+                heap.push_back(Neighbor(d2, index));
+            }
+        }
+        else if(heap.size() < k)
+        {
+            heap.push_back(Neighbor(d2, index));
+            push_heap(heap.begin(), heap.end());
+        }
+        else if(d2 < heap.front().first)
+        {
+            pop_heap(heap.begin(), heap.end());
+            heap.back() = Neighbor(d2, index);
+            push_heap(heap.begin(), heap.end());
+        }
+
+        index++;
+    }
+}
+
+BoctreePointBuffer::BoctreePointBuffer(BoctreeScansPtr scans)
+    : m_scans(scans)
+{
+    scans->flatten(*this);
+}
+
+} // namespace lvr
@@ -25,20 +25,189 @@
 
 #include <lvr/io/GridIO.hpp>
 #include <lvr/io/DataStruct.hpp>
+#include <lvr/io/MappedFile.hpp>
+#include <lvr/io/Timestamp.hpp>
 
+#include <boost/shared_ptr.hpp>
+
+#ifdef LVR_USE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <iostream>
+#include <vector>
+
 using std::ifstream;
+using std::ofstream;
+using std::cout;
+using std::endl;
 
 namespace lvr
 {
 
+namespace
+{
+
+const char     GRID_MAGIC[8]    = {'L', 'V', 'R', 'G', 'R', 'I', 'D', '\0'};
+const uint32_t GRID_BYTE_ORDER  = 0x01020304;
+const uint32_t GRID_VERSION     = 1;
+const size_t   GRID_ALIGNMENT   = 64;
+
+size_t alignOffset(size_t offset)
+{
+    return (offset + GRID_ALIGNMENT - 1) / GRID_ALIGNMENT * GRID_ALIGNMENT;
+}
+
+/// Deleter that keeps the file mapping alive while an array uses it
+struct MappingDeleter
+{
+    boost::shared_ptr<MappedFile> file;
+
+    void operator()(void*) const {}
+};
+
+/**
+ * Returns the given section of num elements with the given number of
+ * components as an array of T. Raw sections point into the mapping,
+ * compressed sections are decoded into a new array. Returns an empty
+ * array if the section is damaged. All header values are untrusted, so
+ * every computation is checked for overflows before it is used.
+ */
+template<typename T>
+boost::shared_array<T> loadSection(boost::shared_ptr<MappedFile> file,
+                                   uint64_t offset, uint64_t bytes,
+                                   uint16_t codec, uint64_t num, size_t components)
+{
+    uint64_t fileSize = file->size();
+    if(offset > fileSize || bytes > fileSize - offset || offset % sizeof(T) != 0
+       || num > SIZE_MAX / sizeof(T) / components)
+    {
+        return boost::shared_array<T>();
+    }
+
+    size_t count = num * components;
+    size_t size = count * sizeof(T);
+
+    if(codec == GridIO::Raw && bytes == size)
+    {
+        MappingDeleter deleter;
+        deleter.file = file;
+        return boost::shared_array<T>((T*)(file->writableData() + offset), deleter);
+    }
+
+#ifdef LVR_USE_ZLIB
+    // Deflate expands data by at most a factor of 1032, so larger
+    // sizes can only come from a damaged header
+    if(codec == GridIO::Deflate && size / 1032 <= bytes)
+    {
+        boost::shared_array<T> array(new T[count]);
+        uLongf destSize = size;
+        int res = uncompress((Bytef*)array.get(), &destSize,
+                             (const Bytef*)(file->data() + offset), bytes);
+        if(res == Z_OK && destSize == size)
+        {
+            return array;
+        }
+    }
+#endif
+
+    return boost::shared_array<T>();
+}
+
+/// Appends a section to the file and returns its stored size
+uint64_t writeSection(ofstream& out, const char* data, size_t size, uint16_t codec)
+{
+#ifdef LVR_USE_ZLIB
+    if(codec == GridIO::Deflate)
+    {
+        std::vector<Bytef> buffer(compressBound(size));
+        uLongf stored = buffer.size();
+        compress2(&buffer[0], &stored, (const Bytef*)data, size, Z_BEST_SPEED);
+        out.write((const char*)&buffer[0], stored);
+        return stored;
+    }
+#else
+    (void)codec;
+#endif
+
+    out.write(data, size);
+    return size;
+}
+
+/// Pads the file with zeros up to the given offset
+void padTo(ofstream& out, uint64_t offset)
+{
+    static const char zeros[GRID_ALIGNMENT] = {0};
+    size_t pos = out.tellp();
+    if(offset > pos)
+    {
+        out.write(zeros, offset - pos);
+    }
+}
+
+} // namespace
+
 GridIO::GridIO()
+    : m_numPoints(0), m_numBoxes(0), m_voxelsize(0.0f)
 {
-    // TODO Auto-generated constructor stub
 
 }
 
 void GridIO::read( std::string filename )
+{
+    m_points.reset();
+    m_boxes.reset();
+    m_numPoints = 0;
+    m_numBoxes = 0;
+
+    if(!readBinary(filename))
+    {
+        readText(filename);
+    }
+}
+
+bool GridIO::readBinary( std::string filename )
+{
+    boost::shared_ptr<MappedFile> file(new MappedFile(filename, true));
+    if(!file->good() || file->size() < sizeof(GridFileHeader)
+       || memcmp(file->data(), GRID_MAGIC, sizeof(GRID_MAGIC)) != 0)
+    {
+        return false;
+    }
+
+    GridFileHeader header;
+    memcpy(&header, file->data(), sizeof(header));
+
+    if(header.byteOrder != GRID_BYTE_ORDER || header.version > GRID_VERSION)
+    {
+        cout << timestamp << "GridIO: Unsupported grid format in '" << filename << "'." << endl;
+        return true;
+    }
+
+    floatArr points = loadSection<float>(file, header.pointOffset, header.pointBytes,
+                                         header.pointCodec, header.numPoints, 4);
+    uintArr boxes = loadSection<unsigned int>(file, header.boxOffset, header.boxBytes,
+                                              header.boxCodec, header.numBoxes, 8);
+
+    if(!points || !boxes)
+    {
+        cout << timestamp << "GridIO: Unable to read grid sections of '" << filename << "'." << endl;
+        return true;
+    }
+
+    m_points = points;
+    m_boxes = boxes;
+    m_numPoints = header.numPoints;
+    m_numBoxes = header.numBoxes;
+    m_voxelsize = header.voxelsize;
+
+    return true;
+}
+
+void GridIO::readText( std::string filename )
 {
     ifstream in(filename.c_str());
 
@@ -50,6 +219,7 @@ void GridIO::read( std::string filename )
 
         // Read header
         in >> n_points >> voxelsize >> n_cells;
+        m_voxelsize = voxelsize;
 
         // Alloc and read points
         m_points = floatArr( new float[4 * n_points] );
@@ -74,6 +244,56 @@ void GridIO::read( std::string filename )
     }
 }
 
+bool GridIO::write( std::string filename,
+                    floatArr points, size_t numPoints,
+                    uintArr boxes, size_t numBoxes,
+                    float voxelsize, bool compress )
+{
+    ofstream out(filename.c_str(), std::ios::binary);
+    if(!out.good())
+    {
+        cout << timestamp << "GridIO: Unable to open '" << filename << "'." << endl;
+        return false;
+    }
+
+#ifndef LVR_USE_ZLIB
+    if(compress)
+    {
+        cout << timestamp << "GridIO: Compiled without zlib. Writing uncompressed grid." << endl;
+        compress = false;
+    }
+#endif
+
+    GridFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRID_MAGIC, sizeof(GRID_MAGIC));
+    header.byteOrder  = GRID_BYTE_ORDER;
+    header.version    = GRID_VERSION;
+    header.numPoints  = numPoints;
+    header.numBoxes   = numBoxes;
+    header.voxelsize  = voxelsize;
+    header.pointCodec = compress ? Deflate : Raw;
+    header.boxCodec   = compress ? Deflate : Raw;
+
+    // Write a preliminary header and update the section
+    // sizes when all data is written
+    out.write((const char*)&header, sizeof(header));
+
+    header.pointOffset = alignOffset(sizeof(header));
+    padTo(out, header.pointOffset);
+    header.pointBytes = writeSection(out, (const char*)points.get(),
+                                     4 * numPoints * sizeof(float), header.pointCodec);
+
+    header.boxOffset = alignOffset(header.pointOffset + header.pointBytes);
+    padTo(out, header.boxOffset);
+    header.boxBytes = writeSection(out, (const char*)boxes.get(),
+                                   8 * numBoxes * sizeof(unsigned int), header.boxCodec);
+
+    out.seekp(0);
+    out.write((const char*)&header, sizeof(header));
+
+    return out.good();
+}
 
 floatArr GridIO::getPoints( size_t &n )
 {
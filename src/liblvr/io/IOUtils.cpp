@@ -220,76 +220,139 @@ size_t getReductionFactorASCII(boost::filesystem::path& inFile, size_t targetSiz
 
 }
 
-void transformAndReducePointCloud(ModelPtr model, int modulo, int sx, int sy, int sz, int xPos, int yPos, int zPos)
+Eigen::Matrix4d buildSwizzleTransformation(int sx, int sy, int sz, int xPos, int yPos, int zPos)
 {
-    size_t n_ip, n_colors;
-    size_t cntr = 0;
+    // The i-th output coordinate is the scaled coordinate
+    // found at the given position in the input data
+    int    pos[3]   = {xPos, yPos, zPos};
+    double scale[3] = {(double)sx, (double)sy, (double)sz};
 
-    floatArr arr = model->m_pointCloud->getPointArray(n_ip);
-    ucharArr colors = model->m_pointCloud->getPointColorArray(n_colors);
+    Eigen::Matrix4d transformation = Eigen::Matrix4d::Zero();
+    for(int i = 0; i < 3; i++)
+    {
+        transformation(i, pos[i]) = scale[pos[i]];
+    }
+    transformation(3, 3) = 1.0;
 
-    // Plus one because it might differ because of the 0-index
-    // better waste memory for one float than having not enough space.
-    // TO-DO think about exact calculation.
-    size_t targetSize = (3 * ((n_ip)/modulo)) + modulo;
-    floatArr points(new float[targetSize ]);
-    ucharArr newColorsArr;
+    return transformation;
+}
 
-    if(n_colors)
+template<typename T>
+size_t transformAndReducePointArrayImpl(const float* in, size_t n, float* out, const T* m, size_t modulo, bool translate)
+{
+    if(modulo == 0)
     {
-        newColorsArr = ucharArr(new unsigned char[targetSize]);
+        modulo = 1;
     }
 
-    for(int i = 0; i < n_ip; i++)
+    size_t numOut = (n + modulo - 1) / modulo;
+
+    // Column major matrix entries and translation
+    const double m0 = m[0], m1 = m[1], m2  = m[2];
+    const double m4 = m[4], m5 = m[5], m6  = m[6];
+    const double m8 = m[8], m9 = m[9], m10 = m[10];
+    const double tx = translate ? m[12] : 0.0;
+    const double ty = translate ? m[13] : 0.0;
+    const double tz = translate ? m[14] : 0.0;
+
+    // The i-th kept point is always the (i * modulo)-th input point,
+    // so each output position can be computed independently
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)numOut; i++)
     {
-        if(i % modulo == 0)
-        {
-            if(sx != 1)
-            {
-                arr[i * 3] 		*= sx;
-            }
+        const float* p = in + 3 * i * modulo;
+        double x = p[0];
+        double y = p[1];
+        double z = p[2];
+
+        out[3 * i]     = m0 * x + m4 * y + m8  * z + tx;
+        out[3 * i + 1] = m1 * x + m5 * y + m9  * z + ty;
+        out[3 * i + 2] = m2 * x + m6 * y + m10 * z + tz;
+    }
 
-            if(sy != 1)
-            {
-                arr[i * 3 + 1] 	*= sy;
-            }
+    return numOut;
+}
 
-            if(sz != 1)
-            {
-                arr[i * 3 + 2] 	*= sz;
-            }
+size_t transformAndReducePointArray(const float* in, size_t n, float* out, const double* transform, size_t modulo, bool translate)
+{
+    return transformAndReducePointArrayImpl(in, n, out, transform, modulo, translate);
+}
 
-            if((cntr * 3) < targetSize)
-            {
-                points[cntr * 3]     = arr[i * 3 + xPos];
-                points[cntr * 3 + 1] = arr[i * 3 + yPos];
-                points[cntr * 3 + 2] = arr[i * 3 + zPos];
-            }
-            else
-            {
-                std::cout << "The following is for debugging purpose" << std::endl;
-                std::cout << "Cntr: " << (cntr * 3) << " targetSize: " << targetSize << std::endl;
-                std::cout << "nip : " << n_ip << " modulo " << modulo << std::endl;
-                break;
-            }
+size_t transformAndReducePointArray(const float* in, size_t n, float* out, const float* transform, size_t modulo, bool translate)
+{
+    return transformAndReducePointArrayImpl(in, n, out, transform, modulo, translate);
+}
 
-            if(n_colors)
-            {
-                newColorsArr[cntr * 3]     = colors[i * 3];
-                newColorsArr[cntr * 3 + 1] = colors[i * 3 + 1];
-                newColorsArr[cntr * 3 + 2] = colors[i * 3 + 2];
-            }
+void transformAndReducePointCloud(ModelPtr model, int modulo, int sx, int sy, int sz, int xPos, int yPos, int zPos)
+{
+    transformAndReducePointCloud(model, modulo, buildSwizzleTransformation(sx, sy, sz, xPos, yPos, zPos));
+}
 
-            cntr++;
-        }
+void transformAndReducePointCloud(ModelPtr model, int modulo, const Eigen::Matrix4d& transformation)
+{
+    size_t n_ip, n_colors, n_normals;
+
+    if(modulo < 1)
+    {
+        modulo = 1;
     }
 
-    // Pass counter because it is the actual number of points used after reduction
-    // it might be 1 less than the size
+    floatArr arr = model->m_pointCloud->getPointArray(n_ip);
+    ucharArr colors = model->m_pointCloud->getPointColorArray(n_colors);
+    floatArr normals = model->m_pointCloud->getPointNormalArray(n_normals);
+
+    size_t targetSize = (n_ip + modulo - 1) / modulo;
+    floatArr points(new float[3 * targetSize]);
+
+    size_t cntr = transformAndReducePointArray(arr.get(), n_ip, points.get(), transformation.data(), modulo);
     model->m_pointCloud->setPointArray(points, cntr);
 
-    if(n_colors)
+    if(n_normals == n_ip)
+    {
+        // Normals are transformed with the inverse transpose of the linear
+        // part. The cofactor matrix equals it up to the determinant, which
+        // only scales the normals, and is defined for singular matrices, too.
+        Eigen::Matrix3d linear = transformation.topLeftCorner<3, 3>();
+        Eigen::Matrix3d cofactor;
+        cofactor.col(0) = linear.col(1).cross(linear.col(2));
+        cofactor.col(1) = linear.col(2).cross(linear.col(0));
+        cofactor.col(2) = linear.col(0).cross(linear.col(1));
+
+        Eigen::Matrix4d normalTransform = Eigen::Matrix4d::Identity();
+        normalTransform.topLeftCorner<3, 3>() = linear.determinant() < 0.0 ? -cofactor : cofactor;
+
+        floatArr newNormalsArr(new float[3 * targetSize]);
+        transformAndReducePointArray(normals.get(), n_normals, newNormalsArr.get(), normalTransform.data(), modulo, false);
+
+        #pragma omp parallel for schedule(static)
+        for(long i = 0; i < (long)cntr; i++)
+        {
+            float* n = newNormalsArr.get() + 3 * i;
+            float length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if(length > 0.0f)
+            {
+                n[0] /= length;
+                n[1] /= length;
+                n[2] /= length;
+            }
+        }
+
+        model->m_pointCloud->setPointNormalArray(newNormalsArr, cntr);
+    }
+
+    if(n_colors == n_ip)
     {
+        ucharArr newColorsArr(new unsigned char[3 * targetSize]);
+
+        #pragma omp parallel for schedule(static)
+        for(long i = 0; i < (long)cntr; i++)
+        {
+            size_t j = i * modulo;
+            newColorsArr[3 * i]     = colors[3 * j];
+            newColorsArr[3 * i + 1] = colors[3 * j + 1];
+            newColorsArr[3 * i + 2] = colors[3 * j + 2];
+        }
+
         model->m_pointCloud->setPointColorArray(newColorsArr, cntr);
     }
 }
@@ -301,20 +364,7 @@ void transformPointCloud(ModelPtr model, Eigen::Matrix4d transformation)
     size_t numPoints;
 
     floatArr arr = model->m_pointCloud->getPointArray(numPoints);
-
-    for(int i = 0; i < numPoints; i++)
-    {
-        float x = arr[3 * i];
-        float y = arr[3 * i + 1];
-        float z = arr[3 * i + 2];
-
-        Eigen::Vector4d v(x,y,z,1);
-        Eigen::Vector4d tv = transformation * v;
-
-        arr[3 * i]     = tv[0];
-        arr[3 * i + 1] = tv[1];
-        arr[3 * i + 2] = tv[2];
-    }
+    transformAndReducePointArray(arr.get(), numPoints, arr.get(), transformation.data());
 }
 
 void transformPointCloudAndAppend(PointBufferPtr& buffer, boost::filesystem::path& transfromFile, std::vector<float>& pts, std::vector<float>& nrm)
@@ -432,4 +482,52 @@ void writePointsAndNormals(std::vector<float>& p, std::vector<float>& n, std::st
 }
 
 
+PointBufferPtr clonePointBuffer(PointBufferPtr buffer)
+{
+    PointBufferPtr out(new PointBuffer);
+
+    size_t n;
+    floatArr points = buffer->getPointArray(n);
+    if(points)
+    {
+        floatArr copy(new float[3 * n]);
+        std::copy(points.get(), points.get() + 3 * n, copy.get());
+        out->setPointArray(copy, n);
+    }
+
+    ucharArr colors = buffer->getPointColorArray(n);
+    if(colors)
+    {
+        ucharArr copy(new unsigned char[3 * n]);
+        std::copy(colors.get(), colors.get() + 3 * n, copy.get());
+        out->setPointColorArray(copy, n);
+    }
+
+    floatArr normals = buffer->getPointNormalArray(n);
+    if(normals)
+    {
+        floatArr copy(new float[3 * n]);
+        std::copy(normals.get(), normals.get() + 3 * n, copy.get());
+        out->setPointNormalArray(copy, n);
+    }
+
+    floatArr intensities = buffer->getPointIntensityArray(n);
+    if(intensities)
+    {
+        floatArr copy(new float[n]);
+        std::copy(intensities.get(), intensities.get() + n, copy.get());
+        out->setPointIntensityArray(copy, n);
+    }
+
+    floatArr confidences = buffer->getPointConfidenceArray(n);
+    if(confidences)
+    {
+        floatArr copy(new float[n]);
+        std::copy(confidences.get(), confidences.get() + n, copy.get());
+        out->setPointConfidenceArray(copy, n);
+    }
+
+    return out;
+}
+
 } // namespace lvr
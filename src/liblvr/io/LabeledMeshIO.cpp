@@ -0,0 +1,419 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+/*
+ * LabeledMeshIO.cpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/io/LabeledMeshIO.hpp>
+#include <lvr/io/MappedFile.hpp>
+#include <lvr/io/Timestamp.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+using std::cout;
+using std::endl;
+using std::ofstream;
+using std::vector;
+
+namespace lvr
+{
+
+namespace
+{
+
+const char     LBM_MAGIC[8]     = {'L', 'V', 'R', 'L', 'B', 'M', '\0', '\0'};
+const uint32_t LBM_BYTE_ORDER   = 0x01020304;
+const uint32_t LBM_VERSION      = 1;
+
+/// Flags for optional vertex attributes
+const uint32_t LBM_HAS_NORMALS  = 1;
+const uint32_t LBM_HAS_COLORS   = 2;
+
+struct LabeledMeshHeader
+{
+    char        magic[8];
+    uint32_t    byteOrder;
+    uint32_t    version;
+    uint64_t    numVertices;
+    uint64_t    numFaces;
+    uint32_t    numRegions;
+    uint32_t    numLabels;
+    uint32_t    flags;
+    uint32_t    reserved;
+};
+
+/// Copies n elements from the current position and advances it
+template<typename T>
+bool readArray(const char*& p, const char* end, T* dst, size_t n)
+{
+    size_t size = n * sizeof(T);
+    if((size_t)(end - p) < size)
+    {
+        return false;
+    }
+    memcpy(dst, p, size);
+    p += size;
+    return true;
+}
+
+template<typename T>
+void writeArray(ofstream& out, const T* src, size_t n)
+{
+    out.write((const char*)src, n * sizeof(T));
+}
+
+/// Computes the metadata of all regions from the face data of the mesh
+void calcRegions(LabeledMesh& mesh)
+{
+    vector<LabeledRegion>& regions = mesh.regions;
+    for(size_t r = 0; r < regions.size(); r++)
+    {
+        LabeledRegion& region = regions[r];
+        region.numFaces = 0;
+        region.area = 0.0f;
+        for(int j = 0; j < 3; j++)
+        {
+            region.normal[j] = 0.0f;
+            region.centroid[j] = 0.0f;
+            region.bbMin[j] = std::numeric_limits<float>::max();
+            region.bbMax[j] = -std::numeric_limits<float>::max();
+        }
+    }
+
+    for(size_t i = 0; i < mesh.numFaces; i++)
+    {
+        LabeledRegion& region = regions[mesh.faceRegions[i]];
+        const float* p[3];
+        for(int k = 0; k < 3; k++)
+        {
+            p[k] = &mesh.vertices[3 * mesh.faces[3 * i + k]];
+            for(int j = 0; j < 3; j++)
+            {
+                region.bbMin[j] = std::min(region.bbMin[j], p[k][j]);
+                region.bbMax[j] = std::max(region.bbMax[j], p[k][j]);
+            }
+        }
+
+        float u[3], v[3], c[3];
+        for(int j = 0; j < 3; j++)
+        {
+            u[j] = p[1][j] - p[0][j];
+            v[j] = p[2][j] - p[0][j];
+        }
+        c[0] = u[1] * v[2] - u[2] * v[1];
+        c[1] = u[2] * v[0] - u[0] * v[2];
+        c[2] = u[0] * v[1] - u[1] * v[0];
+        float a = 0.5f * sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+
+        region.numFaces++;
+        region.area += a;
+        for(int j = 0; j < 3; j++)
+        {
+            region.normal[j] += 0.5f * c[j];
+            region.centroid[j] += a * (p[0][j] + p[1][j] + p[2][j]) / 3.0f;
+        }
+    }
+
+    for(size_t r = 0; r < regions.size(); r++)
+    {
+        LabeledRegion& region = regions[r];
+        float length = sqrt(region.normal[0] * region.normal[0]
+                          + region.normal[1] * region.normal[1]
+                          + region.normal[2] * region.normal[2]);
+        for(int j = 0; j < 3; j++)
+        {
+            if(length > 0.0f)
+            {
+                region.normal[j] /= length;
+            }
+            if(region.area > 0.0f)
+            {
+                region.centroid[j] /= region.area;
+            }
+        }
+    }
+}
+
+} // namespace
+
+ModelPtr LabeledMeshIO::read( string filename )
+{
+    m_mesh = LabeledMesh();
+
+    MappedFile file(filename);
+    if(!file.good())
+    {
+        cout << timestamp << "LabeledMeshIO: Unable to open '" << filename << "'." << endl;
+        return ModelPtr(new Model);
+    }
+
+    const char* p = file.data();
+    const char* end = p + file.size();
+
+    LabeledMeshHeader header;
+    if(!readArray(p, end, &header, 1)
+       || memcmp(header.magic, LBM_MAGIC, sizeof(LBM_MAGIC)) != 0
+       || header.byteOrder != LBM_BYTE_ORDER
+       || header.version > LBM_VERSION)
+    {
+        cout << timestamp << "LabeledMeshIO: '" << filename << "' is no supported labeled mesh." << endl;
+        return ModelPtr(new Model);
+    }
+
+    LabeledMesh mesh;
+    mesh.numVertices = header.numVertices;
+    mesh.numFaces = header.numFaces;
+
+    bool ok = true;
+
+    // Label names
+    for(uint32_t i = 0; ok && i < header.numLabels; i++)
+    {
+        uint32_t length;
+        ok = readArray(p, end, &length, 1) && (size_t)(end - p) >= length;
+        if(ok)
+        {
+            mesh.labels.push_back(string(p, length));
+            p += length;
+        }
+    }
+
+    // Check the counts against the remaining data before anything is
+    // allocated. Every single size is bounded by the file size, so their
+    // sum does not overflow.
+    const uint64_t vertexSize = 3 * sizeof(float)
+            + ((header.flags & LBM_HAS_NORMALS) ? 3 * sizeof(float) : 0)
+            + ((header.flags & LBM_HAS_COLORS) ? 3 * sizeof(unsigned char) : 0);
+    const uint64_t faceSize = 5 * sizeof(unsigned int);
+    const uint64_t available = end - p;
+    ok = ok && header.numRegions <= available / sizeof(LabeledRegion)
+            && header.numVertices <= available / vertexSize
+            && header.numFaces <= available / faceSize
+            && header.numRegions * sizeof(LabeledRegion) + header.numVertices * vertexSize
+               + header.numFaces * faceSize <= available;
+
+    // Region table
+    if(ok)
+    {
+        mesh.regions.resize(header.numRegions);
+    }
+    ok = ok && readArray(p, end, mesh.regions.data(), mesh.regions.size());
+
+    // Vertex data
+    if(ok)
+    {
+        mesh.vertices = floatArr(new float[3 * mesh.numVertices]);
+        ok = readArray(p, end, mesh.vertices.get(), 3 * mesh.numVertices);
+    }
+
+    if(ok && (header.flags & LBM_HAS_NORMALS))
+    {
+        mesh.normals = floatArr(new float[3 * mesh.numVertices]);
+        ok = readArray(p, end, mesh.normals.get(), 3 * mesh.numVertices);
+    }
+
+    if(ok && (header.flags & LBM_HAS_COLORS))
+    {
+        mesh.colors = ucharArr(new unsigned char[3 * mesh.numVertices]);
+        ok = readArray(p, end, mesh.colors.get(), 3 * mesh.numVertices);
+    }
+
+    // Face data
+    if(ok)
+    {
+        mesh.faces = uintArr(new unsigned int[3 * mesh.numFaces]);
+        mesh.faceRegions = uintArr(new unsigned int[mesh.numFaces]);
+        mesh.faceLabels = uintArr(new unsigned int[mesh.numFaces]);
+        ok = readArray(p, end, mesh.faces.get(), 3 * mesh.numFaces)
+          && readArray(p, end, mesh.faceRegions.get(), mesh.numFaces)
+          && readArray(p, end, mesh.faceLabels.get(), mesh.numFaces);
+    }
+
+    if(!ok)
+    {
+        cout << timestamp << "LabeledMeshIO: '" << filename << "' is truncated." << endl;
+        return ModelPtr(new Model);
+    }
+
+    // Faces have to reference existing vertices and regions
+    for(size_t i = 0; i < mesh.numFaces; i++)
+    {
+        if(mesh.faces[3 * i] >= mesh.numVertices
+           || mesh.faces[3 * i + 1] >= mesh.numVertices
+           || mesh.faces[3 * i + 2] >= mesh.numVertices
+           || mesh.faceRegions[i] >= mesh.regions.size())
+        {
+            cout << timestamp << "LabeledMeshIO: Face " << i << " of '" << filename
+                 << "' references a missing vertex or region." << endl;
+            return ModelPtr(new Model);
+        }
+    }
+
+    // Group the faces by label
+    labeledFacesMap labeledFaces;
+    for(size_t i = 0; i < mesh.numFaces; i++)
+    {
+        if(mesh.faceLabels[i] < mesh.labels.size())
+        {
+            labeledFaces[mesh.labels[mesh.faceLabels[i]]].push_back(i);
+        }
+    }
+
+    MeshBufferPtr buffer(new MeshBuffer);
+    buffer->setVertexArray(mesh.vertices, mesh.numVertices);
+    if(mesh.normals)
+    {
+        buffer->setVertexNormalArray(mesh.normals, mesh.numVertices);
+    }
+    if(mesh.colors)
+    {
+        buffer->setVertexColorArray(mesh.colors, mesh.numVertices);
+    }
+    buffer->setFaceArray(mesh.faces, mesh.numFaces);
+    buffer->setLabeledFacesMap(labeledFaces);
+
+    m_mesh = mesh;
+    m_model = ModelPtr(new Model(buffer));
+    return m_model;
+}
+
+void LabeledMeshIO::save( string filename )
+{
+    if(!m_model || !m_model->m_mesh)
+    {
+        cout << timestamp << "LabeledMeshIO: Model does not contain a mesh." << endl;
+        return;
+    }
+
+    MeshBufferPtr buffer = m_model->m_mesh;
+
+    LabeledMesh mesh;
+    size_t n;
+    mesh.vertices = buffer->getVertexArray(mesh.numVertices);
+    mesh.faces = buffer->getFaceArray(mesh.numFaces);
+
+    mesh.normals = buffer->getVertexNormalArray(n);
+    if(n != mesh.numVertices)
+    {
+        mesh.normals.reset();
+    }
+
+    mesh.colors = buffer->getVertexColorArray(n);
+    if(n != mesh.numVertices)
+    {
+        mesh.colors.reset();
+    }
+
+    // Every label forms one region, faces without label are
+    // put into an additional region
+    const uint32_t unlabeled = std::numeric_limits<uint32_t>::max();
+    mesh.faceLabels = uintArr(new unsigned int[mesh.numFaces]);
+    std::fill(mesh.faceLabels.get(), mesh.faceLabels.get() + mesh.numFaces, unlabeled);
+
+    labeledFacesMap labeledFaces = buffer->getLabeledFacesMap();
+    for(labeledFacesMap::iterator it = labeledFaces.begin(); it != labeledFaces.end(); ++it)
+    {
+        uint32_t label = mesh.labels.size();
+        mesh.labels.push_back(it->first);
+        for(size_t i = 0; i < it->second.size(); i++)
+        {
+            if(it->second[i] < mesh.numFaces)
+            {
+                mesh.faceLabels[it->second[i]] = label;
+            }
+        }
+    }
+
+    if(std::find(mesh.faceLabels.get(), mesh.faceLabels.get() + mesh.numFaces, unlabeled)
+       != mesh.faceLabels.get() + mesh.numFaces)
+    {
+        uint32_t label = mesh.labels.size();
+        mesh.labels.push_back("unknown");
+        std::replace(mesh.faceLabels.get(), mesh.faceLabels.get() + mesh.numFaces, unlabeled, label);
+    }
+
+    mesh.faceRegions = uintArr(new unsigned int[mesh.numFaces]);
+    std::copy(mesh.faceLabels.get(), mesh.faceLabels.get() + mesh.numFaces, mesh.faceRegions.get());
+
+    mesh.regions.resize(mesh.labels.size());
+    for(size_t r = 0; r < mesh.regions.size(); r++)
+    {
+        mesh.regions[r].label = r;
+    }
+    calcRegions(mesh);
+
+    write(filename, mesh);
+}
+
+bool LabeledMeshIO::write( string filename, const LabeledMesh& mesh )
+{
+    ofstream out(filename.c_str(), std::ios::binary);
+    if(!out.good())
+    {
+        cout << timestamp << "LabeledMeshIO: Unable to open '" << filename << "'." << endl;
+        return false;
+    }
+
+    LabeledMeshHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LBM_MAGIC, sizeof(LBM_MAGIC));
+    header.byteOrder    = LBM_BYTE_ORDER;
+    header.version      = LBM_VERSION;
+    header.numVertices  = mesh.numVertices;
+    header.numFaces     = mesh.numFaces;
+    header.numRegions   = mesh.regions.size();
+    header.numLabels    = mesh.labels.size();
+    header.flags        = (mesh.normals ? LBM_HAS_NORMALS : 0) | (mesh.colors ? LBM_HAS_COLORS : 0);
+    writeArray(out, &header, 1);
+
+    for(size_t i = 0; i < mesh.labels.size(); i++)
+    {
+        uint32_t length = mesh.labels[i].size();
+        writeArray(out, &length, 1);
+        writeArray(out, mesh.labels[i].data(), length);
+    }
+
+    writeArray(out, mesh.regions.data(), mesh.regions.size());
+
+    writeArray(out, mesh.vertices.get(), 3 * mesh.numVertices);
+    if(mesh.normals)
+    {
+        writeArray(out, mesh.normals.get(), 3 * mesh.numVertices);
+    }
+    if(mesh.colors)
+    {
+        writeArray(out, mesh.colors.get(), 3 * mesh.numVertices);
+    }
+
+    writeArray(out, mesh.faces.get(), 3 * mesh.numFaces);
+    writeArray(out, mesh.faceRegions.get(), mesh.numFaces);
+    writeArray(out, mesh.faceLabels.get(), mesh.numFaces);
+
+    return out.good();
+}
+
+} // namespace lvr
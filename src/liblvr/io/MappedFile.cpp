@@ -0,0 +1,107 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+/*
+ * MappedFile.cpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/io/MappedFile.hpp>
+
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LVR_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace lvr
+{
+
+MappedFile::MappedFile(const std::string& filename, bool writable)
+    : m_data(0), m_size(0), m_open(false), m_mapped(false), m_writable(writable)
+{
+#ifdef LVR_HAVE_MMAP
+    int fd = open(filename.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        return;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) == 0)
+    {
+        m_open = true;
+        m_size = st.st_size;
+        if(m_size > 0)
+        {
+            int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+            void* ptr = mmap(0, m_size, prot, MAP_PRIVATE, fd, 0);
+            if(ptr != MAP_FAILED)
+            {
+                // The file is read sequentially by all users
+                madvise(ptr, m_size, MADV_SEQUENTIAL);
+                m_data = (const char*)ptr;
+                m_mapped = true;
+            }
+        }
+    }
+    close(fd);
+
+    if(m_mapped || !m_open)
+    {
+        return;
+    }
+#endif
+
+    // Fallback: Read the complete file
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    if(!in.good())
+    {
+        return;
+    }
+
+    m_open = true;
+    in.seekg(0, std::ios::end);
+    m_size = in.tellg();
+    in.seekg(0, std::ios::beg);
+
+    if(m_size > 0)
+    {
+        m_buffer.resize(m_size);
+        in.read(&m_buffer[0], m_size);
+        m_data = &m_buffer[0];
+    }
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef LVR_HAVE_MMAP
+    if(m_mapped)
+    {
+        munmap((void*)m_data, m_size);
+    }
+#endif
+}
+
+} // namespace lvr
@@ -0,0 +1,206 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * MeshCheckpointIO.cpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/io/MeshCheckpointIO.hpp>
+#include <lvr/io/MappedFile.hpp>
+#include <lvr/io/Timestamp.hpp>
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using std::cout;
+using std::endl;
+using std::ifstream;
+using std::ofstream;
+
+namespace lvr
+{
+
+namespace
+{
+
+const char     HEM_MAGIC[8]     = {'L', 'V', 'R', 'H', 'E', 'M', '\0', '\0'};
+const uint32_t HEM_BYTE_ORDER   = 0x01020304;
+const uint32_t HEM_VERSION      = 1;
+const size_t   HEM_ALIGNMENT    = 64;
+const size_t   HEM_NUM_TABLES   = 7;
+
+/// Position and size of a table in the file
+struct CheckpointTable
+{
+    uint64_t    offset;
+    uint64_t    count;
+};
+
+struct CheckpointHeader
+{
+    char            magic[8];
+    uint32_t        byteOrder;
+    uint32_t        version;
+    uint32_t        flags;
+    uint32_t        reserved;
+    char            stage[32];
+
+    /// Vertices, edges, in edges, faces, regions, region faces, labels
+    CheckpointTable tables[HEM_NUM_TABLES];
+};
+
+size_t alignOffset(size_t offset)
+{
+    return (offset + HEM_ALIGNMENT - 1) / HEM_ALIGNMENT * HEM_ALIGNMENT;
+}
+
+/// Deleter that keeps the file mapping alive while an array uses it
+struct MappingDeleter
+{
+    boost::shared_ptr<MappedFile> file;
+
+    void operator()(void*) const {}
+};
+
+/// Returns the given table as an array that points into the mapping
+template<typename T>
+bool loadTable(boost::shared_ptr<MappedFile> file, const CheckpointTable& table,
+               boost::shared_array<T>& array, size_t& count)
+{
+    if(table.offset % HEM_ALIGNMENT != 0
+       || table.offset > file->size()
+       || table.count > (file->size() - table.offset) / sizeof(T))
+    {
+        return false;
+    }
+
+    MappingDeleter deleter;
+    deleter.file = file;
+    array = boost::shared_array<T>((T*)(file->writableData() + table.offset), deleter);
+    count = table.count;
+    return true;
+}
+
+/// Appends a table at the next aligned offset
+template<typename T>
+void writeTable(ofstream& out, const T* data, size_t count, CheckpointTable& table)
+{
+    static const char zeros[HEM_ALIGNMENT] = {0};
+    size_t pos = out.tellp();
+    table.offset = alignOffset(pos);
+    table.count = count;
+    out.write(zeros, table.offset - pos);
+    if(count)
+    {
+        out.write((const char*)data, count * sizeof(T));
+    }
+}
+
+} // namespace
+
+bool MeshCheckpointIO::isCheckpoint( std::string filename )
+{
+    ifstream in(filename.c_str(), std::ios::binary);
+    char magic[sizeof(HEM_MAGIC)];
+    return in.read(magic, sizeof(magic)) && memcmp(magic, HEM_MAGIC, sizeof(HEM_MAGIC)) == 0;
+}
+
+bool MeshCheckpointIO::read( std::string filename, MeshCheckpoint& checkpoint )
+{
+    boost::shared_ptr<MappedFile> file(new MappedFile(filename, true));
+    if(!file->good() || file->size() < sizeof(CheckpointHeader)
+       || memcmp(file->data(), HEM_MAGIC, sizeof(HEM_MAGIC)) != 0)
+    {
+        cout << timestamp << "MeshCheckpointIO: '" << filename << "' is no mesh checkpoint." << endl;
+        return false;
+    }
+
+    CheckpointHeader header;
+    memcpy(&header, file->data(), sizeof(header));
+
+    if(header.byteOrder != HEM_BYTE_ORDER || header.version > HEM_VERSION)
+    {
+        cout << timestamp << "MeshCheckpointIO: Unsupported checkpoint format in '" << filename << "'." << endl;
+        return false;
+    }
+
+    MeshCheckpoint c;
+    bool ok = loadTable(file, header.tables[0], c.vertices, c.numVertices)
+           && loadTable(file, header.tables[1], c.edges, c.numEdges)
+           && loadTable(file, header.tables[2], c.inEdges, c.numInEdges)
+           && loadTable(file, header.tables[3], c.faces, c.numFaces)
+           && loadTable(file, header.tables[4], c.regions, c.numRegions)
+           && loadTable(file, header.tables[5], c.regionFaces, c.numRegionFaces)
+           && loadTable(file, header.tables[6], c.labels, c.numLabelBytes);
+
+    if(!ok)
+    {
+        cout << timestamp << "MeshCheckpointIO: '" << filename << "' is truncated." << endl;
+        return false;
+    }
+
+    c.flags = header.flags;
+    c.stage = std::string(header.stage, strnlen(header.stage, sizeof(header.stage)));
+
+    checkpoint = c;
+    return true;
+}
+
+bool MeshCheckpointIO::write( std::string filename, const MeshCheckpoint& c )
+{
+    ofstream out(filename.c_str(), std::ios::binary);
+    if(!out.good())
+    {
+        cout << timestamp << "MeshCheckpointIO: Unable to open '" << filename << "'." << endl;
+        return false;
+    }
+
+    CheckpointHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, HEM_MAGIC, sizeof(HEM_MAGIC));
+    header.byteOrder    = HEM_BYTE_ORDER;
+    header.version      = HEM_VERSION;
+    header.flags        = c.flags;
+    strncpy(header.stage, c.stage.c_str(), sizeof(header.stage) - 1);
+
+    // Write a preliminary header and update the table
+    // positions when all data is written
+    out.write((const char*)&header, sizeof(header));
+
+    writeTable(out, c.vertices.get(),    c.numVertices,    header.tables[0]);
+    writeTable(out, c.edges.get(),       c.numEdges,       header.tables[1]);
+    writeTable(out, c.inEdges.get(),     c.numInEdges,     header.tables[2]);
+    writeTable(out, c.faces.get(),       c.numFaces,       header.tables[3]);
+    writeTable(out, c.regions.get(),     c.numRegions,     header.tables[4]);
+    writeTable(out, c.regionFaces.get(), c.numRegionFaces, header.tables[5]);
+    writeTable(out, c.labels.get(),      c.numLabelBytes,  header.tables[6]);
+
+    out.seekp(0);
+    out.write((const char*)&header, sizeof(header));
+
+    return out.good();
+}
+
+} // namespace lvr
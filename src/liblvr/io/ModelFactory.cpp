@@ -33,6 +33,7 @@
 #include <lvr/io/ModelFactory.hpp>
 #include <lvr/io/DatIO.hpp>
 #include <lvr/io/STLIO.hpp>
+#include <lvr/io/LabeledMeshIO.hpp>
 
 #include <lvr/io/Timestamp.hpp>
 #include <lvr/io/Progress.hpp>
@@ -71,6 +72,14 @@ ModelPtr ModelFactory::readModel( std::string filename )
     {
         io = new ObjIO;
     }
+    else if (extension == ".stl")
+    {
+        io = new STLIO;
+    }
+    else if (extension == ".lbm")
+    {
+        io = new LabeledMeshIO;
+    }
     else if (extension == ".las")
     {
         io = new LasIO;
@@ -222,6 +231,10 @@ void ModelFactory::saveModel( ModelPtr m, std::string filename)
     {
     	io = new STLIO;
     }
+    else if (extension == ".lbm")
+    {
+    	io = new LabeledMeshIO;
+    }
 #ifdef LVR_USE_PCL
     else if (extension == ".pcd")
     {
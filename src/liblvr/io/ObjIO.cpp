@@ -36,12 +36,18 @@
 #include <string.h>
 #include <locale.h>
 #include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdint.h>
 
 #include <boost/filesystem.hpp>
 #include "boost/tuple/tuple.hpp"
 
 #include <lvr/io/PLYIO.hpp>
+#include <lvr/io/MappedFile.hpp>
 #include <lvr/io/Timestamp.hpp>
+#include <lvr/config/TaskScheduler.hpp>
 #include <lvr/geometry/Vertex.hpp>
 #include <lvr/display/GlTexture.hpp>
 #include <lvr/display/TextureFactory.hpp>
@@ -157,154 +163,750 @@ void ObjIO::parseMtlFile(
 	}
 }
 
-ModelPtr ObjIO::read(string filename)
+namespace
 {
-    // Get path from filename
-    boost::filesystem::path p(filename);
 
-	ifstream in(filename.c_str());
+/// Line aligned part of an obj file that is parsed by a single task
+struct ObjChunk
+{
+    const char*     begin;
+    const char*     end;
+
+    /// Number of elements in the chunk (first pass)
+    size_t          numVertices;
+    size_t          numNormals;
+    size_t          numTexCoords;
+    size_t          numFaces;
+
+    /// Offsets of the chunk's elements in the output arrays
+    size_t          vertexOffset;
+    size_t          normalOffset;
+    size_t          texCoordOffset;
+    size_t          faceOffset;
+
+    /// Number of lines in the chunk and before the chunk
+    size_t          numLines;
+    size_t          lineOffset;
+
+    /// Largest positive vertex index of the faces and its line in
+    /// the chunk (first pass)
+    long            maxIndex;
+    size_t          maxIndexLine;
+
+    /// Smallest vertex index relative to the chunk's first vertex that
+    /// a negative index resolves to and its line in the chunk (first pass)
+    long            minRelative;
+    size_t          minRelativeLine;
+
+    /// First line in the chunk with the invalid vertex index 0, 0 if
+    /// there is none (first pass)
+    size_t          zeroIndexLine;
+
+    /// 'usemtl' statements in the order of appearance
+    vector<string>  materialNames;
+
+    /// Resolved material indices of the 'usemtl' statements (-1 if undefined)
+    vector<int>     materialIndices;
+
+    /// 'mtllib' statements in the order of appearance
+    vector<string>  mtlLibs;
+
+    /// Active material at the beginning of the chunk
+    int             startMaterial;
+};
 
-	vector<float> 		vertices;
-	vector<float> 		normals;
-	vector<float> 		texcoords;
-	vector<uint>		faceMaterials;
-	vector<uint>  		faces;
-	vector<Material*> 	materials;
-	vector<GlTexture*>	textures;
+/// Output arrays for the second pass
+struct ObjArrays
+{
+    float*          vertices;
+    float*          normals;
+    float*          texCoords;
+    unsigned int*   faces;
+    unsigned int*   faceMaterials;
+};
 
-	map<string, int> matNames;
+const double s_pow10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
 
-	int currentMat = 0;
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
 
-	if(in.good())
-	{
-		char buffer[1024];
-		while(in.good())
-		{
-			in.getline(buffer, 1024);
+inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
 
-			// Skip comments
-			if(buffer[0] == '#') continue;
+inline const char* skipSpaces(const char* p, const char* end)
+{
+    while(p < end && isSpace(*p))
+    {
+        p++;
+    }
+    return p;
+}
 
-			stringstream ss(buffer);
-			string keyword;
-			ss >> keyword;
-			float x, y, z;
-			if(keyword == "v")
-			{
-				ss >> x >> y >> z;
-				vertices.push_back(x);
-				vertices.push_back(y);
-				vertices.push_back(z);
-			}
-			else if(keyword == "vt")
-			{
-				ss >> x >> y >> z;
-				texcoords.push_back(x);
-				texcoords.push_back(1 - y);
-				texcoords.push_back(z);
-			}
-			else if(keyword == "vn")
-			{
-				ss >> x >> y >> z;
-				normals.push_back(x);
-				normals.push_back(y);
-				normals.push_back(z);
-			}
-			else if(keyword == "f")
-			{
-				vector<string> tokens;
-				tokenize(buffer, tokens);
+inline const char* skipToken(const char* p, const char* end)
+{
+    while(p < end && !isSpace(*p))
+    {
+        p++;
+    }
+    return p;
+}
 
-				if(tokens.size() < 4)
-					continue;
+/// Parses a float value and advances p. Returns false if no number was found.
+bool parseFloat(const char*& p, const char* end, float& value)
+{
+    p = skipSpaces(p, end);
+    const char* start = p;
 
-				vector<string> tokens2;
-				tokenize(tokens.at(1),tokens2,"/");
-				int a = atoi(tokens2.at(0).c_str());
-				tokens2.clear();
+    bool negative = false;
+    if(p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
 
-				tokenize(tokens.at(2),tokens2,"/");
-				int b = atoi(tokens2.at(0).c_str());
-				tokens2.clear();
+    // Collect up to 19 significant digits in an integer mantissa
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool found = false;
 
-				tokenize(tokens.at(3),tokens2,"/");
-				int c = atoi(tokens2.at(0).c_str());
-				tokens2.clear();
+    while(p < end && isDigit(*p))
+    {
+        if(digits < 19)
+        {
+            mantissa = 10 * mantissa + (*p - '0');
+            if(mantissa)
+            {
+                digits++;
+            }
+        }
+        else
+        {
+            exponent++;
+        }
+        found = true;
+        p++;
+    }
 
-				faces.push_back(a - 1);
-				faces.push_back(b - 1);
-				faces.push_back(c - 1);
+    if(p < end && *p == '.')
+    {
+        p++;
+        while(p < end && isDigit(*p))
+        {
+            if(digits < 19)
+            {
+                mantissa = 10 * mantissa + (*p - '0');
+                if(mantissa)
+                {
+                    digits++;
+                }
+                exponent--;
+            }
+            found = true;
+            p++;
+        }
+    }
 
-				// Use current material
-				faceMaterials.push_back(currentMat);
-			}
-			else if(keyword == "usemtl")
-			{
-				string mtlname;
-				ss >> mtlname;
-				// Find name and set current material
-				map<string, int>::iterator it = matNames.find(mtlname);
-				if(it == matNames.end())
-				{
-					cout << "ObjIO:read(): Warning material '" << mtlname << "' is undefined." << endl;
-				}
-				else
-				{
-					currentMat = it->second;
-				}
-			}
-			else if(keyword == "mtllib")
-			{
-			    // Get current path
-			    p = p.remove_filename();
+    if(!found)
+    {
+        // Special values like 'nan' or 'inf'
+        char buffer[64];
+        const char* tokenEnd = skipToken(start, end);
+        size_t length = std::min((size_t)(tokenEnd - start), sizeof(buffer) - 1);
+        memcpy(buffer, start, length);
+        buffer[length] = 0;
+
+        char* parsed;
+        double d = strtod(buffer, &parsed);
+        if(parsed == buffer)
+        {
+            p = start;
+            return false;
+        }
+        value = (float)d;
+        p = start + (parsed - buffer);
+        return true;
+    }
 
-			    // Append .mtl file name
-				string mtlfile;
-				ss >> mtlfile;
-				p = p / mtlfile;
+    if(p < end && (*p == 'e' || *p == 'E'))
+    {
+        const char* q = p + 1;
+        bool negativeExp = false;
+        if(q < end && (*q == '-' || *q == '+'))
+        {
+            negativeExp = (*q == '-');
+            q++;
+        }
+
+        if(q < end && isDigit(*q))
+        {
+            int e = 0;
+            while(q < end && isDigit(*q))
+            {
+                if(e < 10000)
+                {
+                    e = 10 * e + (*q - '0');
+                }
+                q++;
+            }
+            exponent += negativeExp ? -e : e;
+            p = q;
+        }
+    }
 
-				// Get path as string and parse mtl
-				string mtl_path = p.string();
-				parseMtlFile(matNames, materials, textures, mtl_path);
-			}
-		}
+    // Exact for mantissas below 2^53 and small exponents
+    double d = (double)mantissa;
+    if(exponent < 0 && exponent >= -22)
+    {
+        d /= s_pow10[-exponent];
+    }
+    else if(exponent > 0 && exponent <= 22)
+    {
+        d *= s_pow10[exponent];
+    }
+    else if(exponent != 0)
+    {
+        d *= pow(10.0, exponent);
+    }
 
-	}
-	else
-	{
-		cout << timestamp << "ObjIO::read(): Unable to open file'" << filename << "'." << endl;
-	}
+    value = (float)(negative ? -d : d);
+    return true;
+}
+
+/// Parses an integer and advances p. Returns false if no number was found.
+inline bool parseInt(const char*& p, const char* end, long& value)
+{
+    bool negative = false;
+    if(p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
 
-	MeshBufferPtr mesh = MeshBufferPtr(new MeshBuffer);
+    if(p >= end || !isDigit(*p))
+    {
+        return false;
+    }
 
-	if(materials.size())
-	{
-		mesh->setMaterialArray(materials);
-	}
+    // Larger values are clamped, they are no valid indices anyway
+    long v = 0;
+    while(p < end && isDigit(*p))
+    {
+        if(v < 100000000000000L)
+        {
+            v = 10 * v + (*p - '0');
+        }
+        p++;
+    }
+    value = negative ? -v : v;
+    return true;
+}
 
-	if(faceMaterials.size() == faces.size() / 3)
-	{
-		mesh->setFaceMaterialIndexArray(faceMaterials);
-	}
-	else
-	{
-		cout << "ObjIO::read(): Warning: Face material index buffer does not match face number." << endl;
-	}
+/// Returns the first token after p as string
+inline string parseName(const char* p, const char* end)
+{
+    p = skipSpaces(p, end);
+    return string(p, skipToken(p, end));
+}
 
-	if(textures.size())
-	{
-		mesh->setTextureArray(textures);
-	}
+/// Returns true if the line starting at p begins with the given keyword
+inline bool isKeyword(const char* p, const char* end, const char* keyword, size_t length)
+{
+    return (size_t)(end - p) > length
+        && memcmp(p, keyword, length) == 0
+        && isSpace(p[length]);
+}
+
+/**
+ * @brief   Parses the lines of a chunk. In the first pass (arrays == 0)
+ *          the elements are counted and the material statements are
+ *          collected, in the second pass the data is written to the
+ *          output arrays at the chunk's offsets.
+ */
+void parseObjChunk(ObjChunk& chunk, const ObjArrays* arrays)
+{
+    size_t numVertices  = 0;
+    size_t numNormals   = 0;
+    size_t numTexCoords = 0;
+    size_t numFaces     = 0;
+    size_t numMaterials = 0;
+    size_t numLines     = 0;
+    int currentMat = chunk.startMaterial;
+
+    const char* p = chunk.begin;
+    while(p < chunk.end)
+    {
+        numLines++;
+        const char* lineEnd = (const char*)memchr(p, '\n', chunk.end - p);
+        if(!lineEnd)
+        {
+            lineEnd = chunk.end;
+        }
+
+        const char* q = skipSpaces(p, lineEnd);
+        p = lineEnd + 1;
+
+        if(q == lineEnd || *q == '#')
+        {
+            continue;
+        }
+
+        float x, y, z;
+        if(isKeyword(q, lineEnd, "v", 1))
+        {
+            if(arrays)
+            {
+                q += 1;
+                x = y = z = 0.0f;
+                parseFloat(q, lineEnd, x);
+                parseFloat(q, lineEnd, y);
+                parseFloat(q, lineEnd, z);
+                float* v = arrays->vertices + 3 * (chunk.vertexOffset + numVertices);
+                v[0] = x;
+                v[1] = y;
+                v[2] = z;
+            }
+            numVertices++;
+        }
+        else if(isKeyword(q, lineEnd, "vn", 2))
+        {
+            if(arrays)
+            {
+                q += 2;
+                x = y = z = 0.0f;
+                parseFloat(q, lineEnd, x);
+                parseFloat(q, lineEnd, y);
+                parseFloat(q, lineEnd, z);
+                float* n = arrays->normals + 3 * (chunk.normalOffset + numNormals);
+                n[0] = x;
+                n[1] = y;
+                n[2] = z;
+            }
+            numNormals++;
+        }
+        else if(isKeyword(q, lineEnd, "vt", 2))
+        {
+            if(arrays)
+            {
+                q += 2;
+                x = y = z = 0.0f;
+                parseFloat(q, lineEnd, x);
+                parseFloat(q, lineEnd, y);
+                parseFloat(q, lineEnd, z);
+                float* t = arrays->texCoords + 3 * (chunk.texCoordOffset + numTexCoords);
+                t[0] = x;
+                t[1] = 1 - y;
+                t[2] = z;
+            }
+            numTexCoords++;
+        }
+        else if(isKeyword(q, lineEnd, "f", 1))
+        {
+            // Parse the vertex indices of all corners. Texture and
+            // normal indices (a/b/c) are skipped. Polygons are
+            // triangulated as a fan.
+            q += 1;
+            long first = 0;
+            long previous = 0;
+            int corners = 0;
+            while(true)
+            {
+                q = skipSpaces(q, lineEnd);
+                if(q == lineEnd)
+                {
+                    break;
+                }
+
+                long index;
+                if(!parseInt(q, lineEnd, index))
+                {
+                    break;
+                }
+                q = skipToken(q, lineEnd);
+
+                // Remember the extreme indices, they are checked when
+                // the vertex counts of all chunks are known
+                if(!arrays)
+                {
+                    if(index == 0 && chunk.zeroIndexLine == 0)
+                    {
+                        chunk.zeroIndexLine = numLines;
+                    }
+                    else if(index > chunk.maxIndex)
+                    {
+                        chunk.maxIndex = index;
+                        chunk.maxIndexLine = numLines;
+                    }
+                    else if(index < 0 && (long)numVertices + index < chunk.minRelative)
+                    {
+                        chunk.minRelative = (long)numVertices + index;
+                        chunk.minRelativeLine = numLines;
+                    }
+                }
+
+                // Negative indices are relative to the current vertex count
+                long absolute = index > 0 ? index - 1 : (long)(chunk.vertexOffset + numVertices) + index;
+
+                if(corners >= 2)
+                {
+                    if(arrays)
+                    {
+                        unsigned int* f = arrays->faces + 3 * (chunk.faceOffset + numFaces);
+                        f[0] = (unsigned int)first;
+                        f[1] = (unsigned int)previous;
+                        f[2] = (unsigned int)absolute;
+                        arrays->faceMaterials[chunk.faceOffset + numFaces] = currentMat;
+                    }
+                    numFaces++;
+                }
+                else if(corners == 0)
+                {
+                    first = absolute;
+                }
+                previous = absolute;
+                corners++;
+            }
+        }
+        else if(isKeyword(q, lineEnd, "usemtl", 6))
+        {
+            if(arrays)
+            {
+                int index = chunk.materialIndices[numMaterials];
+                if(index >= 0)
+                {
+                    currentMat = index;
+                }
+            }
+            else
+            {
+                chunk.materialNames.push_back(parseName(q + 6, lineEnd));
+            }
+            numMaterials++;
+        }
+        else if(isKeyword(q, lineEnd, "mtllib", 6))
+        {
+            if(!arrays)
+            {
+                chunk.mtlLibs.push_back(parseName(q + 6, lineEnd));
+            }
+        }
+    }
+
+    if(!arrays)
+    {
+        chunk.numVertices  = numVertices;
+        chunk.numNormals   = numNormals;
+        chunk.numTexCoords = numTexCoords;
+        chunk.numFaces     = numFaces;
+        chunk.numLines     = numLines;
+    }
+}
+
+/// Appends an unsigned integer to the string
+inline void appendUInt(string& s, unsigned long value)
+{
+    char buffer[24];
+    int n = 0;
+    do
+    {
+        buffer[n++] = '0' + (char)(value % 10);
+        value /= 10;
+    }
+    while(value);
+
+    while(n)
+    {
+        s += buffer[--n];
+    }
+}
+
+/// Appends a value in the default format of ostreams (%g)
+inline void appendFloat(string& s, double value)
+{
+    char buffer[32];
+    int n = snprintf(buffer, sizeof(buffer), "%g", value);
+    s.append(buffer, n);
+}
 
-	mesh->setVertexTextureCoordinateArray(texcoords);
-	mesh->setVertexArray(vertices);
-	mesh->setVertexNormalArray(normals);
-	mesh->setFaceArray(faces);
+/// Index format of the face definitions (v, v/vt, v//vn or v/vt/vn)
+enum ObjFaceFormat
+{
+    OBJ_FACE_V,
+    OBJ_FACE_V_VT,
+    OBJ_FACE_V_VN,
+    OBJ_FACE_V_VT_VN
+};
 
-	ModelPtr m(new Model(mesh));
-	m_model = m;
-	return m;
+/// Appends an 'f' line for the given face
+inline void appendFace(string& s, const unsigned int* faceIndices, size_t face, ObjFaceFormat format)
+{
+    s += 'f';
+    for(int j = 0; j < 3; j++)
+    {
+        unsigned long index = faceIndices[3 * face + j] + 1;
+        s += ' ';
+        appendUInt(s, index);
+        if(format == OBJ_FACE_V_VT || format == OBJ_FACE_V_VT_VN)
+        {
+            s += '/';
+            appendUInt(s, index);
+        }
+        if(format == OBJ_FACE_V_VN)
+        {
+            s += "//";
+            appendUInt(s, index);
+        }
+        if(format == OBJ_FACE_V_VT_VN)
+        {
+            s += '/';
+            appendUInt(s, index);
+        }
+    }
+    s += '\n';
+}
+
+/**
+ * @brief   Calls format(i, s) for all i in [0, count) to create the text
+ *          of each element. Blocks of elements are formatted in parallel
+ *          and written in order.
+ */
+template<typename FormatT>
+void writeFormatted(ostream& out, size_t count, FormatT format)
+{
+    const size_t blockSize = 1 << 16;
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    const size_t blocksPerRound = 4 * scheduler.numThreads();
+    vector<string> blocks(blocksPerRound);
+
+    for(size_t start = 0; start < count; start += blockSize * blocksPerRound)
+    {
+        size_t end = std::min(count, start + blockSize * blocksPerRound);
+        size_t numBlocks = (end - start + blockSize - 1) / blockSize;
+
+        scheduler.parallelFor(0, numBlocks, [&](size_t b, size_t e)
+        {
+            for(size_t k = b; k < e; k++)
+            {
+                string& s = blocks[k];
+                s.clear();
+                size_t first = start + k * blockSize;
+                size_t last = std::min(end, first + blockSize);
+                for(size_t i = first; i < last; i++)
+                {
+                    format(i, s);
+                }
+            }
+        }, 1);
+
+        for(size_t k = 0; k < numBlocks; k++)
+        {
+            out.write(blocks[k].data(), blocks[k].size());
+        }
+    }
+}
+
+} // namespace
+
+ModelPtr ObjIO::read(string filename)
+{
+    // Get path from filename
+    boost::filesystem::path p(filename);
+
+    MappedFile file(filename);
+
+    vector<Material*> 	materials;
+    vector<GlTexture*>	textures;
+
+    map<string, int> matNames;
+
+    MeshBufferPtr mesh = MeshBufferPtr(new MeshBuffer);
+
+    if(!file.good())
+    {
+        cout << timestamp << "ObjIO::read(): Unable to open file'" << filename << "'." << endl;
+        ModelPtr m(new Model(mesh));
+        m_model = m;
+        return m;
+    }
+
+    // Split the file into line aligned chunks
+    const char* data = file.data();
+    const size_t size = file.size();
+    TaskScheduler& scheduler = TaskScheduler::instance();
+
+    size_t numChunks = std::max((size_t)1, std::min((size_t)(4 * scheduler.numThreads()), size / (1 << 20)));
+    vector<ObjChunk> chunks(numChunks);
+
+    const char* chunkBegin = data;
+    for(size_t i = 0; i < numChunks; i++)
+    {
+        const char* chunkEnd = data + (i + 1) * size / numChunks;
+        if(i + 1 == numChunks)
+        {
+            chunkEnd = data + size;
+        }
+        else
+        {
+            if(chunkEnd < chunkBegin)
+            {
+                chunkEnd = chunkBegin;
+            }
+            const char* newline = (const char*)memchr(chunkEnd, '\n', data + size - chunkEnd);
+            chunkEnd = newline ? newline + 1 : data + size;
+        }
+
+        chunks[i].begin = chunkBegin;
+        chunks[i].end = chunkEnd;
+        chunks[i].startMaterial = 0;
+        chunks[i].maxIndex = 0;
+        chunks[i].maxIndexLine = 0;
+        chunks[i].minRelative = 0;
+        chunks[i].minRelativeLine = 0;
+        chunks[i].zeroIndexLine = 0;
+        chunkBegin = chunkEnd;
+    }
+
+    // First pass: count elements in parallel
+    scheduler.parallelFor(0, numChunks, [&chunks](size_t b, size_t e)
+    {
+        for(size_t i = b; i < e; i++)
+        {
+            parseObjChunk(chunks[i], 0);
+        }
+    }, 1);
+
+    // Compute the output offsets of all chunks (prefix sums)
+    size_t numVertices = 0, numNormals = 0, numTexCoords = 0, numFaces = 0, numLines = 0;
+    for(size_t i = 0; i < numChunks; i++)
+    {
+        chunks[i].vertexOffset   = numVertices;
+        chunks[i].normalOffset   = numNormals;
+        chunks[i].texCoordOffset = numTexCoords;
+        chunks[i].faceOffset     = numFaces;
+        chunks[i].lineOffset     = numLines;
+        numVertices  += chunks[i].numVertices;
+        numNormals   += chunks[i].numNormals;
+        numTexCoords += chunks[i].numTexCoords;
+        numFaces     += chunks[i].numFaces;
+        numLines     += chunks[i].numLines;
+    }
+
+    // Reject faces with vertex indices that do not resolve to a vertex
+    for(size_t i = 0; i < numChunks; i++)
+    {
+        const ObjChunk& c = chunks[i];
+        size_t line = 0;
+        if(c.zeroIndexLine)
+        {
+            line = c.zeroIndexLine;
+        }
+        if(c.maxIndex > (long)numVertices && (!line || c.maxIndexLine < line))
+        {
+            line = c.maxIndexLine;
+        }
+        if((long)c.vertexOffset + c.minRelative < 0 && (!line || c.minRelativeLine < line))
+        {
+            line = c.minRelativeLine;
+        }
+
+        if(line)
+        {
+            cout << timestamp << "ObjIO::read(): Invalid vertex index in line "
+                 << c.lineOffset + line << " of '" << filename << "'." << endl;
+            ModelPtr m(new Model(mesh));
+            m_model = m;
+            return m;
+        }
+    }
+
+    // Parse material libraries
+    for(size_t i = 0; i < numChunks; i++)
+    {
+        for(size_t j = 0; j < chunks[i].mtlLibs.size(); j++)
+        {
+            // Get current path
+            p = p.remove_filename();
+
+            // Append .mtl file name and parse mtl
+            p = p / chunks[i].mtlLibs[j];
+            string mtl_path = p.string();
+            parseMtlFile(matNames, materials, textures, mtl_path);
+        }
+    }
+
+    // Resolve material names and the active material at
+    // the beginning of each chunk
+    int currentMat = 0;
+    for(size_t i = 0; i < numChunks; i++)
+    {
+        chunks[i].startMaterial = currentMat;
+        for(size_t j = 0; j < chunks[i].materialNames.size(); j++)
+        {
+            const string& mtlname = chunks[i].materialNames[j];
+            map<string, int>::iterator it = matNames.find(mtlname);
+            if(it == matNames.end())
+            {
+                cout << "ObjIO:read(): Warning material '" << mtlname << "' is undefined." << endl;
+                chunks[i].materialIndices.push_back(-1);
+            }
+            else
+            {
+                currentMat = it->second;
+                chunks[i].materialIndices.push_back(currentMat);
+            }
+        }
+    }
+
+    // Second pass: parse the data directly into the buffer arrays
+    floatArr vertices(new float[3 * numVertices]);
+    floatArr normals(new float[3 * numNormals]);
+    floatArr texcoords(new float[3 * numTexCoords]);
+    uintArr  faces(new unsigned int[3 * numFaces]);
+    uintArr  faceMaterials(new unsigned int[numFaces]);
+
+    ObjArrays arrays;
+    arrays.vertices      = vertices.get();
+    arrays.normals       = normals.get();
+    arrays.texCoords     = texcoords.get();
+    arrays.faces         = faces.get();
+    arrays.faceMaterials = faceMaterials.get();
+
+    scheduler.parallelFor(0, numChunks, [&chunks, &arrays](size_t b, size_t e)
+    {
+        for(size_t i = b; i < e; i++)
+        {
+            parseObjChunk(chunks[i], &arrays);
+        }
+    }, 1);
+
+    if(materials.size())
+    {
+        mesh->setMaterialArray(materials);
+    }
+
+    mesh->setFaceMaterialIndexArray(faceMaterials, numFaces);
+
+    if(textures.size())
+    {
+        mesh->setTextureArray(textures);
+    }
+
+    mesh->setVertexTextureCoordinateArray(texcoords, numTexCoords);
+    mesh->setVertexArray(vertices, numVertices);
+    mesh->setVertexNormalArray(normals, numNormals);
+    mesh->setFaceArray(faces, numFaces);
+
+    ModelPtr m(new Model(mesh));
+    m_model = m;
+    return m;
 }
 
 class sort_indices
@@ -318,9 +920,6 @@ class sort_indices
 
 void ObjIO::save( string filename )
 {
-	
-	typedef Vertex<unsigned char> ObjColor;
-
 	size_t lenVertices;
 	size_t lenNormals;
 	size_t lenFaces;
@@ -336,12 +935,6 @@ void ObjIO::save( string filename )
 	uintArr	faceMaterialIndices   = m_model->m_mesh->getFaceMaterialIndexArray(lenFaceMaterialIndices);
 	ucharArr colors 			  = m_model->m_mesh->getVertexColorArray(lenColors);
 
-	std::map<ObjColor, unsigned int> colorMap;
-
-
-	std::set<unsigned int> materialIndexSet;
-	std::set<unsigned int> colorIndexSet;
-
 	ofstream out(filename.c_str());
 	ofstream mtlFile("textures.mtl");
 
@@ -356,165 +949,118 @@ void ObjIO::save( string filename )
 		}
 		out << endl << endl << "##  Beginning of vertex definitions.\n";
 
-		for( size_t i=0; i < lenVertices; ++i )
+		writeFormatted(out, lenVertices, [&](size_t i, string& s)
 		{
-			
-			out << "v " << vertices[i][0] << " "
-					<< vertices[i][1] << " "
-					<< vertices[i][2] << " ";
-					if(lenColors>0){
-						unsigned int r=static_cast<unsigned int>(colors[i*3]),g=static_cast<unsigned int>(colors[i*3+1]),b=static_cast<unsigned int>(colors[i*3+2]);
-						out << static_cast<float>(r)/255.0 << " "
-						<< static_cast<float>(g)/255.0 << " "
-						<< static_cast<float>(b)/255.0 ;
-					}
-					out << endl;
-		}
+			s += "v ";
+			appendFloat(s, vertices[i][0]);
+			s += ' ';
+			appendFloat(s, vertices[i][1]);
+			s += ' ';
+			appendFloat(s, vertices[i][2]);
+			s += ' ';
+			if(lenColors > 0)
+			{
+				appendFloat(s, colors[3 * i] / 255.0);
+				s += ' ';
+				appendFloat(s, colors[3 * i + 1] / 255.0);
+				s += ' ';
+				appendFloat(s, colors[3 * i + 2] / 255.0);
+			}
+			s += '\n';
+		});
 
 		out<<endl;
 
 		out << endl << endl << "##  Beginning of vertex normals.\n";
-		for( size_t i=0; i < lenNormals; ++i )
+		writeFormatted(out, lenNormals, [&](size_t i, string& s)
 		{
-			out << "vn " << normals[i][0] << " "
-					<< normals[i][1] << " "
-					<< normals[i][2] << endl;
-		}
+			s += "vn ";
+			appendFloat(s, normals[i][0]);
+			s += ' ';
+			appendFloat(s, normals[i][1]);
+			s += ' ';
+			appendFloat(s, normals[i][2]);
+			s += '\n';
+		});
 
 		out << endl << endl << "##  Beginning of vertexTextureCoordinates.\n";
-
-		for( size_t i=0; i < lenTextureCoordinates; ++i )
+		writeFormatted(out, lenTextureCoordinates, [&](size_t i, string& s)
 		{
-			out << "vt " << textureCoordinates[i][0] << " "
-					<< textureCoordinates[i][1] << " "
-					<< textureCoordinates[i][2] << endl;
-		}
-
+			s += "vt ";
+			appendFloat(s, textureCoordinates[i][0]);
+			s += ' ';
+			appendFloat(s, textureCoordinates[i][1]);
+			s += ' ';
+			appendFloat(s, textureCoordinates[i][2]);
+			s += '\n';
+		});
 
 		out << endl << endl << "##  Beginning of faces.\n";
-		// format of a face: f v/vt/vn
-		//for( size_t i = 0; i < lenFaces; ++i )
-		//{
-			//cout << faceMaterialIndices[i] << " " << lenFaceMaterials << endl;
-			//Material* m = materials[faceMaterialIndices[i]];
-			//if(m->texture_index >= 0)
-			//{
-				//out << "usemtl texture_" << m->texture_index << endl;
-			//}
-			//else
-			//{
-				//out << "usemtl color_" << faceMaterialIndices[i] << endl;
-			//}
-
-			////unsigned int* faceTextureIndices
-			////float**       textureCoordinates
-			////usemtl....
-			//// +1 after every index since in obj the 0-th vertex has index 1.
-			//out << "f "
-					//<< faceIndices[i * 3 + 0] + 1 << "/"
-					//<< faceIndices[i * 3 + 0] + 1 << "/"
-					//<< faceIndices[i * 3 + 0] + 1 << " "
-					//<< faceIndices[i * 3 + 1] + 1 << "/"
-					//<< faceIndices[i * 3 + 1] + 1 << "/"
-					//<< faceIndices[i * 3 + 1] + 1 << " "
-					//<< faceIndices[i * 3 + 2] + 1 << "/"
-					//<< faceIndices[i * 3 + 2] + 1 << "/"
-					//<< faceIndices[i * 3 + 2] + 1 << endl;
-		//}
-		
-		// format of a face: f v/vt/vn
-		
-		std::vector<int> color_indices,texture_indices;
-		
-		//splitting materials in colors an textures
-		for(size_t i = 0; i< lenFaces; ++i)
+
+		// Only reference texture coordinates and normals that exist
+		bool haveTex = lenTextureCoordinates >= lenVertices;
+		bool haveNormals = lenNormals >= lenVertices;
+		ObjFaceFormat format = haveTex ? (haveNormals ? OBJ_FACE_V_VT_VN : OBJ_FACE_V_VT)
+		                               : (haveNormals ? OBJ_FACE_V_VN : OBJ_FACE_V);
+		const unsigned int* faces = faceIndices.get();
+
+		if(lenFaceMaterials == 0 || lenFaceMaterialIndices < lenFaces)
 		{
-			Material* m = materials[faceMaterialIndices[i]];
-			if(m->texture_index >=0 )
+			// No materials
+			writeFormatted(out, lenFaces, [&](size_t i, string& s)
 			{
-				texture_indices.push_back(i);
-			}else{
-				color_indices.push_back(i);
-			}
+				appendFace(s, faces, i, format);
+			});
 		}
-		
-		//sort faceMaterialsIndices: colors, textur_indices 
-		//sort new index lists instead of the faceMaterialIndices
-		std::sort(color_indices.begin(),color_indices.end(),sort_indices(faceMaterialIndices));
-		std::sort(texture_indices.begin(),texture_indices.end(),sort_indices(faceMaterialIndices));
-		
-		//colors
-		for(size_t i = 0; i<color_indices.size() ; i++)
+		else
 		{
-			unsigned int first = faceMaterialIndices[color_indices[i]];
-			unsigned int face_index=color_indices[i];
-			
-			if( i == 0 || first != faceMaterialIndices[color_indices[i-1]] )
-			{
-				out << "usemtl color_" << faceMaterialIndices[color_indices[i]] << endl;
-				out << "f "
-					<< faceIndices[face_index * 3 + 0] + 1 << "/"
-					<< faceIndices[face_index * 3 + 0] + 1 << "/"
-					<< faceIndices[face_index * 3 + 0] + 1 << " "
-					<< faceIndices[face_index * 3 + 1] + 1 << "/"
-					<< faceIndices[face_index * 3 + 1] + 1 << "/"
-					<< faceIndices[face_index * 3 + 1] + 1 << " "
-					<< faceIndices[face_index * 3 + 2] + 1 << "/"
-					<< faceIndices[face_index * 3 + 2] + 1 << "/"
-					<< faceIndices[face_index * 3 + 2] + 1 << endl;
-				
-			}else if( first == faceMaterialIndices[color_indices[i-1]] )
+			std::vector<int> color_indices,texture_indices;
+
+			//splitting materials in colors an textures
+			for(size_t i = 0; i< lenFaces; ++i)
 			{
-				out << "f "
-					<< faceIndices[face_index * 3 + 0] + 1 << "/"
-					<< faceIndices[face_index * 3 + 0] + 1 << "/"
-					<< faceIndices[face_index * 3 + 0] + 1 << " "
-					<< faceIndices[face_index * 3 + 1] + 1 << "/"
-					<< faceIndices[face_index * 3 + 1] + 1 << "/"
-					<< faceIndices[face_index * 3 + 1] + 1 << " "
-					<< faceIndices[face_index * 3 + 2] + 1 << "/"
-					<< faceIndices[face_index * 3 + 2] + 1 << "/"
-					<< faceIndices[face_index * 3 + 2] + 1 << endl;
+				Material* m = materials[faceMaterialIndices[i]];
+				if(m->texture_index >=0 )
+				{
+					texture_indices.push_back(i);
+				}else{
+					color_indices.push_back(i);
+				}
 			}
-		}
-		
-		out<<endl;
-		
-		//textures
-		for(size_t i = 0; i<texture_indices.size() ; i++)
-		{
-			Material* first = materials[faceMaterialIndices[texture_indices[i]]];
-			size_t face_index=texture_indices[i];
-			
-			if(i==0 || first->texture_index != materials[faceMaterialIndices[texture_indices[i-1]]]->texture_index )
+
+			//sort faceMaterialsIndices: colors, textur_indices
+			//sort new index lists instead of the faceMaterialIndices
+			std::stable_sort(color_indices.begin(),color_indices.end(),sort_indices(faceMaterialIndices));
+			std::stable_sort(texture_indices.begin(),texture_indices.end(),sort_indices(faceMaterialIndices));
+
+			//colors
+			writeFormatted(out, color_indices.size(), [&](size_t i, string& s)
 			{
-				out << "usemtl texture_" << first->texture_index << endl;
-				//std::cout << "usemtl texture_" << first->texture_index << std::endl;
-				out << "f "
-					<< faceIndices[face_index * 3 + 0] + 1 << "/"
-					<< faceIndices[face_index * 3 + 0] + 1 << "/"
-					<< faceIndices[face_index * 3 + 0] + 1 << " "
-					<< faceIndices[face_index * 3 + 1] + 1 << "/"
-					<< faceIndices[face_index * 3 + 1] + 1 << "/"
-					<< faceIndices[face_index * 3 + 1] + 1 << " "
-					<< faceIndices[face_index * 3 + 2] + 1 << "/"
-					<< faceIndices[face_index * 3 + 2] + 1 << "/"
-					<< faceIndices[face_index * 3 + 2] + 1 << endl;
-			}else if(first->texture_index == materials[faceMaterialIndices[texture_indices[i-1]]]->texture_index )
-			{ 
-				out << "f "
-					<< faceIndices[face_index * 3 + 0] + 1 << "/"
-					<< faceIndices[face_index * 3 + 0] + 1 << "/"
-					<< faceIndices[face_index * 3 + 0] + 1 << " "
-					<< faceIndices[face_index * 3 + 1] + 1 << "/"
-					<< faceIndices[face_index * 3 + 1] + 1 << "/"
-					<< faceIndices[face_index * 3 + 1] + 1 << " "
-					<< faceIndices[face_index * 3 + 2] + 1 << "/"
-					<< faceIndices[face_index * 3 + 2] + 1 << "/"
-					<< faceIndices[face_index * 3 + 2] + 1 << endl;
-			}
-		}
+				unsigned int material = faceMaterialIndices[color_indices[i]];
+				if(i == 0 || material != faceMaterialIndices[color_indices[i - 1]])
+				{
+					s += "usemtl color_";
+					appendUInt(s, material);
+					s += '\n';
+				}
+				appendFace(s, faces, color_indices[i], format);
+			});
+
+			out<<endl;
 
+			//textures
+			writeFormatted(out, texture_indices.size(), [&](size_t i, string& s)
+			{
+				int texture = materials[faceMaterialIndices[texture_indices[i]]]->texture_index;
+				if(i == 0 || texture != materials[faceMaterialIndices[texture_indices[i - 1]]]->texture_index)
+				{
+					s += "usemtl texture_";
+					appendUInt(s, texture);
+					s += '\n';
+				}
+				appendFace(s, faces, texture_indices[i], format);
+			});
+		}
 
 		out<<endl;
 		out.close();
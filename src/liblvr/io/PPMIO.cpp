@@ -29,8 +29,17 @@
  */
 
 #include <lvr/io/PPMIO.hpp>
+#include <lvr/io/MappedFile.hpp>
+
 #include <iostream>
 #include <fstream>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <stdint.h>
 #include <string.h>
 
 using namespace std;
@@ -38,114 +47,358 @@ using namespace std;
 namespace lvr
 {
 
-PPMIO::PPMIO()
+namespace
 {
-    m_pixels    = 0;
-    m_width   = 0;
-    m_height   = 0;
-}
 
-PPMIO::PPMIO( string filename ) : m_width(0), m_height(0), m_pixels(0)
+/// True if the machine stores the lowest byte first
+bool isLittleEndian()
 {
+    unsigned short x = 1;
+    return *(unsigned char*)&x == 1;
+}
 
-    // Try to open file
-    ifstream in(filename.c_str());
-
-    // Parse file
-    if(in.good())
+/// Skips white spaces and comments
+const char* skipSpace( const char* p, const char* end )
+{
+    while(p < end)
     {
-        // Line buffer
-        char buffer[1024];
-
-        // Read file tag
-        readLine(in, buffer);
-
-        // Check tag
-        string tag(buffer);
-        if(tag == "P3")
+        if(*p == '#')
         {
-            // Read width, height and color information
-            stringstream ss;
-            readLine(in, buffer);
-            ss << buffer << " ";
-            readLine(in, buffer);
-            ss << buffer << " ";
-
-            // Read formatted data
-            ss >> m_width >> m_height;
-
-            // Alloc data
-            m_pixels = new unsigned char[m_width * m_height * 3];
-
-            // Read pixels
-            int p;
-            for(int i = 0; i < m_width * m_height * 3; i++)
+            while(p < end && *p != '\n')
             {
-                in >> p;
-                m_pixels[i] = (unsigned char)p;
+                p++;
             }
         }
+        else if(isspace((unsigned char)*p))
+        {
+            p++;
+        }
         else
         {
-            in.close();
-            in.open(filename.c_str(), ios::binary);
-            //	    readLine(in, buffer);
-            //	    char tmp[3];
-            //	    sscanf(buffer, "%s %d %d 255", tmp, &m_width, &m_height);
+            break;
+        }
+    }
+    return p;
+}
+
+/// Reads the next header token
+bool readToken( const char*& p, const char* end, string& token )
+{
+    p = skipSpace(p, end);
+    const char* start = p;
+    while(p < end && !isspace((unsigned char)*p) && *p != '#')
+    {
+        p++;
+    }
+    token.assign(start, p);
+    return !token.empty();
+}
+
+/// Reads a non negative decimal number. Fails if it does not fit into an int.
+bool readInt( const char*& p, const char* end, int& value )
+{
+    p = skipSpace(p, end);
+    if(p == end || *p < '0' || *p > '9')
+    {
+        return false;
+    }
+
+    value = 0;
+    while(p < end && *p >= '0' && *p <= '9')
+    {
+        int digit = *p - '0';
+        if(value > (INT_MAX - digit) / 10)
+        {
+            return false;
+        }
+        value = 10 * value + digit;
+        p++;
+    }
+    return true;
+}
+
+/// Reads n ASCII samples of P2 and P3 files that must not exceed maxValue
+template<typename T>
+bool readAsciiSamples( const char* p, const char* end, T* out, size_t n, int maxValue )
+{
+    for(size_t i = 0; i < n; i++)
+    {
+        int value;
+        if(!readInt(p, end, value) || value > maxValue)
+        {
+            return false;
+        }
+        out[i] = (T)value;
+    }
+    return true;
+}
+
+/// Builds the header of a binary PGM or PPM file
+string pnmHeader( int width, int height, int channels, int maxValue )
+{
+    stringstream ss;
+    ss << (channels == 1 ? "P5" : "P6") << "\n" << width << " " << height << "\n" << maxValue << "\n";
+    return ss.str();
+}
+
+/// Writes header and data with a single block write each
+bool writeBlock( string filename, const string& header, const char* data, size_t size )
+{
+    ofstream out(filename.c_str(), ios::binary);
+    if(!out.good())
+    {
+        cout << "PPMIO: Unable to open file " << filename << "." << endl;
+        return false;
+    }
+
+    out.write(header.c_str(), header.size());
+    out.write(data, size);
+    return out.good();
+}
+
+} // namespace
+
+PPMIO::PPMIO()
+    : m_width(0), m_height(0), m_channels(3), m_maxValue(255),
+      m_pixels(0), m_pixels16(0), m_floats(0), m_ownsPixels(true)
+{
 
-            string tag;
-            in >> tag;
+}
+
+PPMIO::PPMIO( string filename )
+    : m_width(0), m_height(0), m_channels(3), m_maxValue(255),
+      m_pixels(0), m_pixels16(0), m_floats(0), m_ownsPixels(true)
+{
+    MappedFile file(filename);
+    if(!file.good())
+    {
+        cout << "ReadPPM: Unable to open file " << filename << "." << endl;
+        return;
+    }
+
+    const char* p   = file.data();
+    const char* end = p + file.size();
+
+    // Parse header
+    string tag;
+    readToken(p, end, tag);
 
+    bool isFloat = (tag == "Pf" || tag == "PF");
+    bool isAscii = (tag == "P2" || tag == "P3");
+    if(!isFloat && !isAscii && tag != "P5" && tag != "P6")
+    {
+        cerr << "Unsupported tag, only P2, P3, P5, P6, Pf or PF possible." << endl;
+        return;
+    }
+
+    m_channels = (tag == "P2" || tag == "P5" || tag == "Pf") ? 1 : 3;
+
+    int width, height;
+    if(!readInt(p, end, width) || !readInt(p, end, height))
+    {
+        cerr << "ReadPPM: Invalid header in " << filename << "." << endl;
+        return;
+    }
 
-            if(tag == "P6") // TODO: hacked in for our output
+    // The scale of PFM files encodes the byte order
+    float scale = 1.0f;
+    if(isFloat)
+    {
+        string token;
+        readToken(p, end, token);
+        scale = atof(token.c_str());
+        m_maxValue = 0;
+    }
+    else if(!readInt(p, end, m_maxValue) || m_maxValue <= 0 || m_maxValue > 65535)
+    {
+        cerr << "ReadPPM: Invalid header in " << filename << "." << endl;
+        return;
+    }
+
+    // Binary data starts after a single white space
+    if(!isAscii)
+    {
+        p++;
+    }
+
+    // Every ASCII sample needs at least one digit, so both formats
+    // can be checked against the file size before allocating
+    size_t sampleSize = isFloat ? 4 : (m_maxValue > 255 ? 2 : 1);
+    size_t available  = p > end ? 0 : (size_t)(end - p) / (isAscii ? 1 : sampleSize);
+    if(height > 0 && (size_t)width > SIZE_MAX / height / m_channels)
+    {
+        cerr << "ReadPPM: Invalid header in " << filename << "." << endl;
+        return;
+    }
+
+    size_t n = (size_t)width * height * m_channels;
+    if(available < n)
+    {
+        cerr << "ReadPPM: File " << filename << " is truncated." << endl;
+        return;
+    }
+
+    m_width  = width;
+    m_height = height;
+
+    if(isFloat)
+    {
+        // PFM rows are stored bottom to top
+        m_floats = new float[n];
+        size_t rowSize = (size_t)width * m_channels;
+        for(int y = 0; y < height; y++)
+        {
+            memcpy(m_floats + (height - 1 - y) * rowSize, p + y * rowSize * 4, rowSize * 4);
+        }
+
+        // Negative scale means little endian data
+        if((scale < 0.0f) != isLittleEndian())
+        {
+            unsigned char* bytes = (unsigned char*)m_floats;
+            for(size_t i = 0; i < n; i++)
             {
-                int n_colors;
-                in >> m_width >> m_height >> n_colors;
-		in.getline(0,0);
-                m_pixels = new unsigned char[m_width * m_height * 3];
-                in.read((char *)m_pixels, m_width * m_height * 3);
+                std::swap(bytes[4 * i],     bytes[4 * i + 3]);
+                std::swap(bytes[4 * i + 1], bytes[4 * i + 2]);
             }
-            else
+        }
+    }
+    else if(m_maxValue > 255)
+    {
+        m_pixels16 = new unsigned short[n];
+        if(isAscii && !readAsciiSamples(p, end, m_pixels16, n, m_maxValue))
+        {
+            cerr << "ReadPPM: Invalid samples in " << filename << "." << endl;
+            delete[] m_pixels16;
+            m_pixels16 = 0;
+            m_width = m_height = 0;
+        }
+        else if(!isAscii)
+        {
+            // 16 bit samples are stored big endian
+            const unsigned char* bytes = (const unsigned char*)p;
+            for(size_t i = 0; i < n; i++)
             {
-                cerr << "Unsupported tag, only P3 or P6 possible." << endl;
+                m_pixels16[i] = (unsigned short)((bytes[2 * i] << 8) | bytes[2 * i + 1]);
             }
         }
     }
     else
     {
-        cout << "ReadPPM: Unable to open file " << filename << "." << endl;
+        m_pixels = new unsigned char[n];
+        if(isAscii && !readAsciiSamples(p, end, m_pixels, n, m_maxValue))
+        {
+            cerr << "ReadPPM: Invalid samples in " << filename << "." << endl;
+            delete[] m_pixels;
+            m_pixels = 0;
+            m_width = m_height = 0;
+        }
+        else if(!isAscii)
+        {
+            memcpy(m_pixels, p, n);
+        }
     }
 }
 
-void PPMIO::write( string filename )
+PPMIO::~PPMIO()
 {
-    ofstream out(filename.c_str());
+    if(m_ownsPixels)
+    {
+        delete[] m_pixels;
+    }
+    delete[] m_pixels16;
+    delete[] m_floats;
+}
 
-    if(out.good())
+unsigned char* PPMIO::getRGB8() const
+{
+    if(!m_pixels && !m_pixels16 && !m_floats)
     {
-    	out<<"P6"<<" "<<m_width<<" "<<m_height<<" "<<"255"<<endl;
-	out.write((char*) m_pixels, m_width * m_height * 3);
+        return 0;
     }
 
-    out.close();
+    size_t numPixels = (size_t)m_width * m_height;
+    unsigned char* rgb = new unsigned char[3 * numPixels];
+    for(size_t i = 0; i < numPixels; i++)
+    {
+        for(int c = 0; c < 3; c++)
+        {
+            size_t j = i * m_channels + (m_channels == 1 ? 0 : c);
+            float value;
+            if(m_floats)
+            {
+                value = std::min(1.0f, std::max(0.0f, m_floats[j])) * 255.0f;
+            }
+            else if(m_pixels16)
+            {
+                value = (float)m_pixels16[j] * 255.0f / m_maxValue;
+            }
+            else
+            {
+                value = (float)m_pixels[j] * 255.0f / m_maxValue;
+            }
+            rgb[3 * i + c] = (unsigned char)std::min(255.0f, value + 0.5f);
+        }
+    }
+    return rgb;
+}
 
+void PPMIO::write( string filename )
+{
+    writePNM(filename, m_pixels, m_width, m_height, m_channels);
 }
 
-void PPMIO::setDataArray( unsigned char* array, int width, int height )
+void PPMIO::setDataArray( unsigned char* array, int width, int height, int channels )
 {
+    if(m_ownsPixels)
+    {
+        delete[] m_pixels;
+    }
     m_pixels = array;
+    m_ownsPixels = false;
     m_width = width;
     m_height = height;
+    m_channels = channels;
+    m_maxValue = 255;
 }
 
-void PPMIO::readLine( ifstream & in, char* buffer )
+bool PPMIO::writePNM( string filename, const unsigned char* data,
+                      int width, int height, int channels )
 {
-    // Read lines until no comment line was found
-    do
+    return writeBlock(filename, pnmHeader(width, height, channels, 255),
+                      (const char*)data, (size_t)width * height * channels);
+}
+
+bool PPMIO::writePNM16( string filename, const unsigned short* data,
+                        int width, int height, int channels, int maxValue )
+{
+    size_t n = (size_t)width * height * channels;
+    vector<unsigned char> buffer(2 * n);
+    for(size_t i = 0; i < n; i++)
     {
-      in.getline(buffer, 256);
+        buffer[2 * i]     = (unsigned char)(data[i] >> 8);
+        buffer[2 * i + 1] = (unsigned char)(data[i] & 0xff);
     }
-    while(buffer[0] == '#' && in.good() );
+
+    return writeBlock(filename, pnmHeader(width, height, channels, maxValue),
+                      (const char*)buffer.data(), buffer.size());
+}
+
+bool PPMIO::writePFM( string filename, const float* data,
+                      int width, int height, int channels )
+{
+    stringstream ss;
+    ss << (channels == 1 ? "Pf" : "PF") << "\n" << width << " " << height << "\n"
+       << (isLittleEndian() ? "-1.0" : "1.0") << "\n";
+
+    // Rows are stored bottom to top
+    size_t rowSize = (size_t)width * channels;
+    vector<float> buffer(rowSize * height);
+    for(int y = 0; y < height; y++)
+    {
+        memcpy(&buffer[(height - 1 - y) * rowSize], data + y * rowSize, rowSize * sizeof(float));
+    }
+
+    return writeBlock(filename, ss.str(), (const char*)buffer.data(), buffer.size() * sizeof(float));
 }
 
 }
@@ -7,18 +7,24 @@
 
 
 #include <lvr/io/STLIO.hpp>
+#include <lvr/io/MappedFile.hpp>
 #include <lvr/io/Timestamp.hpp>
-#include <lvr/geometry/Normal.hpp>
-#include <lvr/geometry/Vertex.hpp>
+
+#include <boost/unordered_map.hpp>
+#include <boost/functional/hash.hpp>
 
 #include <iostream>
+#include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <stdint.h>
 #include <fstream>
+#include <vector>
 
 using std::cout;
 using std::endl;
+using std::ifstream;
+using std::vector;
 
 namespace lvr {
 
@@ -31,9 +37,164 @@ STLIO::~STLIO() {
 	// TODO Auto-generated destructor stub
 }
 
+namespace
+{
+
+/// Size of a binary STL face record (normal, three vertices, attribute)
+const size_t STL_RECORD_SIZE = 50;
+
+/// Size of the binary STL header (80 bytes text, 4 bytes face count)
+const size_t STL_HEADER_SIZE = 84;
+
+/// Key for vertex deduplication
+struct STLVertex
+{
+    float v[3];
+
+    bool operator==(const STLVertex& o) const
+    {
+        return memcmp(v, o.v, sizeof(v)) == 0;
+    }
+};
+
+struct STLVertexHash
+{
+    size_t operator()(const STLVertex& k) const
+    {
+        uint32_t bits[3];
+        memcpy(bits, k.v, sizeof(bits));
+        size_t seed = 0;
+        boost::hash_combine(seed, bits[0]);
+        boost::hash_combine(seed, bits[1]);
+        boost::hash_combine(seed, bits[2]);
+        return seed;
+    }
+};
+
+/// Builds an indexed mesh from a triangle soup (9 floats per face)
+MeshBufferPtr buildIndexedMesh(const vector<float>& soup)
+{
+    size_t n_faces = soup.size() / 9;
+
+    boost::unordered_map<STLVertex, unsigned int, STLVertexHash> vertexMap;
+    vector<float> vertices;
+    uintArr faces(new unsigned int[3 * n_faces]);
+
+    for(size_t i = 0; i < 3 * n_faces; i++)
+    {
+        STLVertex key;
+        memcpy(key.v, &soup[3 * i], sizeof(key.v));
+
+        std::pair<boost::unordered_map<STLVertex, unsigned int, STLVertexHash>::iterator, bool> res =
+                vertexMap.insert(std::make_pair(key, (unsigned int)(vertices.size() / 3)));
+        if(res.second)
+        {
+            vertices.insert(vertices.end(), key.v, key.v + 3);
+        }
+        faces[i] = res.first->second;
+    }
+
+    MeshBufferPtr mesh(new MeshBuffer);
+    mesh->setVertexArray(vertices);
+    mesh->setFaceArray(faces, n_faces);
+    return mesh;
+}
+
+/// Reads a binary STL file
+bool readBinarySTL(const MappedFile& file, vector<float>& soup)
+{
+    uint32_t n_faces;
+    memcpy(&n_faces, file.data() + 80, sizeof(n_faces));
+
+    if(file.size() < STL_HEADER_SIZE + (size_t)n_faces * STL_RECORD_SIZE)
+    {
+        return false;
+    }
+
+    soup.resize(9 * (size_t)n_faces);
+    const char* records = file.data() + STL_HEADER_SIZE;
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)n_faces; i++)
+    {
+        // Skip the normal, copy the three vertices
+        memcpy(&soup[9 * i], records + i * STL_RECORD_SIZE + 12, 9 * sizeof(float));
+    }
+
+    return true;
+}
+
+/// Reads an ASCII STL file
+bool readAsciiSTL(const string& filename, vector<float>& soup)
+{
+    ifstream in(filename.c_str());
+    if(!in.good())
+    {
+        return false;
+    }
+
+    string keyword;
+    while(in >> keyword)
+    {
+        if(keyword == "vertex")
+        {
+            float x, y, z;
+            in >> x >> y >> z;
+            soup.push_back(x);
+            soup.push_back(y);
+            soup.push_back(z);
+        }
+    }
+
+    soup.resize(soup.size() - soup.size() % 9);
+    return true;
+}
+
+} // namespace
+
 ModelPtr STLIO::read(string filename)
 {
-	return ModelPtr(new Model);
+    MappedFile file(filename);
+    if(!file.good())
+    {
+        cout << timestamp << "STLIO: Unable to open file " << filename << "." << endl;
+        return ModelPtr(new Model);
+    }
+
+    // A file is binary if its size matches the face count in the
+    // header. Some exporters write binary files that start with 'solid'.
+    bool binary = false;
+    if(file.size() >= STL_HEADER_SIZE)
+    {
+        uint32_t n_faces;
+        memcpy(&n_faces, file.data() + 80, sizeof(n_faces));
+        binary = (file.size() == STL_HEADER_SIZE + (size_t)n_faces * STL_RECORD_SIZE);
+    }
+
+    vector<float> soup;
+    bool success;
+    if(binary)
+    {
+        success = readBinarySTL(file, soup);
+    }
+    else if(file.size() >= 5 && strncmp(file.data(), "solid", 5) == 0)
+    {
+        success = readAsciiSTL(filename, soup);
+    }
+    else
+    {
+        success = false;
+    }
+
+    if(!success)
+    {
+        cout << timestamp << "STLIO: Unable to parse " << filename << "." << endl;
+        return ModelPtr(new Model);
+    }
+
+    ModelPtr model(new Model(buildIndexedMesh(soup)));
+    m_model = model;
+    return model;
 }
 
 void STLIO::save( string filename )
@@ -43,73 +204,72 @@ void STLIO::save( string filename )
 
 void STLIO::save( ModelPtr model, string filename )
 {
-
 	MeshBufferPtr mesh = model->m_mesh;
 	size_t n_vert;
 	size_t n_faces;
 	floatArr vertices = mesh->getVertexArray(n_vert);
 	uintArr indices = mesh->getFaceArray(n_faces);
 
-	std::string header_info = "Created by LVR";
-	char head[80];
-	std::strncpy(head,header_info.c_str(),sizeof(head)-1);
-	char attribute[2] = "0";
-
-	std::ofstream myfile(filename.c_str());
+	std::ofstream myfile(filename.c_str(), std::ios::binary);
 
-	myfile.write(head,sizeof(head));
-	myfile.write((char*)&n_faces,4);
-
-	if(myfile.good())
+	if(!myfile.good())
 	{
-		for(int i = 0; i < n_faces; i++)
-		{
-			int a = (int)indices[3 * i];
-			int b = (int)indices[3 * i + 1];
-			int c = (int)indices[3 * i + 2];
-
-			Vertexf v1;
-			Vertexf v2;
-			Vertexf v3;
+		cout << timestamp << "Could not open file " << filename << " for writing." << endl;
+		return;
+	}
 
-			v1.x = vertices[3 * a];
-			v1.y = vertices[3 * a + 1];
-			v1.z = vertices[3 * a + 2];
+	// Header: 80 bytes of text and the number of faces as
+	// 32 bit unsigned integer
+	char head[STL_HEADER_SIZE];
+	memset(head, 0, sizeof(head));
+	std::strncpy(head, "Created by LVR", 80);
+	uint32_t numFaces = (uint32_t)n_faces;
+	memcpy(head + 80, &numFaces, sizeof(numFaces));
 
-			v2.x = vertices[3 * b];
-			v2.y = vertices[3 * b + 1];
-			v2.z = vertices[3 * b + 2];
+	// Build all face records in a single buffer
+	vector<char> records(n_faces * STL_RECORD_SIZE);
 
-			v3.x = vertices[3 * c];
-			v3.y = vertices[3 * c + 1];
-			v3.z = vertices[3 * c + 2];
+	#pragma omp parallel for schedule(static)
+	for(long i = 0; i < (long)n_faces; i++)
+	{
+		const float* a = vertices.get() + 3 * indices[3 * i];
+		const float* b = vertices.get() + 3 * indices[3 * i + 1];
+		const float* c = vertices.get() + 3 * indices[3 * i + 2];
 
-			Normalf normal( (v1 - v2).cross(v1 - v3));
+		float r[12];
 
-			myfile.write( (char*)&normal.x, 4);
-			myfile.write( (char*)&normal.y, 4);
-			myfile.write( (char*)&normal.z, 4);
+		// Normal (b - a) x (c - a)
+		float u0 = b[0] - a[0], u1 = b[1] - a[1], u2 = b[2] - a[2];
+		float v0 = c[0] - a[0], v1 = c[1] - a[1], v2 = c[2] - a[2];
+		r[0] = u1 * v2 - u2 * v1;
+		r[1] = u2 * v0 - u0 * v2;
+		r[2] = u0 * v1 - u1 * v0;
 
-			myfile.write( (char*)&v1.x, 4);
-			myfile.write( (char*)&v1.y, 4);
-			myfile.write( (char*)&v1.z, 4);
+		float length = sqrtf(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+		if(length > 0)
+		{
+			r[0] /= length;
+			r[1] /= length;
+			r[2] /= length;
+		}
 
-			myfile.write( (char*)&v2.x, 4);
-			myfile.write( (char*)&v2.y, 4);
-			myfile.write( (char*)&v2.z, 4);
+		memcpy(r + 3, a, 3 * sizeof(float));
+		memcpy(r + 6, b, 3 * sizeof(float));
+		memcpy(r + 9, c, 3 * sizeof(float));
 
-			myfile.write( (char*)&v3.x, 4);
-			myfile.write( (char*)&v3.y, 4);
-			myfile.write( (char*)&v3.z, 4);
+		char* record = &records[i * STL_RECORD_SIZE];
+		memcpy(record, r, sizeof(r));
 
-			uint16_t u = 0;
-			myfile.write( (char*)attribute, 2 );
-		}
+		// Attribute byte count
+		record[48] = 0;
+		record[49] = 0;
 	}
-	else
+
+	myfile.write(head, sizeof(head));
+	if(n_faces)
 	{
-		cout << timestamp << "Could not open file " << filename << " for writing." << endl;
- 	}
+		myfile.write(&records[0], records.size());
+	}
 }
 
 } /* namespace lvr */
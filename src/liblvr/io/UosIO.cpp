@@ -190,6 +190,26 @@ void UosIO::reduce(string dir, string target, int reduction)
     // Read data and write reduced points
     ModelPtr m = read(dir);
 
+    // Write the points collected by the reduction engine
+    if(m_reductionEngine)
+    {
+        size_t n_points = 0;
+        size_t n_colors = 0;
+        PointBufferPtr reduced = m_reductionEngine->getReducedPoints();
+        floatArr points = reduced->getPointArray(n_points);
+        ucharArr colors = reduced->getPointColorArray(n_colors);
+
+        cout << timestamp << "Writing " << n_points << " reduced points." << endl;
+        for(size_t i = 0; i < n_points; i++)
+        {
+            m_outputFile << points[3 * i] << " " << points[3 * i + 1] << " " << points[3 * i + 2];
+            if(n_colors == n_points)
+            {
+                m_outputFile << " " << (int)colors[3 * i] << " " << (int)colors[3 * i + 1] << " " << (int)colors[3 * i + 2];
+            }
+            m_outputFile << endl;
+        }
+    }
 
 }
 
@@ -329,6 +349,12 @@ void UosIO::readNewFormat(ModelPtr &model, string dir, int first, int last, size
                 << euler[0] << " " << euler[1] << " " << euler[2] << " "
                 << euler[3] << " " << euler[4] << " " << euler[5] << endl;
 
+            // Blocks of transformed points for the reduction engine
+            const size_t blockSize = 1 << 20;
+            bool engineColors = has_color || (has_intensity && m_saveRemissionColor);
+            vector<float> blockPoints;
+            vector<unsigned char> blockColors;
+
             // Skip first line in scan file (maybe metadata)
             char dummy[1024];
             scan_in.getline(dummy, 1024);
@@ -375,7 +401,35 @@ void UosIO::readNewFormat(ModelPtr &model, string dir, int first, int last, size
                 }
                 else
                 {
-                    if(m_outputFile.good())
+                    if(m_reductionEngine)
+                    {
+                        if(point_counter % skipPoints == 0 && scan_in.good())
+                        {
+                            point.transform(tf);
+                            blockPoints.push_back(point[0]);
+                            blockPoints.push_back(point[1]);
+                            blockPoints.push_back(point[2]);
+
+                            if(has_color)
+                            {
+                                blockColors.push_back(r);
+                                blockColors.push_back(g);
+                                blockColors.push_back(b);
+                            }
+                            else if(engineColors)
+                            {
+                                blockColors.insert(blockColors.end(), 3, (unsigned char)rem);
+                            }
+
+                            if(blockPoints.size() >= 3 * blockSize)
+                            {
+                                m_reductionEngine->addPoints(&blockPoints[0], engineColors ? &blockColors[0] : 0, blockPoints.size() / 3);
+                                blockPoints.clear();
+                                blockColors.clear();
+                            }
+                        }
+                    }
+                    else if(m_outputFile.good())
                     {
                         if(point_counter % skipPoints == 0)
                         {
@@ -405,6 +459,12 @@ void UosIO::readNewFormat(ModelPtr &model, string dir, int first, int last, size
                 ++progress;
             }
 
+            // Pass remaining points to the reduction engine
+            if(m_reductionEngine && blockPoints.size())
+            {
+                m_reductionEngine->addPoints(&blockPoints[0], engineColors ? &blockColors[0] : 0, blockPoints.size() / 3);
+            }
+
             // Save index of first point of new scan
             size_t firstIndex;
             if(allPoints.size() > 0)
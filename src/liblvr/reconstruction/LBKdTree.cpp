@@ -5,20 +5,16 @@
 
 namespace lvr {
 
-// Static variables
-
-ctpl::thread_pool* LBKdTree::pool = new ctpl::thread_pool(8);
-int LBKdTree::st_num_threads = 8;
-int LBKdTree::st_depth_threads = 3;
-
 /// Public
 
 LBKdTree::LBKdTree( LBPointArray<float>& vertices, int num_threads) {
     this->m_values = boost::shared_ptr<LBPointArray<float> >(new LBPointArray<float>);
     this->m_splits = boost::shared_ptr<LBPointArray<unsigned char> >(new LBPointArray<unsigned char>);
-    st_num_threads = num_threads;
-    st_depth_threads = static_cast<int>(log2(st_num_threads));
-    pool = new ctpl::thread_pool(st_num_threads);
+    if(num_threads <= 0)
+    {
+        num_threads = TaskScheduler::instance().numThreads();
+    }
+    m_depth_threads = static_cast<int>(log2(num_threads));
     this->generateKdTree(vertices);
 }
 
@@ -29,15 +25,15 @@ void LBKdTree::generateKdTree(LBPointArray<float> &vertices) {
 
     
 
+    TaskGroup presort;
     for(unsigned int i=0; i< vertices.dim; i++)
     {
         std::cout << "PRESORT " << i+1 << "/"<< vertices.dim << std::endl;
-        pool->push(generateAndSort<float, unsigned int>, vertices, indices_sorted, values_sorted, i);
-        //generateAndSort<float, unsigned int>(0, vertices, indices_sorted, values_sorted, i);
+        presort.run([&vertices, indices_sorted, values_sorted, i]() {
+            generateAndSort<float, unsigned int>(0, vertices, indices_sorted, values_sorted, i);
+        });
     }
-    
-    pool->stop(true);
-    pool = new ctpl::thread_pool(st_num_threads);
+    presort.wait();
     
     std::cout << "KDTREE" << std::endl;
     this->generateKdTreeArray(vertices, indices_sorted, vertices.dim);
@@ -109,12 +105,7 @@ void LBKdTree::generateKdTreeArray(LBPointArray<float>& V, LBPointArray<unsigned
     LBPointArray<float>* value_ptr = this->m_values.get();
     LBPointArray<unsigned char>* splits_ptr = this->m_splits.get();
     //start real generate
-    generateKdTreeRecursive(0, V, sorted_indices, first_split_dim, max_dim, value_ptr, splits_ptr ,size, max_tree_depth, 0, 0);
-
-    //pool->push(generateKdTreeRecursive, V, sorted_indices, 0, max_dim, kd_tree, size, max_tree_depth, 0, 0);
-
-    pool->stop(true);
-    pool = new ctpl::thread_pool(st_num_threads);
+    generateKdTreeRecursive(V, sorted_indices, first_split_dim, max_dim, value_ptr, splits_ptr ,size, max_tree_depth, 0, 0, m_depth_threads);
 }
 
 void LBKdTree::fillCriticalIndices(const LBPointArray<float>& V, LBPointArray<unsigned int>& sorted_indices, unsigned int current_dim,
@@ -141,7 +132,7 @@ void LBKdTree::fillCriticalIndices(const LBPointArray<float>& V, LBPointArray<un
     
 }
 
-void LBKdTree::generateKdTreeRecursive(int id, LBPointArray<float>& V, LBPointArray<unsigned int>* sorted_indices, int current_dim, int max_dim, LBPointArray<float> *values, LBPointArray<unsigned char> *splits , int size, int max_tree_depth, int position, int current_depth) {
+void LBKdTree::generateKdTreeRecursive(LBPointArray<float>& V, LBPointArray<unsigned int>* sorted_indices, int current_dim, int max_dim, LBPointArray<float> *values, LBPointArray<unsigned char> *splits , int size, int max_tree_depth, int position, int current_depth, int depth_threads) {
         
     int left = position*2+1;
     int right = position*2+2;
@@ -234,15 +225,18 @@ void LBKdTree::generateKdTreeRecursive(int id, LBPointArray<float>& V, LBPointAr
 
         //int next_dim = (current_dim+1)%max_dim;
 
-        if(current_depth == st_depth_threads )
+        if(current_depth < depth_threads )
         {
-            pool->push(generateKdTreeRecursive, V, sorted_indices_left, next_dim_left, max_dim, values, splits, size, max_tree_depth, left, current_depth + 1);
-            pool->push(generateKdTreeRecursive, V, sorted_indices_right, next_dim_right, max_dim, values, splits, size, max_tree_depth, right, current_depth +1);
+            // Both sub trees write to disjoint parts of the arrays
+            TaskGroup group;
+            group.run([&V, sorted_indices_left, next_dim_left, max_dim, values, splits, size, max_tree_depth, left, current_depth, depth_threads]() {
+                generateKdTreeRecursive(V, sorted_indices_left, next_dim_left, max_dim, values, splits, size, max_tree_depth, left, current_depth + 1, depth_threads);
+            });
+            generateKdTreeRecursive(V, sorted_indices_right, next_dim_right, max_dim, values, splits, size, max_tree_depth, right, current_depth + 1, depth_threads);
+            group.wait();
         } else {
-            //std::cout<< "left " << current_dim << std::endl;
-            generateKdTreeRecursive(0, V, sorted_indices_left, next_dim_left, max_dim, values, splits, size, max_tree_depth, left, current_depth + 1);
-            //std::cout << "right " << current_dim << std::endl;
-            generateKdTreeRecursive(0, V, sorted_indices_right, next_dim_right, max_dim, values, splits, size, max_tree_depth, right, current_depth +1);
+            generateKdTreeRecursive(V, sorted_indices_left, next_dim_left, max_dim, values, splits, size, max_tree_depth, left, current_depth + 1, depth_threads);
+            generateKdTreeRecursive(V, sorted_indices_right, next_dim_right, max_dim, values, splits, size, max_tree_depth, right, current_depth + 1, depth_threads);
         }
 
     }
@@ -27,6 +27,7 @@
 #include <lvr/reconstruction/Projection.hpp>
 #include <lvr/io/Progress.hpp>
 #include <lvr/io/Timestamp.hpp>
+#include <lvr/io/PPMIO.hpp>
 #include <lvr/geometry/Vertex.hpp>
 
 #include <iostream>
@@ -191,14 +192,15 @@ void ModelToImage::writePGM(string filename, float cutoff)
 
     cout << min_r << " " << max_r << " " << interval << endl;
 
-    // Open file, write header and pixel values
-    std::ofstream out(filename);
-    out << "P2" << endl;
-    out << img.pixels[0].size() << " " << img.pixels.size() << " 255" << endl;
+    // Convert ranges to gray values
+    int height = img.pixels.size();
+    int width = height ? img.pixels[0].size() : 0;
+    vector<unsigned char> gray((size_t)width * height);
 
-    for(int i = 0; i < img.pixels.size(); i++)
+    #pragma omp parallel for schedule(static)
+    for(int i = 0; i < height; i++)
     {
-        for(int j = 0; j < img.pixels[i].size(); j++)
+        for(int j = 0; j < width; j++)
         {
             int val = img.pixels[i][j];
 
@@ -210,9 +212,29 @@ void ModelToImage::writePGM(string filename, float cutoff)
             }
 
             val = (int)((float)(val - min_r) / interval * 255);
-            out << val << " ";
+            gray[(size_t)i * width + j] = (unsigned char)std::max(0, std::min(255, val));
         }
     }
+
+    PPMIO::writePNM(filename, gray.data(), width, height, 1);
+}
+
+void ModelToImage::writePFM(string filename)
+{
+    ModelToImage::DepthImage img;
+    computeDepthImage(img);
+
+    int height = img.pixels.size();
+    int width = height ? img.pixels[0].size() : 0;
+    vector<float> ranges((size_t)width * height);
+
+    #pragma omp parallel for schedule(static)
+    for(int i = 0; i < height; i++)
+    {
+        std::copy(img.pixels[i].begin(), img.pixels[i].end(), ranges.begin() + (size_t)i * width);
+    }
+
+    PPMIO::writePFM(filename, ranges.data(), width, height, 1);
 }
 
 } /* namespace lvr */
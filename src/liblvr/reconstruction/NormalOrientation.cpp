@@ -0,0 +1,297 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * NormalOrientation.cpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/reconstruction/NormalOrientation.hpp>
+#include <lvr/geometry/ConcurrentUnionFind.hpp>
+#include <lvr/io/Timestamp.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdint.h>
+
+using namespace std;
+
+namespace lvr
+{
+
+namespace
+{
+
+/// Normals with a smaller absolute dot product are oriented by their viewpoint
+const float s_ambiguousAngle = 0.1f;
+
+inline float dot(const float* a, const float* b)
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/// Dot product of the normal of point i and the direction from its viewpoint
+inline float viewDot(const float* points, const float* normals, const float* viewpoints, size_t i)
+{
+    float d[3];
+    for(int j = 0; j < 3; j++)
+    {
+        d[j] = points[3 * i + j] - viewpoints[3 * i + j];
+    }
+
+    float len = sqrt(dot(d, d));
+    return len > 0.0f ? dot(&normals[3 * i], d) / len : 0.0f;
+}
+
+inline void flip(float* normals, size_t i)
+{
+    normals[3 * i]     = -normals[3 * i];
+    normals[3 * i + 1] = -normals[3 * i + 1];
+    normals[3 * i + 2] = -normals[3 * i + 2];
+}
+
+/// Sets a to min(a, value)
+inline void atomicMin(atomic<uint64_t>& a, uint64_t value)
+{
+    uint64_t current = a.load();
+    while(value < current && !a.compare_exchange_weak(current, value))
+    {
+    }
+}
+
+} // namespace
+
+size_t orientNormalsMST(
+        const float* points,
+        float* normals,
+        size_t numPoints,
+        const int* neighbors,
+        size_t k,
+        const float* viewpoints)
+{
+    size_t numEdges = numPoints * k;
+    if(numPoints == 0 || numEdges >= numeric_limits<uint32_t>::max())
+    {
+        cout << timestamp << "Normal orientation: Unsupported number of neighbors." << endl;
+        return 0;
+    }
+
+    cout << timestamp << "Orienting normals along the minimum spanning tree of the "
+         << k << "-nearest neighbor graph" << endl;
+
+    // Edge weights of the Riemannian graph. Invalid edges are
+    // marked as loops.
+    vector<uint32_t> target(numEdges);
+    vector<uint32_t> weight(numEdges);
+
+    #pragma omp parallel for schedule(static)
+    for(long e = 0; e < (long)numEdges; e++)
+    {
+        size_t i = e / k;
+        int j = neighbors[e];
+        if(j < 0 || (size_t)j >= numPoints || (size_t)j == i)
+        {
+            target[e] = i;
+            weight[e] = 0;
+            continue;
+        }
+
+        // The bits of non negative floats have the same order
+        // as the floats
+        float w = max(0.0f, 1.0f - fabs(dot(&normals[3 * i], &normals[3 * j])));
+        target[e] = j;
+        memcpy(&weight[e], &w, sizeof(float));
+    }
+
+    // Borůvka: Every component selects its cheapest outgoing edge,
+    // all selected edges are added in parallel. The edge index breaks
+    // ties, so the selected edges never form a cycle.
+    ConcurrentUnionFind sets(numPoints);
+    vector<unsigned char> inTree(numEdges, 0);
+    vector<atomic<uint64_t> > cheapest(numPoints);
+    const uint64_t none = numeric_limits<uint64_t>::max();
+
+    size_t numTreeEdges = 0;
+    while(true)
+    {
+        #pragma omp parallel for schedule(static)
+        for(long i = 0; i < (long)numPoints; i++)
+        {
+            cheapest[i].store(none);
+        }
+
+        #pragma omp parallel for schedule(static)
+        for(long e = 0; e < (long)numEdges; e++)
+        {
+            if(inTree[e] || target[e] == e / k)
+            {
+                continue;
+            }
+
+            uint32_t a = sets.find(e / k);
+            uint32_t b = sets.find(target[e]);
+            if(a == b)
+            {
+                // Inner edges stay inner edges, so they are
+                // marked as loops
+                target[e] = e / k;
+                continue;
+            }
+
+            uint64_t key = ((uint64_t)weight[e] << 32) | (uint64_t)e;
+            atomicMin(cheapest[a], key);
+            atomicMin(cheapest[b], key);
+        }
+
+        size_t added = 0;
+
+        #pragma omp parallel for schedule(static) reduction(+:added)
+        for(long i = 0; i < (long)numPoints; i++)
+        {
+            uint64_t key = cheapest[i].load();
+            if(key == none)
+            {
+                continue;
+            }
+
+            // Both components may select the same edge, only
+            // one of them links the sets
+            uint32_t e = (uint32_t)(key & 0xffffffff);
+            if(sets.unite(e / k, target[e]))
+            {
+                inTree[e] = 1;
+                added++;
+            }
+        }
+
+        if(added == 0)
+        {
+            break;
+        }
+        numTreeEdges += added;
+    }
+
+    // Adjacency lists of the tree (CSR)
+    vector<size_t> offsets(numPoints + 1, 0);
+    for(size_t e = 0; e < numEdges; e++)
+    {
+        if(inTree[e])
+        {
+            offsets[e / k + 1]++;
+            offsets[target[e] + 1]++;
+        }
+    }
+    for(size_t i = 0; i < numPoints; i++)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+
+    vector<uint32_t> adjacent(2 * numTreeEdges);
+    vector<size_t> pos(offsets.begin(), offsets.end() - 1);
+    for(size_t e = 0; e < numEdges; e++)
+    {
+        if(inTree[e])
+        {
+            adjacent[pos[e / k]++] = target[e];
+            adjacent[pos[target[e]]++] = e / k;
+        }
+    }
+
+    // Select the root of every component. Without viewpoints
+    // the root is the first point of the component.
+    vector<uint32_t> roots;
+    vector<float> rootScore(numPoints, -1.0f);
+    vector<uint32_t> rootPoint(numPoints);
+    for(size_t i = 0; i < numPoints; i++)
+    {
+        uint32_t r = sets.find(i);
+        float score = viewpoints ? fabs(viewDot(points, normals, viewpoints, i)) : 0.0f;
+        if(r == i)
+        {
+            roots.push_back(r);
+        }
+        if(score > rootScore[r])
+        {
+            rootScore[r] = score;
+            rootPoint[r] = i;
+        }
+    }
+
+    cout << timestamp << "Normal orientation: " << numTreeEdges << " tree edges in "
+         << roots.size() << " components" << endl;
+
+    // Propagate the orientation through every component
+    vector<unsigned char> visited(numPoints, 0);
+    size_t flipped = 0;
+
+    #pragma omp parallel for schedule(dynamic) reduction(+:flipped)
+    for(long c = 0; c < (long)roots.size(); c++)
+    {
+        uint32_t start = rootPoint[roots[c]];
+        if(viewpoints && viewDot(points, normals, viewpoints, start) < 0.0f)
+        {
+            flip(normals, start);
+            flipped++;
+        }
+
+        vector<uint32_t> queue(1, start);
+        visited[start] = 1;
+        for(size_t q = 0; q < queue.size(); q++)
+        {
+            uint32_t p = queue[q];
+            for(size_t a = offsets[p]; a < offsets[p + 1]; a++)
+            {
+                uint32_t i = adjacent[a];
+                if(visited[i])
+                {
+                    continue;
+                }
+                visited[i] = 1;
+                queue.push_back(i);
+
+                float d = dot(&normals[3 * p], &normals[3 * i]);
+                bool doFlip;
+                if(viewpoints && fabs(d) < s_ambiguousAngle)
+                {
+                    doFlip = viewDot(points, normals, viewpoints, i) < 0.0f;
+                }
+                else
+                {
+                    doFlip = d < 0.0f;
+                }
+
+                if(doFlip)
+                {
+                    flip(normals, i);
+                    flipped++;
+                }
+            }
+        }
+    }
+
+    cout << timestamp << "Normal orientation: Flipped " << flipped << " normals" << endl;
+
+    return flipped;
+}
+
+} // namespace lvr
@@ -0,0 +1,471 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+/*
+ * PointCloudFiltering.cpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/reconstruction/PointCloudFiltering.hpp>
+#include <lvr/reconstruction/PointsetSurfaceQuery.hpp>
+#include <lvr/reconstruction/SearchTreeNanoflann.hpp>
+#include <lvr/reconstruction/SearchTreeFlann.hpp>
+
+#ifdef LVR_USE_STANN
+#include <lvr/reconstruction/SearchTreeStann.hpp>
+#endif
+
+#ifdef LVR_USE_PCL
+#include <lvr/reconstruction/SearchTreeFlannPCL.hpp>
+#endif
+
+#ifdef LVR_USE_NABO
+#include <lvr/reconstruction/SearchTreeNabo.hpp>
+#endif
+
+#include <lvr/io/Timestamp.hpp>
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace lvr
+{
+
+PointCloudFiltering::PointCloudFiltering(PointBufferPtr buffer, std::string searchTreeName)
+    : m_buffer(buffer), m_searchTreeName(searchTreeName)
+{
+
+}
+
+void PointCloudFiltering::buildSearchTree()
+{
+    if(m_searchTree)
+    {
+        return;
+    }
+
+    size_t n = m_buffer->getNumPoints();
+
+#ifdef LVR_USE_PCL
+    if(m_searchTreeName == "pcl" || m_searchTreeName == "PCL")
+    {
+        m_searchTree = SearchTree<VertexT>::Ptr(new SearchTreeFlannPCL<VertexT>(m_buffer, n));
+    }
+#endif
+#ifdef LVR_USE_STANN
+    if(m_searchTreeName == "stann" || m_searchTreeName == "STANN")
+    {
+        m_searchTree = SearchTree<VertexT>::Ptr(new SearchTreeStann<VertexT>(m_buffer, n));
+    }
+#endif
+#ifdef LVR_USE_NABO
+    if(m_searchTreeName == "nabo" || m_searchTreeName == "NABO")
+    {
+        m_searchTree = SearchTree<VertexT>::Ptr(new SearchTreeNabo<VertexT>(m_buffer, n));
+    }
+#endif
+    if(m_searchTreeName == "flann" || m_searchTreeName == "FLANN")
+    {
+        m_searchTree = SearchTree<VertexT>::Ptr(new SearchTreeFlann<VertexT>(m_buffer, n));
+    }
+
+    if(!m_searchTree)
+    {
+        if(m_searchTreeName != "nanoflann" && m_searchTreeName != "NANOFLANN")
+        {
+            cout << timestamp << "No valid search tree specified (" << m_searchTreeName << ")." << endl;
+            cout << timestamp << "Defaulting to nanoflann." << endl;
+        }
+        m_searchTree = SearchTree<VertexT>::Ptr(new SearchTreeNanoflann<VertexT>(m_buffer, n));
+    }
+}
+
+size_t PointCloudFiltering::applyOutlierRemoval(int meank, float thresh)
+{
+    size_t n = 0;
+    floatArr points = m_buffer->getPointArray(n);
+
+    if(n < 2 || meank < 1)
+    {
+        return 0;
+    }
+
+    cout << timestamp << "Applying outlier removal with k=" << meank << " and sigma=" << thresh << endl;
+
+    buildSearchTree();
+
+    // The query point itself is contained in the result
+    int k = std::min((size_t)meank + 1, n);
+
+    // Calculate mean distance to the k nearest neighbors of
+    // every point
+    std::vector<float> meanDistances(n);
+
+    // Searches of trees that are not thread safe are serialized
+    PointsetSurfaceQuery<VertexT> query(m_searchTree);
+
+    #pragma omp parallel
+    {
+        PointsetSurfaceQuery<VertexT>::Context ctx;
+        const vector<int>& indices = ctx.indices;
+
+        #pragma omp for schedule(static)
+        for(long i = 0; i < (long)n; i++)
+        {
+            const float* p = points.get() + 3 * i;
+            query.kSearch(VertexT(p[0], p[1], p[2]), k, ctx);
+
+            // Distances are recomputed here because the backends
+            // differ in returning squared or plain distances
+            double sum = 0.0;
+            int count = 0;
+            for(size_t j = 0; j < indices.size() && count < meank; j++)
+            {
+                if(indices[j] == i || indices[j] < 0 || (size_t)indices[j] >= n)
+                {
+                    continue;
+                }
+
+                const float* q = points.get() + 3 * indices[j];
+                float dx = p[0] - q[0];
+                float dy = p[1] - q[1];
+                float dz = p[2] - q[2];
+                sum += sqrt(dx * dx + dy * dy + dz * dz);
+                count++;
+            }
+            meanDistances[i] = count ? (float)(sum / count) : 0.0f;
+        }
+    }
+
+    // Compute mean and standard deviation of all mean distances
+    double sum = 0.0;
+    double sqSum = 0.0;
+
+    #pragma omp parallel for reduction(+:sum,sqSum) schedule(static)
+    for(long i = 0; i < (long)n; i++)
+    {
+        sum   += meanDistances[i];
+        sqSum += meanDistances[i] * meanDistances[i];
+    }
+
+    double mean = sum / n;
+    double variance = (sqSum - sum * sum / n) / (n - 1);
+    double maxDistance = mean + thresh * sqrt(std::max(variance, 0.0));
+
+    std::vector<unsigned char> keep(n);
+
+    #pragma omp parallel for schedule(static)
+    for(long i = 0; i < (long)n; i++)
+    {
+        keep[i] = meanDistances[i] <= maxDistance;
+    }
+
+    size_t removed = compact(keep);
+    cout << timestamp << "Filtered cloud has " << m_buffer->getNumPoints() << " points" << endl;
+    return removed;
+}
+
+size_t PointCloudFiltering::applyRadiusOutlierRemoval(float radius, int minNeighbors)
+{
+    size_t n = 0;
+    floatArr points = m_buffer->getPointArray(n);
+
+    if(n == 0 || minNeighbors < 1)
+    {
+        return 0;
+    }
+
+    cout << timestamp << "Applying radius outlier removal with r=" << radius
+         << " and " << minNeighbors << " neighbors" << endl;
+
+    if((size_t)minNeighbors >= n)
+    {
+        // No point can have enough neighbors
+        std::vector<unsigned char> keep(n, 0);
+        return compact(keep);
+    }
+
+    buildSearchTree();
+
+    // A point has at least minNeighbors neighbors within the radius
+    // if its minNeighbors nearest neighbors (without the point itself)
+    // are inside. This avoids the radius search that is not supported
+    // by all search tree backends.
+    int k = minNeighbors + 1;
+    float sqRadius = radius * radius;
+    std::vector<unsigned char> keep(n);
+
+    // Searches of trees that are not thread safe are serialized
+    PointsetSurfaceQuery<VertexT> query(m_searchTree);
+
+    #pragma omp parallel
+    {
+        PointsetSurfaceQuery<VertexT>::Context ctx;
+        const vector<int>& indices = ctx.indices;
+
+        #pragma omp for schedule(static)
+        for(long i = 0; i < (long)n; i++)
+        {
+            const float* p = points.get() + 3 * i;
+            query.kSearch(VertexT(p[0], p[1], p[2]), k, ctx);
+
+            int count = 0;
+            for(size_t j = 0; j < indices.size(); j++)
+            {
+                if(indices[j] == i || indices[j] < 0 || (size_t)indices[j] >= n)
+                {
+                    continue;
+                }
+
+                const float* q = points.get() + 3 * indices[j];
+                float dx = p[0] - q[0];
+                float dy = p[1] - q[1];
+                float dz = p[2] - q[2];
+                if(dx * dx + dy * dy + dz * dz <= sqRadius)
+                {
+                    count++;
+                }
+            }
+            keep[i] = count >= minNeighbors;
+        }
+    }
+
+    size_t removed = compact(keep);
+    cout << timestamp << "Filtered cloud has " << m_buffer->getNumPoints() << " points" << endl;
+    return removed;
+}
+
+void PointCloudFiltering::applyMLSProjection(float searchRadius, int k)
+{
+    size_t n = 0;
+    size_t n_normals = 0;
+    floatArr points  = m_buffer->getPointArray(n);
+    floatArr normals = m_buffer->getPointNormalArray(n_normals);
+
+    if(n < 3 || k < 3)
+    {
+        return;
+    }
+
+    std::cout << timestamp << "Applying MLS projection" << std::endl;
+
+    buildSearchTree();
+
+    k = std::min((size_t)k, n);
+    float sqRadius = searchRadius * searchRadius;
+
+    // Projected points are written to a separate array because
+    // the search tree references the original data
+    floatArr projected(new float[3 * n]);
+    floatArr projectedNormals;
+    if(n_normals == n)
+    {
+        projectedNormals = floatArr(new float[3 * n]);
+    }
+
+    // Searches of trees that are not thread safe are serialized
+    PointsetSurfaceQuery<VertexT> query(m_searchTree);
+
+    #pragma omp parallel
+    {
+        PointsetSurfaceQuery<VertexT>::Context ctx;
+        const vector<int>& indices = ctx.indices;
+
+        #pragma omp for schedule(dynamic, 256)
+        for(long i = 0; i < (long)n; i++)
+        {
+            const float* p = points.get() + 3 * i;
+            query.kSearch(VertexT(p[0], p[1], p[2]), k, ctx);
+
+            // Weighted centroid and covariance of the neighborhood
+            Eigen::Vector3d centroid = Eigen::Vector3d::Zero();
+            Eigen::Matrix3d cov = Eigen::Matrix3d::Zero();
+            double weightSum = 0.0;
+            int count = 0;
+
+            for(size_t j = 0; j < indices.size(); j++)
+            {
+                if(indices[j] < 0 || (size_t)indices[j] >= n)
+                {
+                    continue;
+                }
+
+                const float* q = points.get() + 3 * indices[j];
+                Eigen::Vector3d v(q[0], q[1], q[2]);
+                double d2 = (v - Eigen::Vector3d(p[0], p[1], p[2])).squaredNorm();
+                if(d2 > sqRadius)
+                {
+                    continue;
+                }
+
+                double w = exp(-d2 / sqRadius);
+                centroid += w * v;
+                cov += w * v * v.transpose();
+                weightSum += w;
+                count++;
+            }
+
+            float* out = projected.get() + 3 * i;
+            if(count < 3 || weightSum <= 0.0)
+            {
+                out[0] = p[0];
+                out[1] = p[1];
+                out[2] = p[2];
+                if(projectedNormals)
+                {
+                    memcpy(projectedNormals.get() + 3 * i, normals.get() + 3 * i, 3 * sizeof(float));
+                }
+                continue;
+            }
+
+            centroid /= weightSum;
+            cov = cov / weightSum - centroid * centroid.transpose();
+
+            // The plane normal is the eigenvector of the smallest eigenvalue
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(cov);
+            Eigen::Vector3d normal = solver.eigenvectors().col(0);
+
+            Eigen::Vector3d v(p[0], p[1], p[2]);
+            v -= (v - centroid).dot(normal) * normal;
+            out[0] = v.x();
+            out[1] = v.y();
+            out[2] = v.z();
+
+            if(projectedNormals)
+            {
+                // Keep the orientation of the original normal
+                const float* on = normals.get() + 3 * i;
+                if(normal.x() * on[0] + normal.y() * on[1] + normal.z() * on[2] < 0)
+                {
+                    normal = -normal;
+                }
+                float* nn = projectedNormals.get() + 3 * i;
+                nn[0] = normal.x();
+                nn[1] = normal.y();
+                nn[2] = normal.z();
+            }
+        }
+    }
+
+    // Copy the results back into the original arrays
+    memcpy(points.get(), projected.get(), 3 * n * sizeof(float));
+    if(projectedNormals)
+    {
+        memcpy(normals.get(), projectedNormals.get(), 3 * n * sizeof(float));
+    }
+
+    // The search tree is outdated now
+    m_searchTree.reset();
+}
+
+size_t PointCloudFiltering::compact(const std::vector<unsigned char>& keep)
+{
+    size_t n = 0;
+    size_t n_colors = 0;
+    size_t n_normals = 0;
+    size_t n_intensities = 0;
+    size_t n_confidences = 0;
+
+    floatArr points      = m_buffer->getPointArray(n);
+    ucharArr colors      = m_buffer->getPointColorArray(n_colors);
+    floatArr normals     = m_buffer->getPointNormalArray(n_normals);
+    floatArr intensities = m_buffer->getPointIntensityArray(n_intensities);
+    floatArr confidences = m_buffer->getPointConfidenceArray(n_confidences);
+
+    bool haveColors      = colors && n_colors == n;
+    bool haveNormals     = normals && n_normals == n;
+    bool haveIntensities = intensities && n_intensities == n;
+    bool haveConfidences = confidences && n_confidences == n;
+
+    // Stable in place compaction. The write position never
+    // passes the read position, so no data is overwritten
+    // before it was moved.
+    size_t pos = 0;
+    for(size_t i = 0; i < n; i++)
+    {
+        if(!keep[i])
+        {
+            continue;
+        }
+
+        if(pos != i)
+        {
+            memcpy(points.get() + 3 * pos, points.get() + 3 * i, 3 * sizeof(float));
+
+            if(haveColors)
+            {
+                memcpy(colors.get() + 3 * pos, colors.get() + 3 * i, 3 * sizeof(unsigned char));
+            }
+
+            if(haveNormals)
+            {
+                memcpy(normals.get() + 3 * pos, normals.get() + 3 * i, 3 * sizeof(float));
+            }
+
+            if(haveIntensities)
+            {
+                intensities[pos] = intensities[i];
+            }
+
+            if(haveConfidences)
+            {
+                confidences[pos] = confidences[i];
+            }
+        }
+        pos++;
+    }
+
+    // Update the sizes. The arrays are kept, only the
+    // number of valid entries is reduced.
+    m_buffer->setPointArray(points, pos);
+
+    if(haveColors)
+    {
+        m_buffer->setPointColorArray(colors, pos);
+    }
+
+    if(haveNormals)
+    {
+        m_buffer->setPointNormalArray(normals, pos);
+    }
+
+    if(haveIntensities)
+    {
+        m_buffer->setPointIntensityArray(intensities, pos);
+    }
+
+    if(haveConfidences)
+    {
+        m_buffer->setPointConfidenceArray(confidences, pos);
+    }
+
+    // The search tree has to be rebuilt for the new point set
+    if(pos != n)
+    {
+        m_searchTree.reset();
+    }
+
+    return n - pos;
+}
+
+} /* namespace lvr */
@@ -0,0 +1,238 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+/*
+ * PoissonDiskReduction.cpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/reconstruction/PoissonDiskReduction.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace lvr
+{
+
+PoissonDiskReduction::PoissonDiskReduction(float radius)
+    : m_radius(radius), m_hasColors(false), m_hasNormals(false)
+{
+    // With this cell size the diagonal of a cell equals the
+    // radius, so each cell can hold at most one sample
+    m_cellSize = radius / sqrt(3.0f);
+}
+
+void PoissonDiskReduction::clear()
+{
+    m_cells.clear();
+    m_points.clear();
+    m_colors.clear();
+    m_normals.clear();
+    m_hasColors = false;
+    m_hasNormals = false;
+    resetAnchor();
+}
+
+bool PoissonDiskReduction::isFree(const float* p, int64_t i, int64_t j, int64_t k) const
+{
+    float r2 = m_radius * m_radius;
+    for(int64_t di = -2; di <= 2; di++)
+    {
+        for(int64_t dj = -2; dj <= 2; dj++)
+        {
+            for(int64_t dk = -2; dk <= 2; dk++)
+            {
+                boost::unordered_map<uint64_t, size_t>::const_iterator it =
+                        m_cells.find(cellKey(i + di, j + dj, k + dk));
+
+                if(it != m_cells.end())
+                {
+                    const float* q = &m_points[3 * it->second];
+                    float dx = p[0] - q[0];
+                    float dy = p[1] - q[1];
+                    float dz = p[2] - q[2];
+                    if(dx * dx + dy * dy + dz * dz < r2)
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void PoissonDiskReduction::addPoints(const float* points, const unsigned char* colors, const float* normals, size_t n)
+{
+    if(n == 0)
+    {
+        return;
+    }
+
+    if(colors)
+    {
+        m_hasColors = true;
+    }
+
+    if(normals)
+    {
+        m_hasNormals = true;
+    }
+
+    setAnchor(points, m_cellSize);
+
+    // Calculate cell keys and sort the points by cell. Ties are
+    // broken by the point index to get a deterministic result.
+    std::vector<std::pair<uint64_t, size_t> > sorted(n);
+    long outOfRange = 0;
+
+    #pragma omp parallel for schedule(static) reduction(+:outOfRange)
+    for(long i = 0; i < (long)n; i++)
+    {
+        int64_t c[3];
+        if(!cellIndices(points + 3 * i, m_cellSize, c))
+        {
+            outOfRange++;
+        }
+        sorted[i] = std::make_pair(cellKey(c[0], c[1], c[2]), (size_t)i);
+    }
+
+    if(outOfRange)
+    {
+        throw std::range_error("PoissonDiskReduction: The point cloud extends over "
+                "too many grid cells. Please use a larger radius.");
+    }
+
+    std::sort(sorted.begin(), sorted.end());
+
+    // Group the sorted points into cells and assign each
+    // cell to one of 27 phases
+    std::vector<size_t> cellStart;
+    std::vector<size_t> phaseCells[27];
+    for(size_t i = 0; i < n; i++)
+    {
+        if(i == 0 || sorted[i].first != sorted[i - 1].first)
+        {
+            const float* p = points + 3 * sorted[i].second;
+            int phase = 0;
+            for(int j = 0; j < 3; j++)
+            {
+                int64_t c = cellIndex(p[j], m_cellSize);
+                phase = 3 * phase + (int)(((c % 3) + 3) % 3);
+            }
+            phaseCells[phase].push_back(cellStart.size());
+            cellStart.push_back(i);
+        }
+    }
+    cellStart.push_back(n);
+
+    // Process cells phase by phase. The samples accepted in
+    // a phase are inserted after all cells of that phase are
+    // done, so the hash map is only read concurrently.
+    for(int phase = 0; phase < 27; phase++)
+    {
+        const std::vector<size_t>& cells = phaseCells[phase];
+        std::vector<long> accepted(cells.size(), -1);
+
+        #pragma omp parallel for schedule(dynamic, 64)
+        for(long c = 0; c < (long)cells.size(); c++)
+        {
+            size_t begin = cellStart[cells[c]];
+            size_t end   = cellStart[cells[c] + 1];
+
+            if(m_cells.find(sorted[begin].first) != m_cells.end())
+            {
+                continue;
+            }
+
+            for(size_t i = begin; i < end; i++)
+            {
+                const float* p = points + 3 * sorted[i].second;
+                int64_t index[3];
+                cellIndices(p, m_cellSize, index);
+                if(isFree(p, index[0], index[1], index[2]))
+                {
+                    accepted[c] = sorted[i].second;
+                    break;
+                }
+            }
+        }
+
+        for(size_t c = 0; c < cells.size(); c++)
+        {
+            if(accepted[c] < 0)
+            {
+                continue;
+            }
+
+            size_t index = accepted[c];
+            m_cells[sorted[cellStart[cells[c]]].first] = m_points.size() / 3;
+            m_points.insert(m_points.end(), points + 3 * index, points + 3 * index + 3);
+
+            if(colors)
+            {
+                m_colors.insert(m_colors.end(), colors + 3 * index, colors + 3 * index + 3);
+            }
+            else if(m_hasColors)
+            {
+                m_colors.insert(m_colors.end(), 3, 0);
+            }
+
+            if(normals)
+            {
+                m_normals.insert(m_normals.end(), normals + 3 * index, normals + 3 * index + 3);
+            }
+            else if(m_hasNormals)
+            {
+                m_normals.insert(m_normals.end(), 3, 0.0f);
+            }
+        }
+    }
+}
+
+PointBufferPtr PoissonDiskReduction::getReducedPoints()
+{
+    size_t numPoints = m_points.size() / 3;
+
+    floatArr points(new float[3 * numPoints]);
+    std::copy(m_points.begin(), m_points.end(), points.get());
+
+    PointBufferPtr buffer(new PointBuffer);
+    buffer->setPointArray(points, numPoints);
+
+    if(m_hasColors && m_colors.size() == m_points.size())
+    {
+        ucharArr colors(new unsigned char[3 * numPoints]);
+        std::copy(m_colors.begin(), m_colors.end(), colors.get());
+        buffer->setPointColorArray(colors, numPoints);
+    }
+
+    if(m_hasNormals && m_normals.size() == m_points.size())
+    {
+        floatArr normals(new float[3 * numPoints]);
+        std::copy(m_normals.begin(), m_normals.end(), normals.get());
+        buffer->setPointNormalArray(normals, numPoints);
+    }
+
+    return buffer;
+}
+
+} // namespace lvr
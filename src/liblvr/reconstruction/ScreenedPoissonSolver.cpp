@@ -0,0 +1,650 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * ScreenedPoissonSolver.cpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/reconstruction/ScreenedPoissonSolver.hpp>
+#include <lvr/io/Timestamp.hpp>
+
+#include <boost/unordered_set.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+namespace lvr
+{
+
+const uint32_t ScreenedPoissonSolver::NONE;
+
+ScreenedPoissonSolver::ScreenedPoissonSolver(
+        const float* points,
+        const float* normals,
+        size_t n,
+        const float origin[3],
+        float size,
+        int maxDepth)
+    : m_points(points),
+      m_normals(normals),
+      m_numPoints(n),
+      m_size(size),
+      m_maxDepth(min(max(maxDepth, 1), 20)),
+      m_screeningWeight(4.0f),
+      m_maxIterations(100),
+      m_tolerance(1e-5f),
+      m_isoValue(0.0f)
+{
+    m_origin[0] = origin[0];
+    m_origin[1] = origin[1];
+    m_origin[2] = origin[2];
+    setMinDepth(5);
+}
+
+void ScreenedPoissonSolver::setMinDepth(int depth)
+{
+    m_minDepth = min(max(depth, 1), m_maxDepth);
+}
+
+float ScreenedPoissonSolver::cellSize(int depth) const
+{
+    return m_size / (float)((int64_t)1 << depth);
+}
+
+uint32_t ScreenedPoissonSolver::findNode(const Level& level, uint64_t key)
+{
+    vector<uint64_t>::const_iterator it = lower_bound(level.nodes.begin(), level.nodes.end(), key);
+    if(it == level.nodes.end() || *it != key)
+    {
+        return NONE;
+    }
+    return (uint32_t)(it - level.nodes.begin());
+}
+
+void ScreenedPoissonSolver::buildLevel(Level& level, int depth)
+{
+    level.depth = depth;
+    level.resolution = (int64_t)1 << depth;
+    level.cellSize = cellSize(depth);
+
+    const int64_t res = level.resolution;
+    level.cells.clear();
+
+    if(depth == m_minDepth)
+    {
+        // The coarsest grid covers the whole cube
+        level.cells.reserve(res * res * res);
+        for(int64_t i = 0; i < res; i++)
+        {
+            for(int64_t j = 0; j < res; j++)
+            {
+                for(int64_t k = 0; k < res; k++)
+                {
+                    level.cells.push_back(key(i, j, k));
+                }
+            }
+        }
+    }
+    else
+    {
+        // Cells that contain samples
+        vector<uint64_t> occupied(m_numPoints);
+
+        #pragma omp parallel for schedule(static)
+        for(long s = 0; s < (long)m_numPoints; s++)
+        {
+            int64_t c[3];
+            for(int a = 0; a < 3; a++)
+            {
+                c[a] = (int64_t)floor((m_points[3 * s + a] - m_origin[a]) / level.cellSize);
+                c[a] = min(max(c[a], (int64_t)0), res - 1);
+            }
+            occupied[s] = key(c[0], c[1], c[2]);
+        }
+        sort(occupied.begin(), occupied.end());
+        occupied.erase(unique(occupied.begin(), occupied.end()), occupied.end());
+
+        // Add their neighbors
+        level.cells.reserve(27 * occupied.size());
+        for(size_t c = 0; c < occupied.size(); c++)
+        {
+            int64_t i, j, k;
+            unpack(occupied[c], i, j, k);
+            for(int64_t di = max(i - 1, (int64_t)0); di <= min(i + 1, res - 1); di++)
+            {
+                for(int64_t dj = max(j - 1, (int64_t)0); dj <= min(j + 1, res - 1); dj++)
+                {
+                    for(int64_t dk = max(k - 1, (int64_t)0); dk <= min(k + 1, res - 1); dk++)
+                    {
+                        level.cells.push_back(key(di, dj, dk));
+                    }
+                }
+            }
+        }
+        sort(level.cells.begin(), level.cells.end());
+        level.cells.erase(unique(level.cells.begin(), level.cells.end()), level.cells.end());
+    }
+
+    // The nodes are the corners of the cells
+    level.nodes.resize(8 * level.cells.size());
+
+    #pragma omp parallel for schedule(static)
+    for(long c = 0; c < (long)level.cells.size(); c++)
+    {
+        int64_t i, j, k;
+        unpack(level.cells[c], i, j, k);
+        for(int q = 0; q < 8; q++)
+        {
+            level.nodes[8 * c + q] = key(i + (q & 1), j + ((q >> 1) & 1), k + ((q >> 2) & 1));
+        }
+    }
+    sort(level.nodes.begin(), level.nodes.end());
+    level.nodes.erase(unique(level.nodes.begin(), level.nodes.end()), level.nodes.end());
+
+    // Neighborhoods. Nodes at the border of a sparse grid are fixed.
+    size_t numNodes = level.nodes.size();
+    level.neighbors.resize(6 * numNodes);
+    level.fixed.assign(numNodes, 0);
+    level.x.assign(numNodes, 0.0f);
+
+    #pragma omp parallel for schedule(static)
+    for(long n = 0; n < (long)numNodes; n++)
+    {
+        int64_t c[3];
+        unpack(level.nodes[n], c[0], c[1], c[2]);
+        for(int a = 0; a < 3; a++)
+        {
+            for(int dir = 0; dir < 2; dir++)
+            {
+                int64_t d[3] = {c[0], c[1], c[2]};
+                d[a] += dir ? 1 : -1;
+
+                uint32_t neighbor = NONE;
+                if(d[a] >= 0 && d[a] <= res)
+                {
+                    neighbor = findNode(level, key(d[0], d[1], d[2]));
+                }
+                level.neighbors[6 * n + 2 * a + dir] = neighbor;
+
+                if(neighbor == NONE && depth > m_minDepth)
+                {
+                    level.fixed[n] = 1;
+                }
+            }
+        }
+    }
+}
+
+void ScreenedPoissonSolver::buildSamples(const Level& level, Samples& samples)
+{
+    const int64_t res = level.resolution;
+    samples.nodes.resize(8 * m_numPoints);
+    samples.weights.resize(8 * m_numPoints);
+
+    #pragma omp parallel for schedule(static)
+    for(long s = 0; s < (long)m_numPoints; s++)
+    {
+        int64_t c[3];
+        float f[3];
+        for(int a = 0; a < 3; a++)
+        {
+            float u = (m_points[3 * s + a] - m_origin[a]) / level.cellSize;
+            c[a] = min(max((int64_t)floor(u), (int64_t)0), res - 1);
+            f[a] = min(max(u - c[a], 0.0f), 1.0f);
+        }
+
+        for(int q = 0; q < 8; q++)
+        {
+            int dx = q & 1;
+            int dy = (q >> 1) & 1;
+            int dz = (q >> 2) & 1;
+            samples.nodes[8 * s + q] = findNode(level, key(c[0] + dx, c[1] + dy, c[2] + dz));
+            samples.weights[8 * s + q] =
+                    (dx ? f[0] : 1.0f - f[0]) *
+                    (dy ? f[1] : 1.0f - f[1]) *
+                    (dz ? f[2] : 1.0f - f[2]);
+        }
+    }
+
+    // Group the references by node
+    size_t numNodes = level.nodes.size();
+    samples.offsets.assign(numNodes + 1, 0);
+    for(size_t e = 0; e < samples.nodes.size(); e++)
+    {
+        samples.offsets[samples.nodes[e] + 1]++;
+    }
+    for(size_t n = 0; n < numNodes; n++)
+    {
+        samples.offsets[n + 1] += samples.offsets[n];
+    }
+
+    vector<size_t> cursor(samples.offsets.begin(), samples.offsets.end() - 1);
+    samples.references.resize(samples.nodes.size());
+    for(size_t e = 0; e < samples.nodes.size(); e++)
+    {
+        samples.references[cursor[samples.nodes[e]]++] = (uint32_t)e;
+    }
+}
+
+void ScreenedPoissonSolver::multiply(
+        const Level& level,
+        const Samples& samples,
+        float screening,
+        const vector<float>& x,
+        vector<float>& y,
+        vector<float>& tmp) const
+{
+    // Values of x at the samples
+    #pragma omp parallel for schedule(static)
+    for(long s = 0; s < (long)m_numPoints; s++)
+    {
+        float v = 0.0f;
+        for(int q = 0; q < 8; q++)
+        {
+            v += samples.weights[8 * s + q] * x[samples.nodes[8 * s + q]];
+        }
+        tmp[s] = v;
+    }
+
+    #pragma omp parallel for schedule(static)
+    for(long n = 0; n < (long)level.nodes.size(); n++)
+    {
+        if(level.fixed[n])
+        {
+            y[n] = 0.0f;
+            continue;
+        }
+
+        float v = 0.0f;
+        for(int q = 0; q < 6; q++)
+        {
+            uint32_t neighbor = level.neighbors[6 * n + q];
+            if(neighbor != NONE)
+            {
+                v += x[n] - x[neighbor];
+            }
+        }
+
+        float s = 0.0f;
+        for(size_t r = samples.offsets[n]; r < samples.offsets[n + 1]; r++)
+        {
+            uint32_t e = samples.references[r];
+            s += samples.weights[e] * tmp[e / 8];
+        }
+
+        y[n] = v + screening * s;
+    }
+}
+
+void ScreenedPoissonSolver::solveLevel(Level& level)
+{
+    size_t index = level.depth - m_minDepth;
+    size_t numNodes = level.nodes.size();
+    const float h = level.cellSize;
+
+    Samples samples;
+    buildSamples(level, samples);
+
+    // Average normal at the nodes
+    vector<float> field(3 * numNodes, 0.0f);
+    long numSampled = 0;
+
+    #pragma omp parallel for schedule(static) reduction(+:numSampled)
+    for(long n = 0; n < (long)numNodes; n++)
+    {
+        float sum = 0.0f;
+        float v[3] = {0.0f, 0.0f, 0.0f};
+        for(size_t r = samples.offsets[n]; r < samples.offsets[n + 1]; r++)
+        {
+            uint32_t e = samples.references[r];
+            float w = samples.weights[e];
+            const float* normal = m_normals + 3 * (e / 8);
+            v[0] += w * normal[0];
+            v[1] += w * normal[1];
+            v[2] += w * normal[2];
+            sum += w;
+        }
+
+        if(sum > 0.0f)
+        {
+            field[3 * n]     = v[0] / sum;
+            field[3 * n + 1] = v[1] / sum;
+            field[3 * n + 2] = v[2] / sum;
+            numSampled++;
+        }
+    }
+
+    // Normalize the screening weight, so that the screening term of
+    // a node with samples is alpha on average
+    float screening = m_numPoints ? m_screeningWeight * numSampled / m_numPoints : 0.0f;
+
+    // Right hand side (divergence of the field) and diagonal
+    vector<float> b(numNodes, 0.0f);
+    vector<float> diag(numNodes, 1.0f);
+
+    #pragma omp parallel for schedule(static)
+    for(long n = 0; n < (long)numNodes; n++)
+    {
+        if(level.fixed[n])
+        {
+            continue;
+        }
+
+        float v = 0.0f;
+        int degree = 0;
+        for(int a = 0; a < 3; a++)
+        {
+            uint32_t prev = level.neighbors[6 * n + 2 * a];
+            uint32_t next = level.neighbors[6 * n + 2 * a + 1];
+            if(prev != NONE)
+            {
+                v += 0.5f * h * (field[3 * prev + a] + field[3 * n + a]);
+                degree++;
+            }
+            if(next != NONE)
+            {
+                v -= 0.5f * h * (field[3 * n + a] + field[3 * next + a]);
+                degree++;
+            }
+        }
+        b[n] = v;
+
+        float s = 0.0f;
+        for(size_t r = samples.offsets[n]; r < samples.offsets[n + 1]; r++)
+        {
+            float w = samples.weights[samples.references[r]];
+            s += w * w;
+        }
+        diag[n] = max(degree + screening * s, 1e-6f);
+    }
+
+    // Initial guess from the coarser depth
+    if(index > 0)
+    {
+        #pragma omp parallel for schedule(static)
+        for(long n = 0; n < (long)numNodes; n++)
+        {
+            int64_t i, j, k;
+            unpack(level.nodes[n], i, j, k);
+            level.x[n] = interpolate(index - 1, 0.5f * i, 0.5f * j, 0.5f * k);
+        }
+    }
+
+    // Jacobi preconditioned conjugate gradients
+    vector<float>& x = level.x;
+    vector<float> r(numNodes), z(numNodes), p(numNodes), q(numNodes);
+    vector<float> tmp(m_numPoints);
+
+    multiply(level, samples, screening, x, q, tmp);
+
+    double rz = 0.0;
+    double bb = 0.0;
+
+    #pragma omp parallel for schedule(static) reduction(+:rz,bb)
+    for(long n = 0; n < (long)numNodes; n++)
+    {
+        r[n] = level.fixed[n] ? 0.0f : b[n] - q[n];
+        z[n] = r[n] / diag[n];
+        p[n] = z[n];
+        rz += (double)r[n] * z[n];
+        bb += (double)b[n] * b[n];
+    }
+
+    double residual = 0.0;
+    int it = 0;
+    for(; it < m_maxIterations && bb > 0.0; it++)
+    {
+        multiply(level, samples, screening, p, q, tmp);
+
+        double pq = 0.0;
+
+        #pragma omp parallel for schedule(static) reduction(+:pq)
+        for(long n = 0; n < (long)numNodes; n++)
+        {
+            pq += (double)p[n] * q[n];
+        }
+
+        if(pq <= 0.0)
+        {
+            break;
+        }
+
+        float alpha = (float)(rz / pq);
+        double rr = 0.0;
+        double rzNew = 0.0;
+
+        #pragma omp parallel for schedule(static) reduction(+:rr,rzNew)
+        for(long n = 0; n < (long)numNodes; n++)
+        {
+            x[n] += alpha * p[n];
+            r[n] -= alpha * q[n];
+            z[n] = r[n] / diag[n];
+            rr += (double)r[n] * r[n];
+            rzNew += (double)r[n] * z[n];
+        }
+
+        residual = sqrt(rr / bb);
+        if(residual < m_tolerance)
+        {
+            it++;
+            break;
+        }
+
+        float beta = (float)(rzNew / rz);
+        rz = rzNew;
+
+        #pragma omp parallel for schedule(static)
+        for(long n = 0; n < (long)numNodes; n++)
+        {
+            p[n] = z[n] + beta * p[n];
+        }
+    }
+
+    cout << timestamp << "Depth " << level.depth << ": " << numNodes << " nodes, "
+         << it << " iterations, residual " << residual << endl;
+}
+
+float ScreenedPoissonSolver::interpolate(size_t index, float u, float v, float w) const
+{
+    const Level& level = m_levels[index];
+    const int64_t res = level.resolution;
+
+    float pos[3] = {u, v, w};
+    int64_t c[3];
+    float f[3];
+    for(int a = 0; a < 3; a++)
+    {
+        c[a] = min(max((int64_t)floor(pos[a]), (int64_t)0), res - 1);
+        f[a] = min(max(pos[a] - c[a], 0.0f), 1.0f);
+    }
+
+    float value = 0.0f;
+    for(int q = 0; q < 8; q++)
+    {
+        int dx = q & 1;
+        int dy = (q >> 1) & 1;
+        int dz = (q >> 2) & 1;
+
+        uint32_t node = findNode(level, key(c[0] + dx, c[1] + dy, c[2] + dz));
+        if(node == NONE)
+        {
+            return index > 0 ? interpolate(index - 1, 0.5f * u, 0.5f * v, 0.5f * w) : 0.0f;
+        }
+
+        value += (dx ? f[0] : 1.0f - f[0]) *
+                 (dy ? f[1] : 1.0f - f[1]) *
+                 (dz ? f[2] : 1.0f - f[2]) * level.x[node];
+    }
+    return value;
+}
+
+void ScreenedPoissonSolver::solve()
+{
+    m_levels.clear();
+    m_levels.resize(m_maxDepth - m_minDepth + 1);
+
+    for(size_t l = 0; l < m_levels.size(); l++)
+    {
+        buildLevel(m_levels[l], m_minDepth + (int)l);
+        solveLevel(m_levels[l]);
+
+        // Only the solution is needed for interpolation
+        vector<uint32_t>().swap(m_levels[l].neighbors);
+        vector<unsigned char>().swap(m_levels[l].fixed);
+    }
+
+    // Use the mean value at the samples as iso value
+    const Level& finest = m_levels.back();
+    double sum = 0.0;
+
+    #pragma omp parallel for schedule(static) reduction(+:sum)
+    for(long s = 0; s < (long)m_numPoints; s++)
+    {
+        const float* p = m_points + 3 * s;
+        sum += interpolate(m_levels.size() - 1,
+                (p[0] - m_origin[0]) / finest.cellSize,
+                (p[1] - m_origin[1]) / finest.cellSize,
+                (p[2] - m_origin[2]) / finest.cellSize);
+    }
+    m_isoValue = m_numPoints ? (float)(sum / m_numPoints) : 0.0f;
+}
+
+float ScreenedPoissonSolver::value(const float* p) const
+{
+    if(m_levels.empty())
+    {
+        return 0.0f;
+    }
+
+    const Level& finest = m_levels.back();
+    return interpolate(m_levels.size() - 1,
+            (p[0] - m_origin[0]) / finest.cellSize,
+            (p[1] - m_origin[1]) / finest.cellSize,
+            (p[2] - m_origin[2]) / finest.cellSize) - m_isoValue;
+}
+
+void ScreenedPoissonSolver::getFinestCells(vector<int>& cells, bool closeHoles) const
+{
+    cells.clear();
+    if(m_levels.empty())
+    {
+        return;
+    }
+
+    const Level& finest = m_levels.back();
+    vector<uint64_t> keys(finest.cells);
+
+    // Follow the surface into the regions without samples: a cell
+    // is added if it shares a face with a sign change with a cell
+    // of the grid. Only surfaces that are connected to the samples
+    // are found, so no distant artifacts are created.
+    if(closeHoles)
+    {
+        const int64_t res = finest.resolution;
+        const size_t index = m_levels.size() - 1;
+        boost::unordered_set<uint64_t> contained(keys.begin(), keys.end());
+        vector<uint64_t> frontier(keys);
+
+        while(!frontier.empty())
+        {
+            vector<uint64_t> candidates;
+
+            #pragma omp parallel
+            {
+                vector<uint64_t> found;
+
+                #pragma omp for schedule(dynamic, 64)
+                for(long c = 0; c < (long)frontier.size(); c++)
+                {
+                    int64_t i, j, k;
+                    unpack(frontier[c], i, j, k);
+
+                    bool inside[8];
+                    for(int q = 0; q < 8; q++)
+                    {
+                        inside[q] = interpolate(index,
+                                (float)(i + (q & 1)),
+                                (float)(j + ((q >> 1) & 1)),
+                                (float)(k + ((q >> 2) & 1))) < m_isoValue;
+                    }
+
+                    for(int a = 0; a < 3; a++)
+                    {
+                        for(int dir = 0; dir < 2; dir++)
+                        {
+                            int numInside = 0;
+                            for(int q = 0; q < 8; q++)
+                            {
+                                if(((q >> a) & 1) == dir && inside[q])
+                                {
+                                    numInside++;
+                                }
+                            }
+
+                            int64_t d[3] = {i, j, k};
+                            d[a] += dir ? 1 : -1;
+                            if(numInside == 0 || numInside == 4 || d[a] < 0 || d[a] >= res)
+                            {
+                                continue;
+                            }
+                            found.push_back(key(d[0], d[1], d[2]));
+                        }
+                    }
+                }
+
+                #pragma omp critical
+                candidates.insert(candidates.end(), found.begin(), found.end());
+            }
+
+            sort(candidates.begin(), candidates.end());
+            candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+
+            frontier.clear();
+            for(size_t c = 0; c < candidates.size(); c++)
+            {
+                if(contained.insert(candidates[c]).second)
+                {
+                    frontier.push_back(candidates[c]);
+                    keys.push_back(candidates[c]);
+                }
+            }
+        }
+    }
+
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+
+    cells.resize(3 * keys.size());
+    for(size_t c = 0; c < keys.size(); c++)
+    {
+        int64_t i, j, k;
+        unpack(keys[c], i, j, k);
+        cells[3 * c]     = (int)i;
+        cells[3 * c + 1] = (int)j;
+        cells[3 * c + 2] = (int)k;
+    }
+}
+
+} // namespace lvr
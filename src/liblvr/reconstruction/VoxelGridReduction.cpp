@@ -0,0 +1,298 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+/*
+ * VoxelGridReduction.cpp
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/reconstruction/VoxelGridReduction.hpp>
+#include <lvr/config/lvropenmp.hpp>
+
+#include <stdexcept>
+
+namespace lvr
+{
+
+VoxelGridReduction::VoxelGridReduction(float voxelSize, Mode mode)
+    : m_voxelSize(voxelSize), m_mode(mode), m_hasColors(false), m_hasNormals(false)
+{
+    m_shards.resize(OpenMPConfig::getNumThreads());
+}
+
+void VoxelGridReduction::clear()
+{
+    for(size_t i = 0; i < m_shards.size(); i++)
+    {
+        m_shards[i].clear();
+    }
+    m_hasColors = false;
+    m_hasNormals = false;
+    resetAnchor();
+}
+
+void VoxelGridReduction::addPoints(const float* points, const unsigned char* colors, const float* normals, size_t n)
+{
+    if(n == 0)
+    {
+        return;
+    }
+
+    if(colors)
+    {
+        m_hasColors = true;
+    }
+
+    if(normals)
+    {
+        m_hasNormals = true;
+    }
+
+    setAnchor(points, m_voxelSize);
+
+    // Calculate the voxel keys of all points in parallel
+    std::vector<uint64_t> keys(n);
+    long outOfRange = 0;
+
+    #pragma omp parallel for schedule(static) reduction(+:outOfRange)
+    for(long i = 0; i < (long)n; i++)
+    {
+        int64_t c[3];
+        if(!cellIndices(points + 3 * i, m_voxelSize, c))
+        {
+            outOfRange++;
+        }
+        keys[i] = cellKey(c[0], c[1], c[2]);
+    }
+
+    if(outOfRange)
+    {
+        throw std::range_error("VoxelGridReduction: The point cloud extends over "
+                "too many voxels. Please use a larger voxel size.");
+    }
+
+    // Partition the points by shard with a counting sort. The
+    // block is split into chunks that are counted and scattered
+    // in parallel. Points of a shard keep their original order.
+    const size_t numShards = m_shards.size();
+    const size_t numChunks = numShards;
+
+    std::vector<size_t> offsets(numShards * numChunks + 1, 0);
+
+    #pragma omp parallel for schedule(static)
+    for(long c = 0; c < (long)numChunks; c++)
+    {
+        size_t begin = n * c / numChunks;
+        size_t end   = n * (c + 1) / numChunks;
+        for(size_t i = begin; i < end; i++)
+        {
+            offsets[(keys[i] % numShards) * numChunks + c + 1]++;
+        }
+    }
+
+    for(size_t i = 0; i < numShards * numChunks; i++)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+
+    std::vector<size_t> order(n);
+
+    #pragma omp parallel for schedule(static)
+    for(long c = 0; c < (long)numChunks; c++)
+    {
+        size_t begin = n * c / numChunks;
+        size_t end   = n * (c + 1) / numChunks;
+        for(size_t i = begin; i < end; i++)
+        {
+            order[offsets[(keys[i] % numShards) * numChunks + c]++] = i;
+        }
+    }
+
+    // After the scatter pass offsets[s * numChunks - 1] points to
+    // the end of shard s - 1, i.e., to the begin of shard s.
+    // Every shard is updated by a single thread.
+    #pragma omp parallel for schedule(dynamic)
+    for(long s = 0; s < (long)numShards; s++)
+    {
+        VoxelMap& shard = m_shards[s];
+        size_t begin = s > 0 ? offsets[s * numChunks - 1] : 0;
+        size_t end   = offsets[(s + 1) * numChunks - 1];
+
+        for(size_t o = begin; o < end; o++)
+        {
+            size_t i = order[o];
+            const float* p = points + 3 * i;
+
+            std::pair<VoxelMap::iterator, bool> res = shard.insert(std::make_pair(keys[i], Voxel()));
+            Voxel& v = res.first->second;
+            if(res.second)
+            {
+                v.sum[0] = v.sum[1] = v.sum[2] = 0.0;
+                v.colorSum[0] = v.colorSum[1] = v.colorSum[2] = 0.0;
+                v.normalSum[0] = v.normalSum[1] = v.normalSum[2] = 0.0f;
+                v.color[0] = v.color[1] = v.color[2] = 0;
+                v.normal[0] = v.normal[1] = v.normal[2] = 0.0f;
+                v.distance = -1.0f;
+                v.count = 0;
+            }
+
+            v.count++;
+
+            if(m_mode == Centroid)
+            {
+                v.sum[0] += p[0];
+                v.sum[1] += p[1];
+                v.sum[2] += p[2];
+
+                if(colors)
+                {
+                    v.colorSum[0] += colors[3 * i];
+                    v.colorSum[1] += colors[3 * i + 1];
+                    v.colorSum[2] += colors[3 * i + 2];
+                }
+
+                if(normals)
+                {
+                    v.normalSum[0] += normals[3 * i];
+                    v.normalSum[1] += normals[3 * i + 1];
+                    v.normalSum[2] += normals[3 * i + 2];
+                }
+            }
+            else
+            {
+                // Distance to the center of the voxel
+                float d = 0.0f;
+                for(int j = 0; j < 3; j++)
+                {
+                    float center = (cellIndex(p[j], m_voxelSize) + 0.5f) * m_voxelSize;
+                    d += (p[j] - center) * (p[j] - center);
+                }
+
+                if(v.distance < 0.0f || d < v.distance)
+                {
+                    v.distance = d;
+                    v.point[0] = p[0];
+                    v.point[1] = p[1];
+                    v.point[2] = p[2];
+
+                    if(colors)
+                    {
+                        v.color[0] = colors[3 * i];
+                        v.color[1] = colors[3 * i + 1];
+                        v.color[2] = colors[3 * i + 2];
+                    }
+
+                    if(normals)
+                    {
+                        v.normal[0] = normals[3 * i];
+                        v.normal[1] = normals[3 * i + 1];
+                        v.normal[2] = normals[3 * i + 2];
+                    }
+                }
+            }
+        }
+    }
+}
+
+PointBufferPtr VoxelGridReduction::getReducedPoints()
+{
+    // Compute output offsets of the shards
+    std::vector<size_t> offsets(m_shards.size() + 1, 0);
+    for(size_t s = 0; s < m_shards.size(); s++)
+    {
+        offsets[s + 1] = offsets[s] + m_shards[s].size();
+    }
+
+    size_t numPoints = offsets.back();
+    floatArr points(new float[3 * numPoints]);
+    ucharArr colors;
+    if(m_hasColors)
+    {
+        colors = ucharArr(new unsigned char[3 * numPoints]);
+    }
+
+    floatArr normals;
+    if(m_hasNormals)
+    {
+        normals = floatArr(new float[3 * numPoints]);
+    }
+
+    #pragma omp parallel for schedule(dynamic)
+    for(long s = 0; s < (long)m_shards.size(); s++)
+    {
+        size_t i = offsets[s];
+        for(VoxelMap::const_iterator it = m_shards[s].begin(); it != m_shards[s].end(); ++it, ++i)
+        {
+            const Voxel& v = it->second;
+            if(m_mode == Centroid)
+            {
+                for(int j = 0; j < 3; j++)
+                {
+                    points[3 * i + j] = v.sum[j] / v.count;
+                    if(m_hasColors)
+                    {
+                        colors[3 * i + j] = (unsigned char)(v.colorSum[j] / v.count + 0.5);
+                    }
+                }
+
+                if(m_hasNormals)
+                {
+                    // Mean direction of the normals in the voxel
+                    const float* ns = v.normalSum;
+                    float length = sqrt(ns[0] * ns[0] + ns[1] * ns[1] + ns[2] * ns[2]);
+                    for(int j = 0; j < 3; j++)
+                    {
+                        normals[3 * i + j] = length > 0.0f ? ns[j] / length : 0.0f;
+                    }
+                }
+            }
+            else
+            {
+                for(int j = 0; j < 3; j++)
+                {
+                    points[3 * i + j] = v.point[j];
+                    if(m_hasColors)
+                    {
+                        colors[3 * i + j] = v.color[j];
+                    }
+                    if(m_hasNormals)
+                    {
+                        normals[3 * i + j] = v.normal[j];
+                    }
+                }
+            }
+        }
+    }
+
+    PointBufferPtr buffer(new PointBuffer);
+    buffer->setPointArray(points, numPoints);
+    if(m_hasColors)
+    {
+        buffer->setPointColorArray(colors, numPoints);
+    }
+    if(m_hasNormals)
+    {
+        buffer->setPointNormalArray(normals, numPoints);
+    }
+
+    return buffer;
+}
+
+} // namespace lvr
@@ -25,6 +25,7 @@
 #include <lvr/registration/ICPPointAlign.hpp>
 #include <lvr/registration/EigenSVDPointAlign.hpp>
 #include <lvr/io/Timestamp.hpp>
+#include <lvr/io/IOUtils.hpp>
 #include <lvr/reconstruction/SearchTreeFlann.hpp>
 
 
@@ -50,14 +51,7 @@ ICPPointAlign::ICPPointAlign(PointBufferPtr model, PointBufferPtr data, Matrix4f
     floatArr o_points = data->getPointArray(n);
     floatArr t_points(new float[3 * n]);
 
-    for(size_t i = 0; i < numPoints; i++)
-    {
-        Vertexf v(o_points[3 * i], o_points[3 * i + 1], o_points[3 * i + 2]);
-        Vertexf t = transform * v;
-        t_points[3 * i    ] = t[0];
-        t_points[3 * i + 1] = t[1];
-        t_points[3 * i + 2] = t[2];
-    }
+    transformAndReducePointArray(o_points.get(), n, t_points.get(), transform.getData());
     m_dataCloud->setPointArray(t_points, n);
 
     // Create search tree
@@ -60,7 +60,15 @@ void computeNormals(string filename, image_normals::Options& opt, PointBufferPtr
                 opt.minV(), opt.maxV(),
                 opt.optimize(), system);
 
-    mti.writePGM(opt.imageFile(), 3000);
+    // Write raw ranges for float images, scaled gray values otherwise
+    if(boost::filesystem::path(opt.imageFile()).extension().string() == ".pfm")
+    {
+        mti.writePFM(opt.imageFile());
+    }
+    else
+    {
+        mti.writePGM(opt.imageFile(), 3000);
+    }
 
     PanoramaNormals normals(&mti);
     buffer = normals.computeNormals(opt.regionWidth(), opt.regionHeight(), false);
@@ -41,7 +41,7 @@ Options::Options(int argc, char** argv) : m_descr("Supported options")
     ("maxZ",            value<float>(&m_maxZ)->default_value(1e6),      "Maximal depth value.")
     ("maxZimg",         value<float>(&m_maxZimg)->default_value(1e6),   "Maximal depth value in depth image.")
     ("minZimg",         value<float>(&m_maxZimg)->default_value(0),     "Maximal depth value in depth image.")
-    ("img",             value<string>(&m_imageOut)->default_value("panorama.pgm"), "Output file for projection image.")
+    ("img",             value<string>(&m_imageOut)->default_value("panorama.pgm"), "Output file for projection image. Use a .pfm file to store unscaled ranges.")
     ("imageWidth,w",    value<int>(&m_width)->default_value(2800),      "Image width.")
     ("imageHeight,h",   value<int>(&m_height)->default_value(1000),     "Image height.")
     ("regionWidth,i",    value<int>(&m_width)->default_value(5),      "Width of the nearest neighbor region of a pixel for normal estimation.")
@@ -29,6 +29,7 @@
 #include <fstream>
 #include <utility>
 #include <iterator>
+#include <stdexcept>
 using namespace std;
 
 #include <boost/filesystem.hpp>
@@ -47,9 +48,9 @@ using namespace std;
 #include <lvr/io/ModelFactory.hpp>
 #include <lvr/io/AsciiIO.hpp>
 #include <lvr/io/IOUtils.hpp>
-#ifdef LVR_USE_PCL
-#include <lvr/reconstruction/PCLFiltering.hpp>
-#endif
+#include <lvr/reconstruction/VoxelGridReduction.hpp>
+#include <lvr/reconstruction/PoissonDiskReduction.hpp>
+#include <lvr/reconstruction/PointCloudFiltering.hpp>
 
 #define BUF_SIZE 1024
 
@@ -68,26 +69,48 @@ ModelPtr filterModel(ModelPtr p, int k, float sigma)
     {
         if(p->m_pointCloud)
         {
-#ifdef LVR_USE_PCL
-            PCLFiltering filter(p->m_pointCloud);
-            cout << timestamp << "Filtering outliers with k=" << k << " and sigma=" << sigma << "." << endl;
-            size_t original_size = p->m_pointCloud->getNumPoints();
-            filter.applyOutlierRemoval(k, sigma);
-            PointBufferPtr pb( filter.getPointBuffer() );
-            ModelPtr out_model( new Model( pb ) );
-            cout << timestamp << "Filtered out " << original_size - out_model->m_pointCloud->getNumPoints() << " points." << endl;
-            return out_model;
-#else
-            cout << timestamp << "Can't create a PCL Filter without PCL installed." << endl;
-            return NULL;
-#endif
-
+            PointCloudFiltering filter(p->m_pointCloud);
+            size_t removed = filter.applyOutlierRemoval(k, sigma);
+            cout << timestamp << "Filtered out " << removed << " points." << endl;
+            return ModelPtr( new Model( filter.getPointBuffer() ) );
         }
     }
-    return NULL;
+    return ModelPtr();
 }
 
+void spatialReduce(ModelPtr model)
+{
+    if(!model || !model->m_pointCloud)
+    {
+        return;
+    }
+
+    PointCloudReductionPtr engine;
+    if(options->getPoissonRadius() > 0)
+    {
+        engine = PointCloudReductionPtr(new PoissonDiskReduction(options->getPoissonRadius()));
+    }
+    else if(options->getVoxelSize() > 0)
+    {
+        engine = PointCloudReductionPtr(new VoxelGridReduction(options->getVoxelSize()));
+    }
 
+    if(engine)
+    {
+        size_t original_size = model->m_pointCloud->getNumPoints();
+        try
+        {
+            model->m_pointCloud = engine->reduce(model->m_pointCloud);
+        }
+        catch(std::range_error& e)
+        {
+            cout << timestamp << e.what() << " Skipping spatial reduction." << endl;
+            return;
+        }
+        cout << timestamp << "Reduced " << original_size << " points to "
+             << model->m_pointCloud->getNumPoints() << "." << endl;
+    }
+}
 
 size_t writePly(ModelPtr model, std::fstream& out) 
 {
@@ -224,35 +247,34 @@ void processSingleFile(boost::filesystem::path& inFile)
 
         size_t reductionFactor = getReductionFactor(model, options->getTargetSize());
 
-        if(options->transformBefore())
-        {
- 	    transformAndReducePointCloud(
-		model, reductionFactor,
-		options->sx(), options->sy(), options->sz(),
-		options->x(), options->y(), options->z());	    
-        }
-
+        Eigen::Matrix4d transform = Eigen::Matrix4d::Identity();
         if(boost::filesystem::exists(framesPath))
         {
             std::cout << timestamp << "Getting transformation from frame: " << framesPath << std::endl;
-            Eigen::Matrix4d transform = getTransformationFromFrames(framesPath);
-            transformPointCloud(model, transform);
+            transform = getTransformationFromFrames(framesPath);
         }
         else if(boost::filesystem::exists(posePath))
         {
 
             std::cout << timestamp << "Getting transformation from pose: " << posePath << std::endl;
-            Eigen::Matrix4d transform = getTransformationFromPose(posePath);
-            transformPointCloud(model, transform);
+            transform = getTransformationFromPose(posePath);
         }
 
-        if(!options->transformBefore())
+        // Concatenate scan pose and coordinate conversion to transform
+        // and reduce the point cloud in a single pass
+        Eigen::Matrix4d swizzle = buildSwizzleTransformation(
+                options->sx(), options->sy(), options->sz(),
+                options->x(), options->y(), options->z());
+
+        if(options->transformBefore())
         {
-             transformAndReducePointCloud(
-		model, reductionFactor,
-		options->sx(), options->sy(), options->sz(),
-		options->x(), options->y(), options->z());
+            transformAndReducePointCloud(model, reductionFactor, transform * swizzle);
+        }
+        else
+        {
+            transformAndReducePointCloud(model, reductionFactor, swizzle * transform);
         }
+        spatialReduce(model);
 
         static size_t points_written = 0;
 
@@ -402,6 +424,7 @@ void processSingleFile(boost::filesystem::path& inFile)
 		model, getReductionFactor(model, options->getTargetSize()),
 		options->sx(), options->sy(), options->sz(),
 		options->x(), options->y(), options->z());
+	    spatialReduce(model);
 	    
             size_t points_written = writePointsToASCII(model, out, options->noColor());
 
@@ -447,6 +470,7 @@ void processSingleFile(boost::filesystem::path& inFile)
 		model, getReductionFactor(model, options->getTargetSize()),
 		options->sx(), options->sy(), options->sz(),
 		options->x(), options->y(), options->z());
+	    spatialReduce(model);
 
             size_t points_written = writePointsToASCII(model, out, options->noColor());
 
@@ -486,6 +510,7 @@ void processSingleFile(boost::filesystem::path& inFile)
 		model, getReductionFactor(model, options->getTargetSize()),
 		options->sx(), options->sy(), options->sz(),
 		options->x(), options->y(), options->z());
+	    spatialReduce(model);
 
 	    
             std::ofstream out;
@@ -46,6 +46,8 @@ Options::Options(int argc, char** argv) : m_descr("Supported options")
 	    ("k", value<int>()->default_value(1), "k neighborhood for filtering.")
 	    ("sigma", value<float>()->default_value(1.0), "Deviation for outlier filter.")
 	    ("targetSize", value<int>()->default_value(0), "Target size (reduction) for the input scans.")
+	    ("voxelSize", value<float>()->default_value(0), "Reduce the scans to one point per voxel of the given size (0 = off).")
+	    ("poissonRadius", value<float>()->default_value(0), "Reduce the scans to points that are at least the given distance apart (0 = off).")
 	    ("xPos,x", value<int>()->default_value(0), "Position of the x-coordinates in the input data lines.")
 	    ("yPos,y", value<int>()->default_value(1), "Position of the y-coordinates in the input data lines.")
 	    ("zPos,z", value<int>()->default_value(2), "Position of the z-coordinates in the input data lines.")
@@ -129,6 +131,16 @@ int		Options::getTargetSize() const
 	return m_variables["targetSize"].as<int>();
 }
 
+float	Options::getVoxelSize() const
+{
+	return m_variables["voxelSize"].as<float>();
+}
+
+float	Options::getPoissonRadius() const
+{
+	return m_variables["poissonRadius"].as<float>();
+}
+
 
 Options::~Options() {
 	// TODO Auto-generated destructor stub
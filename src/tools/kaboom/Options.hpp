@@ -69,6 +69,8 @@ public:
 	int		getK() const;
 	float	getSigma() const;
 	int		getTargetSize() const;
+	float	getVoxelSize() const;
+	float	getPoissonRadius() const;
 
 	/**
 	 * @brief   Returns the position of the x coordinate in the data.
@@ -159,6 +161,14 @@ inline ostream& operator<<(ostream& os, const Options &o)
 		cout << "##### Filter  \t\t\t: NO" << endl;
 	}
 	cout << "##### Target Size \t: " << o.getTargetSize() << endl;
+	if(o.getPoissonRadius() > 0)
+	{
+		cout << "##### Poisson Radius \t: " << o.getPoissonRadius() << endl;
+	}
+	else if(o.getVoxelSize() > 0)
+	{
+		cout << "##### Voxel Size \t\t: " << o.getVoxelSize() << endl;
+	}
 	return os;
 }
 
@@ -26,6 +26,10 @@
 #include <lvr/io/PLYIO.hpp>
 #include <lvr/geometry/Matrix4.hpp>
 #include <lvr/geometry/HalfEdgeMesh.hpp>
+#include <lvr/geometry/MeshNormals.hpp>
+#include <lvr/geometry/MeshComponents.hpp>
+#include <lvr/io/MeshCheckpointIO.hpp>
+#include <lvr/config/lvropenmp.hpp>
 #include <lvr/geometry/QuadricVertexCosts.hpp>
 #include <lvr/reconstruction/SharpBox.hpp>
 #include <lvr/texture/Texture.hpp>
@@ -67,70 +71,154 @@ int main(int argc, char** argv)
 			return 0;
 		}
 
-		::std::cout << options << ::std::endl;
+		OpenMPConfig::setNumThreads(options.getNumThreads());
 
+		::std::cout << options << ::std::endl;
 
-		// Create a point loader object
-		ModelPtr model = ModelFactory::readModel( options.getInputFileName() );
 
-		MeshBufferPtr mesh_buffer;
+		// Checkpoints are restored after the mesh was created
+		bool resume = MeshCheckpointIO::isCheckpoint(options.getInputFileName());
 
-		// Parse loaded data
-		if ( !model )
-		{
-			cout << timestamp << "IO Error: Unable to parse " << options.getInputFileName() << endl;
-			exit(-1);
-		}
-		mesh_buffer = model->m_mesh;
+		MeshBufferPtr mesh_buffer(new MeshBuffer);
 
-		if(!mesh_buffer)
+		if(!resume)
 		{
-		    cout << timestamp << "Given file contains no supported mesh information" << endl;
+			// Create a point loader object
+			ModelPtr model = ModelFactory::readModel( options.getInputFileName() );
+
+			// Parse loaded data
+			if ( !model )
+			{
+				cout << timestamp << "IO Error: Unable to parse " << options.getInputFileName() << endl;
+				exit(-1);
+			}
+			mesh_buffer = model->m_mesh;
+
+			if(!mesh_buffer)
+			{
+				cout << timestamp << "Given file contains no supported mesh information" << endl;
+			}
+
+			// Remove dangling artifacts before the half edge mesh is built
+			if(mesh_buffer && options.getDanglingArtifacts())
+			{
+				mesh_buffer = MeshComponents::removeSmallComponents(mesh_buffer, options.getDanglingArtifacts());
+			}
 		}
 
 		// Create an empty mesh
 		HalfEdgeMesh<ColorVertex<float, unsigned char> , Normal<float> > mesh( mesh_buffer );
 
-		// Set recursion depth for region growing
-		if(options.getDepth())
+		string stage;
+		if(resume && !mesh.loadCheckpoint(options.getInputFileName(), &stage))
 		{
-			mesh.setDepth(options.getDepth());
+			exit(-1);
 		}
 
-
-
-		if(options.getDanglingArtifacts())
+		// Set recursion depth for region growing
+		if(options.getDepth())
 		{
-			mesh.removeDanglingArtifacts(options.getDanglingArtifacts());
+			mesh.setDepth(options.getDepth());
 		}
-		// Optimize mesh
-
-
-
-
-		mesh.cleanContours(options.getCleanContourIterations());
-
 
 		mesh.setClassifier(options.getClassifier());
 
-
+		// Post-processing passes in the order they are applied. Disabled
+		// passes stay in the list, so checkpoints written after them by
+		// reconstruct are found.
+		vector<string> passes;
+		passes.push_back(CHECKPOINT_STAGE_REMOVE_DANGLING_ARTIFACTS);
+		passes.push_back(CHECKPOINT_STAGE_CLEAN_CONTOURS);
 		if(options.optimizePlanes())
 		{
-			mesh.optimizePlanes(options.getPlaneIterations(),
-					options.getNormalThreshold(),
-					options.getMinPlaneSize(),
-					options.getSmallRegionThreshold(),
-					true);
-
-			mesh.fillHoles(options.getFillHoles());
-			mesh.optimizePlaneIntersections();
-			mesh.restorePlanes(options.getMinPlaneSize());
-
+			passes.push_back(CHECKPOINT_STAGE_OPTIMIZE_PLANES);
+			passes.push_back(CHECKPOINT_STAGE_FILL_HOLES);
+			passes.push_back(CHECKPOINT_STAGE_OPTIMIZE_PLANE_INTERSECTIONS);
+			passes.push_back(CHECKPOINT_STAGE_RESTORE_PLANES);
+			passes.push_back(CHECKPOINT_STAGE_REDUCE_MESH_BY_COLLAPSE);
 		}
 		else
 		{
-			mesh.clusterRegions(options.getNormalThreshold(), options.getMinPlaneSize());
-			mesh.fillHoles(options.getFillHoles());
+			passes.push_back(CHECKPOINT_STAGE_CLUSTER_REGIONS);
+			passes.push_back(CHECKPOINT_STAGE_FILL_HOLES);
+		}
+
+		// Skip all passes up to the one stored in the checkpoint
+		size_t firstPass = 0;
+		if(resume)
+		{
+			vector<string>::iterator it = find(passes.begin(), passes.end(), stage);
+			if(it != passes.end())
+			{
+				firstPass = it - passes.begin() + 1;
+			}
+			else
+			{
+				cout << timestamp << "Checkpoint stage '" << stage << "' is not part of the selected passes. Running all passes." << endl;
+			}
+		}
+
+		// Optimize mesh
+		for(size_t i = firstPass; i < passes.size(); i++)
+		{
+			const string& pass = passes[i];
+			if(pass == CHECKPOINT_STAGE_REMOVE_DANGLING_ARTIFACTS)
+			{
+				if(!options.getDanglingArtifacts())
+				{
+					continue;
+				}
+
+				// Without a checkpoint the artifacts were already removed
+				// from the mesh buffer
+				if(resume)
+				{
+					mesh.removeDanglingArtifacts(options.getDanglingArtifacts());
+				}
+			}
+			else if(pass == CHECKPOINT_STAGE_CLEAN_CONTOURS)
+			{
+				mesh.cleanContours(options.getCleanContourIterations());
+			}
+			else if(pass == CHECKPOINT_STAGE_OPTIMIZE_PLANES)
+			{
+				mesh.optimizePlanes(options.getPlaneIterations(),
+						options.getNormalThreshold(),
+						options.getMinPlaneSize(),
+						options.getSmallRegionThreshold(),
+						true);
+			}
+			else if(pass == CHECKPOINT_STAGE_FILL_HOLES)
+			{
+				mesh.fillHoles(options.getFillHoles());
+			}
+			else if(pass == CHECKPOINT_STAGE_OPTIMIZE_PLANE_INTERSECTIONS)
+			{
+				mesh.optimizePlaneIntersections();
+			}
+			else if(pass == CHECKPOINT_STAGE_RESTORE_PLANES)
+			{
+				mesh.restorePlanes(options.getMinPlaneSize());
+			}
+			else if(pass == CHECKPOINT_STAGE_REDUCE_MESH_BY_COLLAPSE)
+			{
+				if(!options.getNumEdgeCollapses())
+				{
+					continue;
+				}
+
+				QuadricVertexCosts<ColorVertex<float, unsigned char> , Normal<float> > c = QuadricVertexCosts<ColorVertex<float, unsigned char> , Normal<float> >(true);
+				mesh.reduceMeshByCollapse(options.getNumEdgeCollapses(), c);
+			}
+			else if(pass == CHECKPOINT_STAGE_CLUSTER_REGIONS)
+			{
+				mesh.clusterRegions(options.getNormalThreshold(), options.getMinPlaneSize());
+			}
+
+			if(options.writeCheckpoints())
+			{
+				mesh.saveCheckpoint(pass + ".hem", pass);
+			}
 		}
 
 		// Save triangle mesh
@@ -144,6 +232,12 @@ int main(int argc, char** argv)
 			mesh.finalize();
 		}
 
+		if ( options.recalcNormals() )
+		{
+			cout << timestamp << "Recalculating vertex normals." << endl;
+			calcVertexNormals( mesh.meshBuffer() );
+		}
+
 		// Create output model and save to file
 		ModelPtr m( new Model( mesh.meshBuffer() ) );
 
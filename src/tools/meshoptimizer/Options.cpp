@@ -36,20 +36,22 @@ Options::Options(int argc, char** argv) : m_descr("Supported options")
 
 	m_descr.add_options()
 		        ("help", "Produce help message")
-		        ("inputFile", value< vector<string> >(), "Input file name. Supported formats are ASCII (.pts, .xyz) and .ply")
+		        ("inputFile", value< vector<string> >(), "Input file name. Supported formats are ASCII (.pts, .xyz) and .ply. If a checkpoint (.hem) is given, processing is resumed after the stored pass.")
 			    ("optimizePlanes,o", "Shift all triangle vertices of a cluster onto their shared plane")
                 ("clusterPlanes,c", "Cluster planar regions based on normal threshold, do not shift vertices into regression plane.")
 		        ("cleanContours", value<int>(&m_cleanContourIterations)->default_value(0), "Remove noise artifacts from contours. Same values are between 2 and 4")
                 ("planeIterations", value<int>(&m_planeIterations)->default_value(3), "Number of iterations for plane optimization")
                 ("fillHoles,f", value<int>(&m_fillHoles)->default_value(30), "Maximum size for hole filling")
                 ("rda", value<int>(&m_rda)->default_value(0), "Remove dangling artifacts, i.e. remove the n smallest not connected surfaces")
+                ("ecc", value<int>(&m_numEdgeCollapses)->default_value(0), "Edge collapse count. Number of edges to collapse for mesh reduction after plane optimization.")
 		        ("pnt", value<float>(&m_planeNormalThreshold)->default_value(0.85), "(Plane Normal Threshold) Normal threshold for plane optimization. Default 0.85 equals about 3 degrees.")
 		        ("smallRegionThreshold", value<int>(&m_smallRegionThreshold)->default_value(0), "Threshold for small region removal. If 0 nothing will be deleted.")
      		    ("mp", value<int>(&m_minPlaneSize)->default_value(7), "Minimum value for plane optimzation")
 		        ("retesselate,t", "Retesselate regions that are in a regression plane. Implies --optimizePlanes.")
 		        ("lft", value<float>(&m_lineFusionThreshold)->default_value(0.01), "(Line Fusion Threshold) Threshold for fusing line segments while tesselating.")		        ("classifier", value<string>(&m_classifier)->default_value("PlaneSimpsons"),"Classfier object used to color the mesh.")
 		        ("depth", value<int>(&m_depth)->default_value(100), "Maximum recursion depth for region growing.")
-		        ("recalcNormals,r", "Always estimate normals, even if given in .ply file.")
+		        ("recalcNormals,r", "Recalculate area weighted vertex normals from the optimized triangles.")
+		        ("checkpoint", "Write a checkpoint of the mesh (<pass>.hem) after every post-processing pass.")
 		        ("threads", value<int>(&m_numThreads)->default_value( lvr::OpenMPConfig::getNumThreads() ), "Number of threads")
 		        ;
 
@@ -143,6 +145,16 @@ bool Options::retesselate() const
     return m_variables.count("retesselate");
 }
 
+bool Options::recalcNormals() const
+{
+    return m_variables.count("recalcNormals");
+}
+
+bool Options::writeCheckpoints() const
+{
+    return m_variables.count("checkpoint");
+}
+
 
 float Options::getNormalThreshold() const
 {
@@ -160,6 +172,11 @@ int   Options::getCleanContourIterations() const
 }
 
 
+int Options::getNumEdgeCollapses() const
+{
+	return m_variables["ecc"].as<int>();
+}
+
 int Options::getDepth() const
 {
 	return m_depth;
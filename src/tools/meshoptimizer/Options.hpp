@@ -82,11 +82,23 @@ public:
 	  */
 	bool	  retesselate() const;
 
+	/**
+	 * @brief  True if the vertex normals of the optimized mesh should
+	 *         be recalculated from the final triangles.
+	 */
+	bool	  recalcNormals() const;
+
 	/**
 	 * @brief  True if region clustering without plane optimization is required.
 	 */
 	bool 	clusterPlanes() const;
 
+	/**
+	 * @brief  True if a checkpoint should be written after every
+	 *         post-processing pass
+	 */
+	bool 	writeCheckpoints() const;
+
 	/**
 	 * @brief	Returns the output file name
 	 */
@@ -129,6 +141,11 @@ public:
 	 */
 	int   getDanglingArtifacts() const;
 
+	/**
+	 * @brief 	Number of edge collapses after plane optimization
+	 */
+	int   getNumEdgeCollapses() const;
+
 	/**
 	 * @brief   Returns the region threshold for hole filling
 	 */
@@ -180,6 +197,9 @@ private:
 	/// Number of dangling artifacts to remove
 	int                             m_rda;
 
+	/// Number of edges to collapse
+	int                             m_numEdgeCollapses;
+
 	/// Threshold for hole filling
 	int                             m_fillHoles;
 
@@ -239,11 +259,21 @@ inline ostream& operator<<(ostream& os, const Options &o)
 		cout << "##### Region threshold\t\t: " << o.getSmallRegionThreshold() << endl;
 	}
 
+	if(o.getNumEdgeCollapses())
+	{
+	    cout << "##### Number of edge collapses\t: " << o.getNumEdgeCollapses() << endl;
+	}
+
 	if(o.getDepth())
 	{
 	    cout << "##### Recursion depth \t\t: " << o.getDepth() << endl;
 	}
 
+	if(o.writeCheckpoints())
+	{
+	    cout << "##### Write checkpoints \t: YES" << endl;
+	}
+
 	return os;
 }
 
@@ -347,7 +347,7 @@ private:
     /// Whether or not the mesh should be retesselated while being finalized
 	bool						   m_generateTextures;
 
-    /// Whether or not the classifier shall dump meta data to a file 'clusters.clu'
+    /// Whether or not the classifier shall dump the labeled mesh to a file 'clusters.lbm'
 	bool						   m_writeClassificationResult;
 
 	/// The used point cloud manager
@@ -25,6 +25,7 @@
 #include <lvr/io/Progress.hpp>
 #include <lvr/io/DataStruct.hpp>
 #include <lvr/io/ModelFactory.hpp>
+#include <lvr/io/IOUtils.hpp>
 #include <lvr/geometry/Matrix4.hpp>
 #include <lvr/geometry/Normal.hpp>
 #include <lvr/reconstruction/SearchTree.hpp>
@@ -230,7 +231,7 @@ int main(int argc, char** argv)
 
 	        cout << timestamp << "Reducing number of points to " << target << ". Writing every " << skipPoints << "th point." << endl;
 	        size_t pointsRead = 0;
-	        size_t counter;
+	        size_t counter = 0;
 	        for(int i = firstScan; i <= lastScan; i++)
 	        {
 	            char scanFileName[100];
@@ -279,30 +280,32 @@ int main(int argc, char** argv)
 	            // Open scan file
 	            ifstream in(scanFilePath.c_str());
 	            float x, y, z, nx, ny, nz;
+	            size_t firstPoint = pointsRead;
 	            do
 	            {
 	                in >> x >> y >> z >> nx >> ny >> nz;
 	                if(counter % skipPoints == 0)
 	                {
-	                    // Transform normal according to pose
-	                    Normal<float> normal(nx, ny, nz);
-	                    Vertex<float> point(x, y, z);
-	                    normal = transform * normal;
-	                    point = transform * point;
-
 	                    // Write data into buffer
-	                    points[pointsRead * 3]     = point.x;
-	                    points[pointsRead * 3 + 1] = point.y;
-	                    points[pointsRead * 3 + 2] = point.z;
+	                    points[pointsRead * 3]     = x;
+	                    points[pointsRead * 3 + 1] = y;
+	                    points[pointsRead * 3 + 2] = z;
 
-	                    normals[pointsRead * 3]     = normal.x;
-	                    normals[pointsRead * 3 + 1] = normal.y;
-	                    normals[pointsRead * 3 + 2] = normal.z;
+	                    normals[pointsRead * 3]     = nx;
+	                    normals[pointsRead * 3 + 1] = ny;
+	                    normals[pointsRead * 3 + 2] = nz;
 	                    pointsRead++;
 	                }
 	                counter++;
 	            } while(in.good() && pointsRead < numPointsToRead);
 
+	            // Transform points and normals of this scan according to pose
+	            float* scanPoints  = points.get()  + 3 * firstPoint;
+	            float* scanNormals = normals.get() + 3 * firstPoint;
+	            size_t scanSize    = pointsRead - firstPoint;
+	            transformAndReducePointArray(scanPoints, scanSize, scanPoints, transform.getData());
+	            transformAndReducePointArray(scanNormals, scanSize, scanNormals, transform.getData(), 1, false);
+
 	        }
 	        cout << timestamp << "Read " << pointsRead << " from " << numPointsToRead << " requested." << endl;
 
@@ -0,0 +1,272 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * Main.cpp
+ *
+ *  Microbenchmark for the vertex error quadrics of the half edge mesh.
+ *  Compares quadric cost evaluation with the stored quadrics against
+ *  recomputing them from the adjacent faces, then collapses edges and
+ *  checks that the incrementally updated quadrics did not drift.
+ *
+ *  Usage: lvr_quadric_bench [gridSize] [rounds]
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/geometry/HalfEdgeMesh.hpp>
+#include <lvr/geometry/QuadricVertexCosts.hpp>
+#include <lvr/geometry/ColorVertex.hpp>
+#include <lvr/geometry/Normal.hpp>
+#include <lvr/io/Timestamp.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <vector>
+
+using namespace lvr;
+using std::cout;
+using std::endl;
+using std::vector;
+
+typedef ColorVertex<float, unsigned char> cVertex;
+typedef Normal<float> cNormal;
+
+/// Exposes the edge collapse of the half edge mesh
+class BenchMesh : public HalfEdgeMesh<cVertex, cNormal>
+{
+public:
+
+    BenchMesh(MeshBufferPtr buffer) : HalfEdgeMesh<cVertex, cNormal>(buffer) {}
+
+    using HalfEdgeMesh<cVertex, cNormal>::safeCollapseEdge;
+};
+
+typedef BenchMesh::VertexPtr VertexPtr;
+typedef BenchMesh::EdgePtr EdgePtr;
+
+/// Creates a triangulated, wavy height field with n x n vertices
+MeshBufferPtr createHeightField(size_t n)
+{
+    floatArr vertices(new float[3 * n * n]);
+    for(size_t y = 0; y < n; y++)
+    {
+        for(size_t x = 0; x < n; x++)
+        {
+            float* v = &vertices[3 * (y * n + x)];
+            v[0] = x;
+            v[1] = y;
+            v[2] = 2.0f * sin(0.15f * x) * cos(0.1f * y);
+        }
+    }
+
+    size_t numFaces = 2 * (n - 1) * (n - 1);
+    uintArr faces(new unsigned int[3 * numFaces]);
+    unsigned int* f = faces.get();
+    for(size_t y = 0; y + 1 < n; y++)
+    {
+        for(size_t x = 0; x + 1 < n; x++)
+        {
+            unsigned int a = y * n + x;
+            unsigned int b = a + 1;
+            unsigned int c = a + n;
+            unsigned int d = c + 1;
+            *f++ = a; *f++ = b; *f++ = d;
+            *f++ = a; *f++ = d; *f++ = c;
+        }
+    }
+
+    MeshBufferPtr buffer(new MeshBuffer);
+    buffer->setVertexArray(vertices, n * n);
+    buffer->setFaceArray(faces, numFaces);
+    return buffer;
+}
+
+/// The previous cost function that sums up the face planes on every call
+float recomputedCosts(BenchMesh::HVertex& v)
+{
+    Quadric qv;
+    v.calcQuadric(qv, false);
+
+    float mincost = std::numeric_limits<float>::max();
+    for(size_t i = 0; i < v.out.size(); i++)
+    {
+        BenchMesh::HVertex* n = v.out[i]->end();
+        Quadric qn;
+        n->calcQuadric(qn, false);
+        mincost = std::min(mincost, (qv + qn).evaluate(n->m_position));
+    }
+    return mincost;
+}
+
+/// Returns the magnitude of the entries of the given quadric
+float magnitude(const Quadric& q)
+{
+    return fabs(q.m[0]) + fabs(q.m[4]) + fabs(q.m[7]) + fabs(q.m[9]) + 1.0f;
+}
+
+/**
+ * @brief   Counts the vertices whose quadric is negative at the vertex
+ *          or at a point around it. Sums of plane quadrics are positive
+ *          semidefinite, so this only happens if the updates drifted.
+ *          Rounding errors are tolerated relative to the given scales.
+ */
+size_t countIndefinite(BenchMesh& mesh, const vector<char>& removed, const vector<float>& scales)
+{
+    const float offsets[7][3] = {{0, 0, 0}, {1, 0, 0}, {-1, 0, 0}, {0, 1, 0},
+                                 {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+
+    BenchMesh::VertexVector& vertices = mesh.getVertices();
+    size_t indefinite = 0;
+    for(size_t i = 0; i < vertices.size(); i++)
+    {
+        if(removed[i])
+        {
+            continue;
+        }
+
+        const Quadric& q = vertices[i]->m_quadric;
+        for(int j = 0; j < 7; j++)
+        {
+            cVertex p = vertices[i]->m_position + cVertex(offsets[j][0], offsets[j][1], offsets[j][2]);
+            if(q.evaluate(p) < -1e-4f * scales[i])
+            {
+                indefinite++;
+                break;
+            }
+        }
+    }
+    return indefinite;
+}
+
+int main(int argc, char** argv)
+{
+    size_t gridSize = argc > 1 ? atoi(argv[1]) : 1000;
+    int rounds      = argc > 2 ? atoi(argv[2]) : 5;
+
+    BenchMesh mesh(createHeightField(gridSize));
+    BenchMesh::VertexVector& vertices = mesh.getVertices();
+    cout << timestamp << "Mesh with " << vertices.size() << " vertices and "
+         << mesh.getFaces().size() << " faces" << endl;
+
+    double start = timestamp.getCurrentTimeinS();
+    mesh.calcQuadrics();
+    cout << timestamp << "calcQuadrics: " << timestamp.getCurrentTimeinS() - start << " s" << endl;
+
+    // Cost evaluation with the stored quadrics
+    QuadricVertexCosts<cVertex, cNormal> costs(false);
+    double sum = 0;
+    start = timestamp.getCurrentTimeinS();
+    for(int r = 0; r < rounds; r++)
+    {
+        for(size_t i = 0; i < vertices.size(); i++)
+        {
+            sum += costs(*vertices[i]);
+        }
+    }
+    double stored = timestamp.getCurrentTimeinS() - start;
+
+    // Cost evaluation with recomputed quadrics
+    double recomputedSum = 0;
+    start = timestamp.getCurrentTimeinS();
+    for(int r = 0; r < rounds; r++)
+    {
+        for(size_t i = 0; i < vertices.size(); i++)
+        {
+            recomputedSum += recomputedCosts(*vertices[i]);
+        }
+    }
+    double recomputed = timestamp.getCurrentTimeinS() - start;
+
+    cout << timestamp << rounds << " x " << vertices.size() << " cost evaluations: "
+         << stored << " s stored, " << recomputed << " s recomputed (speedup "
+         << recomputed / std::max(stored, 1e-9) << ")" << endl;
+    cout << timestamp << "Cost sums: " << sum << " stored, " << recomputedSum << " recomputed" << endl;
+
+    // Collapse the shortest edges of every fourth interior vertex. The
+    // surviving vertices are moved, so the faces around them change
+    // their planes after their quadrics were added.
+    vector<char> removed(vertices.size(), 0);
+    std::map<VertexPtr, size_t> index;
+    for(size_t i = 0; i < vertices.size(); i++)
+    {
+        index[vertices[i]] = i;
+    }
+
+    size_t collapses = 0;
+    start = timestamp.getCurrentTimeinS();
+    for(size_t i = 0; i < vertices.size(); i += 4)
+    {
+        try
+        {
+            // Keep away from the border of the grid
+            size_t x = i % gridSize;
+            size_t y = i / gridSize;
+            if(removed[i] || x < 2 || y < 2 || x + 2 >= gridSize || y + 2 >= gridSize)
+            {
+                continue;
+            }
+
+            EdgePtr edge = vertices[i]->getShortestEdge();
+            if(!edge || removed[index[edge->start()]])
+            {
+                continue;
+            }
+
+            VertexPtr end = edge->end();
+            if(mesh.safeCollapseEdge(edge))
+            {
+                removed[index[end]] = 1;
+                collapses++;
+            }
+        }
+        catch(HalfEdgeAccessException)
+        {
+            // Skip edges without adjacent faces
+        }
+    }
+    cout << timestamp << collapses << " edge collapses: "
+         << timestamp.getCurrentTimeinS() - start << " s" << endl;
+
+    vector<float> scales(vertices.size());
+    for(size_t i = 0; i < vertices.size(); i++)
+    {
+        scales[i] = magnitude(vertices[i]->m_quadric);
+    }
+
+    size_t indefinite = countIndefinite(mesh, removed, scales);
+    cout << timestamp << indefinite << " vertices with indefinite quadrics" << endl;
+
+    // Remove all faces. Afterwards the vertices only keep the planes of
+    // the faces that were removed by the collapses.
+    BenchMesh::FaceVector faces = mesh.getFaces();
+    mesh.deleteFaces(faces);
+    size_t remaining = countIndefinite(mesh, removed, scales);
+    cout << timestamp << remaining << " vertices with indefinite quadrics after removing all faces" << endl;
+    indefinite += remaining;
+
+    bool ok = mesh.hasQuadrics() && indefinite == 0 && fabs(sum - recomputedSum) <= 1e-3 * fabs(sum) + 1e-3;
+    cout << timestamp << (ok ? "OK" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,308 @@
+/* Copyright (C) 2011 Uni Osnabrück
+ * This file is part of the LAS VEGAS Reconstruction Toolkit,
+ *
+ * LAS VEGAS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * LAS VEGAS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ */
+
+
+/*
+ * Main.cpp
+ *
+ *  Concurrency stress test for the search tree backends and the
+ *  PointsetSurfaceQuery facade. Normals and queries are evaluated
+ *  with one and with several threads, the results have to be equal.
+ *  Backends that are not thread safe are checked to be serialized.
+ *
+ *  Usage: lvr_query_stress [numPoints] [numThreads] [searchTree ...]
+ *
+ *  @date 18.10.2026
+ *  @author agent (agent@local)
+ */
+
+#include <lvr/reconstruction/AdaptiveKSearchSurface.hpp>
+#include <lvr/reconstruction/PointsetSurfaceQuery.hpp>
+#include <lvr/geometry/ColorVertex.hpp>
+#include <lvr/geometry/Normal.hpp>
+#include <lvr/config/lvropenmp.hpp>
+#include <lvr/io/Timestamp.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace lvr;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+typedef ColorVertex<float, unsigned char> cVertex;
+typedef Normal<float> cNormal;
+typedef PointsetSurface<cVertex> psSurface;
+typedef AdaptiveKSearchSurface<cVertex, cNormal> akSurface;
+typedef PointsetSurfaceQuery<cVertex> SurfaceQuery;
+
+/**
+ * @brief   Search tree wrapper that reports not to be thread safe and
+ *          counts how often two threads were inside a query at once.
+ */
+class SerializationCheck : public SearchTree<cVertex>
+{
+public:
+
+    SerializationCheck(SearchTree<cVertex>::Ptr tree)
+        : m_tree(tree), m_inside(0), m_overlaps(0) {}
+
+    virtual void kSearch(coord<float>& qp, int k, vector<int>& indices, vector<float>& distances)
+    {
+        enter();
+        m_tree->kSearch(qp, k, indices, distances);
+        leave();
+    }
+
+    virtual void kSearch(cVertex qp, int k, vector<cVertex>& neighbors)
+    {
+        enter();
+        m_tree->kSearch(qp, k, neighbors);
+        leave();
+    }
+
+    virtual void radiusSearch(float qp[3], float r, vector<int>& indices)                { m_tree->radiusSearch(qp, r, indices); }
+    virtual void radiusSearch(cVertex& qp, float r, vector<int>& indices)                { m_tree->radiusSearch(qp, r, indices); }
+    virtual void radiusSearch(const cVertex& qp, float r, vector<int>& indices)          { m_tree->radiusSearch(qp, r, indices); }
+    virtual void radiusSearch(coord<float>& qp, float r, vector<int>& indices)           { m_tree->radiusSearch(qp, r, indices); }
+    virtual void radiusSearch(const coord<float>& qp, float r, vector<int>& indices)     { m_tree->radiusSearch(qp, r, indices); }
+
+    virtual bool isThreadSafe() const { return false; }
+
+    int overlaps() const { return m_overlaps; }
+
+private:
+
+    void enter()
+    {
+        if(m_inside++)
+        {
+            m_overlaps++;
+        }
+    }
+
+    void leave()
+    {
+        m_inside--;
+    }
+
+    SearchTree<cVertex>::Ptr    m_tree;
+    std::atomic<int>            m_inside;
+    std::atomic<int>            m_overlaps;
+};
+
+/// Creates a noisy unit sphere
+PointBufferPtr createSphere(size_t n)
+{
+    std::mt19937 generator(1);
+    std::normal_distribution<float> gauss;
+
+    floatArr points(new float[3 * n]);
+    for(size_t i = 0; i < n; i++)
+    {
+        float x = gauss(generator);
+        float y = gauss(generator);
+        float z = gauss(generator);
+        float r = (1.0f + 0.01f * gauss(generator)) / sqrt(x * x + y * y + z * z);
+        points[3 * i]     = x * r;
+        points[3 * i + 1] = y * r;
+        points[3 * i + 2] = z * r;
+    }
+
+    PointBufferPtr buffer(new PointBuffer);
+    buffer->setPointArray(points, n);
+    return buffer;
+}
+
+/// Creates a surface and estimates its normals with the given number of threads
+psSurface::Ptr createSurface(string tree, size_t numPoints, int numThreads)
+{
+    OpenMPConfig::setNumThreads(numThreads);
+    psSurface::Ptr surface(new akSurface(createSphere(numPoints), tree, 10, 10, 10));
+    surface->setKd(10);
+    surface->setKi(10);
+    surface->setKn(10);
+    surface->calculateSurfaceNormals();
+    return surface;
+}
+
+/// Compares the estimated normals of two surfaces
+size_t compareNormals(psSurface::Ptr a, psSurface::Ptr b)
+{
+    size_t n = 0;
+    size_t m = 0;
+    floatArr na = a->pointBuffer()->getPointNormalArray(n);
+    floatArr nb = b->pointBuffer()->getPointNormalArray(m);
+    if(n != m)
+    {
+        return std::max(n, m);
+    }
+
+    size_t mismatches = 0;
+    for(size_t i = 0; i < 3 * n; i++)
+    {
+        if(na[i] != nb[i])
+        {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/// Evaluates the surface at random positions with one and with several threads
+size_t compareQueries(psSurface::Ptr surface, int numThreads)
+{
+    const int numQueries = 20000;
+    const int k = 8;
+
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> uniform(-1.2f, 1.2f);
+    vector<cVertex> positions(numQueries);
+    for(int i = 0; i < numQueries; i++)
+    {
+        positions[i] = cVertex(uniform(generator), uniform(generator), uniform(generator));
+    }
+
+    // Sequential reference
+    vector<float> projected(numQueries);
+    vector<float> euklidean(numQueries);
+    vector<cVertex> normals(numQueries);
+    vector<vector<int> > neighbors(numQueries);
+    for(int i = 0; i < numQueries; i++)
+    {
+        surface->distance(positions[i], projected[i], euklidean[i]);
+        normals[i] = surface->getInterpolatedNormal(positions[i]);
+        surface->searchTree()->kSearch(positions[i], k, neighbors[i]);
+    }
+
+    SurfaceQuery query(surface);
+    OpenMPConfig::setNumThreads(numThreads);
+
+    long mismatches = 0;
+    for(int round = 0; round < 3; round++)
+    {
+        #pragma omp parallel reduction(+:mismatches)
+        {
+            SurfaceQuery::Context ctx;
+
+            #pragma omp for schedule(dynamic, 97)
+            for(int i = 0; i < numQueries; i++)
+            {
+                float p, e;
+                query.distance(positions[i], p, e, ctx);
+                if(p != projected[i] || e != euklidean[i])
+                {
+                    mismatches++;
+                }
+
+                cVertex n = query.interpolatedNormal(positions[i], ctx);
+                if(n[0] != normals[i][0] || n[1] != normals[i][1] || n[2] != normals[i][2])
+                {
+                    mismatches++;
+                }
+
+                query.kSearch(positions[i], k, ctx);
+                if(ctx.indices != neighbors[i])
+                {
+                    mismatches++;
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+/// Checks that searches of a tree that is not thread safe are serialized
+int checkSerialization(psSurface::Ptr surface, int numThreads)
+{
+    boost::shared_ptr<SerializationCheck> check(new SerializationCheck(surface->searchTree()));
+    SearchTree<cVertex>::Ptr tree = check;
+    SurfaceQuery query(tree);
+
+    OpenMPConfig::setNumThreads(numThreads);
+
+    #pragma omp parallel
+    {
+        SurfaceQuery::Context ctx;
+
+        #pragma omp for schedule(dynamic, 13)
+        for(int i = 0; i < 50000; i++)
+        {
+            float x = (i % 97) / 48.0f - 1.0f;
+            query.kSearch(cVertex(x, -x, 0.5f * x), 10, ctx);
+            query.kSearchPoints(cVertex(-x, x, 0.5f * x), 2, ctx);
+        }
+    }
+    return check->overlaps();
+}
+
+int main(int argc, char** argv)
+{
+    size_t numPoints = argc > 1 ? atoi(argv[1]) : 20000;
+    int numThreads   = argc > 2 ? atoi(argv[2]) : std::max(4, OpenMPConfig::getNumThreads());
+
+    vector<string> trees;
+    for(int i = 3; i < argc; i++)
+    {
+        trees.push_back(argv[i]);
+    }
+
+    if(trees.empty())
+    {
+        trees.push_back("flann");
+        trees.push_back("nanoflann");
+#ifdef LVR_USE_STANN
+        trees.push_back("stann");
+#endif
+#ifdef LVR_USE_PCL
+        trees.push_back("pcl");
+#endif
+#ifdef LVR_USE_NABO
+        trees.push_back("nabo");
+#endif
+    }
+
+    size_t failures = 0;
+    for(size_t i = 0; i < trees.size(); i++)
+    {
+        psSurface::Ptr reference = createSurface(trees[i], numPoints, 1);
+        psSurface::Ptr surface = createSurface(trees[i], numPoints, numThreads);
+
+        size_t normalMismatches = compareNormals(reference, surface);
+        size_t queryMismatches = compareQueries(surface, numThreads);
+        int overlaps = checkSerialization(surface, numThreads);
+
+        cout << timestamp << trees[i]
+             << (surface->searchTree()->isThreadSafe() ? " (concurrent)" : " (serialized)")
+             << ": " << normalMismatches << " normal mismatches, "
+             << queryMismatches << " query mismatches, "
+             << overlaps << " overlapping serialized searches" << endl;
+
+        failures += normalMismatches + queryMismatches + overlaps;
+    }
+
+    cout << timestamp << (failures ? "FAILED" : "OK") << endl;
+    return failures ? 1 : 0;
+}
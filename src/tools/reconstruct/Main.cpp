@@ -146,8 +146,13 @@
 #include <lvr/reconstruction/FastReconstruction.hpp>
 #include <lvr/reconstruction/PointsetGrid.hpp>
 #include <lvr/reconstruction/FastBox.hpp>
+#include <lvr/reconstruction/TetraederBox.hpp>
+#include <lvr/reconstruction/PoissonReconstruction.hpp>
+#include <lvr/reconstruction/DualOctreeReconstruction.hpp>
+#include <lvr/reconstruction/IncrementalReconstruction.hpp>
 
 #include <lvr/io/PLYIO.hpp>
+#include <lvr/io/MeshCheckpointIO.hpp>
 #include <lvr/config/lvropenmp.hpp>
 #include <lvr/geometry/Matrix4.hpp>
 #include <lvr/geometry/HalfEdgeMesh.hpp>
@@ -165,6 +170,7 @@
 
 
 #include <iostream>
+#include <fstream>
 
 
 using namespace lvr;
@@ -215,8 +221,41 @@ int main(int argc, char** argv)
 		string pcm_name = options.getPCM();
 		psSurface::Ptr surface;
 
+		// Integrate the points into the state of previous runs
+		IncrementalReconstruction<ColorVertex<float, unsigned char>, Normal<float> >* incremental = 0;
+		if(options.getIncrementalState() != "")
+		{
+			if(options.decompositionSet() && options.getDecomposition() != "MC")
+			{
+				cout << timestamp << "Incremental reconstruction only supports MC decomposition." << endl;
+				return -1;
+			}
+
+			string stateFile = options.getIncrementalState();
+			incremental = new IncrementalReconstruction<ColorVertex<float, unsigned char>, Normal<float> >(
+					options.getVoxelsize(), pcm_name,
+					options.getKn(),
+					options.getKi(),
+					options.getKd(),
+					options.useRansac(),
+					options.getScanPoseFile());
+
+			if(ifstream(stateFile.c_str()).good() && !incremental->loadState(stateFile))
+			{
+				return -1;
+			}
+
+			incremental->addPoints(p_loader);
+			incremental->saveState(stateFile);
+			surface = incremental->getSurface();
+		}
+
 		// Create point set surface object
-		if(pcm_name == "PCL")
+		if(incremental)
+		{
+			// Surface was created by the incremental reconstruction
+		}
+		else if(pcm_name == "PCL")
 		{
 #ifdef LVR_USE_PCL
 			surface = psSurface::Ptr( new pclSurface(p_loader));
@@ -225,7 +264,7 @@ int main(int argc, char** argv)
 			exit(-1);
 #endif
 		}
-		else if(pcm_name == "STANN" || pcm_name == "FLANN" || pcm_name == "NABO" || pcm_name == "NANOFLANN")
+		else if(pcm_name == "STANN" || pcm_name == "FLANN" || pcm_name == "NABO" || pcm_name == "NANOFLANN" || pcm_name == "BOCTREE")
 		{
 			akSurface* aks = new akSurface(
 					p_loader, pcm_name,
@@ -242,6 +281,11 @@ int main(int argc, char** argv)
 			{
 				aks->useRansac(true);
 			}
+
+			if(options.orientNormals())
+			{
+				aks->orientNormalsByMST(true);
+			}
 		}
 		else
 		{
@@ -265,7 +309,11 @@ int main(int argc, char** argv)
 		surface->setKn(options.getKn());
 
 		// Calculate normals if necessary
-		if(!surface->pointBuffer()->hasPointNormals()
+		if(incremental)
+		{
+			cout << timestamp << "Using incrementally updated normals." << endl;
+		}
+		else if(!surface->pointBuffer()->hasPointNormals()
 				|| (surface->pointBuffer()->hasPointNormals() && options.recalcNormals()))
 		{
 		    Timestamp ts;
@@ -380,15 +428,24 @@ int main(int argc, char** argv)
 		string decomposition = options.getDecomposition();
 
 		// Fail safe check
-		if(decomposition != "MC" && decomposition != "PMC" && decomposition != "SF" )
+		if(decomposition != "MC" && decomposition != "MT" && decomposition != "PMC" && decomposition != "SF" && decomposition != "SPR" && decomposition != "DMC")
 		{
 			cout << "Unsupported decomposition type " << decomposition << ". Defaulting to PMC." << endl;
 			decomposition = "PMC";
 		}
 
-		GridBase* grid;
-		FastReconstructionBase<ColorVertex<float, unsigned char>, Normal<float> >* reconstruction;
-		if(decomposition == "MC")
+		GridBase* grid = 0;
+		FastReconstructionBase<ColorVertex<float, unsigned char>, Normal<float> >* reconstruction = 0;
+		PoissonReconstruction<ColorVertex<float, unsigned char>, Normal<float> >* poisson = 0;
+		if(incremental)
+		{
+			if(options.getIntersections() > 0)
+			{
+				cout << timestamp << "Incremental reconstruction ignores intersections and uses the voxel size." << endl;
+			}
+			reconstruction = incremental;
+		}
+		else if(decomposition == "MC")
 		{
 			grid = new PointsetGrid<ColorVertex<float, unsigned char>, FastBox<ColorVertex<float, unsigned char>, Normal<float> > >(resolution, surface, surface->getBoundingBox(), useVoxelsize, options.extrude());
 			PointsetGrid<ColorVertex<float, unsigned char>, FastBox<ColorVertex<float, unsigned char>, Normal<float> > >* ps_grid = static_cast<PointsetGrid<ColorVertex<float, unsigned char>, FastBox<ColorVertex<float, unsigned char>, Normal<float> > > *>(grid);
@@ -396,6 +453,13 @@ int main(int argc, char** argv)
 			reconstruction = new FastReconstruction<ColorVertex<float, unsigned char> , Normal<float>, FastBox<ColorVertex<float, unsigned char>, Normal<float> >  >(ps_grid);
 
 		}
+		else if(decomposition == "MT")
+		{
+			grid = new PointsetGrid<ColorVertex<float, unsigned char>, TetraederBox<ColorVertex<float, unsigned char>, Normal<float> > >(resolution, surface, surface->getBoundingBox(), useVoxelsize, options.extrude());
+			PointsetGrid<ColorVertex<float, unsigned char>, TetraederBox<ColorVertex<float, unsigned char>, Normal<float> > >* ps_grid = static_cast<PointsetGrid<ColorVertex<float, unsigned char>, TetraederBox<ColorVertex<float, unsigned char>, Normal<float> > > *>(grid);
+			ps_grid->calcDistanceValues();
+			reconstruction = new FastReconstruction<ColorVertex<float, unsigned char> , Normal<float>, TetraederBox<ColorVertex<float, unsigned char>, Normal<float> >  >(ps_grid);
+		}
 		else if(decomposition == "PMC")
 		{
 			BilinearFastBox<ColorVertex<float, unsigned char>, Normal<float> >::m_surface = surface;
@@ -413,25 +477,59 @@ int main(int argc, char** argv)
 			ps_grid->calcDistanceValues();
 			reconstruction = new FastReconstruction<ColorVertex<float, unsigned char> , Normal<float>, SharpBox<ColorVertex<float, unsigned char>, Normal<float> >  >(ps_grid);
 		}
+		else if(decomposition == "SPR")
+		{
+			poisson = new PoissonReconstruction<ColorVertex<float, unsigned char>, Normal<float> >(surface, resolution, useVoxelsize);
+			poisson->setScreeningWeight(options.getScreeningWeight());
+			poisson->setCloseHoles(options.closeHoles());
+		}
+		else if(decomposition == "DMC")
+		{
+			OctreeGrid<ColorVertex<float, unsigned char>, Normal<float> >* octree = new OctreeGrid<ColorVertex<float, unsigned char>, Normal<float> >(
+					resolution, surface, surface->getBoundingBox(), useVoxelsize,
+					options.getOctreeLevels(), options.getOctreeCurvature(), options.getOctreeMinPoints());
+			octree->calcDistanceValues();
+			reconstruction = new DualOctreeReconstruction<ColorVertex<float, unsigned char>, Normal<float> >(octree);
+		}
 
 
 		
 		// Create mesh
-		reconstruction->getMesh(mesh);
+		if(poisson)
+		{
+			poisson->getMesh(mesh);
+			grid = poisson->getGrid();
+		}
+		else
+		{
+			reconstruction->getMesh(mesh);
+		}
 		
 		// Save grid to file
-		if(options.saveGrid())
+		if(options.saveGrid() && grid)
 		{
-			grid->saveGrid("fastgrid.grid");
+			grid->saveGrid("fastgrid.grid", options.compressGrid());
 		}
 
+		// Writes a checkpoint after the given post-processing pass. The
+		// passes can be resumed with the meshoptimizer tool.
+		auto checkpoint = [&](const string& pass)
+		{
+			if(options.writeCheckpoints())
+			{
+				mesh.saveCheckpoint(pass + ".hem", pass);
+			}
+		};
+
 		if(options.getDanglingArtifacts())
  		{
 			mesh.removeDanglingArtifacts(options.getDanglingArtifacts());
+			checkpoint(CHECKPOINT_STAGE_REMOVE_DANGLING_ARTIFACTS);
 		}
 
 		// Optimize mesh
 		mesh.cleanContours(options.getCleanContourIterations());
+		checkpoint(CHECKPOINT_STAGE_CLEAN_CONTOURS);
 		mesh.setClassifier(options.getClassifier());
 		mesh.getClassifier().setMinRegionSize(options.getSmallRegionThreshold());
 
@@ -442,21 +540,28 @@ int main(int argc, char** argv)
 					options.getMinPlaneSize(),
 					options.getSmallRegionThreshold(),
 					true);
+			checkpoint(CHECKPOINT_STAGE_OPTIMIZE_PLANES);
 
 			mesh.fillHoles(options.getFillHoles());
+			checkpoint(CHECKPOINT_STAGE_FILL_HOLES);
 			mesh.optimizePlaneIntersections();
+			checkpoint(CHECKPOINT_STAGE_OPTIMIZE_PLANE_INTERSECTIONS);
 			mesh.restorePlanes(options.getMinPlaneSize());
+			checkpoint(CHECKPOINT_STAGE_RESTORE_PLANES);
 
 			if(options.getNumEdgeCollapses())
 			{
 				QuadricVertexCosts<ColorVertex<float, unsigned char> , Normal<float> > c = QuadricVertexCosts<ColorVertex<float, unsigned char> , Normal<float> >(true);
 				mesh.reduceMeshByCollapse(options.getNumEdgeCollapses(), c);
+				checkpoint(CHECKPOINT_STAGE_REDUCE_MESH_BY_COLLAPSE);
 			}
 		}
 		else if(options.clusterPlanes())
 		{
 			mesh.clusterRegions(options.getNormalThreshold(), options.getMinPlaneSize());
+			checkpoint(CHECKPOINT_STAGE_CLUSTER_REGIONS);
 			mesh.fillHoles(options.getFillHoles());
+			checkpoint(CHECKPOINT_STAGE_FILL_HOLES);
 		}
 
 		// Save triangle mesh
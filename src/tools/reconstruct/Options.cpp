@@ -44,9 +44,9 @@ Options::Options(int argc, char** argv)
 		        ("voxelsize,v", value<float>(&m_voxelsize)->default_value(10), "Voxelsize of grid used for reconstruction.")
 		        ("noExtrusion", "Do not extend grid. Can be used  to avoid artefacts in dense data sets but. Disabling will possibly create additional holes in sparse data sets.")
 		        ("intersections,i", value<int>(&m_intersections)->default_value(-1), "Number of intersections used for reconstruction. If other than -1, voxelsize will calculated automatically.")
-		        ("pcm,p", value<string>(&m_pcm)->default_value("FLANN"), "Point cloud manager used for point handling and normal estimation. Choose from {STANN, PCL, NABO}.")
+		        ("pcm,p", value<string>(&m_pcm)->default_value("FLANN"), "Point cloud manager used for point handling and normal estimation. Choose from {STANN, PCL, NABO, BOCTREE}. BOCTREE searches the octrees of slam6d .oct scans directly.")
                 ("ransac", "Set this flag for RANSAC based normal estimation.")
-		        ("decomposition,d", value<string>(&m_pcm)->default_value("PMC"), "Defines the type of decomposition that is used for the voxels (Standard Marching Cubes (MC), Planar Marching Cubes (PMC), Standard Marching Cubes with sharp feature detection (SF) or Tetraeder (MT) decomposition. Choose from {MC, PMC, MT, SF}")
+		        ("decomposition,d", value<string>(&m_pcm)->default_value("PMC"), "Defines the type of decomposition that is used for the voxels (Standard Marching Cubes (MC), Planar Marching Cubes (PMC), Standard Marching Cubes with sharp feature detection (SF), Tetraeder (MT) decomposition, Screened Poisson Reconstruction (SPR) or Dual Marching Cubes on an adaptive octree (DMC). Choose from {MC, PMC, MT, SF, SPR, DMC}")
 		        ("optimizePlanes,o", "Shift all triangle vertices of a cluster onto their shared plane")
                 ("clusterPlanes,c", "Cluster planar regions based on normal threshold, do not shift vertices into regression plane.")
 		        ("cleanContours", value<int>(&m_cleanContourIterations)->default_value(0), "Remove noise artifacts from contours. Same values are between 2 and 4")
@@ -55,9 +55,10 @@ Options::Options(int argc, char** argv)
                 ("rda", value<int>(&m_rda)->default_value(0), "Remove dangling artifacts, i.e. remove the n smallest not connected surfaces")
 		        ("pnt", value<float>(&m_planeNormalThreshold)->default_value(0.85), "(Plane Normal Threshold) Normal threshold for plane optimization. Default 0.85 equals about 3 degrees.")
 		        ("smallRegionThreshold", value<int>(&m_smallRegionThreshold)->default_value(10), "Threshold for small region removal. If 0 nothing will be deleted.")
-                ("writeClassificationResult,w", "Write classification results to file 'clusters.clu'")
+                ("writeClassificationResult,w", "Write classification results to the labeled mesh file 'clusters.lbm'")
                 ("exportPointNormals,e", "Exports original point cloud data together with normals into a single file called 'pointnormals.ply'")
 		        ("saveGrid,g", "Writes the generated grid to a file called 'fastgrid.grid. The result can be rendered with qviewer.")
+		        ("compressGrid", "Deflate the grid written by --saveGrid. Requires zlib support.")
 		        ("saveOriginalData,s", "Save the original points and the estimated normals together with the reconstruction into one file ('triangle_mesh.ply')")
 		        ("scanPoseFile", value<string>()->default_value(""), "ASCII file containing scan positions that can be used to flip normals")
 		        ("kd", value<int>(&m_kd)->default_value(5), "Number of normals used for distance function evaluation")
@@ -72,9 +73,17 @@ Options::Options(int argc, char** argv)
 		        ("classifier", value<string>(&m_classifier)->default_value("PlaneSimpsons"),"Classfier object used to color the mesh.")
 		        ("depth", value<int>(&m_depth)->default_value(100), "Maximum recursion depth for region growing.")
 		        ("recalcNormals,r", "Always estimate normals, even if given in .ply file.")
+		        ("checkpoint", "Write a checkpoint of the mesh (<pass>.hem) after every post-processing pass. Checkpoints can be resumed with the meshoptimizer.")
+		        ("orientNormals", "Orient the estimated normals consistently along a minimum spanning tree of the kn-nearest neighbor graph.")
 		        ("threads", value<int>(&m_numThreads)->default_value( lvr::OpenMPConfig::getNumThreads() ), "Number of threads")
 		        ("sft", value<float>(&m_sft)->default_value(0.9), "Sharp feature threshold when using sharp feature decomposition")
 		        ("sct", value<float>(&m_sct)->default_value(0.7), "Sharp corner threshold when using sharp feature decomposition")
+		        ("screening", value<float>(&m_screening)->default_value(4.0), "Weight of the screening term when using screened Poisson reconstruction. Higher values fit the surface more closely to the points.")
+		        ("closeHoles", "Close holes of any size when using screened Poisson reconstruction.")
+		        ("octreeLevels", value<int>(&m_octreeLevels)->default_value(3), "Number of octree levels above the voxel size when using DMC decomposition. Leaves with points are at most 2^octreeLevels voxels large.")
+		        ("octreeCurvature", value<float>(&m_octreeCurvature)->default_value(0.02), "Octree leaves whose normals vary more than this threshold (1 - length of the mean normal) are refined when using DMC decomposition.")
+		        ("octreeMinPoints", value<int>(&m_octreeMinPoints)->default_value(10), "Octree leaves with less points are not refined by curvature when using DMC decomposition.")
+		        ("incremental", value<string>(&m_incrementalState)->default_value(""), "Reconstruct incrementally. The grid, normals and mesh of previous runs are loaded from the given state file if it exists, only the parts affected by the new points are updated and the state file is written again. Uses MC decomposition.")
 		        ("ecm", value<string>(&m_ecm)->default_value("QUADRIC"), "Edge collapse method for mesh reduction. Choose from QUADRIC, QUADRIC_TRI, MELAX, SHORTEST")
 				("ecc", value<int>(&m_numEdgeCollapses)->default_value(0), "Edge collapse count. Number of edges to collapse for mesh reduction.")
 		        ("tp", value<string>(&m_texturePack)->default_value(""), "Path to texture pack")
@@ -109,6 +118,36 @@ float Options::getSharpCornerThreshold() const
 	return m_variables["sct"].as<float>();
 }
 
+float Options::getScreeningWeight() const
+{
+	return m_variables["screening"].as<float>();
+}
+
+int Options::getOctreeLevels() const
+{
+	return m_variables["octreeLevels"].as<int>();
+}
+
+float Options::getOctreeCurvature() const
+{
+	return m_variables["octreeCurvature"].as<float>();
+}
+
+int Options::getOctreeMinPoints() const
+{
+	return m_variables["octreeMinPoints"].as<int>();
+}
+
+string Options::getIncrementalState() const
+{
+	return m_variables["incremental"].as<string>();
+}
+
+bool Options::decompositionSet() const
+{
+	return !m_variables["decomposition"].defaulted();
+}
+
 
 int Options::getNumThreads() const
 {
@@ -252,11 +291,31 @@ bool Options::saveGrid() const
     return (m_variables.count("saveGrid"));
 }
 
+bool Options::compressGrid() const
+{
+    return (m_variables.count("compressGrid"));
+}
+
 bool Options::useRansac() const
 {
     return (m_variables.count("ransac"));
 }
 
+bool Options::orientNormals() const
+{
+    return (m_variables.count("orientNormals"));
+}
+
+bool Options::writeCheckpoints() const
+{
+    return (m_variables.count("checkpoint"));
+}
+
+bool Options::closeHoles() const
+{
+    return (m_variables.count("closeHoles"));
+}
+
 bool Options::saveOriginalData() const
 {
     return (m_variables.count("saveOriginalData"));
@@ -101,6 +101,11 @@ public:
      */
     bool    saveGrid() const;
 
+    /**
+     * @brief   Returns true if the saved grid should be compressed
+     */
+    bool    compressGrid() const;
+
     /**
      * @brief   Returns true if the original points should be stored
      *          together with the reconstruction
@@ -130,6 +135,21 @@ public:
      */
     bool    useRansac() const;
 
+    /**
+     * @brief   If true, normals are oriented along a minimum spanning tree
+     */
+    bool    orientNormals() const;
+
+    /**
+     * @brief   If true, a checkpoint is written after every post-processing pass
+     */
+    bool    writeCheckpoints() const;
+
+    /**
+     * @brief   If true, screened Poisson reconstruction closes all holes
+     */
+    bool    closeHoles() const;
+
     /**
      * @brief   True if texture analysis is enabled
      */
@@ -265,6 +285,38 @@ public:
 		 */
 	float getSharpCornerThreshold() const;
 
+	/**
+	 * @brief   Returns the screening weight when using screened Poisson reconstruction
+	 */
+	float getScreeningWeight() const;
+
+	/**
+	 * @brief   Returns the number of octree levels above the voxel size (DMC)
+	 */
+	int getOctreeLevels() const;
+
+	/**
+	 * @brief   Returns the normal variation threshold for octree refinement (DMC)
+	 */
+	float getOctreeCurvature() const;
+
+	/**
+	 * @brief   Returns the minimum number of points for octree refinement (DMC)
+	 */
+	int getOctreeMinPoints() const;
+
+	/**
+	 * @brief   Returns the state file for incremental reconstruction
+	 *          or an empty string
+	 */
+	string getIncrementalState() const;
+
+	/**
+	 * @brief   Returns true if a decomposition type was given on the
+	 *          command line
+	 */
+	bool decompositionSet() const;
+
     /**
      * @brief   Returns the fusion threshold for tesselation
      */
@@ -343,7 +395,7 @@ private:
     /// Whether or not the mesh should be retesselated while being finalized
 	bool						   m_generateTextures;
 
-    /// Whether or not the classifier shall dump meta data to a file 'clusters.clu'
+    /// Whether or not the classifier shall dump the labeled mesh to a file 'clusters.lbm'
 	bool						   m_writeClassificationResult;
 
 	/// The used point cloud manager
@@ -384,6 +436,21 @@ private:
 	/// Sharp corner threshold when using sharp feature decomposition
 	float 							m_sct;
 
+	/// Screening weight when using screened Poisson reconstruction
+	float 							m_screening;
+
+	/// Number of octree levels above the voxel size (DMC)
+	int 							m_octreeLevels;
+
+	/// Normal variation threshold for octree refinement (DMC)
+	float 							m_octreeCurvature;
+
+	/// Minimum number of points for octree refinement (DMC)
+	int 							m_octreeMinPoints;
+
+	/// State file for incremental reconstruction
+	string 							m_incrementalState;
+
 	/// Name of the classifier object to color the mesh
 	string							m_classifier;
 
@@ -455,6 +522,11 @@ inline ostream& operator<<(ostream& os, const Options &o)
 	    cout << "##### Use RANSAC\t\t: NO" << endl;
 	}
 
+	if(o.orientNormals())
+	{
+	    cout << "##### Orient normals (MST)\t: YES" << endl;
+	}
+
 	cout << "##### Voxel decomposition: \t: " << o.getDecomposition()   << endl;
 	cout << "##### Classifier:\t\t: "         << o.getClassifier()      << endl;
 	if(o.writeClassificationResult())
@@ -473,6 +545,24 @@ inline ostream& operator<<(ostream& os, const Options &o)
 		cout << "##### Sharp feature threshold \t: " << o.getSharpFeatureThreshold() << endl;
 		cout << "##### Sharp corner threshold \t: " << o.getSharpCornerThreshold() << endl;
 	}
+	if(o.getDecomposition() == "DMC")
+	{
+		cout << "##### Octree levels \t\t: " << o.getOctreeLevels() << endl;
+		cout << "##### Octree curvature \t\t: " << o.getOctreeCurvature() << endl;
+		cout << "##### Octree min. points \t: " << o.getOctreeMinPoints() << endl;
+	}
+	if(o.getIncrementalState() != "")
+	{
+		cout << "##### Incremental state \t: " << o.getIncrementalState() << endl;
+	}
+	if(o.getDecomposition() == "SPR")
+	{
+		cout << "##### Screening weight \t\t: " << o.getScreeningWeight() << endl;
+		if(o.closeHoles())
+		{
+			cout << "##### Close holes \t\t: YES" << endl;
+		}
+	}
 	if(o.retesselate())
 	{
 		cout << "##### Retesselate \t\t: YES"     << endl;
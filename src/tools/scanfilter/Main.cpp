@@ -21,9 +21,7 @@
 
 #include <lvr/io/Timestamp.hpp>
 #include <lvr/io/ModelFactory.hpp>
-#ifdef LVR_USE_PCL
-#include <lvr/reconstruction/PCLFiltering.hpp>
-#endif
+#include <lvr/reconstruction/PointCloudFiltering.hpp>
 
 
 #include <iostream>
@@ -55,29 +53,27 @@ int main(int argc, char** argv)
 			if(m->m_pointCloud)
 			{
 
-#ifdef LVR_USE_PCL
-				PCLFiltering filter(m->m_pointCloud);
+				PointCloudFiltering filter(m->m_pointCloud, options.searchTree());
 
 				// Apply filters
 				if(options.removeOutliers())
 				{
-					filter.applyOutlierRemoval(options. sorMeanK(), options.sorDevThreshold());
+					filter.applyOutlierRemoval(options.sorMeanK(), options.sorDevThreshold());
 				}
 
+				if(options.rorRadius() > 0)
+				{
+					filter.applyRadiusOutlierRemoval(options.rorRadius(), options.rorMinNeighbors());
+				}
 
 				if(options.mlsDistance() > 0)
 				{
 					filter.applyMLSProjection(options.mlsDistance());
 				}
 
-				PointBufferPtr pb( filter.getPointBuffer() );
-				ModelPtr out_model( new Model( pb ) );
+				ModelPtr out_model( new Model( filter.getPointBuffer() ) );
 
 				ModelFactory::saveModel(out_model, options.outputFile());
-#else 
-				cout << timestamp << "Can't create a PCL Filter without PCL installed." << endl;
-				exit(-1);
-#endif
 			}
 		}
 		else
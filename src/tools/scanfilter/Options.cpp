@@ -42,6 +42,9 @@ Options::Options(int argc, char** argv) : m_descr("Supported options")
 	    ("mlsDistance,m", value<float>()->default_value(0), "Max distance for MLS reconstruction.")
 	    ("sorThresh,t", value<float>()->default_value(1.0), "Std. deviation threshold for outlier removal.")
 	    ("sorMeank,k", value<int>()->default_value(50), "k value mean calculation for outlier removal.")
+	    ("rorRadius", value<float>()->default_value(0), "Remove points with less than rorMinNeighbors neighbors within this radius (0 = off).")
+	    ("rorMinNeighbors", value<int>()->default_value(5), "Minimum number of neighbors for radius outlier removal.")
+	    ("searchTree", value<string>()->default_value("nanoflann"), "Search tree backend for neighbor queries (flann, nanoflann, stann, nabo or pcl).")
 		;
 
 	m_pdescr.add("inputFile", -1);
@@ -71,6 +74,24 @@ float Options::sorDevThreshold() const
 }
 
 
+float Options::rorRadius() const
+{
+    return (m_variables["rorRadius"].as<float>());
+}
+
+
+int Options::rorMinNeighbors() const
+{
+    return (m_variables["rorMinNeighbors"].as<int>());
+}
+
+
+string Options::searchTree() const
+{
+    return (m_variables["searchTree"].as<string>());
+}
+
+
 bool  Options::removeOutliers() const
 {
     return (m_variables.count("removeOutliers"));
@@ -74,6 +74,22 @@ public:
 	float   sorDevThreshold() const;
 
 
+	/**
+	 * @brief   Returns the radius for radius outlier removal
+	 */
+	float   rorRadius() const;
+
+	/**
+	 * @brief   Returns the minimum number of neighbors for radius
+	 *          outlier removal
+	 */
+	int     rorMinNeighbors() const;
+
+	/**
+	 * @brief   Returns the name of the used search tree backend
+	 */
+	string  searchTree() const;
+
 	/**
 	 * @brief   True if outlier removel is turned on
 	 */
@@ -140,6 +156,13 @@ inline ostream& operator<<(ostream& os, const Options &o)
 	{
 	    cout << "##### Apply outlier removal\t: NO" << endl;
 	}
+	if( o.rorRadius() > 0)
+	{
+	    cout << "##### Radius outlier removal\t: YES" << endl;
+	    cout << "##### Radius\t\t\t: " << o.rorRadius() << endl;
+	    cout << "##### Min. neighbors\t\t: " << o.rorMinNeighbors() << endl;
+	}
+	cout << "##### Search tree\t\t: " << o.searchTree() << endl;
 	return os;
 }
 
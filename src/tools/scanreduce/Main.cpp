@@ -20,8 +20,11 @@
  #include "Options.hpp"
 
 #include <lvr/io/UosIO.hpp>
+#include <lvr/reconstruction/VoxelGridReduction.hpp>
+#include <lvr/reconstruction/PoissonDiskReduction.hpp>
 
 #include <iostream>
+#include <stdexcept>
 
 using namespace lvr;
 
@@ -45,7 +48,26 @@ int main(int argc, char** argv)
     io.setLastScan(options.lastScan());
     io.saveRemission(options.saveRemission());
     io.saveRemissionAsColor(options.convertRemission());
-    io.reduce(options.directory(), options.outputFile(), options.reduction());
+
+    if(options.poissonRadius() > 0)
+    {
+        io.setReductionEngine(PointCloudReductionPtr(new PoissonDiskReduction(options.poissonRadius())));
+    }
+    else if(options.voxelSize() > 0)
+    {
+        io.setReductionEngine(PointCloudReductionPtr(new VoxelGridReduction(options.voxelSize(),
+                options.closestToCenter() ? VoxelGridReduction::ClosestToCenter : VoxelGridReduction::Centroid)));
+    }
+
+    try
+    {
+        io.reduce(options.directory(), options.outputFile(), options.reduction());
+    }
+    catch(std::range_error& e)
+    {
+        ::std::cout << e.what() << ::std::endl;
+        return 1;
+    }
 
 	return 0;
 }
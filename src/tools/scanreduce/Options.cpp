@@ -41,6 +41,9 @@ Options::Options(int argc, char** argv) : m_descr("Supported options")
 		("output,o", value<string>()->default_value("out.txt"), "Name of the generated output file.")
 	    ("inputFile", value< vector<string> >(), "Directory containing scans in uos format.")
 	    ("saveRemission,r", "Save remission values")
+		("voxelSize,v", value<float>(&m_voxelSize)->default_value(0), "If > 0, keep only one point per voxel of the given size.")
+		("closestToCenter", "Use the point closest to the voxel center instead of the centroid in voxel grid reduction.")
+		("poissonRadius,p", value<float>(&m_poissonRadius)->default_value(0), "If > 0, use Poisson disk subsampling with the given minimum point distance.")
 		;
 
 	m_pdescr.add("inputFile", -1);
@@ -82,6 +85,21 @@ int Options::reduction() const
     return m_variables["reduction"].as<int>();
 }
 
+float Options::voxelSize() const
+{
+    return m_variables["voxelSize"].as<float>();
+}
+
+bool Options::closestToCenter() const
+{
+    return m_variables.count("closestToCenter");
+}
+
+float Options::poissonRadius() const
+{
+    return m_variables["poissonRadius"].as<float>();
+}
+
 string Options::directory() const
 {
     return (m_variables["inputFile"].as< vector<string> >())[0];
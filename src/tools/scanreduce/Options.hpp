@@ -64,6 +64,9 @@ public:
 	int     firstScan() const;
 	int     lastScan() const;
 	int     reduction() const;
+	float   voxelSize() const;
+	bool    closestToCenter() const;
+	float   poissonRadius() const;
 	string  directory() const;
 	string  outputFile() const;
 	bool    convertRemission() const;
@@ -76,6 +79,8 @@ private:
 	int m_first;
 	int m_last;
 	int m_reduction;
+	float m_voxelSize;
+	float m_poissonRadius;
 	string m_outputFile;
 	bool m_convertRemission;
 
@@ -100,6 +105,14 @@ inline ostream& operator<<(ostream& os, const Options &o)
 	cout << "##### First scan to read \t: " << o.firstScan() << endl;
 	cout << "##### Last scan to read \t: " << o.lastScan() << endl;
 	cout << "##### Reduction \t\t: " << o.reduction() << endl;
+	if(o.voxelSize() > 0)
+	{
+		cout << "##### Voxel size \t\t: " << o.voxelSize() << endl;
+	}
+	if(o.poissonRadius() > 0)
+	{
+		cout << "##### Poisson radius \t\t: " << o.poissonRadius() << endl;
+	}
 	cout << "##### Save Remission:\t\t" << o.saveRemission() << endl;
 	cout << "##### Convert Remission: " << o.convertRemission() << endl;
 	return os;
@@ -30,6 +30,7 @@
 #include <lvr/io/Model.hpp>
 #include <lvr/io/ModelFactory.hpp>
 #include <lvr/io/Timestamp.hpp>
+#include <lvr/io/IOUtils.hpp>
 #include <iostream>
 #include <cmath>
 
@@ -139,6 +140,14 @@ int main(int argc, char **argv)
       mat = Matrix4<float>(Vertex3f(x, y, z), Vertex3f(r1, r2, r3));
     }
 
+    // Apply the scaling after the transformation. Both are
+    // concatenated into a single matrix.
+    Matrix4<float> scale;
+    scale.set(0,  options.anyScaleX() ? options.getScaleX() : 1.0f);
+    scale.set(5,  options.anyScaleY() ? options.getScaleY() : 1.0f);
+    scale.set(10, options.anyScaleZ() ? options.getScaleZ() : 1.0f);
+    mat = scale * mat;
+
     // Get point buffer
     if(model->m_pointCloud)
     {
@@ -146,17 +155,9 @@ int main(int argc, char **argv)
 
       cout << timestamp << "Using points" << endl;
       did_anything = true;
-      coord3fArr points = p_buffer->getIndexedPointArray(num);
+      floatArr points = p_buffer->getPointArray(num);
       cout << mat;
-      for(size_t i = 0; i < num; i++)
-      {
-        Vertex<float> v(points[i][0], points[i][1], points[i][2]);
-        v = mat * v;
-        points[i][0] = options.anyScaleX() ? v[0] * options.getScaleX() : v[0];
-        points[i][1] = options.anyScaleY() ? v[1] * options.getScaleY() : v[1];
-        points[i][2] = options.anyScaleZ() ? v[2] * options.getScaleZ() : v[2];
-      }
-      p_buffer->setIndexedPointArray(points, num);
+      transformAndReducePointArray(points.get(), num, points.get(), mat.getData());
     }
 
     // Get mesh buffer
@@ -166,17 +167,8 @@ int main(int argc, char **argv)
 
       cout << timestamp << "Using meshes" << endl;
       did_anything = true;
-      coord3fArr points = m_buffer->getIndexedVertexArray(num);
-
-      for(size_t i = 0; i < num; i++)
-      {
-        Vertex<float> v(points[i][0], points[i][1], points[i][2]);
-        v = mat * v;
-        points[i][0] = options.anyScaleX() ? v[0] * options.getScaleX() : v[0];
-        points[i][1] = options.anyScaleY() ? v[1] * options.getScaleY() : v[1];
-        points[i][2] = options.anyScaleZ() ? v[2] * options.getScaleZ() : v[2];
-      }
-      m_buffer->setIndexedVertexArray(points, num);
+      floatArr points = m_buffer->getVertexArray(num);
+      transformAndReducePointArray(points.get(), num, points.get(), mat.getData());
     }
 
     if(!did_anything)
@@ -34,7 +34,8 @@ void LVRMLSProjectionDialog::applyMLSProjection()
     QDoubleSpinBox* maximumDistance_box = m_dialog->doubleSpinBox_md;
     float maximumDistance = (float)maximumDistance_box->value();
 
-   /* PCLFiltering filter(m_pc->getPointBuffer());
+    // The filter works in place, so filter a copy of the point cloud
+    PointCloudFiltering filter(clonePointBuffer(m_pc->getPointBuffer()));
     filter.applyMLSProjection(maximumDistance);
 
     PointBufferPtr pb( filter.getPointBuffer() );
@@ -48,7 +49,7 @@ void LVRMLSProjectionDialog::applyMLSProjection()
     m_optimizedPointCloud = new LVRModelItem(bridge, base);
 
     m_treeWidget->addTopLevelItem(m_optimizedPointCloud);
-    m_optimizedPointCloud->setExpanded(true); */
+    m_optimizedPointCloud->setExpanded(true);
 }
 
 }
@@ -7,7 +7,8 @@
 #include <vtkSmartPointer.h>
 
 #include <lvr/io/ModelFactory.hpp>
-#include <lvr/reconstruction/PCLFiltering.hpp>
+#include <lvr/io/IOUtils.hpp>
+#include <lvr/reconstruction/PointCloudFiltering.hpp>
 
 #include "LVRFilteringMLSProjectionDialogUI.h"
 #include "LVRPointCloudItem.hpp"
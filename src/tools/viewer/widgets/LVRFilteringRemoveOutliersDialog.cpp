@@ -33,10 +33,11 @@ void LVRRemoveOutliersDialog::removeOutliers()
 {
     QDoubleSpinBox* standardDeviation_box = m_dialog->doubleSpinBox_st;
     float standardDeviation = (float)standardDeviation_box->value();
-    QDoubleSpinBox* meanK_box = m_dialog->doubleSpinBox_st;
-    float meanK = (float)meanK_box->value();
-	/*
-    PCLFiltering filter(m_pc->getPointBuffer());
+    QDoubleSpinBox* meanK_box = m_dialog->doubleSpinBox_sk;
+    int meanK = (int)meanK_box->value();
+
+    // The filter works in place, so filter a copy of the point cloud
+    PointCloudFiltering filter(clonePointBuffer(m_pc->getPointBuffer()));
     filter.applyOutlierRemoval(meanK, standardDeviation);
 
     PointBufferPtr pb( filter.getPointBuffer() );
@@ -50,7 +51,7 @@ void LVRRemoveOutliersDialog::removeOutliers()
     m_optimizedPointCloud = new LVRModelItem(bridge, base);
 
     m_treeWidget->addTopLevelItem(m_optimizedPointCloud);
-    m_optimizedPointCloud->setExpanded(true); */
+    m_optimizedPointCloud->setExpanded(true);
 }
 
 }